@@ -4,22 +4,25 @@
  ******************************************************************************/
 
 #include "Animator.h"
+#include "Core/Profiler.h"
 
 namespace MyEngine {
 
-Animator::Animator(Animation* animation) 
-    : m_CurrentTime(0.0f)
+Animator::Animator(Animation* animation, BonePalette* palette) 
+    : m_Palette(palette ? palette : &m_OwnPalette)
+    , m_CurrentTime(0.0f)
     , m_DeltaTime(0.0f)
 {
-    m_FinalBoneMatrices.reserve(MAX_BONES);
-    
-    for (int i = 0; i < MAX_BONES; i++)
-        m_FinalBoneMatrices.push_back(Mat4());
-
+    m_PaletteRange = m_Palette->Allocate(MAX_BONES);
     m_CurrentAnimation = animation;
 }
 
+Animator::~Animator() {
+    m_Palette->Free(m_PaletteRange);
+}
+
 void Animator::UpdateAnimation(float dt) {
+    PROFILE_SCOPE("Animator::UpdateAnimation");
     m_DeltaTime = dt;
     if (m_CurrentAnimation) {
         m_CurrentTime += m_CurrentAnimation->GetTicksPerSecond() * dt;
@@ -46,11 +49,11 @@ void Animator::CalculateBoneTransform(const AssimpNodeData* node, const Mat4& pa
 
     Mat4 globalTransformation = parentTransform * nodeTransform;
 
-    auto boneInfoMap = m_CurrentAnimation->GetBoneIDMap();
-    if (boneInfoMap.find(nodeName) != boneInfoMap.end()) {
-        int index = boneInfoMap[nodeName].id;
-        Mat4 offset = boneInfoMap[nodeName].offset;
-        m_FinalBoneMatrices[index] = globalTransformation * offset;
+    // By reference: the map used to be copied for every node of every frame
+    const auto& boneInfoMap = m_CurrentAnimation->GetBoneIDMap();
+    auto boneInfo = boneInfoMap.find(nodeName);
+    if (boneInfo != boneInfoMap.end() && boneInfo->second.id >= 0 && boneInfo->second.id < MAX_BONES) {
+        m_Palette->GetMatrices(m_PaletteRange)[boneInfo->second.id] = globalTransformation * boneInfo->second.offset;
     }
 
     for (int i = 0; i < node->childrenCount; i++)
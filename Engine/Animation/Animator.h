@@ -6,22 +6,35 @@
 #pragma once
 
 #include "Animation.h"
-#include <vector>
+#include "BonePalette.h"
+#include <span>
 
 namespace MyEngine {
 
 class Animator {
 public:
-    Animator(Animation* animation);
+    /**
+     * @brief palette: shared storage for several skinned instances (nullptr = own storage)
+     * The animator writes its MAX_BONES matrices into a range of the palette
+     */
+    Animator(Animation* animation, BonePalette* palette = nullptr);
+    ~Animator();
+    Animator(const Animator&) = delete;
+    Animator& operator=(const Animator&) = delete;
     
     void UpdateAnimation(float dt);
     void PlayAnimation(Animation* pAnimation);
     void CalculateBoneTransform(const AssimpNodeData* node, const Mat4& parentTransform);
     
-    std::vector<Mat4> GetFinalBoneMatrices() const { return m_FinalBoneMatrices; }
+    // In place, no copy. Invalidated when any animator on the same palette is created
+    // (Allocate may reallocate the storage); fetch it again each frame, keep the range instead
+    std::span<const Mat4> GetFinalBoneMatrices() const { return m_Palette->GetMatrices(m_PaletteRange); }
+    BonePalette::Range GetPaletteRange() const { return m_PaletteRange; }
 
 private:
-    std::vector<Mat4> m_FinalBoneMatrices;
+    BonePalette m_OwnPalette;
+    BonePalette* m_Palette;
+    BonePalette::Range m_PaletteRange;
     Animation* m_CurrentAnimation;
     float m_CurrentTime;
     float m_DeltaTime;
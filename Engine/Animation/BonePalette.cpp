@@ -0,0 +1,64 @@
+/******************************************************************************
+ * File: BonePalette.cpp
+ * Description: Contiguous bone matrix storage shared by skinned instances
+ ******************************************************************************/
+
+#include "BonePalette.h"
+#include <algorithm>
+
+namespace MyEngine {
+
+BonePalette::Range BonePalette::Allocate(uint32_t boneCount) {
+    Range range;
+    range.count = boneCount;
+
+    // First fit among freed ranges; the remainder stays free
+    auto hole = std::find_if(m_FreeRanges.begin(), m_FreeRanges.end(),
+        [boneCount](const Range& free) { return free.count >= boneCount; });
+    if (boneCount > 0 && hole != m_FreeRanges.end()) {
+        range.offset = hole->offset;
+        hole->offset += boneCount;
+        hole->count -= boneCount;
+        if (hole->count == 0) {
+            m_FreeRanges.erase(hole);
+        }
+        std::fill_n(m_Matrices.begin() + range.offset, boneCount, Mat4());
+        return range;
+    }
+
+    range.offset = static_cast<uint32_t>(m_Matrices.size());
+    m_Matrices.resize(m_Matrices.size() + boneCount);
+    return range;
+}
+
+void BonePalette::Free(Range range) {
+    if (range.count == 0 || range.offset + range.count > m_Matrices.size()) {
+        return;
+    }
+
+    auto next = std::lower_bound(m_FreeRanges.begin(), m_FreeRanges.end(), range.offset,
+        [](const Range& free, uint32_t offset) { return free.offset < offset; });
+
+    // Merge with the free neighbours on either side
+    if (next != m_FreeRanges.end() && range.offset + range.count == next->offset) {
+        range.count += next->count;
+        next = m_FreeRanges.erase(next);
+    }
+    if (next != m_FreeRanges.begin()) {
+        Range& previous = *(next - 1);
+        if (previous.offset + previous.count == range.offset) {
+            range.offset = previous.offset;
+            range.count += previous.count;
+            next = m_FreeRanges.erase(next - 1);
+        }
+    }
+
+    // A hole at the end just shortens the buffer (no other range moves)
+    if (range.offset + range.count == m_Matrices.size()) {
+        m_Matrices.resize(range.offset);
+        return;
+    }
+    m_FreeRanges.insert(next, range);
+}
+
+} // namespace MyEngine
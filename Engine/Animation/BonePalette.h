@@ -0,0 +1,60 @@
+/******************************************************************************
+ * File: BonePalette.h
+ * Description: Contiguous bone matrix storage shared by skinned instances
+ ******************************************************************************/
+
+#pragma once
+
+#include "Math/MathTypes.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace MyEngine {
+
+/**
+ * @brief Bone matrices of many skinned instances in one contiguous buffer
+ *
+ * 每个实例（Animator）分配一段区间，动画更新直接写入该区间；渲染时按实例 offset
+ * 取子区间整段上传（或一次上传全部），中间不再拷贝。
+ * 实例销毁时用 Free 归还区间：空闲区间按 offset 排序并与相邻区间合并，之后的 Allocate
+ * 先从中按首次适配复用，位于末尾的空闲区间直接截掉。已分配区间的 offset 永不移动（不做压缩）。
+ * Allocate 可能使底层存储重新分配：只长期保存 Range，不要保存指针或 span。
+ */
+class BonePalette {
+public:
+    struct Range {
+        uint32_t offset = 0;
+        uint32_t count = 0;
+    };
+
+    /**
+     * @brief Reserve boneCount matrices (identity) for one instance
+     */
+    Range Allocate(uint32_t boneCount);
+
+    /**
+     * @brief Return an instance's range for reuse (other ranges are unaffected)
+     */
+    void Free(Range range);
+
+    /**
+     * @brief Drop every range at once (all outstanding ranges become invalid)
+     */
+    void Clear() {
+        m_Matrices.clear();
+        m_FreeRanges.clear();
+    }
+
+    std::span<Mat4> GetMatrices(Range range) { return { m_Matrices.data() + range.offset, range.count }; }
+    std::span<const Mat4> GetMatrices(Range range) const { return { m_Matrices.data() + range.offset, range.count }; }
+
+    // Every instance by offset; freed holes inside hold stale matrices
+    std::span<const Mat4> GetAll() const { return m_Matrices; }
+
+private:
+    std::vector<Mat4> m_Matrices;
+    std::vector<Range> m_FreeRanges;   // Sorted by offset, never adjacent, never at the end
+};
+
+} // namespace MyEngine
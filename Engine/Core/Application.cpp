@@ -9,6 +9,8 @@
 #include "Log.h"
 #include "Config.h"
 #include "Module.h"
+#include "TaskSystem.h"
+#include "Profiler.h"
 #include "ImGuiLayer.h"
 #include "../Platform/Timer.h"
 #include "../Rendering/Renderer.h"
@@ -46,13 +48,20 @@ Application::Application(const std::string& name, EngineMode mode)
         m_Window->SetEventCallback([this](Event& e) { OnEvent(e); });
     }
 
+    // Start worker threads (modules initialize/update on them)
+    TaskSystem::Initialize(static_cast<uint32_t>(Config::Get<int>("tasks.worker_count", 0)));
+
     // Initialize modules
     ModuleRegistry::Get().InitializeAll();
     ENGINE_INFO("All modules initialized successfully");
     
-    // Initialize Renderer
-    Renderer::Init();
-    ENGINE_INFO("Renderer initialized");
+    // Initialize Renderer (needs the window's GL context)
+    if (m_Window) {
+        Renderer::Init();
+        ENGINE_INFO("Renderer initialized");
+    } else {
+        ENGINE_INFO("Headless mode: renderer disabled");
+    }
     
     // Create and push ImGui layer (only in Editor mode)
     if (mode == EngineMode::Editor) {
@@ -63,22 +72,66 @@ Application::Application(const std::string& name, EngineMode mode)
 
 Application::~Application() {
     // Shutdown renderer
-    Renderer::Shutdown();
-    ENGINE_INFO("Renderer shutdown");
+    if (m_Window) {
+        Renderer::Shutdown();
+        ENGINE_INFO("Renderer shutdown");
+    }
     
     // Shutdown modules
     ModuleRegistry::Get().ShutdownAll();
     
+    TaskSystem::Shutdown();
+    
     ENGINE_INFO("Application destroyed");
 }
 
+// Config values may come from engine.ini (typed) or the command line (strings)
+static double GetConfigNumber(const std::string& key, double defaultValue) {
+    if (Config::Has(key)) {
+        if (auto value = Config::Get<float>(key, -1.0f); value >= 0.0f) return value;
+        if (auto value = Config::Get<int>(key, -1); value >= 0) return value;
+        auto str = Config::Get<std::string>(key);
+        if (!str.empty()) {
+            try { return std::stod(str); } catch (...) {}
+        }
+    }
+    return defaultValue;
+}
+
+static bool GetConfigFlag(const std::string& key, bool defaultValue) {
+    if (!Config::Has(key)) return defaultValue;
+    auto str = Config::Get<std::string>(key);
+    if (!str.empty()) return str == "true" || str == "1";
+    return Config::Get<bool>(key, defaultValue);
+}
+
+static void ReportTickStatistics(const TickStatistics& stats, uint64_t ticks, float seconds) {
+    ENGINE_INFO("Server ticks: {} in {}s ({} ticks/s) | ms avg {} p50 {} p90 {} p99 {} max {}",
+        ticks, seconds, seconds > 0.0f ? ticks / seconds : 0.0f,
+        stats.GetAverage(), stats.GetPercentile(50.0f), stats.GetPercentile(90.0f),
+        stats.GetPercentile(99.0f), stats.GetMax());
+}
+
 void Application::Run() {
     ENGINE_INFO("Application started");
+    Profiler::SetThreadName("Main");
+
+    if (m_Window) {
+        RunWindowed();
+    } else {
+        RunHeadless();
+    }
+
+    ENGINE_INFO("Application stopped");
+}
 
+void Application::RunWindowed() {
     Timer frameTimer;
     m_LastFrameTime = 0.0f;
 
     while (m_Running) {
+        Profiler::BeginFrame();
+        
         float currentTime = frameTimer.Elapsed();
         float deltaTime = currentTime - m_LastFrameTime;
         m_LastFrameTime = currentTime;
@@ -89,15 +142,22 @@ void Application::Run() {
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
             
             // Update layers
-            for (auto& layer : m_LayerStack) {
-                layer->OnUpdate(deltaTime);
+            {
+                PROFILE_SCOPE("Layers::OnUpdate");
+                for (auto& layer : m_LayerStack) {
+                    layer->OnUpdate(deltaTime);
+                }
             }
             
             // Update modules
-            ModuleRegistry::Get().UpdateAll(deltaTime);
+            {
+                PROFILE_SCOPE("Modules::UpdateAll");
+                ModuleRegistry::Get().UpdateAll(deltaTime);
+            }
             
             // Render ImGui (only if ImGuiLayer exists)
             if (m_ImGuiLayer) {
+                PROFILE_SCOPE("ImGui");
                 m_ImGuiLayer->Begin();
                 
                 // Render all layer UIs
@@ -109,18 +169,83 @@ void Application::Run() {
             }
             
             // Swap buffers
-            if (m_Window) {
+            {
+                PROFILE_SCOPE("SwapBuffers");
                 m_Window->SwapBuffers();
             }
         }
 
-        // Poll events - skip in headless mode
-        if (m_Window) {
-            m_Window->OnUpdate();
-        }
+        // Poll events
+        m_Window->OnUpdate();
+        
+        Profiler::EndFrame();
     }
+}
 
-    ENGINE_INFO("Application stopped");
+void Application::RunHeadless() {
+    // server.tick_rate       - simulation rate in Hz (also sets the fixed delta)
+    // server.unthrottled     - run ticks back-to-back (soak tests)
+    // server.max_ticks       - stop after N ticks (0 = run until Close())
+    // server.report_interval - seconds between tick-time reports
+    double tickRate = GetConfigNumber("server.tick_rate", 60.0);
+    if (tickRate <= 0.0) tickRate = 60.0;
+    bool unthrottled = GetConfigFlag("server.unthrottled", false);
+    uint64_t maxTicks = static_cast<uint64_t>(GetConfigNumber("server.max_ticks", 0.0));
+    float reportInterval = static_cast<float>(GetConfigNumber("server.report_interval", 5.0));
+    
+    const float fixedDelta = static_cast<float>(1.0 / tickRate);
+    
+    ENGINE_INFO("Headless loop: {} Hz{}, max ticks {}",
+        tickRate, unthrottled ? " (unthrottled)" : "", maxTicks);
+    
+    FixedRateLimiter limiter(unthrottled ? 0.0 : tickRate);
+    TickStatistics stats;
+    Timer tickTimer;
+    Timer reportTimer;
+    Timer totalTimer;
+    uint64_t ticksSinceReport = 0;
+    m_TickCount = 0;
+    
+    while (m_Running) {
+        Profiler::BeginFrame();
+        tickTimer.Reset();
+        
+        {
+            PROFILE_SCOPE("Layers::OnUpdate");
+            for (auto& layer : m_LayerStack) {
+                layer->OnUpdate(fixedDelta);
+            }
+        }
+        {
+            PROFILE_SCOPE("Modules::UpdateAll");
+            ModuleRegistry::Get().UpdateAll(fixedDelta);
+        }
+        
+        stats.AddSample(tickTimer.ElapsedMillis());
+        Profiler::EndFrame();
+        ++m_TickCount;
+        ++ticksSinceReport;
+        
+        if (maxTicks != 0 && m_TickCount >= maxTicks) {
+            m_Running = false;
+        }
+        
+        if (reportInterval > 0.0f && reportTimer.Elapsed() >= reportInterval) {
+            ReportTickStatistics(stats, ticksSinceReport, reportTimer.Elapsed());
+            stats.Reset();
+            ticksSinceReport = 0;
+            reportTimer.Reset();
+        }
+        
+        if (m_Running) {
+            limiter.WaitForNextTick();
+        }
+    }
+    
+    if (ticksSinceReport > 0) {
+        ReportTickStatistics(stats, ticksSinceReport, reportTimer.Elapsed());
+    }
+    ENGINE_INFO("Headless loop finished: {} ticks in {}s", m_TickCount, totalTimer.Elapsed());
 }
 
 void Application::OnEvent(Event& e) {
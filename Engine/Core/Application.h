@@ -13,6 +13,7 @@
 #include "ApplicationEvent.h"
 #include "EngineMode.h"
 #include "LayerStack.h"
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -31,8 +32,16 @@ public:
 
     /**
      * @brief Run main application loop
+     * 
+     * Windowed modes run the render loop. Headless modes (Server/Tool) run
+     * a fixed-rate simulation loop that never touches the graphics API.
      */
     void Run();
+    
+    /**
+     * @brief Request the main loop to exit after the current frame/tick
+     */
+    void Close() { m_Running = false; }
 
     /**
      * @brief Handle events
@@ -49,6 +58,16 @@ public:
      */
     static Application& Get() { return *s_Instance; }
 
+    /**
+     * @brief Check if running without window/graphics context
+     */
+    bool IsHeadless() const { return m_Window == nullptr; }
+    
+    /**
+     * @brief Get number of ticks run by the headless loop
+     */
+    uint64_t GetTickCount() const { return m_TickCount; }
+
     /**
      * @brief Get engine mode
      */
@@ -70,6 +89,9 @@ public:
     void PushOverlay(std::shared_ptr<Layer> overlay);
 
 private:
+    void RunWindowed();
+    void RunHeadless();
+    
     bool OnWindowClose(WindowCloseEvent& e);
     bool OnWindowResize(WindowResizeEvent& e);
 
@@ -79,6 +101,7 @@ private:
     bool m_Running = true;
     bool m_Minimized = false;
     float m_LastFrameTime = 0.0f;
+    uint64_t m_TickCount = 0;
     
     LayerStack m_LayerStack;
     std::shared_ptr<class ImGuiLayer> m_ImGuiLayer;
@@ -28,6 +28,15 @@ void* FrameAllocator::Allocate(size_t size, size_t alignment) {
     return m_Buffers[m_CurrentBuffer]->Allocate(size, alignment);
 }
 
+void* FrameAllocator::TryAllocate(size_t size, size_t alignment) {
+    LinearAllocator* buffer = m_Buffers[m_CurrentBuffer];
+    // Worst-case padding is alignment - 1
+    if (buffer->GetUsedMemory() + size + alignment - 1 > buffer->GetTotalMemory()) {
+        return nullptr;
+    }
+    return buffer->Allocate(size, alignment);
+}
+
 void FrameAllocator::NextFrame() {
     // Switch to next buffer
     m_CurrentBuffer = (m_CurrentBuffer + 1) % BUFFER_COUNT;
@@ -37,6 +37,11 @@ public:
      */
     void* Allocate(size_t size, size_t alignment = 8);
 
+    /**
+     * @brief Allocate memory for current frame, returning nullptr instead of asserting when full
+     */
+    void* TryAllocate(size_t size, size_t alignment = 8);
+
     /**
      * @brief Switch to next frame (resets old buffer)
      */
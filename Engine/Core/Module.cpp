@@ -7,9 +7,13 @@
 
 #include "Module.h"
 #include "Log.h"
+#include "TaskSystem.h"
+#include "../Platform/Timer.h"
 #include <algorithm>
 #include <set>
 #include <functional>
+#include <mutex>
+#include <condition_variable>
 
 namespace MyEngine {
 
@@ -33,18 +37,27 @@ bool ModuleRegistry::InitializeAll() {
         return false;
     }
 
-    // Initialize in dependency order
-    for (const auto& moduleName : m_InitializationOrder) {
-        auto it = m_Modules.find(moduleName);
-        if (it != m_Modules.end()) {
-            ENGINE_INFO("Initializing module: {}", moduleName.c_str());
-            if (!it->second->Initialize()) {
-                ENGINE_ERROR("Failed to initialize module: {}", moduleName.c_str());
-                return false;
-            }
+    BuildGraph();
+
+    // Initialize in dependency order, independent branches in parallel
+    Timer startupTimer;
+    bool success = ExecuteGraph([](ModuleNode& node) {
+        ENGINE_INFO("Initializing module: {}", node.Name.c_str());
+        Timer timer;
+        bool ok = node.Module->Initialize();
+        node.InitTimeMs = timer.ElapsedMillis();
+        if (!ok) {
+            ENGINE_ERROR("Failed to initialize module: {}", node.Name.c_str());
         }
+        return ok;
+    });
+    m_StartupTimeMs = startupTimer.ElapsedMillis();
+
+    if (!success) {
+        return false;
     }
 
+    LogStartupReport();
     ENGINE_INFO("All modules initialized successfully");
     return true;
 }
@@ -65,11 +78,178 @@ void ModuleRegistry::ShutdownAll() {
 }
 
 void ModuleRegistry::UpdateAll(float deltaTime) {
+    ExecuteGraph([deltaTime](ModuleNode& node) {
+        Timer timer;
+        node.Module->Update(deltaTime);
+        node.UpdateTimeMs = timer.ElapsedMillis();
+        return true;
+    });
+}
+
+std::vector<ModuleRegistry::ModuleTiming> ModuleRegistry::GetModuleTimings() const {
+    std::vector<ModuleTiming> timings;
+    timings.reserve(m_Graph.size());
+    for (const auto& node : m_Graph) {
+        timings.push_back({ node.Name, node.InitTimeMs, node.UpdateTimeMs, node.MainThread });
+    }
+    return timings;
+}
+
+void ModuleRegistry::BuildGraph() {
+    m_Graph.clear();
+
+    std::unordered_map<std::string, uint32_t> indices;
     for (const auto& moduleName : m_InitializationOrder) {
         auto it = m_Modules.find(moduleName);
-        if (it != m_Modules.end()) {
-            it->second->Update(deltaTime);
+        if (it == m_Modules.end()) {
+            ENGINE_WARN("Module dependency '{}' is not registered, ignoring", moduleName.c_str());
+            continue;
+        }
+
+        ModuleNode node;
+        node.Name = moduleName;
+        node.Module = it->second;
+        node.MainThread = it->second->RequiresMainThread();
+        indices[moduleName] = static_cast<uint32_t>(m_Graph.size());
+        m_Graph.push_back(std::move(node));
+    }
+
+    // Edges (dependency -> dependent). Order is topological, so every
+    // registered dependency already has an index.
+    for (uint32_t i = 0; i < m_Graph.size(); ++i) {
+        std::set<uint32_t> uniqueDependencies;
+        for (const auto& dep : m_Graph[i].Module->GetDependencies()) {
+            auto it = indices.find(dep);
+            if (it != indices.end()) {
+                uniqueDependencies.insert(it->second);
+            }
+        }
+        for (uint32_t dep : uniqueDependencies) {
+            m_Graph[dep].Dependents.push_back(i);
+        }
+        m_Graph[i].DependencyCount = static_cast<uint32_t>(uniqueDependencies.size());
+    }
+
+    m_PendingDependencies.resize(m_Graph.size());
+}
+
+bool ModuleRegistry::ExecuteGraph(const std::function<bool(ModuleNode&)>& work) {
+    const uint32_t count = static_cast<uint32_t>(m_Graph.size());
+    if (count == 0) {
+        return true;
+    }
+
+    const bool parallel = TaskSystem::GetWorkerCount() > 0;
+
+    // Serial path: initialization order is already topological
+    if (!parallel) {
+        for (auto& node : m_Graph) {
+            if (!work(node)) {
+                return false;
+            }
         }
+        return true;
+    }
+
+    std::vector<uint32_t> ready;
+    std::vector<uint32_t> localReady;
+    std::vector<uint32_t> finishedBatch;
+    ready.reserve(count);
+    finishedBatch.reserve(count);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        m_PendingDependencies[i] = m_Graph[i].DependencyCount;
+        if (m_PendingDependencies[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+
+    // Completions reported by workers
+    std::mutex completedMutex;
+    std::condition_variable completedCondition;
+    std::vector<uint32_t> completed;
+    completed.reserve(count);
+    bool failed = false;  // Guarded by completedMutex
+
+    uint32_t finishedCount = 0;
+    while (finishedCount < count) {
+        // Dispatch everything whose dependencies are satisfied
+        for (uint32_t index : ready) {
+            bool skip;
+            {
+                std::lock_guard<std::mutex> lock(completedMutex);
+                skip = failed;
+            }
+
+            if (skip) {
+                // A dependency chain failed: don't start new work
+                finishedBatch.push_back(index);
+            } else if (m_Graph[index].MainThread || localReady.empty()) {
+                // Main-thread modules stay here; otherwise keep one ready
+                // module for ourselves instead of idling until a worker finishes
+                localReady.push_back(index);
+            } else {
+                TaskSystem::Schedule([&, index]() {
+                    bool ok = work(m_Graph[index]);
+                    std::lock_guard<std::mutex> lock(completedMutex);
+                    failed = failed || !ok;
+                    completed.push_back(index);
+                    completedCondition.notify_one();
+                });
+            }
+        }
+        ready.clear();
+
+        if (!localReady.empty()) {
+            // Run one module locally, then re-check for completions
+            uint32_t index = localReady.back();
+            localReady.pop_back();
+            bool ok = work(m_Graph[index]);
+            finishedBatch.push_back(index);
+
+            std::lock_guard<std::mutex> lock(completedMutex);
+            failed = failed || !ok;
+            finishedBatch.insert(finishedBatch.end(), completed.begin(), completed.end());
+            completed.clear();
+        } else if (finishedBatch.empty()) {
+            std::unique_lock<std::mutex> lock(completedMutex);
+            completedCondition.wait(lock, [&]() { return !completed.empty(); });
+            finishedBatch.insert(finishedBatch.end(), completed.begin(), completed.end());
+            completed.clear();
+        }
+
+        // Release dependents of finished modules
+        for (uint32_t index : finishedBatch) {
+            ++finishedCount;
+            for (uint32_t dependent : m_Graph[index].Dependents) {
+                if (--m_PendingDependencies[dependent] == 0) {
+                    ready.push_back(dependent);
+                }
+            }
+        }
+        finishedBatch.clear();
+    }
+
+    std::lock_guard<std::mutex> lock(completedMutex);
+    return !failed;
+}
+
+void ModuleRegistry::LogStartupReport() const {
+    std::vector<const ModuleNode*> sorted;
+    float totalMs = 0.0f;
+    for (const auto& node : m_Graph) {
+        sorted.push_back(&node);
+        totalMs += node.InitTimeMs;
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const ModuleNode* a, const ModuleNode* b) {
+        return a->InitTimeMs > b->InitTimeMs;
+    });
+
+    ENGINE_INFO("Module startup: {} ms wall, {} ms summed over {} modules",
+        m_StartupTimeMs, totalMs, sorted.size());
+    for (const auto* node : sorted) {
+        ENGINE_INFO("  {} : {} ms{}", node->Name.c_str(), node->InitTimeMs,
+            node->MainThread ? " (main thread)" : "");
     }
 }
 
@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <functional>
 #include <unordered_map>
 
 namespace MyEngine {
@@ -36,6 +37,15 @@ public:
      */
     virtual std::vector<std::string> GetDependencies() const { return {}; }
 
+    /**
+     * @brief Whether Initialize/Update must run on the main thread
+     * 
+     * Modules are otherwise free to run on TaskSystem workers concurrently
+     * with any module they do not (transitively) depend on. Override this
+     * for modules touching thread-affine APIs (GL context, window, etc.).
+     */
+    virtual bool RequiresMainThread() const { return false; }
+
     /**
      * @brief Initialize module
      */
@@ -67,8 +77,21 @@ public:
      */
     void RegisterModule(const std::string& name, std::shared_ptr<IModule> module);
 
+    /**
+     * @brief Per-module timing (milliseconds)
+     */
+    struct ModuleTiming {
+        std::string Name;
+        float InitTimeMs = 0.0f;
+        float UpdateTimeMs = 0.0f;   // Last frame
+        bool MainThread = false;
+    };
+
     /**
      * @brief Initialize all modules in dependency order
+     * 
+     * Independent modules are initialized concurrently on TaskSystem
+     * (serially if TaskSystem is not running).
      */
     bool InitializeAll();
 
@@ -78,10 +101,20 @@ public:
     void ShutdownAll();
 
     /**
-     * @brief Update all modules
+     * @brief Update all modules (dependencies update before dependents)
      */
     void UpdateAll(float deltaTime);
 
+    /**
+     * @brief Get timings of all modules, in initialization order
+     */
+    std::vector<ModuleTiming> GetModuleTimings() const;
+
+    /**
+     * @brief Wall-clock time of the last InitializeAll (milliseconds)
+     */
+    float GetStartupTimeMs() const { return m_StartupTimeMs; }
+
     /**
      * @brief Get module by name
      */
@@ -108,9 +141,39 @@ private:
     bool HasCircularDependency(const std::string& module, 
                                 std::vector<std::string>& visited);
 
+    /**
+     * @brief Node of the module dependency DAG (indices into m_Graph)
+     */
+    struct ModuleNode {
+        std::string Name;
+        std::shared_ptr<IModule> Module;
+        std::vector<uint32_t> Dependents;
+        uint32_t DependencyCount = 0;
+        bool MainThread = false;
+        float InitTimeMs = 0.0f;
+        float UpdateTimeMs = 0.0f;
+    };
+
+    /**
+     * @brief Build m_Graph from m_InitializationOrder
+     */
+    void BuildGraph();
+
+    /**
+     * @brief Run work on every node, each node only after its dependencies
+     * @return false if any work item failed (dependents are skipped)
+     */
+    bool ExecuteGraph(const std::function<bool(ModuleNode&)>& work);
+
+    void LogStartupReport() const;
+
 private:
     std::unordered_map<std::string, std::shared_ptr<IModule>> m_Modules;
     std::vector<std::string> m_InitializationOrder;
+
+    std::vector<ModuleNode> m_Graph;
+    std::vector<uint32_t> m_PendingDependencies;   // Reused scratch per execution
+    float m_StartupTimeMs = 0.0f;
 };
 
 /**
@@ -0,0 +1,287 @@
+/******************************************************************************
+ * File: Profiler.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: CPU profiler implementation
+ ******************************************************************************/
+
+#include "Profiler.h"
+#include "Log.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace MyEngine {
+
+namespace {
+
+struct RawEvent {
+    const char* Name;
+    uint64_t Start;
+    uint64_t End;
+    uint32_t Depth;
+};
+
+/**
+ * @brief Event buffer owned by one thread
+ * 
+ * The mutex is only contended while EndFrame drains the buffer.
+ */
+struct ThreadBuffer {
+    std::mutex Mutex;
+    std::vector<RawEvent> Events;
+    std::string Name;
+    uint32_t Index = 0;
+};
+
+struct ProfilerState {
+    std::atomic<bool> Enabled{true};
+    
+    std::mutex BuffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> Buffers;
+    
+    // Continuous tick calibration against steady_clock
+    uint64_t CalibrationTicks = Profiler::ReadTimestamp();
+    std::chrono::steady_clock::time_point CalibrationTime = std::chrono::steady_clock::now();
+    std::atomic<double> TicksPerMs{0.0};
+    
+    uint64_t FrameStart = 0;
+    uint64_t FrameIndex = 0;
+    size_t HistorySize = 300;
+    std::deque<ProfileFrame> History;
+    
+    std::vector<RawEvent> Scratch;
+};
+
+ProfilerState& GetState() {
+    static ProfilerState state;
+    return state;
+}
+
+thread_local ThreadBuffer* t_Buffer = nullptr;
+thread_local uint32_t t_Depth = 0;
+
+ThreadBuffer& GetThreadBuffer() {
+    if (!t_Buffer) {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> lock(state.BuffersMutex);
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->Index = static_cast<uint32_t>(state.Buffers.size());
+        buffer->Name = "Thread " + std::to_string(buffer->Index);
+        buffer->Events.reserve(1024);
+        t_Buffer = buffer.get();
+        state.Buffers.push_back(std::move(buffer));
+    }
+    return *t_Buffer;
+}
+
+void UpdateCalibration(ProfilerState& state) {
+    uint64_t ticks = Profiler::ReadTimestamp();
+    auto now = std::chrono::steady_clock::now();
+    double elapsedMs = std::chrono::duration<double, std::milli>(now - state.CalibrationTime).count();
+    if (elapsedMs > 1.0) {
+        state.TicksPerMs.store(static_cast<double>(ticks - state.CalibrationTicks) / elapsedMs,
+                               std::memory_order_relaxed);
+    }
+}
+
+void AppendEscaped(std::string& out, const char* str) {
+    for (const char* c = str; *c; ++c) {
+        if (*c == '"' || *c == '\\') out += '\\';
+        out += *c;
+    }
+}
+
+} // namespace
+
+void Profiler::BeginFrame() {
+    auto& state = GetState();
+    state.FrameStart = ReadTimestamp();
+}
+
+void Profiler::EndFrame() {
+    auto& state = GetState();
+    uint64_t frameEnd = ReadTimestamp();
+    UpdateCalibration(state);
+    
+    ProfileFrame frame;
+    frame.FrameIndex = state.FrameIndex++;
+    frame.StartTicks = state.FrameStart;
+    frame.DurationMs = TicksToMs(frameEnd - state.FrameStart);
+    
+    std::lock_guard<std::mutex> buffersLock(state.BuffersMutex);
+    for (auto& buffer : state.Buffers) {
+        state.Scratch.clear();
+        {
+            std::lock_guard<std::mutex> lock(buffer->Mutex);
+            std::swap(state.Scratch, buffer->Events);
+        }
+        if (state.Scratch.empty()) continue;
+        
+        // Events are recorded on scope exit (children first); reorder to
+        // start time so parents precede children
+        std::sort(state.Scratch.begin(), state.Scratch.end(),
+            [](const RawEvent& a, const RawEvent& b) {
+                return a.Start != b.Start ? a.Start < b.Start : a.Depth < b.Depth;
+            });
+        
+        std::vector<int32_t> stack;
+        for (const RawEvent& event : state.Scratch) {
+            while (!stack.empty() && frame.Nodes[stack.back()].Depth >= event.Depth) {
+                stack.pop_back();
+            }
+            
+            ProfileNode node;
+            node.Name = event.Name;
+            node.ThreadIndex = buffer->Index;
+            node.Depth = event.Depth;
+            node.Parent = stack.empty() ? -1 : stack.back();
+            node.StartMs = event.Start >= state.FrameStart
+                ? TicksToMs(event.Start - state.FrameStart)
+                : -TicksToMs(state.FrameStart - event.Start);
+            node.DurationMs = TicksToMs(event.End - event.Start);
+            node.SelfMs = node.DurationMs;
+            
+            if (node.Parent >= 0) {
+                frame.Nodes[node.Parent].SelfMs -= node.DurationMs;
+            }
+            
+            stack.push_back(static_cast<int32_t>(frame.Nodes.size()));
+            frame.Nodes.push_back(node);
+        }
+        
+        // Hand the (now larger) allocation back to avoid regrowth next frame
+        {
+            std::lock_guard<std::mutex> lock(buffer->Mutex);
+            if (buffer->Events.empty()) {
+                state.Scratch.clear();
+                std::swap(state.Scratch, buffer->Events);
+            }
+        }
+    }
+    
+    state.History.push_back(std::move(frame));
+    while (state.History.size() > state.HistorySize) {
+        state.History.pop_front();
+    }
+}
+
+void Profiler::SetEnabled(bool enabled) {
+    GetState().Enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::IsEnabled() {
+    return GetState().Enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::SetHistorySize(size_t frames) {
+    auto& state = GetState();
+    state.HistorySize = std::max<size_t>(frames, 1);
+    while (state.History.size() > state.HistorySize) {
+        state.History.pop_front();
+    }
+}
+
+const std::deque<ProfileFrame>& Profiler::GetHistory() {
+    return GetState().History;
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+    auto& buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(GetState().BuffersMutex);
+    buffer.Name = name;
+}
+
+std::string Profiler::GetThreadName(uint32_t threadIndex) {
+    auto& state = GetState();
+    std::lock_guard<std::mutex> lock(state.BuffersMutex);
+    if (threadIndex < state.Buffers.size()) {
+        return state.Buffers[threadIndex]->Name;
+    }
+    return "Unknown";
+}
+
+double Profiler::TicksToMs(uint64_t ticks) {
+    auto& state = GetState();
+    double ticksPerMs = state.TicksPerMs.load(std::memory_order_relaxed);
+    if (ticksPerMs <= 0.0) {
+        UpdateCalibration(state);
+        ticksPerMs = state.TicksPerMs.load(std::memory_order_relaxed);
+        if (ticksPerMs <= 0.0) return 0.0;
+    }
+    return static_cast<double>(ticks) / ticksPerMs;
+}
+
+uint32_t Profiler::EnterScope() {
+    return t_Depth++;
+}
+
+void Profiler::LeaveScope(const char* name, uint64_t start, uint64_t end, uint32_t depth) {
+    t_Depth = depth;
+    auto& buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.Mutex);
+    buffer.Events.push_back({ name, start, end, depth });
+}
+
+bool Profiler::ExportChromeTrace(const std::string& path) {
+    auto& state = GetState();
+    if (state.History.empty()) {
+        ENGINE_WARN("Profiler: nothing to export");
+        return false;
+    }
+    
+    std::ofstream file(path);
+    if (!file) {
+        ENGINE_ERROR("Profiler: failed to open '{}'", path);
+        return false;
+    }
+    
+    const uint64_t origin = state.History.front().StartTicks;
+    std::string json;
+    json.reserve(1 << 16);
+    json += "{\"traceEvents\":[";
+    
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) json += ',';
+        first = false;
+    };
+    
+    {
+        std::lock_guard<std::mutex> lock(state.BuffersMutex);
+        for (const auto& buffer : state.Buffers) {
+            separator();
+            json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":";
+            json += std::to_string(buffer->Index);
+            json += ",\"args\":{\"name\":\"";
+            AppendEscaped(json, buffer->Name.c_str());
+            json += "\"}}";
+        }
+    }
+    
+    for (const auto& frame : state.History) {
+        double frameOffsetUs = TicksToMs(frame.StartTicks - origin) * 1000.0;
+        for (const auto& node : frame.Nodes) {
+            separator();
+            json += "{\"name\":\"";
+            AppendEscaped(json, node.Name);
+            json += "\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":0,\"tid\":";
+            json += std::to_string(node.ThreadIndex);
+            json += ",\"ts\":";
+            json += std::to_string(frameOffsetUs + node.StartMs * 1000.0);
+            json += ",\"dur\":";
+            json += std::to_string(node.DurationMs * 1000.0);
+            json += '}';
+        }
+    }
+    
+    json += "]}";
+    file << json;
+    
+    ENGINE_INFO("Profiler: exported {} frames to '{}'", state.History.size(), path);
+    return true;
+}
+
+} // namespace MyEngine
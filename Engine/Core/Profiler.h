@@ -0,0 +1,162 @@
+/******************************************************************************
+ * File: Profiler.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Hierarchical CPU frame profiler (per-thread event buffers,
+ *              per-frame call trees, history, Chrome trace export)
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define MYENGINE_PROFILER_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define MYENGINE_PROFILER_RDTSC 1
+#endif
+
+// Compile profiling out entirely with -DMYENGINE_PROFILING=0
+#ifndef MYENGINE_PROFILING
+    #define MYENGINE_PROFILING 1
+#endif
+
+namespace MyEngine {
+
+/**
+ * @brief One node of a frame's call tree
+ */
+struct ProfileNode {
+    const char* Name = nullptr;
+    uint32_t ThreadIndex = 0;
+    uint32_t Depth = 0;
+    int32_t Parent = -1;          // Index into ProfileFrame::Nodes (-1 = root)
+    double StartMs = 0.0;         // Relative to frame start
+    double DurationMs = 0.0;
+    double SelfMs = 0.0;          // Duration minus children
+};
+
+/**
+ * @brief Everything recorded between BeginFrame and EndFrame
+ * 
+ * Nodes are grouped by thread, and within a thread ordered depth-first
+ * (parents precede their children).
+ */
+struct ProfileFrame {
+    uint64_t FrameIndex = 0;
+    uint64_t StartTicks = 0;
+    double DurationMs = 0.0;
+    std::vector<ProfileNode> Nodes;
+};
+
+/**
+ * @brief Global CPU profiler
+ * 
+ * Usage:
+ *   void Foo() {
+ *       PROFILE_FUNCTION();
+ *       {
+ *           PROFILE_SCOPE("Foo::Inner");
+ *       }
+ *   }
+ * 
+ * Scopes write raw timestamps (rdtsc where available) into a buffer owned
+ * by the calling thread. EndFrame (main thread) drains all buffers, builds
+ * the call tree and appends it to a bounded history.
+ * 
+ * Scope names must be string literals (or otherwise outlive the history).
+ */
+class Profiler {
+public:
+    static void BeginFrame();
+    static void EndFrame();
+    
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled();
+    
+    /**
+     * @brief Number of frames kept in history
+     */
+    static void SetHistorySize(size_t frames);
+    static const std::deque<ProfileFrame>& GetHistory();
+    
+    /**
+     * @brief Name the calling thread (shown in panel and trace)
+     */
+    static void SetThreadName(const std::string& name);
+    static std::string GetThreadName(uint32_t threadIndex);
+    
+    /**
+     * @brief Write history as Chrome trace JSON (chrome://tracing, Perfetto)
+     */
+    static bool ExportChromeTrace(const std::string& path);
+    
+    /**
+     * @brief Raw timestamp in profiler ticks
+     */
+    static uint64_t ReadTimestamp() {
+#ifdef MYENGINE_PROFILER_RDTSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+    
+    /**
+     * @brief Convert profiler ticks to milliseconds
+     */
+    static double TicksToMs(uint64_t ticks);
+    
+    // Internal: called by ProfileScope
+    static uint32_t EnterScope();
+    static void LeaveScope(const char* name, uint64_t start, uint64_t end, uint32_t depth);
+};
+
+/**
+ * @brief RAII scope recorder (use the PROFILE_* macros)
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : m_Name(name) {
+        m_Active = Profiler::IsEnabled();
+        if (m_Active) {
+            m_Depth = Profiler::EnterScope();
+            m_Start = Profiler::ReadTimestamp();
+        }
+    }
+    
+    ~ProfileScope() {
+        if (m_Active) {
+            Profiler::LeaveScope(m_Name, m_Start, Profiler::ReadTimestamp(), m_Depth);
+        }
+    }
+    
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+    
+private:
+    const char* m_Name;
+    uint64_t m_Start = 0;
+    uint32_t m_Depth = 0;
+    bool m_Active = false;
+};
+
+} // namespace MyEngine
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if MYENGINE_PROFILING
+    #define PROFILE_SCOPE(name) ::MyEngine::ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+    #define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#else
+    #define PROFILE_SCOPE(name)
+    #define PROFILE_FUNCTION()
+#endif
@@ -7,6 +7,7 @@
 
 #include "TaskSystem.h"
 #include "Log.h"
+#include "Profiler.h"
 #include <algorithm>
 #include <random>
 
@@ -135,6 +136,7 @@ TaskHandle TaskSystem::ScheduleInternal(TaskFunction function, TaskPriority prio
 }
 
 void TaskSystem::WorkerThreadFunction(uint32_t threadIndex) {
+    Profiler::SetThreadName("Worker " + std::to_string(threadIndex));
     Task task;
     
     while (m_Running.load(std::memory_order_acquire)) {
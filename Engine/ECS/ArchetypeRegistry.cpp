@@ -0,0 +1,317 @@
+/******************************************************************************
+ * File: ArchetypeRegistry.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Archetype registry implementation
+ ******************************************************************************/
+
+#include "ArchetypeRegistry.h"
+#include <algorithm>
+
+namespace MyEngine {
+
+// ============================================================================
+// ArchetypeChunkData
+// ============================================================================
+
+ArchetypeChunkData::ArchetypeChunkData() {
+    Data = static_cast<std::byte*>(::operator new(ArchetypeRegistry::CHUNK_SIZE,
+        std::align_val_t(ArchetypeRegistry::COLUMN_ALIGNMENT)));
+}
+
+ArchetypeChunkData::~ArchetypeChunkData() {
+    ::operator delete(Data, std::align_val_t(ArchetypeRegistry::COLUMN_ALIGNMENT));
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static EntityID* GetEntityColumn(ArchetypeChunkData& chunk) {
+    return reinterpret_cast<EntityID*>(chunk.Data);
+}
+
+// ============================================================================
+// ArchetypeRegistry
+// ============================================================================
+
+ArchetypeRegistry::ArchetypeRegistry() {
+    // Index 0 is reserved so that NULL_ENTITY (0) is never a live handle
+    m_Records.emplace_back();
+    m_EmptyArchetype = GetOrCreateArchetype(std::bitset<MAX_COMPONENTS>());
+}
+
+ArchetypeRegistry::~ArchetypeRegistry() {
+    for (auto& archetype : m_Archetypes) {
+        for (auto& chunk : archetype->Chunks) {
+            for (size_t column = 0; column < archetype->Types.size(); ++column) {
+                const ComponentTypeInfo& info = m_TypeInfos[archetype->Types[column]];
+                for (uint32_t row = 0; row < chunk->Count; ++row) {
+                    info.Destroy(GetCell(*archetype, *chunk, column, info.Size, row));
+                }
+            }
+        }
+    }
+}
+
+EntityID ArchetypeRegistry::CreateEntity() {
+    EntityID entity;
+    uint32_t index;
+    if (m_FreeHead != 0) {
+        index = m_FreeHead;
+        const EntityID slot = m_Records[index].Handle;
+        m_FreeHead = GetEntityIndex(slot);
+        entity = MakeEntityID(index, GetEntityVersion(slot));
+    } else {
+        if (m_Records.size() > ENTITY_INDEX_MASK) {
+            ENGINE_ERROR("Too many entities in existence.");
+            return NULL_ENTITY;
+        }
+        index = static_cast<uint32_t>(m_Records.size());
+        entity = MakeEntityID(index, 0);
+        m_Records.emplace_back();
+    }
+
+    auto [chunk, row] = AllocateRow(*m_EmptyArchetype, entity);
+    m_Records[index] = { m_EmptyArchetype, chunk, row, entity };
+    m_LivingEntityCount++;
+    return entity;
+}
+
+void ArchetypeRegistry::DestroyEntity(EntityID entity) {
+    if (!IsAlive(entity)) {
+        ENGINE_ERROR("Destroying non-existent entity {}.", entity);
+        return;
+    }
+
+    const uint32_t index = GetEntityIndex(entity);
+    EntityRecord record = m_Records[index];
+    Archetype& archetype = *record.Arch;
+    ArchetypeChunkData& chunk = *archetype.Chunks[record.Chunk];
+    for (size_t column = 0; column < archetype.Types.size(); ++column) {
+        const ComponentTypeInfo& info = m_TypeInfos[archetype.Types[column]];
+        info.Destroy(GetCell(archetype, chunk, column, info.Size, record.Row));
+    }
+    RemoveRow(archetype, record.Chunk, record.Row);
+
+    m_Records[index] = { nullptr, 0, 0, MakeEntityID(m_FreeHead, NextEntityVersion(GetEntityVersion(entity))) };
+    m_FreeHead = index;
+    m_LivingEntityCount--;
+}
+
+bool ArchetypeRegistry::IsAlive(EntityID entity) const {
+    const uint32_t index = GetEntityIndex(entity);
+    return index != 0 && index < m_Records.size() && m_Records[index].Handle == entity
+        && m_Records[index].Arch != nullptr;
+}
+
+size_t ArchetypeRegistry::GetChunkCount() const {
+    size_t count = 0;
+    for (const auto& archetype : m_Archetypes) {
+        count += archetype->Chunks.size();
+    }
+    return count;
+}
+
+bool ArchetypeRegistry::CheckComponent(EntityID entity, ComponentID id, const char* operation) const {
+    if (!IsAlive(entity)) {
+        ENGINE_ERROR("{}: entity {} does not exist.", operation, entity);
+        return false;
+    }
+    if (!m_Registered.test(id)) {
+        ENGINE_ERROR("{}: component type {} is not registered.", operation, id);
+        return false;
+    }
+    return true;
+}
+
+void* ArchetypeRegistry::GetComponentPointer(EntityID entity, ComponentID id) {
+    const EntityRecord& record = m_Records[GetEntityIndex(entity)];
+    const int16_t column = record.Arch->ColumnIndex[id];
+    if (column < 0) {
+        return nullptr;
+    }
+    return GetCell(*record.Arch, *record.Arch->Chunks[record.Chunk], column,
+                   m_TypeInfos[id].Size, record.Row);
+}
+
+Archetype* ArchetypeRegistry::GetOrCreateArchetype(const std::bitset<MAX_COMPONENTS>& mask) {
+    auto it = m_ArchetypeLookup.find(mask);
+    if (it != m_ArchetypeLookup.end()) {
+        return it->second;
+    }
+
+    auto archetype = std::make_unique<Archetype>();
+    archetype->Mask = mask;
+    archetype->ColumnIndex.fill(-1);
+    for (ComponentID id = 0; id < MAX_COMPONENTS; ++id) {
+        if (mask.test(id)) {
+            archetype->ColumnIndex[id] = static_cast<int16_t>(archetype->Types.size());
+            archetype->Types.push_back(id);
+        }
+    }
+
+    // Largest capacity whose aligned SoA layout fits in one chunk
+    size_t bytesPerEntity = sizeof(EntityID);
+    for (ComponentID id : archetype->Types) {
+        bytesPerEntity += m_TypeInfos[id].Size;
+    }
+    uint32_t capacity = static_cast<uint32_t>(CHUNK_SIZE / bytesPerEntity);
+    archetype->ColumnOffsets.resize(archetype->Types.size());
+    for (; capacity > 0; --capacity) {
+        size_t offset = sizeof(EntityID) * capacity;
+        for (size_t column = 0; column < archetype->Types.size(); ++column) {
+            const ComponentTypeInfo& info = m_TypeInfos[archetype->Types[column]];
+            offset = AlignUp(offset, std::max(info.Alignment, COLUMN_ALIGNMENT));
+            archetype->ColumnOffsets[column] = offset;
+            offset += info.Size * capacity;
+        }
+        if (offset <= CHUNK_SIZE) {
+            break;
+        }
+    }
+    if (capacity == 0) {
+        // Rows would run past the chunk allocation: refuse the archetype, the caller fails
+        ENGINE_ERROR("Archetype with {} components does not fit in a {} byte chunk.",
+                     archetype->Types.size(), CHUNK_SIZE);
+        return nullptr;
+    }
+    archetype->ChunkCapacity = capacity;
+
+    Archetype* result = archetype.get();
+    m_Archetypes.push_back(std::move(archetype));
+    m_ArchetypeLookup[mask] = result;
+
+    // Keep cached queries complete
+    for (auto& query : m_Queries) {
+        if ((mask & query->Mask) == query->Mask) {
+            query->Archetypes.push_back(result);
+        }
+    }
+    return result;
+}
+
+Archetype* ArchetypeRegistry::GetAddTarget(Archetype& source, ComponentID id) {
+    if (!source.AddEdges[id]) {
+        Archetype* target = GetOrCreateArchetype(std::bitset<MAX_COMPONENTS>(source.Mask).set(id));
+        if (!target) {
+            return nullptr;
+        }
+        source.AddEdges[id] = target;
+        target->RemoveEdges[id] = &source;
+    }
+    return source.AddEdges[id];
+}
+
+Archetype* ArchetypeRegistry::GetRemoveTarget(Archetype& source, ComponentID id) {
+    if (!source.RemoveEdges[id]) {
+        Archetype* target = GetOrCreateArchetype(std::bitset<MAX_COMPONENTS>(source.Mask).reset(id));
+        source.RemoveEdges[id] = target;
+        target->AddEdges[id] = &source;
+    }
+    return source.RemoveEdges[id];
+}
+
+const std::vector<Archetype*>& ArchetypeRegistry::GetMatchingArchetypes(const std::bitset<MAX_COMPONENTS>& mask) {
+    for (const auto& query : m_Queries) {
+        if (query->Mask == mask) {
+            return query->Archetypes;
+        }
+    }
+
+    auto query = std::make_unique<ArchetypeQuery>();
+    query->Mask = mask;
+    for (const auto& archetype : m_Archetypes) {
+        if ((archetype->Mask & mask) == mask) {
+            query->Archetypes.push_back(archetype.get());
+        }
+    }
+    m_Queries.push_back(std::move(query));
+    return m_Queries.back()->Archetypes;
+}
+
+std::pair<uint32_t, uint32_t> ArchetypeRegistry::AllocateRow(Archetype& archetype, EntityID entity) {
+    if (archetype.Chunks.empty() || archetype.Chunks.back()->Count == archetype.ChunkCapacity) {
+        archetype.Chunks.push_back(AcquireChunk());
+    }
+
+    const uint32_t chunkIndex = static_cast<uint32_t>(archetype.Chunks.size() - 1);
+    ArchetypeChunkData& chunk = *archetype.Chunks[chunkIndex];
+    const uint32_t row = chunk.Count++;
+    GetEntityColumn(chunk)[row] = entity;
+    archetype.EntityCount++;
+    return { chunkIndex, row };
+}
+
+void ArchetypeRegistry::RemoveRow(Archetype& archetype, uint32_t chunkIndex, uint32_t row) {
+    // Components at (chunkIndex, row) must already be destroyed.
+    // Fill the hole with the archetype's last row so chunks stay packed.
+    ArchetypeChunkData& chunk = *archetype.Chunks[chunkIndex];
+    ArchetypeChunkData& last = *archetype.Chunks.back();
+    const uint32_t lastRow = last.Count - 1;
+
+    if (&chunk != &last || row != lastRow) {
+        for (size_t column = 0; column < archetype.Types.size(); ++column) {
+            const ComponentTypeInfo& info = m_TypeInfos[archetype.Types[column]];
+            void* src = GetCell(archetype, last, column, info.Size, lastRow);
+            info.MoveConstruct(GetCell(archetype, chunk, column, info.Size, row), src);
+            info.Destroy(src);
+        }
+
+        const EntityID moved = GetEntityColumn(last)[lastRow];
+        GetEntityColumn(chunk)[row] = moved;
+        m_Records[GetEntityIndex(moved)].Chunk = chunkIndex;
+        m_Records[GetEntityIndex(moved)].Row = row;
+    }
+
+    last.Count--;
+    archetype.EntityCount--;
+    if (last.Count == 0) {
+        ReleaseChunk(std::move(archetype.Chunks.back()));
+        archetype.Chunks.pop_back();
+    }
+}
+
+void ArchetypeRegistry::MoveEntity(EntityID entity, Archetype* target) {
+    const EntityRecord record = m_Records[GetEntityIndex(entity)];
+    Archetype& source = *record.Arch;
+    ArchetypeChunkData& sourceChunk = *source.Chunks[record.Chunk];
+
+    auto [chunkIndex, row] = AllocateRow(*target, entity);
+    ArchetypeChunkData& targetChunk = *target->Chunks[chunkIndex];
+
+    // Carry over shared components, destroy the rest
+    for (size_t column = 0; column < source.Types.size(); ++column) {
+        const ComponentID id = source.Types[column];
+        const ComponentTypeInfo& info = m_TypeInfos[id];
+        void* src = GetCell(source, sourceChunk, column, info.Size, record.Row);
+        const int16_t targetColumn = target->ColumnIndex[id];
+        if (targetColumn >= 0) {
+            info.MoveConstruct(GetCell(*target, targetChunk, targetColumn, info.Size, row), src);
+        }
+        info.Destroy(src);
+    }
+
+    RemoveRow(source, record.Chunk, record.Row);
+    m_Records[GetEntityIndex(entity)] = { target, chunkIndex, row, entity };
+}
+
+std::unique_ptr<ArchetypeChunkData> ArchetypeRegistry::AcquireChunk() {
+    if (!m_FreeChunks.empty()) {
+        auto chunk = std::move(m_FreeChunks.back());
+        m_FreeChunks.pop_back();
+        return chunk;
+    }
+    return std::make_unique<ArchetypeChunkData>();
+}
+
+void ArchetypeRegistry::ReleaseChunk(std::unique_ptr<ArchetypeChunkData> chunk) {
+    chunk->Count = 0;
+    m_FreeChunks.push_back(std::move(chunk));
+}
+
+} // namespace MyEngine
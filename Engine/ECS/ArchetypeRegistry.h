@@ -0,0 +1,304 @@
+/******************************************************************************
+ * File: ArchetypeRegistry.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Archetype/chunk based ECS storage (SoA columns in 16 KB chunks)
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Component.h"
+#include "Core/Log.h"
+
+namespace MyEngine {
+
+/**
+ * @brief Type-erased component operations used when moving rows between chunks
+ */
+struct ComponentTypeInfo {
+    size_t Size = 0;
+    size_t Alignment = 0;
+    void (*MoveConstruct)(void* dst, void* src) = nullptr;
+    void (*Destroy)(void* ptr) = nullptr;
+    const char* Name = nullptr;
+};
+
+/**
+ * @brief Fixed-size block holding up to ChunkCapacity entities of one archetype
+ *
+ * 布局（SoA）：[EntityID 列][组件 A 列][组件 B 列]...，每列按 64 字节对齐。
+ */
+struct ArchetypeChunkData {
+    std::byte* Data = nullptr;
+    uint32_t Count = 0;
+
+    ArchetypeChunkData();
+    ~ArchetypeChunkData();
+    ArchetypeChunkData(const ArchetypeChunkData&) = delete;
+    ArchetypeChunkData& operator=(const ArchetypeChunkData&) = delete;
+};
+
+/**
+ * @brief Set of entities sharing exactly the same component types
+ */
+struct Archetype {
+    std::bitset<MAX_COMPONENTS> Mask;
+    std::vector<ComponentID> Types;                 // Sorted component IDs
+    std::vector<size_t> ColumnOffsets;              // Byte offset of each column in a chunk
+    std::array<int16_t, MAX_COMPONENTS> ColumnIndex; // ComponentID -> column (-1 = absent)
+    uint32_t ChunkCapacity = 0;
+    size_t EntityCount = 0;
+    std::vector<std::unique_ptr<ArchetypeChunkData>> Chunks;
+
+    // Archetype graph: cached transitions for adding/removing one component
+    std::array<Archetype*, MAX_COMPONENTS> AddEdges{};
+    std::array<Archetype*, MAX_COMPONENTS> RemoveEdges{};
+};
+
+/**
+ * @brief Read/write access to one chunk during iteration
+ */
+class ArchetypeChunk {
+public:
+    ArchetypeChunk(const Archetype& archetype, ArchetypeChunkData& chunk)
+        : m_Archetype(archetype), m_Chunk(chunk) {}
+
+    uint32_t Count() const { return m_Chunk.Count; }
+    const EntityID* Entities() const { return reinterpret_cast<const EntityID*>(m_Chunk.Data); }
+
+    /**
+     * @brief Contiguous column for T (nullptr if the archetype lacks T)
+     */
+    template<typename T>
+    T* Column() const {
+        const int16_t column = m_Archetype.ColumnIndex[GetComponentTypeID<T>()];
+        if (column < 0) {
+            return nullptr;
+        }
+        return std::launder(reinterpret_cast<T*>(m_Chunk.Data + m_Archetype.ColumnOffsets[column]));
+    }
+
+    template<typename T>
+    bool Has() const {
+        return m_Archetype.ColumnIndex[GetComponentTypeID<T>()] >= 0;
+    }
+
+private:
+    const Archetype& m_Archetype;
+    ArchetypeChunkData& m_Chunk;
+};
+
+/**
+ * @brief 基于 Archetype 的 ECS 存储
+ *
+ * 与 Registry 提供相同的实体/组件接口，但拥有相同组件集合的实体存放在一起：
+ * - 每个 Archetype 拥有若干 16 KB Chunk，组件按列（SoA）连续存放，便于流式访问与向量化
+ * - Archetype 图的边缓存"增/删一个组件"后的目标 Archetype，迁移只需一次查表
+ * - 迭代以 Chunk 为单位（EachChunk）或逐实体（Each）
+ *
+ * 取舍：迭代密集型负载更快；频繁增删组件时每次都要在 Chunk 间搬移整行数据，
+ * 此时 Registry（稀疏集合）通常更合适。
+ *
+ * 迭代期间不允许结构性修改（创建/销毁实体、增删组件）。
+ */
+class ArchetypeRegistry {
+public:
+    static constexpr size_t CHUNK_SIZE = 16 * 1024;
+    static constexpr size_t COLUMN_ALIGNMENT = 64;
+
+    ArchetypeRegistry();
+    ~ArchetypeRegistry();
+    ArchetypeRegistry(const ArchetypeRegistry&) = delete;
+    ArchetypeRegistry& operator=(const ArchetypeRegistry&) = delete;
+
+    EntityID CreateEntity();
+    void DestroyEntity(EntityID entity);
+    bool IsAlive(EntityID entity) const;
+
+    template<typename T>
+    void RegisterComponent() {
+        const ComponentID id = GetComponentTypeID<T>();
+        if (m_Registered.test(id)) {
+            return;
+        }
+        ComponentTypeInfo& info = m_TypeInfos[id];
+        info.Size = sizeof(T);
+        info.Alignment = alignof(T);
+        info.MoveConstruct = [](void* dst, void* src) {
+            new (dst) T(std::move(*static_cast<T*>(src)));
+        };
+        info.Destroy = [](void* ptr) {
+            static_cast<T*>(ptr)->~T();
+        };
+        info.Name = typeid(T).name();
+        m_Registered.set(id);
+    }
+
+    template<typename T>
+    T& AddComponent(EntityID entity, T component) {
+        const ComponentID id = GetComponentTypeID<T>();
+        if (!CheckComponent(entity, id, "AddComponent")) {
+            static T dummy;
+            return dummy;
+        }
+
+        Archetype* source = m_Records[GetEntityIndex(entity)].Arch;
+        if (source->ColumnIndex[id] >= 0) {
+            ENGINE_ERROR("Component added to same entity more than once.");
+            return *static_cast<T*>(GetComponentPointer(entity, id));
+        }
+
+        Archetype* target = GetAddTarget(*source, id);
+        if (!target) {
+            static T dummy;
+            return dummy;
+        }
+        MoveEntity(entity, target);
+        return *new (GetComponentPointer(entity, id)) T(std::move(component));
+    }
+
+    template<typename T>
+    void RemoveComponent(EntityID entity) {
+        const ComponentID id = GetComponentTypeID<T>();
+        if (!CheckComponent(entity, id, "RemoveComponent")) {
+            return;
+        }
+
+        Archetype* source = m_Records[GetEntityIndex(entity)].Arch;
+        if (source->ColumnIndex[id] < 0) {
+            ENGINE_ERROR("Removing non-existent component.");
+            return;
+        }
+        MoveEntity(entity, GetRemoveTarget(*source, id));
+    }
+
+    template<typename T>
+    T& GetComponent(EntityID entity) {
+        void* ptr = IsAlive(entity) ? GetComponentPointer(entity, GetComponentTypeID<T>()) : nullptr;
+        if (!ptr) {
+            ENGINE_ERROR("Retrieving non-existent component.");
+            static T dummy;
+            return dummy;
+        }
+        return *std::launder(static_cast<T*>(ptr));
+    }
+
+    template<typename T>
+    bool HasComponent(EntityID entity) const {
+        return IsAlive(entity) && m_Records[GetEntityIndex(entity)].Arch->ColumnIndex[GetComponentTypeID<T>()] >= 0;
+    }
+
+    std::bitset<MAX_COMPONENTS> GetSignature(EntityID entity) const {
+        return IsAlive(entity) ? m_Records[GetEntityIndex(entity)].Arch->Mask : std::bitset<MAX_COMPONENTS>();
+    }
+
+    /**
+     * @brief Invoke func(ArchetypeChunk&) for every non-empty chunk containing all Ts
+     */
+    template<typename... Ts, typename Func>
+    void EachChunk(Func&& func) {
+        std::bitset<MAX_COMPONENTS> mask;
+        (mask.set(GetComponentTypeID<Ts>()), ...);
+
+        for (Archetype* archetype : GetMatchingArchetypes(mask)) {
+            for (auto& chunk : archetype->Chunks) {
+                if (chunk->Count == 0) {
+                    continue;
+                }
+                ArchetypeChunk view(*archetype, *chunk);
+                func(view);
+            }
+        }
+    }
+
+    /**
+     * @brief Invoke func(EntityID, Ts&...) or func(Ts&...) for every matching entity
+     */
+    template<typename... Ts, typename Func>
+    void Each(Func&& func) {
+        EachChunk<Ts...>([&func](ArchetypeChunk& chunk) {
+            const EntityID* entities = chunk.Entities();
+            std::tuple<Ts*...> columns(chunk.Column<Ts>()...);
+            const uint32_t count = chunk.Count();
+            for (uint32_t i = 0; i < count; ++i) {
+                if constexpr (std::is_invocable_v<Func, EntityID, Ts&...>) {
+                    func(entities[i], std::get<Ts*>(columns)[i]...);
+                } else {
+                    func(std::get<Ts*>(columns)[i]...);
+                }
+            }
+        });
+    }
+
+    // Statistics
+    size_t GetEntityCount() const { return m_LivingEntityCount; }
+    size_t GetArchetypeCount() const { return m_Archetypes.size(); }
+    size_t GetChunkCount() const;
+
+private:
+    /**
+     * @brief Per-index slot. Free slots reuse Handle as an intrusive free list
+     *        (index bits = next free slot, version bits = next version).
+     */
+    struct EntityRecord {
+        Archetype* Arch = nullptr;   // nullptr = entity not alive
+        uint32_t Chunk = 0;
+        uint32_t Row = 0;
+        EntityID Handle = NULL_ENTITY;
+    };
+
+    struct ArchetypeQuery {
+        std::bitset<MAX_COMPONENTS> Mask;
+        std::vector<Archetype*> Archetypes;
+    };
+
+    bool CheckComponent(EntityID entity, ComponentID id, const char* operation) const;
+    void* GetComponentPointer(EntityID entity, ComponentID id);
+
+    /**
+     * @brief nullptr if not even one entity of mask fits in a chunk (the archetype is rejected)
+     */
+    Archetype* GetOrCreateArchetype(const std::bitset<MAX_COMPONENTS>& mask);
+    Archetype* GetAddTarget(Archetype& source, ComponentID id);   // nullptr: see GetOrCreateArchetype
+    Archetype* GetRemoveTarget(Archetype& source, ComponentID id);
+    const std::vector<Archetype*>& GetMatchingArchetypes(const std::bitset<MAX_COMPONENTS>& mask);
+
+    std::pair<uint32_t, uint32_t> AllocateRow(Archetype& archetype, EntityID entity);
+    void RemoveRow(Archetype& archetype, uint32_t chunkIndex, uint32_t row);
+    void MoveEntity(EntityID entity, Archetype* target);
+
+    std::unique_ptr<ArchetypeChunkData> AcquireChunk();
+    void ReleaseChunk(std::unique_ptr<ArchetypeChunkData> chunk);
+
+    static std::byte* GetCell(const Archetype& archetype, ArchetypeChunkData& chunk,
+                              size_t column, size_t size, uint32_t row) {
+        return chunk.Data + archetype.ColumnOffsets[column] + size * row;
+    }
+
+private:
+    std::array<ComponentTypeInfo, MAX_COMPONENTS> m_TypeInfos{};
+    std::bitset<MAX_COMPONENTS> m_Registered;
+
+    std::vector<std::unique_ptr<Archetype>> m_Archetypes;
+    std::unordered_map<std::bitset<MAX_COMPONENTS>, Archetype*> m_ArchetypeLookup;
+    Archetype* m_EmptyArchetype = nullptr;
+    std::vector<std::unique_ptr<ArchetypeQuery>> m_Queries;
+
+    std::vector<EntityRecord> m_Records;
+    uint32_t m_FreeHead = 0;
+    size_t m_LivingEntityCount = 0;
+
+    std::vector<std::unique_ptr<ArchetypeChunkData>> m_FreeChunks;
+};
+
+} // namespace MyEngine
@@ -0,0 +1,324 @@
+/******************************************************************************
+ * File: CommandBuffer.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Entity command buffer implementation
+ ******************************************************************************/
+
+#include "CommandBuffer.h"
+#include "Core/FrameAllocator.h"
+#include "Core/Log.h"
+#include "Core/Profiler.h"
+#include <algorithm>
+
+namespace MyEngine {
+
+namespace {
+
+/**
+ * @brief Last set looked up by this thread (set IDs are never reused)
+ */
+struct ThreadBufferCache {
+    uint64_t SetID = 0;
+    EntityCommandBuffer* Buffer = nullptr;
+};
+
+thread_local ThreadBufferCache t_BufferCache;
+thread_local uint64_t t_SortKey = 0;
+std::atomic<uint64_t> s_NextSetID{1};
+
+EntityID ResolveWith(const std::vector<EntityID>& resolved, EntityID entity) {
+    if (!IsPlaceholderEntity(entity)) {
+        return entity;
+    }
+    const uint32_t index = GetEntityIndex(entity);
+    return index < resolved.size() ? resolved[index] : NULL_ENTITY;
+}
+
+} // anonymous namespace
+
+uint64_t CommandSortKey::Get() {
+    return t_SortKey;
+}
+
+void CommandSortKey::Set(uint64_t key) {
+    t_SortKey = key;
+}
+
+// ============================================================================
+// EntityCommandBuffer
+// ============================================================================
+
+EntityCommandBuffer::~EntityCommandBuffer() {
+    Clear();
+}
+
+EntityID EntityCommandBuffer::CreateEntity() {
+    const uint32_t placeholder = m_Set ? m_Set->AllocatePlaceholder() : m_NextPlaceholder++;
+    const EntityID entity = MakeEntityID(placeholder, ENTITY_PLACEHOLDER_VERSION);
+    Record(CommandType::CreateEntity, entity, 0, 1);
+    return entity;
+}
+
+void EntityCommandBuffer::DestroyEntity(EntityID entity) {
+    Record(CommandType::DestroyEntity, entity, 0, 1);
+}
+
+EntityCommandBuffer::Command& EntityCommandBuffer::Record(CommandType type, EntityID entity,
+                                                          size_t payloadSize, size_t payloadAlignment) {
+    void* memory = AllocateBytes(sizeof(Command), alignof(Command));
+    Command* command = new (memory) Command();
+    command->Type = type;
+    command->Entity = entity;
+    command->SortKey = t_SortKey;
+    if (payloadSize > 0) {
+        command->Payload = AllocateBytes(payloadSize, payloadAlignment);
+    }
+
+    if (m_Tail) {
+        m_Tail->Next = command;
+    } else {
+        m_Head = command;
+    }
+    m_Tail = command;
+    m_CommandCount++;
+    return *command;
+}
+
+void* EntityCommandBuffer::AllocateBytes(size_t size, size_t alignment) {
+    if (m_Blocks) {
+        const size_t offset = (m_Blocks->Used + alignment - 1) & ~(alignment - 1);
+        if (offset + size <= m_Blocks->Size) {
+            m_Blocks->Used = offset + size;
+            return m_Blocks->Data + offset;
+        }
+    }
+
+    // New block: header at the front, data after it (oversized payloads get their own block)
+    const size_t headerSize = (sizeof(Block) + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+    const size_t blockSize = std::max(BLOCK_SIZE, headerSize + size + alignment);
+
+    bool heap = true;
+    void* memory = nullptr;
+    if (m_Set) {
+        memory = m_Set->AllocateBlock(blockSize, heap);
+    } else {
+        memory = ::operator new(blockSize, std::align_val_t(BLOCK_ALIGNMENT));
+    }
+
+    Block* block = new (memory) Block();
+    block->Data = static_cast<std::byte*>(memory) + headerSize;
+    block->Size = blockSize - headerSize;
+    block->Heap = heap;
+    block->Next = m_Blocks;
+    m_Blocks = block;
+
+    // Data is BLOCK_ALIGNMENT-aligned, so the first allocation needs no padding
+    block->Used = size;
+    return block->Data;
+}
+
+void EntityCommandBuffer::ReleaseBlocks() {
+    Block* block = m_Blocks;
+    while (block) {
+        Block* next = block->Next;
+        if (block->Heap) {
+            block->~Block();
+            ::operator delete(static_cast<void*>(block), std::align_val_t(BLOCK_ALIGNMENT));
+        }
+        // Arena blocks are reclaimed when the frame allocator rotates
+        block = next;
+    }
+    m_Blocks = nullptr;
+    m_Head = nullptr;
+    m_Tail = nullptr;
+    m_CommandCount = 0;
+}
+
+void EntityCommandBuffer::Clear() {
+    for (Command* command = m_Head; command; command = command->Next) {
+        if (command->Destroy) {
+            command->Destroy(command->Payload);
+        }
+    }
+    ReleaseBlocks();
+    m_NextPlaceholder = 0;
+}
+
+bool EntityCommandBuffer::Gather(std::vector<Command*>& commands) const {
+    bool sorted = true;
+    for (Command* command = m_Head; command; command = command->Next) {
+        sorted = sorted && (commands.empty() || commands.back()->SortKey <= command->SortKey);
+        commands.push_back(command);
+    }
+    return sorted;
+}
+
+void EntityCommandBuffer::SortByKey(std::vector<Command*>& commands) {
+    // Keys are copied next to the pointers so sorting does not chase every command
+    struct Entry {
+        uint64_t Key;
+        Command* Cmd;
+    };
+
+    std::vector<Entry> entries;
+    entries.reserve(commands.size());
+    for (Command* command : commands) {
+        entries.push_back({ command->SortKey, command });
+    }
+
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const Entry& a, const Entry& b) { return a.Key < b.Key; });
+    for (size_t i = 0; i < entries.size(); ++i) {
+        commands[i] = entries[i].Cmd;
+    }
+}
+
+void EntityCommandBuffer::Execute(Registry& registry, const std::vector<Command*>& commands,
+                                  std::vector<EntityID>& resolved) {
+    // Placeholders first: another thread's command may sort ahead of the CreateEntity it refers to
+    for (Command* command : commands) {
+        if (command->Type == CommandType::CreateEntity) {
+            const uint32_t index = GetEntityIndex(command->Entity);
+            if (index >= resolved.size()) {
+                resolved.resize(index + 1, NULL_ENTITY);
+            }
+            resolved[index] = registry.CreateEntity();
+        }
+    }
+
+    for (Command* command : commands) {
+        if (command->Type == CommandType::CreateEntity) {
+            continue;
+        }
+
+        const EntityID target = ResolveWith(resolved, command->Entity);
+        if (target == NULL_ENTITY && IsPlaceholderEntity(command->Entity)) {
+            ENGINE_WARN("EntityCommandBuffer: placeholder {} has no CreateEntity in this playback, command dropped",
+                        GetEntityIndex(command->Entity));
+        } else if (registry.IsValid(target)) {
+            if (command->Type == CommandType::DestroyEntity) {
+                registry.DestroyEntity(target);
+            } else {
+                command->Apply(registry, target, command->Payload);
+            }
+        }
+
+        // Moved-from (or skipped) payloads still need their destructor
+        if (command->Destroy) {
+            command->Destroy(command->Payload);
+            command->Destroy = nullptr;
+        }
+    }
+}
+
+void EntityCommandBuffer::Playback(Registry& registry) {
+    PROFILE_FUNCTION();
+    std::vector<Command*> commands;
+    commands.reserve(m_CommandCount);
+    if (!Gather(commands)) {
+        SortByKey(commands);
+    }
+
+    m_Resolved.clear();
+    Execute(registry, commands, m_Resolved);
+    ReleaseBlocks();
+    m_NextPlaceholder = 0;
+}
+
+EntityID EntityCommandBuffer::Resolve(EntityID entity) const {
+    return ResolveWith(m_Resolved, entity);
+}
+
+// ============================================================================
+// EntityCommandBufferSet
+// ============================================================================
+
+EntityCommandBufferSet::EntityCommandBufferSet(FrameAllocator* arena)
+    : m_Arena(arena), m_SetID(s_NextSetID.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+EntityCommandBufferSet::~EntityCommandBufferSet() {
+    Clear();
+}
+
+EntityCommandBuffer& EntityCommandBufferSet::GetThreadBuffer() {
+    if (t_BufferCache.SetID == m_SetID) {
+        return *t_BufferCache.Buffer;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    EntityCommandBuffer*& buffer = m_ThreadBuffers[std::this_thread::get_id()];
+    if (!buffer) {
+        m_Buffers.push_back(std::make_unique<EntityCommandBuffer>());
+        buffer = m_Buffers.back().get();
+        buffer->m_Set = this;
+    }
+    t_BufferCache = { m_SetID, buffer };
+    return *buffer;
+}
+
+void* EntityCommandBufferSet::AllocateBlock(size_t size, bool& heap) {
+    if (m_Arena) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (void* memory = m_Arena->TryAllocate(size, EntityCommandBuffer::BLOCK_ALIGNMENT)) {
+            heap = false;
+            return memory;
+        }
+    }
+    heap = true;
+    return ::operator new(size, std::align_val_t(EntityCommandBuffer::BLOCK_ALIGNMENT));
+}
+
+void EntityCommandBufferSet::Playback(Registry& registry) {
+    PROFILE_FUNCTION();
+    size_t total = 0;
+    for (const auto& buffer : m_Buffers) {
+        total += buffer->m_CommandCount;
+    }
+    if (total == 0) {
+        return;
+    }
+
+    std::vector<EntityCommandBuffer::Command*> commands;
+    commands.reserve(total);
+    bool sorted = true;
+    for (const auto& buffer : m_Buffers) {
+        sorted = buffer->Gather(commands) && sorted;
+    }
+    // Usually unsorted only when several threads recorded
+    if (!sorted) {
+        EntityCommandBuffer::SortByKey(commands);
+    }
+
+    m_Resolved.clear();
+    EntityCommandBuffer::Execute(registry, commands, m_Resolved);
+
+    for (const auto& buffer : m_Buffers) {
+        buffer->ReleaseBlocks();
+    }
+    m_NextPlaceholder.store(0, std::memory_order_relaxed);
+}
+
+void EntityCommandBufferSet::Clear() {
+    for (const auto& buffer : m_Buffers) {
+        buffer->Clear();
+    }
+    m_Resolved.clear();
+    m_NextPlaceholder.store(0, std::memory_order_relaxed);
+}
+
+bool EntityCommandBufferSet::Empty() const {
+    for (const auto& buffer : m_Buffers) {
+        if (!buffer->Empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+EntityID EntityCommandBufferSet::Resolve(EntityID entity) const {
+    return ResolveWith(m_Resolved, entity);
+}
+
+} // namespace MyEngine
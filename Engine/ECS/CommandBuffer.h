@@ -0,0 +1,227 @@
+/******************************************************************************
+ * File: CommandBuffer.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Deferred structural ECS changes recorded from worker threads
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Registry.h"
+
+namespace MyEngine {
+
+class FrameAllocator;
+class EntityCommandBufferSet;
+
+/**
+ * @brief Sort key stamped on commands recorded by the current thread
+ *
+ * 回放按 key 排序（同 key 内保持录制顺序），因此顺序与线程调度无关：
+ * SystemScheduler 在运行系统时设置高 32 位（系统注册序号），
+ * SystemScheduler::ParallelRange 为每个批次设置低 32 位（批次起点）。
+ */
+class CommandSortKey {
+public:
+    static uint64_t Get();
+    static void Set(uint64_t key);
+
+    /**
+     * @brief RAII override of the current thread's key
+     */
+    class Scope {
+    public:
+        explicit Scope(uint64_t key) : m_Previous(Get()) { Set(key); }
+        ~Scope() { Set(m_Previous); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        uint64_t m_Previous;
+    };
+};
+
+/**
+ * @brief 实体命令缓冲
+ *
+ * 记录 CreateEntity / DestroyEntity / AddComponent / RemoveComponent，
+ * 在同步点由 Playback 统一应用到 Registry：
+ * - CreateEntity 立即返回占位句柄（版本为 ENTITY_PLACEHOLDER_VERSION），
+ *   同一缓冲（或同一 EntityCommandBufferSet）后续命令可直接使用；回放时先为所有
+ *   CreateEntity 创建真实实体，再按顺序执行其余命令，因此引用不受排序影响
+ * - 命令与组件数据按块存放在帧分配器（或堆）中，录制阶段不访问 Registry
+ * - 回放时目标实体已失效（例如被更早的命令销毁）的命令会被静默跳过
+ * - 回放顺序由 CommandSortKey 决定
+ *
+ * 单个缓冲不是线程安全的；多线程录制请使用 EntityCommandBufferSet::GetThreadBuffer。
+ */
+class EntityCommandBuffer {
+public:
+    EntityCommandBuffer() = default;
+    ~EntityCommandBuffer();
+    EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+    EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+
+    /**
+     * @brief Record entity creation
+     * @return Placeholder handle, resolved by Playback
+     */
+    EntityID CreateEntity();
+
+    void DestroyEntity(EntityID entity);
+
+    template<typename T>
+    void AddComponent(EntityID entity, T component) {
+        static_assert(alignof(T) <= BLOCK_ALIGNMENT, "Component alignment exceeds command block alignment");
+        Command& command = Record(CommandType::AddComponent, entity, sizeof(T), alignof(T));
+        new (command.Payload) T(std::move(component));
+        command.Apply = [](Registry& registry, EntityID target, void* payload) {
+            registry.AddComponent<T>(target, std::move(*static_cast<T*>(payload)));
+        };
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            command.Destroy = [](void* payload) { static_cast<T*>(payload)->~T(); };
+        }
+    }
+
+    template<typename T>
+    void RemoveComponent(EntityID entity) {
+        Command& command = Record(CommandType::RemoveComponent, entity, 0, 1);
+        command.Apply = [](Registry& registry, EntityID target, void*) {
+            registry.RemoveComponent<T>(target);
+        };
+    }
+
+    /**
+     * @brief Apply all commands to registry, then clear the buffer
+     */
+    void Playback(Registry& registry);
+
+    /**
+     * @brief Discard recorded commands (component payloads are destroyed)
+     */
+    void Clear();
+
+    /**
+     * @brief Real entity for a placeholder after Playback (until the next Clear/Playback)
+     */
+    EntityID Resolve(EntityID entity) const;
+
+    bool Empty() const { return m_CommandCount == 0; }
+    uint32_t GetCommandCount() const { return m_CommandCount; }
+
+private:
+    friend class EntityCommandBufferSet;
+
+    static constexpr size_t BLOCK_SIZE = 16 * 1024;
+    static constexpr size_t BLOCK_ALIGNMENT = 64;
+
+    enum class CommandType : uint8_t {
+        CreateEntity,
+        DestroyEntity,
+        AddComponent,
+        RemoveComponent
+    };
+
+    struct Command {
+        Command* Next = nullptr;
+        void (*Apply)(Registry&, EntityID, void*) = nullptr;
+        void (*Destroy)(void*) = nullptr;
+        void* Payload = nullptr;
+        uint64_t SortKey = 0;
+        EntityID Entity = NULL_ENTITY;
+        CommandType Type = CommandType::CreateEntity;
+    };
+
+    struct Block {
+        Block* Next = nullptr;
+        std::byte* Data = nullptr;
+        size_t Size = 0;
+        size_t Used = 0;
+        bool Heap = false;
+    };
+
+    Command& Record(CommandType type, EntityID entity, size_t payloadSize, size_t payloadAlignment);
+    void* AllocateBytes(size_t size, size_t alignment);
+    void ReleaseBlocks();
+
+    bool Gather(std::vector<Command*>& commands) const;  // Appends; false if keys went backwards
+    static void SortByKey(std::vector<Command*>& commands);
+    static void Execute(Registry& registry, const std::vector<Command*>& commands,
+                        std::vector<EntityID>& resolved);
+
+private:
+    EntityCommandBufferSet* m_Set = nullptr;  // Arena + shared placeholder numbering
+    Block* m_Blocks = nullptr;
+    Command* m_Head = nullptr;
+    Command* m_Tail = nullptr;
+    uint32_t m_CommandCount = 0;
+    uint32_t m_NextPlaceholder = 0;
+    std::vector<EntityID> m_Resolved;
+};
+
+/**
+ * @brief Per-thread command buffers played back together at a sync point
+ *
+ * 每个线程首次调用 GetThreadBuffer 时获得自己的缓冲，录制无需加锁；
+ * 仅在申请新内存块时短暂加锁访问帧分配器。占位句柄在整个集合内编号，
+ * 因此一个线程创建的占位实体可以在另一个线程的命令中引用。
+ *
+ * 使用帧分配器时，必须在帧分配器轮转（NextFrame 两次）之前回放。
+ */
+class EntityCommandBufferSet {
+public:
+    explicit EntityCommandBufferSet(FrameAllocator* arena = nullptr);
+    ~EntityCommandBufferSet();
+    EntityCommandBufferSet(const EntityCommandBufferSet&) = delete;
+    EntityCommandBufferSet& operator=(const EntityCommandBufferSet&) = delete;
+
+    void SetFrameAllocator(FrameAllocator* arena) { m_Arena = arena; }
+
+    /**
+     * @brief Buffer owned by the calling thread
+     */
+    EntityCommandBuffer& GetThreadBuffer();
+
+    /**
+     * @brief Merge all buffers ordered by CommandSortKey (then record order) and apply them
+     *
+     * 必须在没有线程录制时调用（例如 SystemScheduler 的 Stage 之间）。
+     */
+    void Playback(Registry& registry);
+
+    void Clear();
+    bool Empty() const;
+
+    /**
+     * @brief Real entity for a placeholder after the last Playback
+     */
+    EntityID Resolve(EntityID entity) const;
+
+private:
+    friend class EntityCommandBuffer;
+
+    void* AllocateBlock(size_t size, bool& heap);
+    uint32_t AllocatePlaceholder() { return m_NextPlaceholder.fetch_add(1, std::memory_order_relaxed); }
+
+private:
+    FrameAllocator* m_Arena = nullptr;
+    std::mutex m_Mutex;
+    std::vector<std::unique_ptr<EntityCommandBuffer>> m_Buffers;
+    std::unordered_map<std::thread::id, EntityCommandBuffer*> m_ThreadBuffers;
+    std::atomic<uint32_t> m_NextPlaceholder{0};
+    std::vector<EntityID> m_Resolved;
+    uint64_t m_SetID = 0;  // Distinguishes sets in the thread-local lookup cache
+};
+
+} // namespace MyEngine
@@ -7,42 +7,105 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+#include <typeinfo>
+#include "Core/Log.h"
 
 namespace MyEngine {
 
+/**
+ * @brief Entity handle: [version:8][index:24]
+ *
+ * 索引定位存储槽位，版本在槽位回收时递增，用于识别过期句柄。
+ * 索引 0 保留，因此 0 永远不是有效实体（NULL_ENTITY）。
+ */
+using EntityID = uint32_t;
+
+constexpr uint32_t ENTITY_INDEX_BITS = 24;
+constexpr uint32_t ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1;
+constexpr uint32_t ENTITY_VERSION_MASK = 0xFFu;
+constexpr EntityID NULL_ENTITY = 0;
+
+constexpr uint32_t GetEntityIndex(EntityID entity) {
+    return entity & ENTITY_INDEX_MASK;
+}
+
+constexpr uint32_t GetEntityVersion(EntityID entity) {
+    return entity >> ENTITY_INDEX_BITS;
+}
+
+constexpr EntityID MakeEntityID(uint32_t index, uint32_t version) {
+    return (index & ENTITY_INDEX_MASK) | ((version & ENTITY_VERSION_MASK) << ENTITY_INDEX_BITS);
+}
+
+/**
+ * @brief Version reserved for command-buffer placeholders (see EntityCommandBuffer)
+ *
+ * 存活实体的版本在 [0, ENTITY_PLACEHOLDER_VERSION) 内循环，占位句柄永远不会与真实句柄相等。
+ */
+constexpr uint32_t ENTITY_PLACEHOLDER_VERSION = ENTITY_VERSION_MASK;
+
+constexpr uint32_t NextEntityVersion(uint32_t version) {
+    return (version + 1) % ENTITY_PLACEHOLDER_VERSION;
+}
+
+constexpr bool IsPlaceholderEntity(EntityID entity) {
+    return GetEntityVersion(entity) == ENTITY_PLACEHOLDER_VERSION;
+}
+
 /**
  * @brief Base type for component IDs
  */
 using ComponentID = uint32_t;
 
+/**
+ * @brief Maximum number of components supported
+ */
+const uint32_t MAX_COMPONENTS = 64;
+
 /**
  * @brief Internal counter for generating unique component IDs
  */
 namespace Internal {
-    inline ComponentID GetUniqueComponentID() {
-        static ComponentID lastID = 0;
-        return lastID++;
+    /**
+     * @brief Next free ID; running out is fatal
+     *
+     * 组件池数组、Signature 与原型掩码都按 MAX_COMPONENTS 定长，
+     * 在此处统一检查后，各调用点可以直接用 ID 下标访问。
+     */
+    inline ComponentID GetUniqueComponentID(const char* typeName) {
+        static std::atomic<ComponentID> lastID{ 0 };
+        const ComponentID id = lastID.fetch_add(1, std::memory_order_relaxed);
+        if (id >= MAX_COMPONENTS) {
+            if (Log::GetCoreLogger()) {
+                ENGINE_FATAL("Component type {} exceeds MAX_COMPONENTS ({})", typeName, MAX_COMPONENTS);
+            } else {
+                std::fprintf(stderr, "Component type %s exceeds MAX_COMPONENTS (%u)\n", typeName, MAX_COMPONENTS);
+            }
+            std::abort();
+        }
+        return id;
     }
 }
 
 /**
  * @brief Template to get a unique ID for each component type
+ *
+ * 每个类型只在首次调用时分配一次，之后是对函数内静态变量的直接读取；
+ * Registry 用它直接索引组件池数组，无需 typeid 名称哈希。
  */
 template<typename T>
 inline ComponentID GetComponentTypeID() {
-    static ComponentID typeID = Internal::GetUniqueComponentID();
-    return typeID;
+    if constexpr (std::is_const_v<T> || std::is_volatile_v<T>) {
+        return GetComponentTypeID<std::remove_cv_t<T>>();  // View<const T> shares T's ID
+    } else {
+        static ComponentID typeID = Internal::GetUniqueComponentID(typeid(T).name());
+        return typeID;
+    }
 }
 
-/**
- * @brief Maximum number of entities supported
- */
-const uint32_t MAX_ENTITIES = 10000;
-
-/**
- * @brief Maximum number of components supported
- */
-const uint32_t MAX_COMPONENTS = 64;
-
 } // namespace MyEngine
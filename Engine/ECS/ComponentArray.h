@@ -0,0 +1,505 @@
+/******************************************************************************
+ * File: ComponentArray.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Per-type component storage built on SparseSet
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+#include "SparseSet.h"
+#include "Core/Log.h"
+
+namespace MyEngine {
+
+/**
+ * @brief Change ticks of one component instance
+ *
+ * 值为写入时 Registry 的 ChangeTick；"tick > since" 即表示在 since 之后发生。
+ */
+struct ComponentTicks {
+    uint32_t Added = 0;
+    uint32_t Changed = 0;
+};
+
+/**
+ * @brief Removal record kept when removal tracking is enabled
+ */
+struct RemovedComponent {
+    EntityID Entity = NULL_ENTITY;
+    uint32_t Tick = 0;
+};
+
+/**
+ * @brief Internal interface for component storage
+ */
+class IComponentArray {
+public:
+    virtual ~IComponentArray() = default;
+    virtual void EntityDestroyed(EntityID entity) = 0;
+
+    /**
+     * @brief Remove the components of count destroyed entities in one sweep (absent ones are skipped)
+     */
+    virtual void EntitiesDestroyed(const EntityID* entities, size_t count) = 0;
+
+    // Type-erased copying used by Prefab
+    virtual std::unique_ptr<IComponentArray> CreateEmpty() const = 0;
+    virtual bool CopyComponent(EntityID from, IComponentArray& dst, EntityID to) const = 0;
+
+    /**
+     * @brief Append copies of every component into dst (same type) for copies instances
+     *
+     * 本池中的实体是 Prefab 的局部句柄（索引 1..localCount），
+     * 第 c 份拷贝中局部索引 i 的实体映射为 mapping[c * localCount + i - 1]。
+     */
+    virtual void InstantiateInto(IComponentArray& dst, const EntityID* mapping,
+                                 uint32_t localCount, uint32_t copies) const = 0;
+
+    // Bulk copies used by RegistrySnapshot
+    virtual bool IsCopyable() const = 0;
+    virtual std::unique_ptr<IComponentArray> Clone() const = 0;
+
+    /**
+     * @brief Replace contents with a copy of source (same type); ticks restart at the current tick
+     */
+    virtual void RestoreFrom(const IComponentArray& source) = 0;
+    virtual void Clear() = 0;
+    virtual size_t GetMemoryUsage() const = 0;
+
+    /**
+     * @brief Tick source (Registry's change tick); nullptr = ticks stay 0
+     */
+    void SetTickSource(const uint32_t* tick) { m_Tick = tick; }
+    uint32_t CurrentTick() const { return m_Tick ? *m_Tick : 0; }
+
+    void SetTrackRemovals(bool track) { m_TrackRemovals = track; }
+    bool IsTrackingRemovals() const { return m_TrackRemovals; }
+    const std::vector<RemovedComponent>& GetRemoved() const { return m_Removed; }
+
+    /**
+     * @brief Drop removal records with Tick <= tick (all consumers have seen them)
+     */
+    void TrimRemoved(uint32_t tick) {
+        auto it = std::find_if(m_Removed.begin(), m_Removed.end(),
+            [tick](const RemovedComponent& record) { return record.Tick > tick; });
+        m_Removed.erase(m_Removed.begin(), it);
+    }
+
+    /**
+     * @brief Log the dense indices whose occupant changes (insert, swap-and-pop removal)
+     *
+     * 供缓存 Dense 下标的使用方增量修补（TransformSystem）：记下 GetLayoutCursor()，
+     * 之后用 GetLayoutChanges 取得此后变化过的下标（可能重复，也可能已超出 Size()）。
+     * 日志超过 LAYOUT_LOG_LIMIT 条、Clear 或 RestoreFrom 之后旧游标失效，使用方需整体重建。
+     */
+    static constexpr size_t LAYOUT_LOG_LIMIT = 1 << 16;
+
+    void SetTrackLayout(bool track) {
+        if (track != m_TrackLayout) {
+            m_TrackLayout = track;
+            InvalidateLayoutLog();
+        }
+    }
+    bool IsTrackingLayout() const { return m_TrackLayout; }
+    uint64_t GetLayoutCursor() const { return m_LayoutLogEnd; }
+
+    /**
+     * @brief Indices changed after cursor as [first, last)
+     * @return false if the log no longer reaches back to cursor (rebuild from scratch)
+     */
+    bool GetLayoutChanges(uint64_t cursor, const uint32_t*& first, const uint32_t*& last) const {
+        if (!m_TrackLayout || cursor < m_LayoutLogBase || cursor > m_LayoutLogEnd) {
+            return false;
+        }
+        first = m_LayoutLog.data() + (cursor - m_LayoutLogBase);
+        last = m_LayoutLog.data() + m_LayoutLog.size();
+        return true;
+    }
+
+protected:
+    void RecordRemoval(EntityID entity) {
+        if (m_TrackRemovals) {
+            m_Removed.push_back({ entity, CurrentTick() });
+        }
+    }
+
+    void RecordLayoutChange(uint32_t index) {
+        if (!m_TrackLayout) {
+            return;
+        }
+        if (m_LayoutLog.size() >= LAYOUT_LOG_LIMIT) {
+            InvalidateLayoutLog();
+        }
+        m_LayoutLog.push_back(index);
+        m_LayoutLogEnd++;
+    }
+
+    /**
+     * @brief Drop the log; every cursor handed out so far becomes stale
+     */
+    void InvalidateLayoutLog() {
+        m_LayoutLog.clear();
+        m_LayoutLogBase = ++m_LayoutLogEnd;
+    }
+
+private:
+    const uint32_t* m_Tick = nullptr;
+    bool m_TrackRemovals = false;
+    std::vector<RemovedComponent> m_Removed;  // Appended in tick order
+    bool m_TrackLayout = false;
+    std::vector<uint32_t> m_LayoutLog;        // Cursor positions [m_LayoutLogBase, m_LayoutLogEnd)
+    uint64_t m_LayoutLogBase = 0;
+    uint64_t m_LayoutLogEnd = 0;
+};
+
+/**
+ * @brief Packed storage for components of a specific type
+ *
+ * 基于 SparseSet：组件与 Dense 实体数组一一对应，按页存放。
+ * - 访问：两次数组下标，无哈希
+ * - 内存：只为存活组件分配（按页增长）
+ * - 插入不会移动已有组件，引用在插入后保持有效；删除会把最后一个元素移入空位
+ * - 每个组件附带 ComponentTicks（与 Dense 同序），插入时记录 Added，
+ *   可变访问（GetData / MarkChanged）时记录 Changed
+ */
+template<typename T>
+class ComponentArray : public IComponentArray {
+public:
+    static constexpr uint32_t PAGE_SIZE = 1024;
+
+    ComponentArray() = default;
+    ComponentArray(const ComponentArray&) = delete;
+    ComponentArray& operator=(const ComponentArray&) = delete;
+
+    ~ComponentArray() override {
+        for (size_t i = 0; i < m_Set.Size(); ++i) {
+            At(static_cast<uint32_t>(i)).~T();
+        }
+        for (T* page : m_Pages) {
+            std::allocator<T>().deallocate(page, PAGE_SIZE);
+        }
+    }
+
+    void InsertData(EntityID entity, T component) {
+        if (m_Set.Contains(entity)) {
+            ENGINE_ERROR("Component added to same entity more than once.");
+            return;
+        }
+
+        const uint32_t index = static_cast<uint32_t>(m_Set.Size());
+        if (index / PAGE_SIZE >= m_Pages.size()) {
+            m_Pages.push_back(std::allocator<T>().allocate(PAGE_SIZE));
+        }
+        new (&At(index)) T(std::move(component));
+        m_Set.Insert(entity);
+        const uint32_t tick = CurrentTick();
+        m_Ticks.push_back({ tick, tick });
+        RecordLayoutChange(index);
+    }
+
+    /**
+     * @brief Pre-allocate pages and dense storage for count components in total
+     */
+    void Reserve(size_t count) {
+        while (m_Pages.size() * PAGE_SIZE < count) {
+            m_Pages.push_back(std::allocator<T>().allocate(PAGE_SIZE));
+        }
+        m_Set.Reserve(count);
+        m_Ticks.reserve(count);
+    }
+
+    /**
+     * @brief Bulk insert: copy value to each entity (entities must not have T yet)
+     */
+    void InsertCopies(const EntityID* entities, size_t count, const T& value) {
+        Reserve(Size() + count);
+        const ComponentTicks ticks{ CurrentTick(), CurrentTick() };
+        for (size_t i = 0; i < count; ++i) {
+            AppendUnchecked(entities[i], value, ticks);
+        }
+    }
+
+    /**
+     * @brief Bulk append of trivially copyable components, copied page by page
+     *
+     * entities 不能已拥有 T；data 可以直接指向映射的文件内存。
+     */
+    void AppendRaw(const EntityID* entities, const T* data, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "AppendRaw requires a trivially copyable component");
+        const size_t start = Size();
+        Reserve(start + count);
+        for (size_t copied = 0; copied < count;) {
+            const size_t index = start + copied;
+            const size_t n = std::min<size_t>(PAGE_SIZE - index % PAGE_SIZE, count - copied);
+            std::memcpy(static_cast<void*>(&m_Pages[index / PAGE_SIZE][index % PAGE_SIZE]), data + copied, n * sizeof(T));
+            copied += n;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            m_Set.Insert(entities[i]);
+            RecordLayoutChange(static_cast<uint32_t>(start + i));
+        }
+        const uint32_t tick = CurrentTick();
+        m_Ticks.resize(start + count, ComponentTicks{ tick, tick });
+    }
+
+    void RemoveData(EntityID entity) {
+        if (!m_Set.Contains(entity)) {
+            ENGINE_ERROR("Removing non-existent component.");
+            return;
+        }
+
+        const uint32_t last = static_cast<uint32_t>(m_Set.Size() - 1);
+        const uint32_t index = m_Set.Remove(entity);
+        if (index != last) {
+            At(index) = std::move(At(last));
+            m_Ticks[index] = m_Ticks[last];
+            RecordLayoutChange(index);
+        }
+        At(last).~T();
+        m_Ticks.pop_back();
+        RecordLayoutChange(last);
+        m_LayoutVersion++;
+        RecordRemoval(entity);
+    }
+
+    /**
+     * @brief Mutable access: marks the component changed at the current tick
+     */
+    T& GetData(EntityID entity) {
+        const uint32_t index = m_Set.IndexOf(entity);
+        if (index == SparseSet::NULL_INDEX) {
+            ENGINE_ERROR("Retrieving non-existent component.");
+            static T dummy;
+            return dummy;
+        }
+        MarkChangedAt(index);
+        return At(index);
+    }
+
+    /**
+     * @brief Read-only access: ticks are left untouched
+     */
+    const T& ReadData(EntityID entity) {
+        const uint32_t index = m_Set.IndexOf(entity);
+        if (index == SparseSet::NULL_INDEX) {
+            ENGINE_ERROR("Retrieving non-existent component.");
+            static T dummy;
+            return dummy;
+        }
+        return At(index);
+    }
+
+    void MarkChanged(EntityID entity) {
+        const uint32_t index = m_Set.IndexOf(entity);
+        if (index != SparseSet::NULL_INDEX) {
+            MarkChangedAt(index);
+        }
+    }
+
+    void MarkChangedAt(uint32_t index) { m_Ticks[index].Changed = CurrentTick(); }
+    const ComponentTicks& GetTicksAt(uint32_t index) const { return m_Ticks[index]; }
+    uint32_t IndexOf(EntityID entity) const { return m_Set.IndexOf(entity); }
+
+    /**
+     * @brief Component pointer or nullptr (single sparse lookup, no logging, ticks untouched)
+     */
+    T* TryGet(EntityID entity) {
+        const uint32_t index = m_Set.IndexOf(entity);
+        return index == SparseSet::NULL_INDEX ? nullptr : &At(index);
+    }
+
+    bool HasData(EntityID entity) const {
+        return m_Set.Contains(entity);
+    }
+
+    void EntityDestroyed(EntityID entity) override {
+        if (m_Set.Contains(entity)) {
+            RemoveData(entity);
+        }
+    }
+
+    void EntitiesDestroyed(const EntityID* entities, size_t count) override {
+        std::vector<uint32_t> indices;
+        indices.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t index = m_Set.IndexOf(entities[i]);
+            if (index != SparseSet::NULL_INDEX) {
+                indices.push_back(index);
+                RecordRemoval(entities[i]);
+            }
+        }
+        if (indices.empty()) {
+            return;
+        }
+
+        // Highest dense index first: the element swapped into a hole is always a survivor
+        // (every doomed index above it is already gone), so no lookups are repeated
+        std::sort(indices.begin(), indices.end(), std::greater<uint32_t>());
+        for (uint32_t index : indices) {
+            const uint32_t last = static_cast<uint32_t>(m_Set.Size() - 1);
+            m_Set.RemoveAt(index);
+            if (index != last) {
+                At(index) = std::move(At(last));
+                m_Ticks[index] = m_Ticks[last];
+                RecordLayoutChange(index);
+            }
+            At(last).~T();
+            m_Ticks.pop_back();
+            RecordLayoutChange(last);
+        }
+        m_LayoutVersion++;
+    }
+
+    std::unique_ptr<IComponentArray> CreateEmpty() const override {
+        return std::make_unique<ComponentArray<T>>();
+    }
+
+    bool CopyComponent(EntityID from, IComponentArray& dst, EntityID to) const override {
+        if constexpr (std::is_copy_constructible_v<T>) {
+            const uint32_t index = m_Set.IndexOf(from);
+            if (index == SparseSet::NULL_INDEX) {
+                return false;
+            }
+            static_cast<ComponentArray<T>&>(dst).InsertData(to, At(index));
+            return true;
+        } else {
+            ENGINE_WARN("Component type {} is not copyable; skipped", typeid(T).name());
+            return false;
+        }
+    }
+
+    void InstantiateInto(IComponentArray& dst, const EntityID* mapping,
+                         uint32_t localCount, uint32_t copies) const override {
+        if constexpr (std::is_copy_constructible_v<T>) {
+            auto& target = static_cast<ComponentArray<T>&>(dst);
+            target.Reserve(target.Size() + Size() * copies);
+            const ComponentTicks ticks{ target.CurrentTick(), target.CurrentTick() };
+            for (uint32_t copy = 0; copy < copies; ++copy) {
+                const EntityID* base = mapping + static_cast<size_t>(copy) * localCount;
+                for (uint32_t i = 0; i < Size(); ++i) {
+                    target.AppendUnchecked(base[GetEntityIndex(GetEntity(i)) - 1], At(i), ticks);
+                }
+            }
+        } else {
+            ENGINE_WARN("Component type {} is not copyable; skipped", typeid(T).name());
+        }
+    }
+
+    bool IsCopyable() const override {
+        return std::is_copy_constructible_v<T>;
+    }
+
+    std::unique_ptr<IComponentArray> Clone() const override {
+        auto copy = std::make_unique<ComponentArray<T>>();
+        copy->RestoreFrom(*this);
+        return copy;
+    }
+
+    void RestoreFrom(const IComponentArray& source) override {
+        const auto& from = static_cast<const ComponentArray<T>&>(source);
+        if (IsTrackingRemovals()) {
+            for (EntityID entity : m_Set.GetEntities()) {
+                if (!from.m_Set.Contains(entity)) {
+                    RecordRemoval(entity);
+                }
+            }
+        }
+        DestroyElements();
+
+        if constexpr (std::is_copy_constructible_v<T>) {
+            const size_t count = from.Size();
+            Reserve(count);
+            // Trivially copyable components go page by page with memcpy
+            for (size_t first = 0; first < count; first += PAGE_SIZE) {
+                const size_t page = first / PAGE_SIZE;
+                const size_t n = std::min<size_t>(PAGE_SIZE, count - first);
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    std::memcpy(static_cast<void*>(m_Pages[page]), from.m_Pages[page], n * sizeof(T));
+                } else {
+                    for (size_t i = 0; i < n; ++i) {
+                        new (&m_Pages[page][i]) T(from.m_Pages[page][i]);
+                    }
+                }
+            }
+            m_Set.CopyFrom(from.m_Set);
+            const uint32_t tick = CurrentTick();
+            m_Ticks.assign(count, ComponentTicks{ tick, tick });
+        } else {
+            ENGINE_WARN("Component type {} is not copyable; restored empty", typeid(T).name());
+        }
+    }
+
+    void Clear() override {
+        if (IsTrackingRemovals()) {
+            for (EntityID entity : m_Set.GetEntities()) {
+                RecordRemoval(entity);
+            }
+        }
+        DestroyElements();
+    }
+
+    // Dense access (for iteration)
+    size_t Size() const { return m_Set.Size(); }
+    T& At(uint32_t index) { return m_Pages[index / PAGE_SIZE][index % PAGE_SIZE]; }
+    const T& At(uint32_t index) const { return m_Pages[index / PAGE_SIZE][index % PAGE_SIZE]; }
+    EntityID GetEntity(uint32_t index) const { return m_Set.GetEntity(index); }
+    const std::vector<EntityID>& GetEntities() const { return m_Set.GetEntities(); }
+
+    /**
+     * @brief Bumped whenever existing components move or die (removal, clear, restore)
+     * Cached dense indices stay valid while this and Size() are unchanged
+     */
+    uint32_t GetLayoutVersion() const { return m_LayoutVersion; }
+
+    /**
+     * @brief Approximate heap usage in bytes
+     */
+    size_t GetMemoryUsage() const override {
+        return m_Set.GetMemoryUsage() + m_Pages.size() * PAGE_SIZE * sizeof(T)
+             + m_Pages.capacity() * sizeof(T*) + m_Ticks.capacity() * sizeof(ComponentTicks);
+    }
+
+private:
+    /**
+     * @brief Destroy every component and empty the set; pages are kept for reuse
+     */
+    void DestroyElements() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < m_Set.Size(); ++i) {
+                At(static_cast<uint32_t>(i)).~T();
+            }
+        }
+        m_Set.Clear();
+        m_Ticks.clear();
+        m_LayoutVersion++;
+        InvalidateLayoutLog();
+    }
+
+    /**
+     * @brief Append without the duplicate check (storage already reserved)
+     */
+    void AppendUnchecked(EntityID entity, const T& value, const ComponentTicks& ticks) {
+        const uint32_t index = static_cast<uint32_t>(m_Set.Size());
+        new (&At(index)) T(value);
+        m_Set.Insert(entity);
+        m_Ticks.push_back(ticks);
+        RecordLayoutChange(index);
+    }
+
+private:
+    SparseSet m_Set;
+    std::vector<T*> m_Pages;
+    std::vector<ComponentTicks> m_Ticks;  // Parallel to the dense array
+    uint32_t m_LayoutVersion = 0;
+};
+
+} // namespace MyEngine
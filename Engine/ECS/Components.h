@@ -40,7 +40,9 @@ struct TagComponent {
 struct HierarchyComponent {
     EntityID parent = 0;           // Parent entity (0 = root)
     EntityID firstChild = 0;       // First child in linked list
+    EntityID lastChild = 0;        // Last child (O(1) append)
     EntityID nextSibling = 0;      // Next sibling in linked list
+    EntityID prevSibling = 0;      // Previous sibling (O(1) unlink)
     uint32_t depth = 0;            // Depth in hierarchy (for sorting)
     
     HierarchyComponent() = default;
@@ -61,9 +63,9 @@ struct TransformComponent {
     Quat localRotation = Quat::Identity();
     Vec3 localScale = Vec3(1, 1, 1);
     
-    // Cached matrices
-    Mat4 localMatrix;              // Local transformation matrix
-    Mat4 worldMatrix;              // World transformation matrix
+    // Cached matrices (3x4 affine; renderers read worldMatrix instead of rebuilding TRS)
+    Mat3x4 localMatrix;            // Local transformation matrix
+    Mat3x4 worldMatrix;            // World transformation matrix (written by TransformSystem)
     
     // Version tracking for lazy updates
     uint32_t localVersion = 0;     // Incremented when local transform changes
@@ -82,11 +84,15 @@ struct TransformComponent {
     
     // Update local matrix from position/rotation/scale
     void UpdateLocalMatrix() {
-        localMatrix = Mat4::Translation(localPosition) * Mat4::Scale(localScale);
-        // TODO: Add rotation when Mat4::FromQuaternion is implemented
+        localMatrix = Mat3x4::FromTRS(localPosition, localRotation, localScale);
         MarkDirty();
     }
     
+    // World matrix in the 4x4 layout shaders expect
+    Mat4 GetWorldMatrix() const {
+        return worldMatrix.ToMat4();
+    }
+    
     // Check if world matrix needs update
     bool NeedsUpdate(uint32_t parentWorldVersion) const {
         return (parentVersion != parentWorldVersion) || (worldVersion != localVersion);
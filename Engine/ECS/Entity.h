@@ -42,15 +42,20 @@ public:
         return signature.test(type);
     }
     
+    /**
+     * @brief True if the handle still refers to a live entity (false once destroyed)
+     */
+    bool IsValid() const { return m_Registry != nullptr && m_Registry->IsValid(m_EntityHandle); }
+    
     operator EntityID() const { return m_EntityHandle; }
-    operator bool() const { return m_EntityHandle != 0 && m_Registry != nullptr; }
+    operator bool() const { return m_EntityHandle != NULL_ENTITY && m_Registry != nullptr; }
     
     bool operator==(const Entity& other) const {
         return m_EntityHandle == other.m_EntityHandle && m_Registry == other.m_Registry;
     }
     
 private:
-    EntityID m_EntityHandle = 0;
+    EntityID m_EntityHandle = NULL_ENTITY;
     Registry* m_Registry = nullptr;
 };
 
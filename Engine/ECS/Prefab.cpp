@@ -0,0 +1,210 @@
+/******************************************************************************
+ * File: Prefab.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Prefab capture and bulk instantiation
+ ******************************************************************************/
+
+#include "Prefab.h"
+#include "Components.h"
+#include "Core/Profiler.h"
+#include <unordered_map>
+
+namespace MyEngine {
+
+Prefab Prefab::FromEntity(Registry& registry, EntityID root) {
+    PROFILE_FUNCTION();
+    Prefab prefab;
+    if (!registry.IsValid(root)) {
+        ENGINE_ERROR("Prefab::FromEntity called with invalid entity {}.", root);
+        return prefab;
+    }
+
+    const ComponentID hierarchyType = GetComponentTypeID<HierarchyComponent>();
+    auto* hierarchy = registry.GetComponentArray<HierarchyComponent>();
+
+    // Breadth-first over the subtree; local handle of entities[k] is k + 1
+    std::vector<EntityID> entities{ root };
+    std::vector<uint32_t> depths{ 0 };
+    std::unordered_map<EntityID, uint32_t> locals{ { root, 1 } };
+    for (size_t k = 0; k < entities.size(); ++k) {
+        const EntityID entity = entities[k];
+        if (!registry.m_Signatures[GetEntityIndex(entity)].test(hierarchyType)) {
+            continue;
+        }
+        EntityID child = hierarchy->ReadData(entity).firstChild;
+        // The locals check also stops on corrupted (cyclic) links
+        while (registry.IsValid(child) && locals.find(child) == locals.end()) {
+            locals.emplace(child, static_cast<uint32_t>(entities.size() + 1));
+            entities.push_back(child);
+            depths.push_back(depths[k] + 1);
+            if (!registry.m_Signatures[GetEntityIndex(child)].test(hierarchyType)) {
+                break;
+            }
+            child = hierarchy->ReadData(child).nextSibling;
+        }
+    }
+
+    prefab.m_Signatures.resize(entities.size());
+    for (size_t k = 0; k < entities.size(); ++k) {
+        const EntityID local = MakeEntityID(static_cast<uint32_t>(k + 1), 0);
+        const Signature& signature = registry.m_Signatures[GetEntityIndex(entities[k])];
+        for (ComponentID type = 0; type < MAX_COMPONENTS; ++type) {
+            if (!signature.test(type) || !registry.m_ComponentArrays[type]) {
+                continue;
+            }
+            auto& pool = prefab.m_Pools[type];
+            if (!pool) {
+                pool = registry.m_ComponentArrays[type]->CreateEmpty();
+            }
+            if (registry.m_ComponentArrays[type]->CopyComponent(entities[k], *pool, local)) {
+                prefab.m_Signatures[k].set(type);
+            }
+        }
+    }
+
+    // Rewrite links as local handles; anything outside the subtree becomes 0
+    if (prefab.m_Pools[hierarchyType]) {
+        auto& pool = static_cast<ComponentArray<HierarchyComponent>&>(*prefab.m_Pools[hierarchyType]);
+        auto toLocal = [&locals](EntityID entity) -> EntityID {
+            auto it = locals.find(entity);
+            return it != locals.end() ? MakeEntityID(it->second, 0) : NULL_ENTITY;
+        };
+
+        for (uint32_t k = 0; k < entities.size(); ++k) {
+            if (!prefab.m_Signatures[k].test(hierarchyType)) {
+                continue;
+            }
+            HierarchyComponent& node = pool.GetData(MakeEntityID(k + 1, 0));
+            node.parent = k == 0 ? NULL_ENTITY : toLocal(node.parent);
+            node.firstChild = toLocal(node.firstChild);
+            node.lastChild = toLocal(node.lastChild);
+            node.nextSibling = k == 0 ? NULL_ENTITY : toLocal(node.nextSibling);
+            node.prevSibling = k == 0 ? NULL_ENTITY : toLocal(node.prevSibling);
+            node.depth = depths[k];
+            prefab.m_HierarchyLocals.push_back(k);
+        }
+    }
+
+    return prefab;
+}
+
+EntityID Prefab::Instantiate(Registry& registry, EntityID parent) const {
+    std::vector<EntityID> roots = InstantiateMany(registry, 1, parent);
+    return roots.empty() ? NULL_ENTITY : roots.front();
+}
+
+std::vector<EntityID> Prefab::InstantiateMany(Registry& registry, uint32_t count, EntityID parent) const {
+    PROFILE_FUNCTION();
+    std::vector<EntityID> roots;
+    if (Empty() || count == 0) {
+        return roots;
+    }
+
+    if (parent != NULL_ENTITY && !registry.IsValid(parent)) {
+        ENGINE_WARN("Prefab::Instantiate: invalid parent {}, spawning at root", parent);
+        parent = NULL_ENTITY;
+    }
+
+    // Copy c of local entity i is mapping[c * localCount + i]
+    const uint32_t localCount = GetEntityCount();
+    std::vector<EntityID> mapping(static_cast<size_t>(count) * localCount);
+    if (!registry.AllocateEntities(mapping.data(), mapping.size())) {
+        return roots;
+    }
+
+    for (size_t n = 0; n < mapping.size(); ++n) {
+        registry.m_Signatures[GetEntityIndex(mapping[n])] = m_Signatures[n % localCount];
+    }
+    for (ComponentID type = 0; type < MAX_COMPONENTS; ++type) {
+        if (m_Pools[type]) {
+            IComponentArray* target = registry.AssureComponentArray(type, *m_Pools[type]);
+            m_Pools[type]->InstantiateInto(*target, mapping.data(), localCount, count);
+        }
+    }
+    registry.AddNewEntitiesToQueries(mapping.data(), mapping.size());
+
+    roots.reserve(count);
+    for (uint32_t copy = 0; copy < count; ++copy) {
+        roots.push_back(mapping[static_cast<size_t>(copy) * localCount]);
+    }
+
+    // Local handles -> new entities. The copies were appended in prefab pool order,
+    // so they are the last count * m_HierarchyLocals.size() dense slots
+    auto* hierarchy = registry.GetWritableComponentArray<HierarchyComponent>();
+    if (hierarchy && !m_HierarchyLocals.empty()) {
+        const size_t perCopy = m_HierarchyLocals.size();
+        uint32_t dense = static_cast<uint32_t>(hierarchy->Size() - perCopy * count);
+        for (uint32_t copy = 0; copy < count; ++copy) {
+            const EntityID* base = mapping.data() + static_cast<size_t>(copy) * localCount;
+            auto toGlobal = [base](EntityID local) {
+                return local != NULL_ENTITY ? base[GetEntityIndex(local) - 1] : NULL_ENTITY;
+            };
+            for (size_t j = 0; j < perCopy; ++j, ++dense) {
+                HierarchyComponent& node = hierarchy->At(dense);
+                node.parent = toGlobal(node.parent);
+                node.firstChild = toGlobal(node.firstChild);
+                node.lastChild = toGlobal(node.lastChild);
+                node.nextSibling = toGlobal(node.nextSibling);
+                node.prevSibling = toGlobal(node.prevSibling);
+            }
+        }
+    }
+
+    if (parent == NULL_ENTITY) {
+        return roots;
+    }
+
+    registry.RegisterComponent<HierarchyComponent>();
+    hierarchy = registry.GetWritableComponentArray<HierarchyComponent>();
+    if (!registry.m_Signatures[GetEntityIndex(parent)].test(GetComponentTypeID<HierarchyComponent>())) {
+        registry.AddComponent<HierarchyComponent>(parent, HierarchyComponent());
+    }
+    if (!m_Signatures[0].test(GetComponentTypeID<HierarchyComponent>())) {
+        for (EntityID root : roots) {
+            registry.AddComponent<HierarchyComponent>(root, HierarchyComponent());
+        }
+    }
+
+    // Shift subtree depths below the parent
+    const uint32_t depthOffset = hierarchy->ReadData(parent).depth + 1;
+    for (uint32_t copy = 0; copy < count; ++copy) {
+        const EntityID* base = mapping.data() + static_cast<size_t>(copy) * localCount;
+        for (uint32_t local : m_HierarchyLocals) {
+            hierarchy->GetData(base[local]).depth += depthOffset;
+        }
+    }
+
+    // Append the new roots to the parent's children, chained in spawn order
+    HierarchyComponent& parentNode = hierarchy->GetData(parent);
+    EntityID last = registry.IsValid(parentNode.lastChild) ? parentNode.lastChild : NULL_ENTITY;
+    if (last == NULL_ENTITY && registry.IsValid(parentNode.firstChild)) {
+        // Links written without lastChild
+        last = parentNode.firstChild;
+        for (;;) {
+            const EntityID next = hierarchy->ReadData(last).nextSibling;
+            if (!registry.IsValid(next)) {
+                break;
+            }
+            last = next;
+        }
+    }
+    if (last == NULL_ENTITY) {
+        parentNode.firstChild = roots.front();
+    } else {
+        hierarchy->GetData(last).nextSibling = roots.front();
+    }
+    parentNode.lastChild = roots.back();
+
+    for (uint32_t copy = 0; copy < count; ++copy) {
+        HierarchyComponent& node = hierarchy->GetData(roots[copy]);
+        node.parent = parent;
+        node.depth = depthOffset;
+        node.prevSibling = copy > 0 ? roots[copy - 1] : last;
+        node.nextSibling = copy + 1 < count ? roots[copy + 1] : NULL_ENTITY;
+    }
+
+    return roots;
+}
+
+} // namespace MyEngine
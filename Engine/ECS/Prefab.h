@@ -0,0 +1,61 @@
+/******************************************************************************
+ * File: Prefab.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Entity subtree template instantiated by bulk component copies
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+#include "Registry.h"
+
+namespace MyEngine {
+
+/**
+ * @brief 预制体：实体子树的组件快照
+ *
+ * FromEntity 沿 HierarchyComponent 收集根实体及其全部后代，把组件复制进预制体自己的
+ * 紧凑组件池（实体使用局部句柄 1..N）。Instantiate 一次分配全部实体，
+ * 每个组件池整体追加到 Registry，然后只修正 HierarchyComponent 的
+ * parent / firstChild / nextSibling / depth 链接，最后整体更新查询缓存。
+ *
+ * 注意：其他组件中保存的 EntityID 不会被重映射；不可拷贝的组件类型会被跳过。
+ */
+class Prefab {
+public:
+    Prefab() = default;
+    Prefab(Prefab&&) = default;
+    Prefab& operator=(Prefab&&) = default;
+    Prefab(const Prefab&) = delete;
+    Prefab& operator=(const Prefab&) = delete;
+
+    /**
+     * @brief Capture root and all of its descendants
+     */
+    static Prefab FromEntity(Registry& registry, EntityID root);
+
+    /**
+     * @brief Spawn one copy; with a valid parent the copy is appended to its children
+     * @return Root of the new subtree
+     */
+    EntityID Instantiate(Registry& registry, EntityID parent = NULL_ENTITY) const;
+
+    /**
+     * @brief Spawn count copies at once
+     * @return Roots of the new subtrees, in spawn (and sibling) order
+     */
+    std::vector<EntityID> InstantiateMany(Registry& registry, uint32_t count, EntityID parent = NULL_ENTITY) const;
+
+    uint32_t GetEntityCount() const { return static_cast<uint32_t>(m_Signatures.size()); }
+    bool Empty() const { return m_Signatures.empty(); }
+
+private:
+    std::array<std::unique_ptr<IComponentArray>, MAX_COMPONENTS> m_Pools;
+    std::vector<Signature> m_Signatures;       // Local entity i + 1
+    std::vector<uint32_t> m_HierarchyLocals;   // Local indices carrying a HierarchyComponent
+};
+
+} // namespace MyEngine
@@ -6,45 +6,270 @@
  ******************************************************************************/
 
 #include "Registry.h"
+#include "RegistrySnapshot.h"
 
 namespace MyEngine {
 
 Registry::Registry() {
-    for (EntityID entity = 0; entity < MAX_ENTITIES; ++entity) {
-        m_AvailableEntities.push(entity);
+    // Index 0 is reserved so that NULL_ENTITY (0) is never a live handle
+    m_Entities.push_back(NULL_ENTITY);
+    m_Signatures.emplace_back();
+}
+
+Registry::~Registry() {
+    if (m_SharedSnapshot) {
+        m_SharedSnapshot->Release();
     }
 }
 
+void Registry::Reserve(size_t entityCount) {
+    m_Entities.reserve(entityCount + 1);
+    m_Signatures.reserve(entityCount + 1);
+}
+
 EntityID Registry::CreateEntity() {
-    if (m_LivingEntityCount >= MAX_ENTITIES) {
-        ENGINE_ERROR("Too many entities in existence.");
-        return 0;
+    EntityID entity;
+    if (m_FreeHead != 0) {
+        // Pop the intrusive free list; the slot already carries the bumped version
+        const uint32_t index = m_FreeHead;
+        const EntityID slot = m_Entities[index];
+        m_FreeHead = GetEntityIndex(slot);
+        entity = MakeEntityID(index, GetEntityVersion(slot));
+        m_Entities[index] = entity;
+    } else {
+        const size_t index = m_Entities.size();
+        if (index > ENTITY_INDEX_MASK) {
+            ENGINE_ERROR("Too many entities in existence.");
+            return NULL_ENTITY;
+        }
+        entity = MakeEntityID(static_cast<uint32_t>(index), 0);
+        m_Entities.push_back(entity);
+        m_Signatures.emplace_back();
     }
 
-    EntityID id = m_AvailableEntities.front();
-    m_AvailableEntities.pop();
     m_LivingEntityCount++;
-    m_ActiveEntities.set(id);
-
-    return id;
+    UpdateQueries(entity);
+    return entity;
 }
 
 void Registry::DestroyEntity(EntityID entity) {
-    if (entity >= MAX_ENTITIES) {
-        ENGINE_ERROR("Entity out of range.");
+    if (!IsValid(entity)) {
+        ENGINE_ERROR("Destroying invalid entity {}.", entity);
         return;
     }
 
-    m_Signatures[entity].reset();
-    m_ActiveEntities.reset(entity);
-
-    for (auto const& pair : m_ComponentArrays) {
-        auto const& componentArray = pair.second;
-        componentArray->EntityDestroyed(entity);
+    const uint32_t index = GetEntityIndex(entity);
+    // Only visit the pools this entity actually has a component in
+    const Signature& signature = m_Signatures[index];
+    if (signature.any()) {
+        for (ComponentID type = 0; type < MAX_COMPONENTS; ++type) {
+            if (signature.test(type) && m_ComponentArrays[type]) {
+                AssureWritable(type);
+                m_ComponentArrays[type]->EntityDestroyed(entity);
+            }
+        }
     }
 
-    m_AvailableEntities.push(entity);
+    // Push onto the free list with the next version; the old handle is now stale
+    m_Entities[index] = MakeEntityID(m_FreeHead, NextEntityVersion(GetEntityVersion(entity)));
+    m_FreeHead = index;
+    m_Signatures[index].reset();
+    UpdateQueries(entity);
+
     m_LivingEntityCount--;
 }
 
+bool Registry::AllocateEntities(EntityID* out, size_t count) {
+    const size_t freeSlots = (m_Entities.size() - 1) - m_LivingEntityCount;
+    const size_t newSlots = count > freeSlots ? count - freeSlots : 0;
+    if (m_Entities.size() + newSlots - 1 > ENTITY_INDEX_MASK) {
+        ENGINE_ERROR("Too many entities in existence.");
+        return false;
+    }
+
+    m_Entities.reserve(m_Entities.size() + newSlots);
+    m_Signatures.reserve(m_Signatures.size() + newSlots);
+
+    for (size_t i = 0; i < count; ++i) {
+        EntityID entity;
+        if (m_FreeHead != 0) {
+            const uint32_t index = m_FreeHead;
+            const EntityID slot = m_Entities[index];
+            m_FreeHead = GetEntityIndex(slot);
+            entity = MakeEntityID(index, GetEntityVersion(slot));
+            m_Entities[index] = entity;
+        } else {
+            entity = MakeEntityID(static_cast<uint32_t>(m_Entities.size()), 0);
+            m_Entities.push_back(entity);
+            m_Signatures.emplace_back();
+        }
+        out[i] = entity;
+    }
+
+    m_LivingEntityCount += static_cast<uint32_t>(count);
+    return true;
+}
+
+void Registry::AddNewEntitiesToQueries(const EntityID* entities, size_t count) {
+    for (const auto& query : m_Queries) {
+        for (size_t i = 0; i < count; ++i) {
+            if ((m_Signatures[GetEntityIndex(entities[i])] & query->Mask) == query->Mask) {
+                query->Entities.Insert(entities[i]);
+            }
+        }
+    }
+}
+
+void Registry::RemoveEntitiesFromQueries(const EntityID* entities, size_t count, const Signature& touched) {
+    for (const auto& query : m_Queries) {
+        // No destroyed entity had every component of the mask
+        if ((touched & query->Mask) != query->Mask || query->Entities.Empty()) {
+            continue;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (query->Entities.Contains(entities[i])) {
+                query->Entities.Remove(entities[i]);
+            }
+        }
+    }
+}
+
+void Registry::DestroyEntities(const EntityID* entities, size_t count) {
+    std::vector<EntityID> destroyed;
+    destroyed.reserve(count);
+    Signature touched;
+    size_t skipped = 0;
+
+    // Free the slots first; a repeated handle is stale by its second occurrence
+    for (size_t i = 0; i < count; ++i) {
+        const EntityID entity = entities[i];
+        if (!IsValid(entity)) {
+            skipped++;
+            continue;
+        }
+        const uint32_t index = GetEntityIndex(entity);
+        touched |= m_Signatures[index];
+        m_Signatures[index].reset();
+        m_Entities[index] = MakeEntityID(m_FreeHead, NextEntityVersion(GetEntityVersion(entity)));
+        m_FreeHead = index;
+        destroyed.push_back(entity);
+    }
+    m_LivingEntityCount -= static_cast<uint32_t>(destroyed.size());
+
+    // One sweep per pool any of them had a component in
+    if (!destroyed.empty()) {
+        for (ComponentID type = 0; type < MAX_COMPONENTS; ++type) {
+            if (touched.test(type) && m_ComponentArrays[type]) {
+                AssureWritable(type);
+                m_ComponentArrays[type]->EntitiesDestroyed(destroyed.data(), destroyed.size());
+            }
+        }
+        RemoveEntitiesFromQueries(destroyed.data(), destroyed.size(), touched);
+    }
+
+    if (skipped > 0) {
+        ENGINE_WARN("DestroyEntities: skipped {} invalid handles", skipped);
+    }
+}
+
+IComponentArray* Registry::AssureComponentArray(ComponentID type, const IComponentArray& prototype) {
+    if (!m_ComponentArrays[type]) {
+        m_ComponentArrays[type] = prototype.CreateEmpty();
+        m_ComponentArrays[type]->SetTickSource(&m_ChangeTick);
+    }
+    AssureWritable(type);
+    return m_ComponentArrays[type].get();
+}
+
+void Registry::DetachPool(ComponentID type) {
+    std::unique_lock<std::mutex> lock(m_ParallelMutex, std::defer_lock);
+    if (m_ParallelAccess) {
+        lock.lock();
+        if (!m_SharedPools.test(type)) {
+            return;  // Another system copied it first
+        }
+        ENGINE_ERROR("Registry: component pool {} written inside a parallel stage while shared with a snapshot "
+                     "(missing Writes<T>()?)", type);
+    }
+    m_SharedPools.reset(type);
+    m_SharedSnapshot->SavePool(type, *m_ComponentArrays[type]);
+}
+
+void Registry::BeginParallelAccess(const Signature& writes) {
+    const Signature detach = writes & m_SharedPools;
+    if (detach.any()) {
+        for (ComponentID type = 0; type < MAX_COMPONENTS; ++type) {
+            if (detach.test(type) && m_ComponentArrays[type]) {
+                DetachPool(type);
+            }
+        }
+    }
+    m_ParallelAccess = true;
+}
+
+void Registry::EndParallelAccess() {
+    m_ParallelAccess = false;
+}
+
+void Registry::TrimRemovals(uint32_t tick) {
+    for (const auto& pool : m_ComponentArrays) {
+        if (pool && pool->IsTrackingRemovals()) {
+            pool->TrimRemoved(tick);
+        }
+    }
+}
+
+const SparseSet& Registry::GetOrCreateQuery(const Signature& mask) {
+    // Concurrent systems may create queries on first use
+    std::unique_lock<std::mutex> lock(m_ParallelMutex, std::defer_lock);
+    if (m_ParallelAccess) {
+        lock.lock();
+    }
+    for (const auto& query : m_Queries) {
+        if (query->Mask == mask) {
+            return query->Entities;
+        }
+    }
+
+    // First use: one full scan, incremental from here on
+    auto query = std::make_unique<QueryCache>();
+    query->Mask = mask;
+    for (uint32_t index = 1; index < m_Entities.size(); ++index) {
+        const EntityID entity = m_Entities[index];
+        if (GetEntityIndex(entity) == index && (m_Signatures[index] & mask) == mask) {
+            query->Entities.Insert(entity);
+        }
+    }
+
+    m_Queries.push_back(std::move(query));
+    return m_Queries.back()->Entities;
+}
+
+void Registry::RebuildQueries() {
+    for (const auto& query : m_Queries) {
+        query->Entities.Clear();
+        for (uint32_t index = 1; index < m_Entities.size(); ++index) {
+            const EntityID entity = m_Entities[index];
+            if (GetEntityIndex(entity) == index && (m_Signatures[index] & query->Mask) == query->Mask) {
+                query->Entities.Insert(entity);
+            }
+        }
+    }
+}
+
+void Registry::UpdateQueries(EntityID entity) {
+    const Signature& signature = m_Signatures[GetEntityIndex(entity)];
+    const bool active = IsValid(entity);
+
+    for (const auto& query : m_Queries) {
+        const bool matches = active && (signature & query->Mask) == query->Mask;
+        const bool contained = query->Entities.Contains(entity);
+        if (matches && !contained) {
+            query->Entities.Insert(entity);
+        } else if (!matches && contained) {
+            query->Entities.Remove(entity);
+        }
+    }
+}
+
 } // namespace MyEngine
@@ -7,171 +7,346 @@
 
 #pragma once
 
+#include <algorithm>
 #include <vector>
-#include <queue>
-#include <array>
 #include <bitset>
 #include <memory>
-#include <unordered_map>
+#include <mutex>
+#include <array>
+#include <type_traits>
 #include "Component.h"
+#include "ComponentArray.h"
+#include "View.h"
 #include "Core/Log.h"
 
 namespace MyEngine {
 
-using EntityID = uint32_t;
-using Signature = std::bitset<MAX_COMPONENTS>;
+class RegistrySnapshot;
 
-/**
- * @brief Internal interface for component storage
- */
-class IComponentArray {
-public:
-    virtual ~IComponentArray() = default;
-    virtual void EntityDestroyed(EntityID entity) = 0;
-};
+using Signature = std::bitset<MAX_COMPONENTS>;
 
 /**
- * @brief Packed storage for components of a specific type
+ * @brief Core ECS manager
  */
-template<typename T>
-class ComponentArray : public IComponentArray {
+class Registry {
 public:
-    void InsertData(EntityID entity, T component) {
-        if (m_EntityToIndexMap.find(entity) != m_EntityToIndexMap.end()) {
-            ENGINE_ERROR("Component added to same entity more than once.");
-            return;
-        }
+    Registry();
+    ~Registry();
+    Registry(const Registry&) = delete;             // Pools keep a pointer to m_ChangeTick
+    Registry& operator=(const Registry&) = delete;
+    
+    EntityID CreateEntity();
+    void DestroyEntity(EntityID entity);
 
-        size_t newIndex = m_Size;
-        m_EntityToIndexMap[entity] = newIndex;
-        m_IndexToEntityMap[newIndex] = entity;
-        m_ComponentArray[newIndex] = component;
-        m_Size++;
+    /**
+     * @brief O(1) check that the handle refers to a live entity (stale handles fail)
+     */
+    bool IsValid(EntityID entity) const {
+        const uint32_t index = GetEntityIndex(entity);
+        return index != 0 && index < m_Entities.size() && m_Entities[index] == entity;
     }
 
-    void RemoveData(EntityID entity) {
-        if (m_EntityToIndexMap.find(entity) == m_EntityToIndexMap.end()) {
-            ENGINE_ERROR("Removing non-existent component.");
-            return;
-        }
+    /**
+     * @brief Pre-allocate slot storage for bulk creation
+     */
+    void Reserve(size_t entityCount);
 
-        size_t indexOfRemovedEntity = m_EntityToIndexMap[entity];
-        size_t indexOfLastElement = m_Size - 1;
-        m_ComponentArray[indexOfRemovedEntity] = m_ComponentArray[indexOfLastElement];
-
-        EntityID entityOfLastElement = m_IndexToEntityMap[indexOfLastElement];
-        m_EntityToIndexMap[entityOfLastElement] = indexOfRemovedEntity;
-        m_IndexToEntityMap[indexOfRemovedEntity] = entityOfLastElement;
-
-        m_EntityToIndexMap.erase(entity);
-        m_IndexToEntityMap.erase(indexOfLastElement);
-
-        m_Size--;
+    /**
+     * @brief Create count entities, each holding a copy of every given component
+     *
+     * 批量路径：实体槽位一次分配，每个组件池一次预留后顺序写入，
+     * 查询缓存按签名整体更新，没有逐个 AddComponent 的检查与签名比较。
+     * 组件类型如未注册会自动注册。
+     */
+    template<typename... Components>
+    std::vector<EntityID> CreateEntities(size_t count, const Components&... components) {
+        std::vector<EntityID> entities(count);
+        if (!CreateEntities(entities.data(), count, components...)) {
+            entities.clear();
+        }
+        return entities;
     }
 
-    T& GetData(EntityID entity) {
-        if (m_EntityToIndexMap.find(entity) == m_EntityToIndexMap.end()) {
-            ENGINE_ERROR("Retrieving non-existent component.");
-            static T dummy;
-            return dummy;
+    template<typename... Components>
+    bool CreateEntities(EntityID* out, size_t count, const Components&... components) {
+        (RegisterComponent<Components>(), ...);
+        if (!AllocateEntities(out, count)) {
+            return false;
         }
-        return m_ComponentArray[m_EntityToIndexMap[entity]];
-    }
 
-    void EntityDestroyed(EntityID entity) override {
-        if (m_EntityToIndexMap.find(entity) != m_EntityToIndexMap.end()) {
-            RemoveData(entity);
+        Signature mask;
+        (mask.set(GetComponentTypeID<Components>()), ...);
+        for (size_t i = 0; i < count; ++i) {
+            m_Signatures[GetEntityIndex(out[i])] = mask;
         }
+        (GetWritableComponentArray<Components>()->InsertCopies(out, count, components), ...);
+        AddNewEntitiesToQueries(out, count);
+        return true;
     }
 
-private:
-    std::array<T, MAX_ENTITIES> m_ComponentArray;
-    std::unordered_map<EntityID, size_t> m_EntityToIndexMap;
-    std::unordered_map<size_t, EntityID> m_IndexToEntityMap;
-    size_t m_Size = 0;
-};
+    /**
+     * @brief Destroy every valid entity in the range (stale handles are skipped)
+     *
+     * 批量路径：先统一回收槽位并合并签名，然后每个涉及的组件池一次性删除，
+     * 查询缓存每个只扫一遍（签名合集不覆盖其掩码的查询直接跳过）。
+     */
+    void DestroyEntities(const EntityID* entities, size_t count);
+    void DestroyEntities(const std::vector<EntityID>& entities) {
+        DestroyEntities(entities.data(), entities.size());
+    }
 
-/**
- * @brief Core ECS manager
- */
-class Registry {
-public:
-    Registry();
-    
-    EntityID CreateEntity();
-    void DestroyEntity(EntityID entity);
+    uint32_t GetEntityCount() const { return m_LivingEntityCount; }
 
     template<typename T>
     void RegisterComponent() {
-        const char* typeName = typeid(T).name();
-        if (m_ComponentTypes.find(typeName) != m_ComponentTypes.end()) {
+        const ComponentID type = GetComponentTypeID<T>();
+        if (type >= MAX_COMPONENTS) {
+            ENGINE_ERROR("Too many component types (max {}).", MAX_COMPONENTS);
             return;
         }
-        m_ComponentTypes[typeName] = GetComponentTypeID<T>();
-        m_ComponentArrays[typeName] = std::make_shared<ComponentArray<T>>();
+        if (!m_ComponentArrays[type]) {
+            m_ComponentArrays[type] = std::make_unique<ComponentArray<T>>();
+            m_ComponentArrays[type]->SetTickSource(&m_ChangeTick);
+        }
     }
 
     template<typename T>
     void AddComponent(EntityID entity, T component) {
-        GetComponentArray<T>()->InsertData(entity, component);
+        if (!IsValid(entity)) {
+            ENGINE_ERROR("Adding component to invalid entity {}.", entity);
+            return;
+        }
+        GetWritableComponentArray<T>()->InsertData(entity, std::move(component));
         auto type = GetComponentType<T>();
-        m_Signatures[entity].set(type);
+        m_Signatures[GetEntityIndex(entity)].set(type);
+        UpdateQueries(entity);
     }
 
     template<typename T>
     void RemoveComponent(EntityID entity) {
-        GetComponentArray<T>()->RemoveData(entity);
+        if (!IsValid(entity)) {
+            ENGINE_ERROR("Removing component from invalid entity {}.", entity);
+            return;
+        }
+        GetWritableComponentArray<T>()->RemoveData(entity);
         auto type = GetComponentType<T>();
-        m_Signatures[entity].reset(type);
+        m_Signatures[GetEntityIndex(entity)].reset(type);
+        UpdateQueries(entity);
     }
 
+    /**
+     * @brief Component access; GetComponent<const T> reads without marking T changed
+     */
     template<typename T>
     T& GetComponent(EntityID entity) {
-        return GetComponentArray<T>()->GetData(entity);
+        if constexpr (std::is_const_v<T>) {
+            return GetComponentArray<std::remove_const_t<T>>()->ReadData(entity);
+        } else {
+            return GetWritableComponentArray<T>()->GetData(entity);
+        }
     }
 
+    /**
+     * @brief Flag T as changed at the current tick (for writes through cached pointers)
+     */
     template<typename T>
-    ComponentID GetComponentType() {
-        const char* typeName = typeid(T).name();
-        return m_ComponentTypes[typeName];
+    void MarkChanged(EntityID entity) {
+        if (auto* pool = GetWritableComponentArray<T>()) {
+            pool->MarkChanged(entity);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Change detection
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief 变更 tick
+     *
+     * 组件的 Added/Changed 记录写入时的 tick。系统记住上次运行时的 tick，
+     * 用 View::Filter<Changed<T>>(lastTick) 只访问此后变化的实体。
+     * SystemScheduler 在每个 Stage 前后推进 tick；不使用调度器时手动调用 AdvanceChangeTick。
+     */
+    uint32_t GetChangeTick() const { return m_ChangeTick; }
+    uint32_t AdvanceChangeTick() { return ++m_ChangeTick; }
+
+    /**
+     * @brief Start recording removals of T (component removed or entity destroyed)
+     */
+    template<typename T>
+    void TrackRemovals() {
+        RegisterComponent<T>();
+        if (auto* pool = GetComponentArray<T>()) {
+            pool->SetTrackRemovals(true);
+        }
+    }
+
+    /**
+     * @brief Invoke func(EntityID) for every T removed after sinceTick (requires TrackRemovals<T>)
+     *
+     * 传入的是已失效的句柄，只能用于查找外部数据（空间索引、网络对象等）。
+     */
+    template<typename T, typename Func>
+    void EachRemoved(uint32_t sinceTick, Func&& func) const {
+        const auto& pool = m_ComponentArrays[GetComponentTypeID<T>()];
+        if (!pool) {
+            return;
+        }
+        const auto& removed = pool->GetRemoved();
+        auto it = std::upper_bound(removed.begin(), removed.end(), sinceTick,
+            [](uint32_t tick, const RemovedComponent& record) { return tick < record.Tick; });
+        for (; it != removed.end(); ++it) {
+            func(it->Entity);
+        }
+    }
+
+    /**
+     * @brief Forget removal records every consumer has seen (Tick <= tick)
+     */
+    void TrimRemovals(uint32_t tick);
+
+    /**
+     * @brief Bracket systems running concurrently (SystemScheduler, around each parallel stage)
+     *
+     * 在主线程上先把 writes 中仍与写时复制快照共享的池复制出来；并行期间首次使用的 Query
+     * 与（写了未声明组件导致的）池复制加锁执行，后者记录错误。
+     */
+    void BeginParallelAccess(const Signature& writes);
+    void EndParallelAccess();
+
+    template<typename T>
+    ComponentID GetComponentType() const {
+        return GetComponentTypeID<T>();
     }
 
     Signature GetSignature(EntityID entity) {
-        return m_Signatures[entity];
+        return IsValid(entity) ? m_Signatures[GetEntityIndex(entity)] : Signature();
     }
 
+    /**
+     * @brief View over the component pools (no allocation, no signature scan)
+     */
     template<typename... Components>
-    std::vector<EntityID> GetEntitiesWith() {
-        std::vector<EntityID> entities;
-        Signature targetSignature;
-        ComponentID componentIDs[] = { GetComponentType<Components>()... };
-        for (ComponentID id : componentIDs) {
-            targetSignature.set(id);
-        }
+    View<Components...> GetView() {
+        // Mutable components may be written through the view
+        return View<Components...>(std::is_const_v<Components>
+            ? GetComponentArray<std::remove_const_t<Components>>()
+            : GetWritableComponentArray<std::remove_const_t<Components>>()...);
+    }
 
-        for (EntityID i = 0; i < MAX_ENTITIES; i++) {
-            if (m_ActiveEntities.test(i) && (m_Signatures[i] & targetSignature) == targetSignature) {
-                entities.push_back(i);
-            }
-        }
-        return entities;
+    /**
+     * @brief Pool of T for systems that batch over cached dense indices (nullptr if never registered)
+     * Fetch it again every frame: this detaches the pool from a copy-on-write snapshot before writes
+     */
+    template<typename T>
+    ComponentArray<T>* GetComponentStorage() {
+        return GetWritableComponentArray<T>();
+    }
+
+    /**
+     * @brief Persistent query: entities having all Components
+     *
+     * 首次调用时扫描一次并缓存；之后在组件增删、实体销毁时增量维护，
+     * 调用开销与匹配数量无关，返回的引用在下次结构性修改前有效。
+     */
+    template<typename... Components>
+    const std::vector<EntityID>& Query() {
+        Signature mask;
+        (mask.set(GetComponentType<Components>()), ...);
+        return GetOrCreateQuery(mask).GetEntities();
+    }
+
+    /**
+     * @brief Snapshot of Query<Components...>() (allocates; prefer GetView / Query)
+     */
+    template<typename... Components>
+    std::vector<EntityID> GetEntitiesWith() {
+        return Query<Components...>();
     }
 
 private:
+    /**
+     * @brief Pool for T (nullptr if T was never registered): one indexed load
+     */
     template<typename T>
-    std::shared_ptr<ComponentArray<T>> GetComponentArray() {
-        const char* typeName = typeid(T).name();
-        return std::static_pointer_cast<ComponentArray<T>>(m_ComponentArrays[typeName]);
+    ComponentArray<T>* GetComponentArray() {
+        return static_cast<ComponentArray<T>*>(m_ComponentArrays[GetComponentTypeID<T>()].get());
+    }
+
+    /**
+     * @brief Pool for T about to be modified (copies it into a copy-on-write snapshot first)
+     */
+    template<typename T>
+    ComponentArray<T>* GetWritableComponentArray() {
+        AssureWritable(GetComponentTypeID<T>());
+        return GetComponentArray<T>();
+    }
+
+    void AssureWritable(ComponentID type) {
+        if (m_SharedPools.test(type)) {
+            DetachPool(type);
+        }
     }
+    void DetachPool(ComponentID type);
+
+    /**
+     * @brief Cached entity set for one signature mask
+     */
+    struct QueryCache {
+        Signature Mask;
+        SparseSet Entities;
+    };
+
+    const SparseSet& GetOrCreateQuery(const Signature& mask);
+    void UpdateQueries(EntityID entity);
+    void RebuildQueries();
+
+    /**
+     * @brief Allocate count live slots with empty signatures (queries not yet updated)
+     */
+    bool AllocateEntities(EntityID* out, size_t count);
+
+    /**
+     * @brief Insert freshly created entities into every matching query
+     */
+    void AddNewEntitiesToQueries(const EntityID* entities, size_t count);
+
+    /**
+     * @brief Drop destroyed entities from the queries; touched = union of their signatures
+     */
+    void RemoveEntitiesFromQueries(const EntityID* entities, size_t count, const Signature& touched);
+
+    /**
+     * @brief Storage for component type id in this registry, created from prototype if missing
+     */
+    IComponentArray* AssureComponentArray(ComponentID type, const IComponentArray& prototype);
+
+    friend class Prefab;
+    friend class RegistrySnapshot;
+    friend class SceneSerializer;
 
 private:
-    std::queue<EntityID> m_AvailableEntities;
-    std::bitset<MAX_ENTITIES> m_ActiveEntities;
-    std::array<Signature, MAX_ENTITIES> m_Signatures;
+    // Slot per entity index. Live slots hold the entity's handle; free slots form an
+    // intrusive list: index bits = next free slot (0 terminates), version bits = next version.
+    std::vector<EntityID> m_Entities;
+    std::vector<Signature> m_Signatures;
+    uint32_t m_FreeHead = 0;
     uint32_t m_LivingEntityCount = 0;
 
-    std::unordered_map<const char*, ComponentID> m_ComponentTypes;
-    std::unordered_map<const char*, std::shared_ptr<IComponentArray>> m_ComponentArrays;
+    // Flat pool table indexed by GetComponentTypeID<T>()
+    std::array<std::unique_ptr<IComponentArray>, MAX_COMPONENTS> m_ComponentArrays;
+
+    std::vector<std::unique_ptr<QueryCache>> m_Queries;
+
+    uint32_t m_ChangeTick = 1;  // 0 = "never": everything counts as changed for a first run
+
+    // Pools still shared with a copy-on-write snapshot (copied out on first write)
+    Signature m_SharedPools;
+    RegistrySnapshot* m_SharedSnapshot = nullptr;
+
+    // Set between Begin/EndParallelAccess; lazy query creation and pool detaching lock m_ParallelMutex
+    bool m_ParallelAccess = false;
+    std::mutex m_ParallelMutex;
 };
 
 } // namespace MyEngine
@@ -0,0 +1,143 @@
+/******************************************************************************
+ * File: RegistrySnapshot.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Registry snapshot implementation
+ ******************************************************************************/
+
+#include "RegistrySnapshot.h"
+#include "Core/Profiler.h"
+
+namespace MyEngine {
+
+RegistrySnapshot::~RegistrySnapshot() {
+    Release();
+}
+
+void RegistrySnapshot::Capture(Registry& registry, Mode mode) {
+    PROFILE_FUNCTION();
+    Release();
+
+    // Another copy-on-write snapshot of this registry keeps its data but stops sharing
+    if (mode == Mode::CopyOnWrite && registry.m_SharedSnapshot) {
+        RegistrySnapshot* previous = registry.m_SharedSnapshot;
+        for (ComponentID type = 0; type < MAX_COMPONENTS; ++type) {
+            if (registry.m_SharedPools.test(type)) {
+                previous->SavePool(type, *registry.m_ComponentArrays[type]);
+            }
+        }
+        registry.m_SharedPools.reset();
+        registry.m_SharedSnapshot = nullptr;
+        previous->m_Shared = nullptr;
+    }
+
+    m_Mode = mode;
+    m_Entities = registry.m_Entities;
+    m_Signatures = registry.m_Signatures;
+    m_FreeHead = registry.m_FreeHead;
+    m_LivingEntityCount = registry.m_LivingEntityCount;
+
+    for (ComponentID type = 0; type < MAX_COMPONENTS; ++type) {
+        const auto& pool = registry.m_ComponentArrays[type];
+        if (!pool) {
+            continue;
+        }
+        m_Registered.set(type);
+        if (!pool->IsCopyable()) {
+            ENGINE_WARN("RegistrySnapshot: component type {} is not copyable and will be restored empty", type);
+            m_Skipped.set(type);
+        } else if (mode == Mode::Copy) {
+            m_Pools[type] = pool->Clone();
+        } else {
+            registry.m_SharedPools.set(type);
+        }
+    }
+
+    if (mode == Mode::CopyOnWrite) {
+        m_Shared = &registry;
+        registry.m_SharedSnapshot = this;
+    }
+    m_Captured = true;
+}
+
+void RegistrySnapshot::Restore(Registry& registry) {
+    PROFILE_FUNCTION();
+    if (!m_Captured) {
+        ENGINE_WARN("RegistrySnapshot: Restore called without a capture");
+        return;
+    }
+    if (m_Mode == Mode::CopyOnWrite && &registry != m_Shared) {
+        ENGINE_ERROR("RegistrySnapshot: copy-on-write snapshot can only restore its source registry");
+        return;
+    }
+
+    // Restored components count as changed after everything systems have already seen
+    registry.AdvanceChangeTick();
+
+    registry.m_Entities = m_Entities;
+    registry.m_Signatures = m_Signatures;
+    registry.m_FreeHead = m_FreeHead;
+    registry.m_LivingEntityCount = m_LivingEntityCount;
+
+    for (ComponentID type = 0; type < MAX_COMPONENTS; ++type) {
+        const auto& live = registry.m_ComponentArrays[type];
+        if (!m_Registered.test(type) || m_Skipped.test(type)) {
+            // Registered after the capture, or impossible to copy: restored empty
+            if (live) {
+                live->Clear();
+            }
+            if (m_Skipped.test(type)) {
+                for (Signature& signature : registry.m_Signatures) {
+                    signature.reset(type);
+                }
+            }
+            continue;
+        }
+
+        // No saved copy means the shared pool was never written
+        if (m_Pools[type]) {
+            registry.AssureComponentArray(type, *m_Pools[type])->RestoreFrom(*m_Pools[type]);
+        }
+    }
+
+    registry.RebuildQueries();
+}
+
+void RegistrySnapshot::Release() {
+    if (m_Shared) {
+        m_Shared->m_SharedPools.reset();
+        m_Shared->m_SharedSnapshot = nullptr;
+        m_Shared = nullptr;
+    }
+
+    m_Entities.clear();
+    m_Entities.shrink_to_fit();
+    m_Signatures.clear();
+    m_Signatures.shrink_to_fit();
+    m_FreeHead = 0;
+    m_LivingEntityCount = 0;
+    m_Registered.reset();
+    m_Skipped.reset();
+    for (auto& pool : m_Pools) {
+        pool.reset();
+    }
+    m_Captured = false;
+}
+
+void RegistrySnapshot::SavePool(ComponentID type, const IComponentArray& pool) {
+    if (!m_Pools[type]) {
+        m_Pools[type] = pool.Clone();
+    }
+}
+
+size_t RegistrySnapshot::GetMemoryUsage() const {
+    size_t bytes = m_Entities.capacity() * sizeof(EntityID) + m_Signatures.capacity() * sizeof(Signature);
+    for (const auto& pool : m_Pools) {
+        if (pool) {
+            bytes += pool->GetMemoryUsage();
+        }
+    }
+    return bytes;
+}
+
+} // namespace MyEngine
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * File: RegistrySnapshot.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Bulk copy of registry state for Play Mode save/restore
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+#include "Registry.h"
+
+namespace MyEngine {
+
+/**
+ * @brief Registry 快照
+ *
+ * 整体复制实体槽位、签名与全部组件池：可平凡复制的组件按页 memcpy，
+ * 其余组件通过拷贝构造复制；不可拷贝的组件类型在恢复后为空（并给出警告）。
+ *
+ * CopyOnWrite 模式下 Capture 只复制实体表，组件池与 Registry 共享：
+ * 某个池第一次被写入（AddComponent / 可变 GetComponent / 非 const View / 销毁实体等）
+ * 之前才把它复制进快照。运行期间从未写过的池在 Restore 时无需任何复制。
+ * 该模式下快照与 Registry 互相关联，只能恢复到源 Registry。
+ *
+ * Restore 把所有恢复的组件记为在当前 tick Added/Changed，并重建查询缓存；
+ * 变更 tick 本身保持单调递增。
+ */
+class RegistrySnapshot {
+public:
+    enum class Mode {
+        Copy,        // Copy every pool now
+        CopyOnWrite  // Copy each pool just before its first write
+    };
+
+    RegistrySnapshot() = default;
+    ~RegistrySnapshot();
+    RegistrySnapshot(const RegistrySnapshot&) = delete;
+    RegistrySnapshot& operator=(const RegistrySnapshot&) = delete;
+
+    void Capture(Registry& registry, Mode mode = Mode::Copy);
+
+    /**
+     * @brief Put registry back into the captured state (the snapshot stays valid)
+     */
+    void Restore(Registry& registry);
+
+    /**
+     * @brief Drop captured data and stop sharing pools with the registry
+     */
+    void Release();
+
+    bool IsCaptured() const { return m_Captured; }
+    Mode GetMode() const { return m_Mode; }
+
+    /**
+     * @brief Approximate heap usage in bytes (pools still shared are not counted)
+     */
+    size_t GetMemoryUsage() const;
+
+private:
+    friend class Registry;
+
+    /**
+     * @brief Called by Registry before the first write to a shared pool
+     */
+    void SavePool(ComponentID type, const IComponentArray& pool);
+
+private:
+    Mode m_Mode = Mode::Copy;
+    bool m_Captured = false;
+    Registry* m_Shared = nullptr;  // Registry whose pools are shared (CopyOnWrite)
+
+    std::vector<EntityID> m_Entities;
+    std::vector<Signature> m_Signatures;
+    uint32_t m_FreeHead = 0;
+    uint32_t m_LivingEntityCount = 0;
+
+    Signature m_Registered;  // Pools that existed at capture
+    Signature m_Skipped;     // Pools that cannot be copied
+    std::array<std::unique_ptr<IComponentArray>, MAX_COMPONENTS> m_Pools;
+};
+
+} // namespace MyEngine
@@ -0,0 +1,367 @@
+/******************************************************************************
+ * File: SceneSerializer.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Binary scene format implementation
+ ******************************************************************************/
+
+#include "SceneSerializer.h"
+#include "Components.h"
+#include "Core/Hash.h"
+#include "Core/Profiler.h"
+#include "Platform/FileSystem.h"
+#include <fstream>
+
+namespace MyEngine {
+
+namespace {
+
+// Little-endian on disk (every supported platform); version bumps on any layout change
+constexpr char SCENE_MAGIC[4] = { 'M', 'E', 'S', 'N' };
+
+struct SceneFileHeader {
+    char Magic[4];
+    uint32_t Version;
+    uint32_t HeaderSize;
+    uint32_t PoolCount;
+    uint32_t EntitySlotCount;  // Including reserved slot 0
+    uint32_t LivingEntityCount;
+    uint32_t FreeHead;
+    uint32_t Reserved;
+    uint64_t EntitiesOffset;
+    uint64_t StringsOffset;
+    uint64_t StringsSize;
+    uint64_t FileSize;
+};
+static_assert(sizeof(SceneFileHeader) == 64, "Scene header layout changed");
+
+struct ScenePoolEntry {
+    uint64_t NameHash;
+    SceneString Name;
+    uint32_t Count;
+    uint32_t RecordSize;
+    uint64_t EntitiesOffset;
+    uint64_t RecordsOffset;
+};
+static_assert(sizeof(ScenePoolEntry) == 40, "Scene pool entry layout changed");
+
+uint64_t AlignOffset(uint64_t offset) {
+    return (offset + SceneSerializer::BLOCK_ALIGNMENT - 1) & ~uint64_t(SceneSerializer::BLOCK_ALIGNMENT - 1);
+}
+
+void PadTo(std::ostream& out, uint64_t offset) {
+    static const char zeros[SceneSerializer::BLOCK_ALIGNMENT] = {};
+    uint64_t position = static_cast<uint64_t>(out.tellp());
+    while (offset > position) {
+        const uint64_t n = std::min<uint64_t>(offset - position, sizeof(zeros));
+        out.write(zeros, static_cast<std::streamsize>(n));
+        position += n;
+    }
+}
+
+bool InFile(uint64_t offset, uint64_t size, uint64_t fileSize) {
+    return offset <= fileSize && size <= fileSize - offset;
+}
+
+std::vector<SceneComponentCodec>& GetCodecs() {
+    static std::vector<SceneComponentCodec> s_Codecs;
+    return s_Codecs;
+}
+
+// Builtin non-raw components
+struct MeshFilterRecord {
+    uint64_t MeshID;
+    uint32_t Generation;
+    uint32_t Padding;
+};
+
+void EncodeTag(const TagComponent& tag, SceneString& record, SceneStringWriter& strings) {
+    record = strings.Add(tag.Tag);
+}
+
+void DecodeTag(const SceneString& record, TagComponent& tag, const SceneStringReader& strings) {
+    tag.Tag = std::string(strings.Get(record));
+}
+
+void EncodeMeshFilter(const MeshFilterComponent& filter, MeshFilterRecord& record, SceneStringWriter&) {
+    record.MeshID = filter.MeshHandle.GetID().Get();
+    record.Generation = filter.MeshHandle.GetGeneration();
+}
+
+void DecodeMeshFilter(const MeshFilterRecord& record, MeshFilterComponent& filter, const SceneStringReader&) {
+    filter.MeshHandle = Handle<Mesh>(UUID(record.MeshID), record.Generation);
+}
+
+} // anonymous namespace
+
+SceneString SceneStringWriter::Add(std::string_view text) {
+    auto it = m_Lookup.find(std::string(text));
+    if (it != m_Lookup.end()) {
+        return it->second;
+    }
+    const SceneString entry{ static_cast<uint32_t>(m_Data.size()), static_cast<uint32_t>(text.size()) };
+    m_Data.append(text.data(), text.size());
+    m_Lookup.emplace(std::string(text), entry);
+    return entry;
+}
+
+void SceneSerializer::AddCodec(SceneComponentCodec codec) {
+    RegisterBuiltinComponents();
+    codec.NameHash = HashString(codec.Name);
+
+    auto& codecs = GetCodecs();
+    for (auto& existing : codecs) {
+        if (existing.NameHash == codec.NameHash) {
+            existing = std::move(codec);  // Re-registration replaces (e.g. overriding a builtin)
+            return;
+        }
+    }
+    codecs.push_back(std::move(codec));
+}
+
+void SceneSerializer::RegisterBuiltinComponents() {
+    static bool s_Registered = false;
+    if (s_Registered) {
+        return;
+    }
+    s_Registered = true;
+
+    RegisterComponent<TagComponent, SceneString>("Tag", &EncodeTag, &DecodeTag);
+    RegisterComponent<HierarchyComponent>("Hierarchy");
+    RegisterComponent<TransformComponent>("Transform");
+    RegisterComponent<MeshRendererComponent>("MeshRenderer");
+    RegisterComponent<MeshFilterComponent, MeshFilterRecord>("MeshFilter", &EncodeMeshFilter, &DecodeMeshFilter);
+}
+
+bool SceneSerializer::Save(Registry& registry, const std::string& path) {
+    PROFILE_FUNCTION();
+    RegisterBuiltinComponents();
+
+    std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        ENGINE_ERROR("SceneSerializer: cannot open {} for writing", path);
+        return false;
+    }
+
+    struct PoolToWrite {
+        const SceneComponentCodec* Codec;
+        const IComponentArray* Pool;
+        ScenePoolEntry Entry;
+    };
+
+    SceneStringWriter strings;
+    std::vector<PoolToWrite> pools;
+    for (const SceneComponentCodec& codec : GetCodecs()) {
+        const IComponentArray* pool = registry.m_ComponentArrays[codec.GetTypeID()].get();
+        if (pool && !codec.GetEntities(*pool).empty()) {
+            ScenePoolEntry entry{};
+            entry.NameHash = codec.NameHash;
+            entry.Name = strings.Add(codec.Name);
+            entry.Count = static_cast<uint32_t>(codec.GetEntities(*pool).size());
+            entry.RecordSize = codec.RecordSize;
+            pools.push_back({ &codec, pool, entry });
+        }
+    }
+
+    // Layout: every block starts on a BLOCK_ALIGNMENT boundary
+    SceneFileHeader header{};
+    std::memcpy(header.Magic, SCENE_MAGIC, sizeof(SCENE_MAGIC));
+    header.Version = FORMAT_VERSION;
+    header.HeaderSize = sizeof(SceneFileHeader);
+    header.PoolCount = static_cast<uint32_t>(pools.size());
+    header.EntitySlotCount = static_cast<uint32_t>(registry.m_Entities.size());
+    header.LivingEntityCount = registry.m_LivingEntityCount;
+    header.FreeHead = registry.m_FreeHead;
+
+    uint64_t offset = AlignOffset(sizeof(SceneFileHeader) + pools.size() * sizeof(ScenePoolEntry));
+    header.EntitiesOffset = offset;
+    offset = AlignOffset(offset + uint64_t(header.EntitySlotCount) * sizeof(EntityID));
+    for (PoolToWrite& pool : pools) {
+        pool.Entry.EntitiesOffset = offset;
+        offset = AlignOffset(offset + uint64_t(pool.Entry.Count) * sizeof(EntityID));
+        pool.Entry.RecordsOffset = offset;
+        offset = AlignOffset(offset + uint64_t(pool.Entry.Count) * pool.Entry.RecordSize);
+    }
+    header.StringsOffset = offset;
+
+    // Header and directory are rewritten once the string table size is known
+    PadTo(out, header.EntitiesOffset);
+    out.write(reinterpret_cast<const char*>(registry.m_Entities.data()),
+              static_cast<std::streamsize>(registry.m_Entities.size() * sizeof(EntityID)));
+
+    for (const PoolToWrite& pool : pools) {
+        const std::vector<EntityID>& entities = pool.Codec->GetEntities(*pool.Pool);
+        PadTo(out, pool.Entry.EntitiesOffset);
+        out.write(reinterpret_cast<const char*>(entities.data()),
+                  static_cast<std::streamsize>(entities.size() * sizeof(EntityID)));
+
+        PadTo(out, pool.Entry.RecordsOffset);
+        pool.Codec->Write(*pool.Codec, *pool.Pool, out, strings);
+        const uint64_t written = static_cast<uint64_t>(out.tellp()) - pool.Entry.RecordsOffset;
+        if (written != uint64_t(pool.Entry.Count) * pool.Entry.RecordSize) {
+            ENGINE_ERROR("SceneSerializer: component {} wrote {} bytes, expected {}",
+                         pool.Codec->Name, written, uint64_t(pool.Entry.Count) * pool.Entry.RecordSize);
+            return false;
+        }
+    }
+
+    PadTo(out, header.StringsOffset);
+    out.write(strings.GetData().data(), static_cast<std::streamsize>(strings.GetData().size()));
+    header.StringsSize = strings.GetData().size();
+    header.FileSize = header.StringsOffset + header.StringsSize;
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const PoolToWrite& pool : pools) {
+        out.write(reinterpret_cast<const char*>(&pool.Entry), sizeof(ScenePoolEntry));
+    }
+
+    if (!out.good()) {
+        ENGINE_ERROR("SceneSerializer: failed writing {}", path);
+        return false;
+    }
+    ENGINE_INFO("Scene saved: {} entities, {} component pools -> {}", header.LivingEntityCount, pools.size(), path);
+    return true;
+}
+
+bool SceneSerializer::Load(Registry& registry, const std::string& path) {
+    PROFILE_FUNCTION();
+    RegisterBuiltinComponents();
+
+    if (registry.m_LivingEntityCount != 0 || registry.m_Entities.size() != 1) {
+        ENGINE_ERROR("SceneSerializer: Load requires an empty registry");
+        return false;
+    }
+
+    FileSystem::MappedFile file;
+    if (!file.Open(path)) {
+        ENGINE_ERROR("SceneSerializer: cannot map {}", path);
+        return false;
+    }
+    const uint8_t* data = file.GetData();
+    const uint64_t size = file.GetSize();
+
+    SceneFileHeader header;
+    if (size < sizeof(header)) {
+        ENGINE_ERROR("SceneSerializer: {} is not a scene file", path);
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.Magic, SCENE_MAGIC, sizeof(SCENE_MAGIC)) != 0 || header.HeaderSize != sizeof(header)) {
+        ENGINE_ERROR("SceneSerializer: {} is not a scene file", path);
+        return false;
+    }
+    if (header.Version != FORMAT_VERSION) {
+        ENGINE_ERROR("SceneSerializer: {} has format version {}, expected {}", path, header.Version, FORMAT_VERSION);
+        return false;
+    }
+    if (header.FileSize != size || header.EntitySlotCount == 0 || header.EntitySlotCount - 1 > ENTITY_INDEX_MASK ||
+        !InFile(sizeof(header), uint64_t(header.PoolCount) * sizeof(ScenePoolEntry), size) ||
+        !InFile(header.EntitiesOffset, uint64_t(header.EntitySlotCount) * sizeof(EntityID), size) ||
+        !InFile(header.StringsOffset, header.StringsSize, size)) {
+        ENGINE_ERROR("SceneSerializer: {} is truncated or corrupt", path);
+        return false;
+    }
+
+    const auto* entries = reinterpret_cast<const ScenePoolEntry*>(data + sizeof(header));
+    const SceneStringReader strings(reinterpret_cast<const char*>(data + header.StringsOffset), header.StringsSize);
+
+    // Entity slots are taken over verbatim, so every saved handle stays valid
+    registry.m_Entities.resize(header.EntitySlotCount);
+    std::memcpy(registry.m_Entities.data(), data + header.EntitiesOffset, header.EntitySlotCount * sizeof(EntityID));
+    registry.m_Signatures.assign(header.EntitySlotCount, Signature());
+    registry.m_FreeHead = header.FreeHead;
+    registry.m_LivingEntityCount = header.LivingEntityCount;
+
+    auto fail = [&registry, &path]() {
+        registry.m_Entities.assign(1, NULL_ENTITY);
+        registry.m_Signatures.assign(1, Signature());
+        registry.m_FreeHead = 0;
+        registry.m_LivingEntityCount = 0;
+        ENGINE_ERROR("SceneSerializer: {} is truncated or corrupt", path);
+        return false;
+    };
+
+    // The slot table is trusted by CreateEntity: every slot must be either live (its own index)
+    // or on one acyclic free list, and the counts must add up
+    const uint32_t slotCount = header.EntitySlotCount;
+    if (registry.m_Entities[0] != NULL_ENTITY || header.FreeHead >= slotCount ||
+        header.LivingEntityCount > slotCount - 1) {
+        return fail();
+    }
+    uint32_t liveSlots = 0;
+    for (uint32_t index = 1; index < slotCount; ++index) {
+        liveSlots += GetEntityIndex(registry.m_Entities[index]) == index ? 1 : 0;
+    }
+    uint32_t freeSlots = 0;
+    for (uint32_t index = header.FreeHead; index != 0; index = GetEntityIndex(registry.m_Entities[index])) {
+        // Out of the table, through a live slot, or longer than the free slots there are (cycle)
+        if (index >= slotCount || GetEntityIndex(registry.m_Entities[index]) == index ||
+            ++freeSlots > slotCount - 1 - liveSlots) {
+            return fail();
+        }
+    }
+    if (liveSlots != header.LivingEntityCount || freeSlots + liveSlots != slotCount - 1) {
+        return fail();
+    }
+
+    // Validate every pool (and build signatures) before touching component storage
+    std::vector<const SceneComponentCodec*> codecs(header.PoolCount, nullptr);
+    for (uint32_t p = 0; p < header.PoolCount; ++p) {
+        const ScenePoolEntry& entry = entries[p];
+        if (!InFile(entry.EntitiesOffset, uint64_t(entry.Count) * sizeof(EntityID), size) ||
+            !InFile(entry.RecordsOffset, uint64_t(entry.Count) * entry.RecordSize, size) ||
+            entry.EntitiesOffset % BLOCK_ALIGNMENT != 0 || entry.RecordsOffset % BLOCK_ALIGNMENT != 0) {
+            return fail();
+        }
+
+        const SceneComponentCodec* codec = nullptr;
+        for (const SceneComponentCodec& candidate : GetCodecs()) {
+            if (candidate.NameHash == entry.NameHash) {
+                codec = &candidate;
+                break;
+            }
+        }
+        const std::string_view name = strings.Get(entry.Name);
+        if (!codec) {
+            ENGINE_WARN("SceneSerializer: unknown component '{}' skipped", std::string(name));
+            continue;
+        }
+        if (codec->RecordSize != entry.RecordSize) {
+            ENGINE_WARN("SceneSerializer: component '{}' record size {} != {}, skipped",
+                        codec->Name, entry.RecordSize, codec->RecordSize);
+            continue;
+        }
+
+        const ComponentID type = codec->GetTypeID();
+        const auto* entities = reinterpret_cast<const EntityID*>(data + entry.EntitiesOffset);
+        for (uint32_t i = 0; i < entry.Count; ++i) {
+            const uint32_t index = GetEntityIndex(entities[i]);
+            if (index == 0 || index >= header.EntitySlotCount || registry.m_Entities[index] != entities[i] ||
+                registry.m_Signatures[index].test(type)) {
+                return fail();
+            }
+            registry.m_Signatures[index].set(type);
+        }
+        codecs[p] = codec;
+    }
+
+    uint32_t loadedPools = 0;
+    for (uint32_t p = 0; p < header.PoolCount; ++p) {
+        if (!codecs[p]) {
+            continue;
+        }
+        const ScenePoolEntry& entry = entries[p];
+        codecs[p]->Register(registry);
+        IComponentArray& pool = *registry.m_ComponentArrays[codecs[p]->GetTypeID()];
+        codecs[p]->Read(*codecs[p], pool, reinterpret_cast<const EntityID*>(data + entry.EntitiesOffset),
+                        data + entry.RecordsOffset, entry.Count, strings);
+        loadedPools++;
+    }
+
+    registry.RebuildQueries();
+    ENGINE_INFO("Scene loaded: {} entities, {} component pools <- {}", header.LivingEntityCount, loadedPools, path);
+    return true;
+}
+
+} // namespace MyEngine
@@ -0,0 +1,214 @@
+/******************************************************************************
+ * File: SceneSerializer.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Versioned binary scene format, loaded through a memory mapping
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "Registry.h"
+
+namespace MyEngine {
+
+/**
+ * @brief String reference inside the scene string table
+ */
+struct SceneString {
+    uint32_t Offset = 0;
+    uint32_t Length = 0;
+};
+
+/**
+ * @brief Deduplicating string table built while saving
+ */
+class SceneStringWriter {
+public:
+    SceneString Add(std::string_view text);
+    const std::string& GetData() const { return m_Data; }
+
+private:
+    std::string m_Data;
+    std::unordered_map<std::string, SceneString> m_Lookup;
+};
+
+/**
+ * @brief String table view over the mapped file
+ */
+class SceneStringReader {
+public:
+    SceneStringReader(const char* data, size_t size) : m_Data(data), m_Size(size) {}
+
+    std::string_view Get(const SceneString& text) const {
+        if (static_cast<size_t>(text.Offset) + text.Length > m_Size) {
+            return {};
+        }
+        return std::string_view(m_Data + text.Offset, text.Length);
+    }
+
+private:
+    const char* m_Data;
+    size_t m_Size;
+};
+
+/**
+ * @brief How one component type is written to and read from a scene file
+ */
+struct SceneComponentCodec {
+    using GenericFn = void (*)();
+
+    std::string Name;
+    uint64_t NameHash = 0;
+    uint32_t RecordSize = 0;
+    bool Raw = false;  // Records are the components themselves (memcpy both ways)
+
+    ComponentID (*GetTypeID)() = nullptr;
+    void (*Register)(Registry&) = nullptr;
+    const std::vector<EntityID>& (*GetEntities)(const IComponentArray&) = nullptr;
+    void (*Write)(const SceneComponentCodec&, const IComponentArray&, std::ostream&, SceneStringWriter&) = nullptr;
+    void (*Read)(const SceneComponentCodec&, IComponentArray&, const EntityID*, const uint8_t*,
+                 uint32_t, const SceneStringReader&) = nullptr;
+
+    // User conversion functions of non-raw codecs (cast back to their real type)
+    GenericFn Encode = nullptr;
+    GenericFn Decode = nullptr;
+};
+
+/**
+ * @brief 二进制场景格式
+ *
+ * 文件布局（所有块按 64 字节对齐）：
+ *   Header | 组件池目录 | 实体槽位表 | 每个池的 [实体数组][记录数组] | 字符串表
+ * - 实体槽位表原样保存（包括空闲链表），加载后句柄与保存时完全一致，
+ *   因此 HierarchyComponent 等组件里的 EntityID 无需重映射
+ * - 组件类型按注册名的哈希识别（运行时类型 ID 不稳定）；记录大小不符的池被跳过
+ * - 可平凡复制的组件记录就是组件本身：加载时从映射内存按页 memcpy 进组件池，不做解析
+ * - 其他组件注册 Record 类型与转换函数，字符串（标签等）写入字符串表
+ *
+ * 加载目标必须是空 Registry。
+ */
+class SceneSerializer {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr uint32_t BLOCK_ALIGNMENT = 64;
+
+    /**
+     * @brief Register a trivially copyable component stored as raw bytes
+     */
+    template<typename T>
+    static void RegisterComponent(const char* name) {
+        static_assert(std::is_trivially_copyable_v<T>, "Raw scene components must be trivially copyable");
+        SceneComponentCodec codec = MakeCodec<T>(name, sizeof(T));
+        codec.Raw = true;
+        codec.Write = &WriteRaw<T>;
+        codec.Read = &ReadRaw<T>;
+        AddCodec(std::move(codec));
+    }
+
+    /**
+     * @brief Register a component converted to a trivially copyable Record
+     */
+    template<typename T, typename Record>
+    static void RegisterComponent(const char* name,
+                                  void (*encode)(const T&, Record&, SceneStringWriter&),
+                                  void (*decode)(const Record&, T&, const SceneStringReader&)) {
+        static_assert(std::is_trivially_copyable_v<Record>, "Scene records must be trivially copyable");
+        static_assert(alignof(Record) <= BLOCK_ALIGNMENT, "Scene record alignment exceeds block alignment");
+        SceneComponentCodec codec = MakeCodec<T>(name, sizeof(Record));
+        codec.Write = &WriteRecords<T, Record>;
+        codec.Read = &ReadRecords<T, Record>;
+        codec.Encode = reinterpret_cast<SceneComponentCodec::GenericFn>(encode);
+        codec.Decode = reinterpret_cast<SceneComponentCodec::GenericFn>(decode);
+        AddCodec(std::move(codec));
+    }
+
+    /**
+     * @brief Write every registered component pool of registry to path
+     */
+    static bool Save(Registry& registry, const std::string& path);
+
+    /**
+     * @brief Map path and load it into an empty registry
+     */
+    static bool Load(Registry& registry, const std::string& path);
+
+private:
+    template<typename T>
+    static SceneComponentCodec MakeCodec(const char* name, size_t recordSize) {
+        SceneComponentCodec codec;
+        codec.Name = name;
+        codec.RecordSize = static_cast<uint32_t>(recordSize);
+        codec.GetTypeID = []() { return GetComponentTypeID<T>(); };
+        codec.Register = [](Registry& registry) { registry.RegisterComponent<T>(); };
+        codec.GetEntities = [](const IComponentArray& pool) -> const std::vector<EntityID>& {
+            return static_cast<const ComponentArray<T>&>(pool).GetEntities();
+        };
+        return codec;
+    }
+
+    template<typename T>
+    static void WriteRaw(const SceneComponentCodec&, const IComponentArray& pool, std::ostream& out,
+                         SceneStringWriter&) {
+        const auto& components = static_cast<const ComponentArray<T>&>(pool);
+        // Pages are contiguous runs of PAGE_SIZE components
+        for (size_t first = 0; first < components.Size(); first += ComponentArray<T>::PAGE_SIZE) {
+            const size_t n = std::min<size_t>(ComponentArray<T>::PAGE_SIZE, components.Size() - first);
+            out.write(reinterpret_cast<const char*>(&components.At(static_cast<uint32_t>(first))),
+                      static_cast<std::streamsize>(n * sizeof(T)));
+        }
+    }
+
+    template<typename T>
+    static void ReadRaw(const SceneComponentCodec&, IComponentArray& pool, const EntityID* entities,
+                        const uint8_t* records, uint32_t count, const SceneStringReader&) {
+        static_cast<ComponentArray<T>&>(pool).AppendRaw(entities, reinterpret_cast<const T*>(records), count);
+    }
+
+    template<typename T, typename Record>
+    static void WriteRecords(const SceneComponentCodec& codec, const IComponentArray& pool, std::ostream& out,
+                             SceneStringWriter& strings) {
+        auto encode = reinterpret_cast<void (*)(const T&, Record&, SceneStringWriter&)>(codec.Encode);
+        const auto& components = static_cast<const ComponentArray<T>&>(pool);
+
+        // Encoded in fixed-size batches to keep the staging buffer small
+        constexpr size_t Batch = 1024;
+        std::vector<Record> staging(std::min<size_t>(Batch, components.Size()));
+        for (size_t first = 0; first < components.Size(); first += Batch) {
+            const size_t n = std::min(Batch, components.Size() - first);
+            for (size_t i = 0; i < n; ++i) {
+                staging[i] = Record{};
+                encode(components.At(static_cast<uint32_t>(first + i)), staging[i], strings);
+            }
+            out.write(reinterpret_cast<const char*>(staging.data()), static_cast<std::streamsize>(n * sizeof(Record)));
+        }
+    }
+
+    template<typename T, typename Record>
+    static void ReadRecords(const SceneComponentCodec& codec, IComponentArray& pool, const EntityID* entities,
+                            const uint8_t* records, uint32_t count, const SceneStringReader& strings) {
+        auto decode = reinterpret_cast<void (*)(const Record&, T&, const SceneStringReader&)>(codec.Decode);
+        auto& components = static_cast<ComponentArray<T>&>(pool);
+        components.Reserve(components.Size() + count);
+        for (uint32_t i = 0; i < count; ++i) {
+            Record record;
+            std::memcpy(&record, records + static_cast<size_t>(i) * sizeof(Record), sizeof(Record));
+            T component{};
+            decode(record, component, strings);
+            components.InsertData(entities[i], std::move(component));
+        }
+    }
+
+    static void AddCodec(SceneComponentCodec codec);
+    static void RegisterBuiltinComponents();
+};
+
+} // namespace MyEngine
@@ -0,0 +1,161 @@
+/******************************************************************************
+ * File: SparseSet.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Paged sparse set mapping entities to dense indices
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include "Component.h"
+
+namespace MyEngine {
+
+/**
+ * @brief 分页稀疏集合
+ *
+ * 三部分组成：
+ * - Dense：紧密排列的实体数组（迭代顺序）
+ * - Sparse：按页分配的 实体索引 -> Dense 下标 表
+ * - 页在首次写入时才分配，内存随实际使用的实体索引范围增长
+ *
+ * Sparse 以实体索引为键，Dense 保存完整句柄：过期句柄（版本不同）查找失败。
+ * 查找、插入、删除均为 O(1)，无哈希。删除采用 swap-and-pop，
+ * 因此 Dense 顺序不稳定。
+ */
+class SparseSet {
+public:
+    static constexpr uint32_t PAGE_SIZE = 4096;
+    static constexpr uint32_t NULL_INDEX = UINT32_MAX;
+
+    /**
+     * @brief Dense index of entity, or NULL_INDEX if absent
+     */
+    uint32_t IndexOf(EntityID entity) const {
+        const uint32_t slot = GetEntityIndex(entity);
+        const size_t page = slot / PAGE_SIZE;
+        if (page >= m_Sparse.size() || !m_Sparse[page]) {
+            return NULL_INDEX;
+        }
+        const uint32_t index = m_Sparse[page][slot % PAGE_SIZE];
+        return (index != NULL_INDEX && m_Dense[index] == entity) ? index : NULL_INDEX;
+    }
+
+    bool Contains(EntityID entity) const {
+        return IndexOf(entity) != NULL_INDEX;
+    }
+
+    /**
+     * @brief Append entity to the dense array
+     * @return Dense index of the new element (caller must check Contains first)
+     */
+    uint32_t Insert(EntityID entity) {
+        const uint32_t index = static_cast<uint32_t>(m_Dense.size());
+        const uint32_t slot = GetEntityIndex(entity);
+        AssurePage(slot / PAGE_SIZE)[slot % PAGE_SIZE] = index;
+        m_Dense.push_back(entity);
+        return index;
+    }
+
+    /**
+     * @brief Swap-and-pop removal
+     * @return Dense index that was vacated (the last element now lives there)
+     */
+    uint32_t Remove(EntityID entity) {
+        return RemoveAt(IndexOf(entity));
+    }
+
+    /**
+     * @brief Swap-and-pop removal of the element at dense index (must be in range)
+     */
+    uint32_t RemoveAt(uint32_t index) {
+        const EntityID entity = m_Dense[index];
+        const EntityID last = m_Dense.back();
+
+        const uint32_t lastSlot = GetEntityIndex(last);
+        const uint32_t slot = GetEntityIndex(entity);
+
+        m_Dense[index] = last;
+        m_Sparse[lastSlot / PAGE_SIZE][lastSlot % PAGE_SIZE] = index;
+        m_Sparse[slot / PAGE_SIZE][slot % PAGE_SIZE] = NULL_INDEX;
+        m_Dense.pop_back();
+        return index;
+    }
+
+    /**
+     * @brief Reserve dense capacity for count entities
+     */
+    void Reserve(size_t count) {
+        m_Dense.reserve(count);
+    }
+
+    /**
+     * @brief Become a copy of source, reusing already allocated pages
+     */
+    void CopyFrom(const SparseSet& source) {
+        m_Dense = source.m_Dense;
+        if (m_Sparse.size() < source.m_Sparse.size()) {
+            m_Sparse.resize(source.m_Sparse.size());
+        }
+        for (size_t page = 0; page < m_Sparse.size(); ++page) {
+            const uint32_t* from = page < source.m_Sparse.size() ? source.m_Sparse[page].get() : nullptr;
+            if (from) {
+                if (!m_Sparse[page]) {
+                    m_Sparse[page] = std::make_unique<uint32_t[]>(PAGE_SIZE);
+                }
+                std::copy_n(from, PAGE_SIZE, m_Sparse[page].get());
+            } else if (m_Sparse[page]) {
+                std::fill_n(m_Sparse[page].get(), PAGE_SIZE, NULL_INDEX);
+            }
+        }
+    }
+
+    void Clear() {
+        for (EntityID entity : m_Dense) {
+            const uint32_t slot = GetEntityIndex(entity);
+            m_Sparse[slot / PAGE_SIZE][slot % PAGE_SIZE] = NULL_INDEX;
+        }
+        m_Dense.clear();
+    }
+
+    size_t Size() const { return m_Dense.size(); }
+    bool Empty() const { return m_Dense.empty(); }
+
+    const std::vector<EntityID>& GetEntities() const { return m_Dense; }
+    EntityID GetEntity(uint32_t index) const { return m_Dense[index]; }
+
+    /**
+     * @brief Approximate heap usage in bytes
+     */
+    size_t GetMemoryUsage() const {
+        size_t bytes = m_Dense.capacity() * sizeof(EntityID);
+        bytes += m_Sparse.capacity() * sizeof(std::unique_ptr<uint32_t[]>);
+        for (const auto& page : m_Sparse) {
+            if (page) bytes += PAGE_SIZE * sizeof(uint32_t);
+        }
+        return bytes;
+    }
+
+private:
+    uint32_t* AssurePage(size_t page) {
+        if (page >= m_Sparse.size()) {
+            m_Sparse.resize(page + 1);
+        }
+        if (!m_Sparse[page]) {
+            m_Sparse[page] = std::make_unique<uint32_t[]>(PAGE_SIZE);
+            std::fill_n(m_Sparse[page].get(), PAGE_SIZE, NULL_INDEX);
+        }
+        return m_Sparse[page].get();
+    }
+
+private:
+    std::vector<EntityID> m_Dense;
+    std::vector<std::unique_ptr<uint32_t[]>> m_Sparse;
+};
+
+} // namespace MyEngine
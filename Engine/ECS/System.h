@@ -7,17 +7,98 @@
 
 #pragma once
 
+#include <memory>
 #include <set>
+#include <typeinfo>
+#include <unordered_map>
 #include "Registry.h"
+#include "CommandBuffer.h"
 
 namespace MyEngine {
 
+/**
+ * @brief Components a system reads and writes
+ *
+ * 调度器据此判断两个系统能否并行：只要一方写入的组件被另一方读或写，即为冲突。
+ * 什么都没声明的系统按独占处理（与所有系统冲突），保证未迁移的旧系统行为不变。
+ */
+struct SystemAccess {
+    Signature Reads;
+    Signature Writes;
+    bool Exclusive = false;      // Conflicts with every other system
+    bool MainThreadOnly = false; // Must run on the thread calling SystemScheduler::Update
+
+    bool IsDeclared() const {
+        return Exclusive || Reads.any() || Writes.any();
+    }
+
+    bool ConflictsWith(const SystemAccess& other) const {
+        if (!IsDeclared() || !other.IsDeclared() || Exclusive || other.Exclusive) {
+            return true;
+        }
+        return (Writes & (other.Reads | other.Writes)).any() || (Reads & other.Writes).any();
+    }
+};
+
 /**
  * @brief Base class for all ECS systems
+ *
+ * 派生类在构造函数中声明访问的组件，然后交给 SystemScheduler 调度：
+ * @code
+ * class MovementSystem : public System {
+ * public:
+ *     MovementSystem() { Reads<VelocityComponent>(); Writes<TransformComponent>(); }
+ *     const char* GetName() const override { return "MovementSystem"; }
+ *     void Update(Registry& registry, float deltaTime) override { ... }
+ * };
+ * @endcode
+ *
+ * 并行执行的系统只能读写组件数据；创建/销毁实体、增删组件等结构性修改
+ * 通过 GetCommandBuffer() 录制，由调度器在 Stage 结束时统一回放。
  */
 class System {
 public:
+    virtual ~System() = default;
+
+    virtual const char* GetName() const { return typeid(*this).name(); }
+    virtual void Update(Registry& /*registry*/, float /*deltaTime*/) {}
+
+    const SystemAccess& GetAccess() const { return m_Access; }
+
+    /**
+     * @brief Registry change tick of this system's previous run (0 before the first run)
+     *
+     * 配合 View::Filter<Changed<T>>(GetLastRunTick()) 只处理上次运行后变化的实体。
+     */
+    uint32_t GetLastRunTick() const { return m_LastRunTick; }
+
     std::set<EntityID> m_Entities;
+
+protected:
+    template<typename... Components>
+    void Reads() {
+        (m_Access.Reads.set(GetComponentTypeID<Components>()), ...);
+    }
+
+    template<typename... Components>
+    void Writes() {
+        (m_Access.Writes.set(GetComponentTypeID<Components>()), ...);
+    }
+
+    void SetExclusive(bool exclusive = true) { m_Access.Exclusive = exclusive; }
+    void SetMainThreadOnly(bool mainThread = true) { m_Access.MainThreadOnly = mainThread; }
+
+    /**
+     * @brief Calling thread's deferred command buffer (only while run by a SystemScheduler)
+     */
+    EntityCommandBuffer& GetCommandBuffer() { return m_Commands->GetThreadBuffer(); }
+
+private:
+    friend class SystemScheduler;
+
+    SystemAccess m_Access;
+    EntityCommandBufferSet* m_Commands = nullptr;
+    uint32_t m_LastRunTick = 0;
 };
 
 /**
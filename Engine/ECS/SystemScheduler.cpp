@@ -0,0 +1,297 @@
+/******************************************************************************
+ * File: SystemScheduler.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Parallel system scheduler implementation
+ ******************************************************************************/
+
+#include "SystemScheduler.h"
+#include "Core/Log.h"
+#include "Core/Profiler.h"
+#include "Core/TaskSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+namespace MyEngine {
+
+namespace {
+
+/**
+ * @brief Shared state of one fork-join: items are claimed through an atomic cursor
+ *
+ * 工作线程上的任务可能在 fork-join 结束后才开始运行，此时只会发现没有剩余工作并退出，
+ * 因此状态以 shared_ptr 持有，而任务体（栈上对象）只在领取到工作时才被访问。
+ */
+struct ForkJoinState {
+    std::atomic<uint32_t> Next{0};
+    std::atomic<uint32_t> Done{0};
+    uint32_t Count = 0;
+    const std::function<void(uint32_t)>* Body = nullptr;
+};
+
+void DrainForkJoin(ForkJoinState& state) {
+    for (;;) {
+        const uint32_t item = state.Next.fetch_add(1, std::memory_order_relaxed);
+        if (item >= state.Count) {
+            return;
+        }
+        (*state.Body)(item);
+        state.Done.fetch_add(1, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief Run body(i) for i in [0, count) on the caller plus up to (count - 1) workers
+ */
+void ForkJoin(uint32_t count, const std::function<void(uint32_t)>& body) {
+    const uint32_t workers = TaskSystem::GetWorkerCount();
+    if (count <= 1 || workers == 0) {
+        for (uint32_t i = 0; i < count; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    auto state = std::make_shared<ForkJoinState>();
+    state->Count = count;
+    state->Body = &body;
+
+    const uint32_t helpers = std::min(workers, count - 1);
+    for (uint32_t i = 0; i < helpers; ++i) {
+        TaskSystem::Schedule([state]() { DrainForkJoin(*state); }, TaskPriority::High);
+    }
+
+    DrainForkJoin(*state);
+    while (state->Done.load(std::memory_order_acquire) < count) {
+        std::this_thread::yield();
+    }
+}
+
+} // anonymous namespace
+
+void SystemScheduler::AddSystem(std::unique_ptr<System> system) {
+    if (!system) {
+        return;
+    }
+    system->m_Commands = &m_Commands;
+    m_Systems.push_back(std::move(system));
+    m_Dirty = true;
+}
+
+void SystemScheduler::RemoveSystem(System* system) {
+    auto it = std::find_if(m_Systems.begin(), m_Systems.end(),
+        [system](const std::unique_ptr<System>& entry) { return entry.get() == system; });
+    if (it == m_Systems.end()) {
+        ENGINE_WARN("SystemScheduler: RemoveSystem called with unknown system");
+        return;
+    }
+    m_Systems.erase(it);
+    m_Dirty = true;
+}
+
+void SystemScheduler::Clear() {
+    m_Systems.clear();
+    m_Dirty = true;
+}
+
+const std::vector<std::vector<uint32_t>>& SystemScheduler::GetStages() {
+    if (m_Dirty) {
+        RebuildSchedule();
+    }
+    return m_Stages;
+}
+
+const std::vector<SystemScheduler::SystemInfo>& SystemScheduler::GetSystemInfos() {
+    if (m_Dirty) {
+        RebuildSchedule();
+    }
+    return m_Infos;
+}
+
+void SystemScheduler::RebuildSchedule() {
+    PROFILE_FUNCTION();
+    const uint32_t count = static_cast<uint32_t>(m_Systems.size());
+
+    m_Infos.assign(count, SystemInfo());
+    m_Stages.clear();
+
+    // Stage(i) = 1 + max Stage(j) over earlier systems j that conflict with i
+    for (uint32_t i = 0; i < count; ++i) {
+        SystemInfo& info = m_Infos[i];
+        info.Name = m_Systems[i]->GetName();
+
+        const SystemAccess& access = m_Systems[i]->GetAccess();
+        for (uint32_t j = 0; j < i; ++j) {
+            if (access.ConflictsWith(m_Systems[j]->GetAccess())) {
+                info.Conflicts.push_back(j);
+                info.Stage = std::max(info.Stage, m_Infos[j].Stage + 1);
+            }
+        }
+
+        if (info.Stage >= m_Stages.size()) {
+            m_Stages.resize(info.Stage + 1);
+        }
+        m_Stages[info.Stage].push_back(i);
+    }
+
+    m_Dirty = false;
+}
+
+void SystemScheduler::Update(Registry& registry, float deltaTime) {
+    PROFILE_FUNCTION();
+    if (m_Dirty) {
+        RebuildSchedule();
+    }
+
+    // Each stage runs at a fresh change tick, and its deferred commands at another one, so
+    // every change is newer than the last-run tick of each system that has not seen it yet
+    if (!m_Parallel) {
+        for (uint32_t i = 0; i < m_Systems.size(); ++i) {
+            const uint32_t tick = registry.AdvanceChangeTick();
+            RunSystem(i, registry, deltaTime);
+            m_Systems[i]->m_LastRunTick = tick;
+            registry.AdvanceChangeTick();
+            m_Commands.Playback(registry);
+        }
+    } else {
+        for (const auto& stage : m_Stages) {
+            const uint32_t tick = registry.AdvanceChangeTick();
+            RunStage(stage, registry, deltaTime);
+            for (uint32_t index : stage) {
+                m_Systems[index]->m_LastRunTick = tick;
+            }
+            // Sync point: structural changes become visible to the next stage
+            registry.AdvanceChangeTick();
+            m_Commands.Playback(registry);
+        }
+    }
+
+    // Removal records every system has already seen can go
+    uint32_t oldest = UINT32_MAX;
+    for (const auto& system : m_Systems) {
+        oldest = std::min(oldest, system->m_LastRunTick);
+    }
+    if (!m_Systems.empty()) {
+        registry.TrimRemovals(oldest);
+    }
+}
+
+void SystemScheduler::RunStage(const std::vector<uint32_t>& stage, Registry& registry, float deltaTime) {
+    // Main-thread systems run on the caller first; the rest are shared with workers
+    std::vector<uint32_t> parallel;
+    parallel.reserve(stage.size());
+    Signature writes;
+    for (uint32_t index : stage) {
+        if (m_Systems[index]->GetAccess().MainThreadOnly) {
+            RunSystem(index, registry, deltaTime);
+        } else {
+            parallel.push_back(index);
+            writes |= m_Systems[index]->GetAccess().Writes;
+        }
+    }
+
+    if (parallel.size() <= 1) {
+        for (uint32_t index : parallel) {
+            RunSystem(index, registry, deltaTime);
+        }
+        return;
+    }
+
+    // Snapshot pools the stage writes are copied out here, on the calling thread
+    registry.BeginParallelAccess(writes);
+    ForkJoin(static_cast<uint32_t>(parallel.size()), [&](uint32_t i) {
+        RunSystem(parallel[i], registry, deltaTime);
+    });
+    registry.EndParallelAccess();
+}
+
+void SystemScheduler::RunSystem(uint32_t index, Registry& registry, float deltaTime) {
+    System& system = *m_Systems[index];
+    PROFILE_SCOPE(m_Infos[index].Name);
+    CommandSortKey::Scope sortKey(static_cast<uint64_t>(index) << 32);
+
+    const auto start = std::chrono::steady_clock::now();
+    system.Update(registry, deltaTime);
+    const auto end = std::chrono::steady_clock::now();
+
+    m_Infos[index].LastTimeMs = std::chrono::duration<float, std::milli>(end - start).count();
+}
+
+std::string SystemScheduler::DescribeSchedule() {
+    if (m_Dirty) {
+        RebuildSchedule();
+    }
+
+    std::ostringstream out;
+    for (size_t s = 0; s < m_Stages.size(); ++s) {
+        out << "Stage " << s << ":";
+        for (uint32_t index : m_Stages[s]) {
+            const SystemInfo& info = m_Infos[index];
+            out << " " << info.Name;
+            if (m_Systems[index]->GetAccess().MainThreadOnly) {
+                out << "[main]";
+            }
+            out << " (" << info.LastTimeMs << " ms)";
+        }
+        out << "\n";
+    }
+
+    for (const SystemInfo& info : m_Infos) {
+        if (info.Conflicts.empty()) {
+            continue;
+        }
+        out << "  " << info.Name << " after:";
+        for (uint32_t other : info.Conflicts) {
+            out << " " << m_Infos[other].Name;
+        }
+        out << "\n";
+    }
+    return out.str();
+}
+
+void SystemScheduler::LogSchedule() {
+    GetStages();
+    ENGINE_INFO("SystemScheduler: {} systems in {} stages", m_Systems.size(), m_Stages.size());
+    std::istringstream lines(DescribeSchedule());
+    std::string line;
+    while (std::getline(lines, line)) {
+        ENGINE_INFO("  {}", line);
+    }
+}
+
+void SystemScheduler::ParallelRange(uint32_t count, uint32_t batchSize,
+                                    const std::function<void(uint32_t, uint32_t)>& func) {
+    if (count == 0) {
+        return;
+    }
+
+    // Commands recorded by a batch are ordered by its start index, whichever thread runs it
+    const uint64_t baseKey = CommandSortKey::Get() & 0xFFFFFFFF00000000ull;
+
+    const uint32_t workers = TaskSystem::GetWorkerCount();
+    batchSize = std::max(1u, batchSize);
+    if (workers == 0 || count <= batchSize) {
+        CommandSortKey::Scope sortKey(baseKey);
+        func(0, count);
+        return;
+    }
+
+    // At most a few batches per thread: enough for load balancing, little scheduling overhead
+    const uint32_t maxBatches = (workers + 1) * 4;
+    const uint32_t batches = std::min(maxBatches, (count + batchSize - 1) / batchSize);
+    const uint32_t size = (count + batches - 1) / batches;
+
+    ForkJoin(batches, [&](uint32_t batch) {
+        const uint32_t begin = batch * size;
+        const uint32_t end = std::min(begin + size, count);
+        if (begin < end) {
+            CommandSortKey::Scope sortKey(baseKey | begin);
+            func(begin, end);
+        }
+    });
+}
+
+} // namespace MyEngine
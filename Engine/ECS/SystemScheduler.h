@@ -0,0 +1,125 @@
+/******************************************************************************
+ * File: SystemScheduler.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Parallel system scheduler driven by declared component access
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "System.h"
+
+namespace MyEngine {
+
+/**
+ * @brief 并行系统调度器
+ *
+ * 根据各系统声明的读/写组件（SystemAccess）构建冲突图，并把系统分成若干 Stage：
+ * - 两个系统冲突（写-写 或 读-写 重叠）时，后注册的系统排在更靠后的 Stage
+ * - 同一 Stage 内的系统互不冲突，通过 TaskSystem 并发执行
+ * - Stage 之间按顺序执行，冲突系统之间保持注册顺序
+ *
+ * 调度表只在系统增删时重建（脏标记），每帧只做执行。
+ * 每个 Stage 结束是一个同步点：系统通过命令缓冲录制的结构性修改在此按确定顺序回放。
+ * 调用 Update 的线程也参与执行（并负责 MainThreadOnly 系统），
+ * 因此在系统内部再嵌套 ParallelEach 不会因工作线程全部等待而死锁。
+ */
+class SystemScheduler {
+public:
+    /**
+     * @brief Per-system debug information
+     */
+    struct SystemInfo {
+        const char* Name = nullptr;
+        uint32_t Stage = 0;
+        float LastTimeMs = 0.0f;
+        std::vector<uint32_t> Conflicts;  // Indices of earlier systems this one must follow
+    };
+
+    SystemScheduler() = default;
+    ~SystemScheduler() = default;
+    SystemScheduler(const SystemScheduler&) = delete;
+    SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+    template<typename T, typename... Args>
+    T& AddSystem(Args&&... args) {
+        auto system = std::make_unique<T>(std::forward<Args>(args)...);
+        T& ref = *system;
+        AddSystem(std::move(system));
+        return ref;
+    }
+
+    void AddSystem(std::unique_ptr<System> system);
+    void RemoveSystem(System* system);
+    void Clear();
+
+    /**
+     * @brief Run every system once, stage by stage
+     */
+    void Update(Registry& registry, float deltaTime);
+
+    /**
+     * @brief Force serial execution in registration order (debugging aid)
+     */
+    void SetParallel(bool parallel) { m_Parallel = parallel; }
+    bool IsParallel() const { return m_Parallel; }
+
+    /**
+     * @brief Back command buffer blocks with the frame arena (Update must run once per frame)
+     */
+    void SetFrameAllocator(FrameAllocator* arena) { m_Commands.SetFrameAllocator(arena); }
+    EntityCommandBufferSet& GetCommandBuffers() { return m_Commands; }
+
+    size_t GetSystemCount() const { return m_Systems.size(); }
+    const std::vector<std::vector<uint32_t>>& GetStages();
+    const std::vector<SystemInfo>& GetSystemInfos();
+
+    /**
+     * @brief Human-readable schedule: one line per stage plus conflict reasons
+     */
+    std::string DescribeSchedule();
+    void LogSchedule();
+
+    /**
+     * @brief Split [0, count) into batches and run func(begin, end) on workers
+     *
+     * 调用线程同样领取批次，只等待已被领取的批次完成，可在系统内部安全调用。
+     */
+    static void ParallelRange(uint32_t count, uint32_t batchSize,
+                              const std::function<void(uint32_t, uint32_t)>& func);
+
+    /**
+     * @brief Parallel View<Ts...>::Each for large systems
+     *
+     * 按驱动池切块，每块至少 minBatch 个实体；回调中只能修改组件数据。
+     */
+    template<typename... Ts, typename Func>
+    static void ParallelEach(Registry& registry, Func&& func, uint32_t minBatch = 1024) {
+        View<Ts...> view = registry.GetView<Ts...>();
+        const uint32_t count = static_cast<uint32_t>(view.SizeHint());
+        ParallelRange(count, minBatch, [&view, &func](uint32_t begin, uint32_t end) {
+            view.EachRange(begin, end, func);
+        });
+    }
+
+private:
+    void RebuildSchedule();
+    void RunSystem(uint32_t index, Registry& registry, float deltaTime);
+    void RunStage(const std::vector<uint32_t>& stage, Registry& registry, float deltaTime);
+
+private:
+    std::vector<std::unique_ptr<System>> m_Systems;
+    std::vector<SystemInfo> m_Infos;
+    std::vector<std::vector<uint32_t>> m_Stages;
+    EntityCommandBufferSet m_Commands;
+    bool m_Dirty = true;
+    bool m_Parallel = true;
+};
+
+} // namespace MyEngine
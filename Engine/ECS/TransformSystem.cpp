@@ -0,0 +1,745 @@
+/******************************************************************************
+ * File: TransformSystem.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Transform system hierarchy maintenance and update
+ ******************************************************************************/
+
+#include "TransformSystem.h"
+#include "SystemScheduler.h"
+#include "Core/TaskSystem.h"
+#include "Math/MathSIMD.h"
+#include <atomic>
+#include <cstring>
+
+namespace MyEngine {
+
+void TransformSystem::RebuildHierarchyOrder() {
+    PROFILE_FUNCTION();
+    const auto& hierarchyEntities = m_Registry->Query<HierarchyComponent>();
+    const size_t total = hierarchyEntities.size();
+
+    LinkOrphans(hierarchyEntities);
+
+    std::fill(m_OrderIndex.begin(), m_OrderIndex.end(), NOT_IN_ORDER);
+    m_HierarchyOrdered.clear();
+    m_HierarchyOrdered.reserve(total);
+
+    // Depth-first from every root; links (depth, parent, prevSibling, lastChild) are
+    // repaired on the way, writing only when a value actually differs
+    std::vector<EntityID>& stack = m_Scratch;
+    for (EntityID root : hierarchyEntities) {
+        const auto& rootNode = m_Registry->GetComponent<const HierarchyComponent>(root);
+        if (HasHierarchy(rootNode.parent)) {
+            continue;
+        }
+        if (rootNode.parent != 0 || rootNode.depth != 0 || rootNode.prevSibling != 0 || rootNode.nextSibling != 0) {
+            auto& node = m_Registry->GetComponent<HierarchyComponent>(root);
+            node.parent = node.prevSibling = node.nextSibling = 0;
+            node.depth = 0;
+        }
+
+        stack.clear();
+        stack.push_back(root);
+        while (!stack.empty()) {
+            const EntityID entity = stack.back();
+            stack.pop_back();
+            if (FindSlot(entity) != NOT_IN_ORDER) {
+                continue;  // Corrupted links reached it twice
+            }
+            SetSlot(entity, static_cast<uint32_t>(m_HierarchyOrdered.size()));
+            m_HierarchyOrdered.push_back(entity);
+
+            const auto& node = m_Registry->GetComponent<const HierarchyComponent>(entity);
+            const uint32_t childDepth = node.depth + 1;
+            const size_t firstPushed = stack.size();
+            EntityID previous = 0;
+            for (EntityID child = node.firstChild; HasHierarchy(child) && FindSlot(child) == NOT_IN_ORDER &&
+                 stack.size() - firstPushed < total;) {
+                const auto& childNode = m_Registry->GetComponent<const HierarchyComponent>(child);
+                if (childNode.parent != entity || childNode.depth != childDepth || childNode.prevSibling != previous) {
+                    auto& writable = m_Registry->GetComponent<HierarchyComponent>(child);
+                    writable.parent = entity;
+                    writable.depth = childDepth;
+                    writable.prevSibling = previous;
+                }
+                stack.push_back(child);
+                previous = child;
+                child = childNode.nextSibling;
+            }
+            if (node.lastChild != previous) {
+                m_Registry->GetComponent<HierarchyComponent>(entity).lastChild = previous;
+            }
+            // Children were pushed in sibling order; pop them in the same order
+            std::reverse(stack.begin() + firstPushed, stack.end());
+        }
+    }
+
+    // Subtree sizes: children follow their parent, so accumulate back to front
+    m_SubtreeSizes.assign(m_HierarchyOrdered.size(), 1);
+    for (size_t i = m_HierarchyOrdered.size(); i-- > 0;) {
+        const EntityID parent = m_Registry->GetComponent<const HierarchyComponent>(m_HierarchyOrdered[i]).parent;
+        if (parent != 0) {
+            m_SubtreeSizes[FindSlot(parent)] += m_SubtreeSizes[i];
+        }
+    }
+
+    if (m_HierarchyOrdered.size() != total) {
+        ENGINE_WARN("TransformSystem: {} hierarchy entities unreachable from a root (cyclic links?)",
+                    total - m_HierarchyOrdered.size());
+    }
+    m_OrderDirty = false;
+    m_LayoutChanged = true;
+    ENGINE_TRACE("TransformSystem: Rebuilt hierarchy order ({} entities)", m_HierarchyOrdered.size());
+}
+
+void TransformSystem::LinkOrphans(const std::vector<EntityID>& hierarchyEntities) {
+    const size_t total = hierarchyEntities.size();
+    std::vector<uint8_t> listed;
+    auto isListed = [&listed](EntityID entity) {
+        const uint32_t index = GetEntityIndex(entity);
+        return index < listed.size() && listed[index] != 0;
+    };
+
+    // Mark every node reachable through some parent's child list; the true last child
+    // becomes lastChild so the appends below are O(1)
+    for (EntityID parent : hierarchyEntities) {
+        const auto& parentNode = m_Registry->GetComponent<const HierarchyComponent>(parent);
+        EntityID last = 0;
+        size_t steps = 0;
+        for (EntityID child = parentNode.firstChild; HasHierarchy(child) && !isListed(child) && steps++ < total;
+             child = m_Registry->GetComponent<const HierarchyComponent>(child).nextSibling) {
+            const uint32_t index = GetEntityIndex(child);
+            if (index >= listed.size()) {
+                listed.resize(static_cast<size_t>(index) + 1, 0);
+            }
+            listed[index] = 1;
+            last = child;
+        }
+        if (parentNode.lastChild != last) {
+            m_Registry->GetComponent<HierarchyComponent>(parent).lastChild = last;
+        }
+    }
+
+    uint32_t linked = 0;
+    for (EntityID entity : hierarchyEntities) {
+        const EntityID parent = m_Registry->GetComponent<const HierarchyComponent>(entity).parent;
+        if (parent != 0 && parent != entity && HasHierarchy(parent) && !isListed(entity)) {
+            LinkLast(entity, parent);
+            linked++;
+        }
+    }
+    if (linked > 0) {
+        ENGINE_TRACE("TransformSystem: linked {} nodes that only named their parent", linked);
+    }
+}
+
+void TransformSystem::FlushHierarchyChanges() {
+    // Hierarchy entities created or destroyed outside this system also need a re-layout
+    if (m_OrderDirty || m_Registry->Query<HierarchyComponent>().size() != m_HierarchyOrdered.size()) {
+        RebuildHierarchyOrder();
+    }
+    m_EditsThisFrame = 0;
+}
+
+void TransformSystem::Update() {
+    PROFILE_SCOPE("TransformSystem::Update");
+    FlushHierarchyChanges();
+    ComponentArray<TransformComponent>* transforms = m_Registry->GetComponentStorage<TransformComponent>();
+    if (!transforms) {
+        m_DirtyEntities.clear();
+        return;
+    }
+
+    // Hierarchy edits re-layout everything; adds / removes in the pool only patch the indices they moved
+    bool layoutChanged = m_LayoutChanged || transforms != m_TransformPool;
+    if (!layoutChanged && transforms->GetLayoutCursor() != m_TransformLayoutCursor) {
+        layoutChanged = !PatchPropagationData(*transforms);
+    }
+    if (layoutChanged) {
+        RebuildPropagationData(*transforms);
+    }
+
+    // A static scene (empty dirty list) costs nothing beyond the checks above
+    uint32_t updatedCount = 0;
+    if (layoutChanged || m_AllDirty) {
+        updatedCount = PropagateAll(*transforms);
+    } else if (!m_DirtyEntities.empty()) {
+        updatedCount = PropagateDirty(*transforms);
+    }
+    m_DirtyEntities.clear();
+    m_AllDirty = false;
+
+    // Debug logging (can be removed in production)
+    if (updatedCount > 0) {
+        ENGINE_TRACE("TransformSystem: Updated {} / {} transforms", updatedCount, transforms->Size());
+    }
+}
+
+uint32_t TransformSystem::PropagateAll(ComponentArray<TransformComponent>& transforms) {
+    // Spine first (parents before children), then independent subtrees and
+    // blocks of transforms without a hierarchy in parallel
+    uint32_t updatedCount = 0;
+    for (uint32_t slot : m_SpineSlots) {
+        updatedCount += PropagateRange(transforms, slot, slot + 1);
+    }
+    const uint32_t chunkCount = static_cast<uint32_t>(m_Chunks.size());
+    const uint32_t denseCount = static_cast<uint32_t>(m_DenseSlots.size());
+    const uint32_t looseBlocks = m_LooseCount > 0 ? (denseCount + PROPAGATION_GRAIN - 1) / PROPAGATION_GRAIN : 0;
+    std::atomic<uint32_t> chunkUpdates{ 0 };
+    SystemScheduler::ParallelRange(chunkCount + looseBlocks, 1,
+        [this, &transforms, chunkCount, denseCount, &chunkUpdates](uint32_t begin, uint32_t end) {
+            uint32_t updated = 0;
+            for (uint32_t task = begin; task < end; ++task) {
+                if (task < chunkCount) {
+                    updated += PropagateRange(transforms, m_Chunks[task].First, m_Chunks[task].Last);
+                } else {
+                    const uint32_t first = (task - chunkCount) * PROPAGATION_GRAIN;
+                    const uint32_t last = std::min(first + PROPAGATION_GRAIN, denseCount);
+                    for (uint32_t index = first; index < last; ++index) {
+                        if (m_DenseSlots[index] == NOT_IN_ORDER) {
+                            UpdateLoose(transforms, index);
+                            updated++;
+                        }
+                    }
+                }
+            }
+            chunkUpdates.fetch_add(updated, std::memory_order_relaxed);
+        });
+    return updatedCount + chunkUpdates.load(std::memory_order_relaxed);
+}
+
+uint32_t TransformSystem::PropagateDirty(ComponentArray<TransformComponent>& transforms) {
+    PROFILE_FUNCTION();
+    // A partial pass pays two random lookups per dirty entity (one to two nodes' matrix work)
+    // before it knows how much the subtrees cover. Long lists go straight to the full pass, and so
+    // do lists as long as one whose lookups plus subtrees already cost more than the full pass
+    // (random parents: 10% dirty covers nearly everything); that limit is re-probed periodically
+    const size_t dirtyCount = m_DirtyEntities.size();
+    if (dirtyCount * 8 > transforms.Size()) {
+        return PropagateAll(transforms);
+    }
+    if (dirtyCount >= m_CoveringDirtyCount) {
+        if (++m_CoveringSkips < COVERAGE_REPROBE) {
+            return PropagateAll(transforms);
+        }
+        m_CoveringDirtyCount = NOT_IN_ORDER;
+        m_CoveringSkips = 0;
+    }
+
+    uint32_t updatedCount = 0;
+    m_DirtySlots.clear();
+    for (EntityID entity : m_DirtyEntities) {
+        const uint32_t slot = FindSlot(entity);
+        if (slot != NOT_IN_ORDER) {
+            m_DirtySlots.push_back(slot);
+            continue;
+        }
+        const uint32_t index = transforms.IndexOf(entity);
+        if (index != SparseSet::NULL_INDEX) {
+            UpdateLoose(transforms, index);
+            updatedCount++;
+        }
+    }
+
+    // Hierarchy order: a dirty node's subtree [slot, slot + size) swallows dirty descendants.
+    // Short lists are sorted; long ones are flagged per slot and collected by one byte scan,
+    // so finding the ranges never approaches the cost of the matrix work
+    const uint32_t count = static_cast<uint32_t>(m_HierarchyOrdered.size());
+    m_DirtyRanges.clear();
+    size_t affected = 0;
+    if (m_DirtySlots.size() * 256 < count) {
+        std::sort(m_DirtySlots.begin(), m_DirtySlots.end());
+        uint32_t covered = 0;
+        for (uint32_t slot : m_DirtySlots) {
+            if (slot < covered) {
+                continue;
+            }
+            covered = slot + m_SubtreeSizes[slot];
+            m_DirtyRanges.push_back({ slot, covered });
+            affected += m_SubtreeSizes[slot];
+        }
+    } else {
+        m_DirtyFlags.resize(count, 0);
+        for (uint32_t slot : m_DirtySlots) {
+            m_DirtyFlags[slot] = 1;
+        }
+        uint8_t* flags = m_DirtyFlags.data();
+        for (uint32_t slot = 0; slot < count;) {
+            const void* next = std::memchr(flags + slot, 1, count - slot);
+            if (!next) {
+                break;
+            }
+            slot = static_cast<uint32_t>(static_cast<const uint8_t*>(next) - flags);
+            const uint32_t last = slot + m_SubtreeSizes[slot];
+            std::memset(flags + slot, 0, last - slot);
+            m_DirtyRanges.push_back({ slot, last });
+            affected += last - slot;
+            slot = last;
+        }
+    }
+
+    if (affected + dirtyCount > count) {
+        m_CoveringDirtyCount = std::min(m_CoveringDirtyCount, static_cast<uint32_t>(dirtyCount));
+    }
+
+    // Most of the scene moved (e.g. a root): with workers the partitioned full pass splits the
+    // work evenly; serially the ranges are never more work than the full pass
+    if (affected * 2 > count && affected > PROPAGATION_GRAIN && TaskSystem::GetWorkerCount() > 0) {
+        return PropagateAll(transforms);
+    }
+
+    // Disjoint subtrees whose parents are clean: independent of each other
+    if (affected < PROPAGATION_GRAIN) {
+        for (const PropagationChunk& range : m_DirtyRanges) {
+            updatedCount += PropagateRange(transforms, range.First, range.Last);
+        }
+        return updatedCount;
+    }
+    std::atomic<uint32_t> rangeUpdates{ 0 };
+    SystemScheduler::ParallelRange(static_cast<uint32_t>(m_DirtyRanges.size()), 1,
+        [this, &transforms, &rangeUpdates](uint32_t begin, uint32_t end) {
+            uint32_t updated = 0;
+            for (uint32_t i = begin; i < end; ++i) {
+                updated += PropagateRange(transforms, m_DirtyRanges[i].First, m_DirtyRanges[i].Last);
+            }
+            rangeUpdates.fetch_add(updated, std::memory_order_relaxed);
+        });
+    return updatedCount + rangeUpdates.load(std::memory_order_relaxed);
+}
+
+void TransformSystem::RebuildPropagationData(ComponentArray<TransformComponent>& transforms) {
+    PROFILE_FUNCTION();
+    const uint32_t count = static_cast<uint32_t>(m_HierarchyOrdered.size());
+    m_WorldMatrices.resize(count);
+    m_ParentSlots.resize(count);
+    m_TransformIndices.resize(count);
+
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        const EntityID entity = m_HierarchyOrdered[slot];
+        const EntityID parent = m_Registry->GetComponent<const HierarchyComponent>(entity).parent;
+        m_ParentSlots[slot] = parent != 0 ? FindSlot(parent) : NOT_IN_ORDER;
+        const uint32_t index = transforms.IndexOf(entity);
+        m_TransformIndices[slot] = index != SparseSet::NULL_INDEX ? index : NOT_IN_ORDER;
+    }
+
+    // Nodes whose subtree exceeds the grain form the spine; everything else is whole
+    // small subtrees, merged into contiguous chunks of at least the grain
+    m_SpineSlots.clear();
+    m_Chunks.clear();
+    uint32_t chunkFirst = NOT_IN_ORDER;
+    for (uint32_t slot = 0; slot < count;) {
+        if (m_SubtreeSizes[slot] <= PROPAGATION_GRAIN) {
+            if (chunkFirst == NOT_IN_ORDER) {
+                chunkFirst = slot;
+            }
+            slot += m_SubtreeSizes[slot];
+            if (slot - chunkFirst >= PROPAGATION_GRAIN) {
+                m_Chunks.push_back({ chunkFirst, slot });
+                chunkFirst = NOT_IN_ORDER;
+            }
+        } else {
+            if (chunkFirst != NOT_IN_ORDER) {
+                m_Chunks.push_back({ chunkFirst, slot });
+                chunkFirst = NOT_IN_ORDER;
+            }
+            m_SpineSlots.push_back(slot);
+            ++slot;
+        }
+    }
+    if (chunkFirst != NOT_IN_ORDER) {
+        m_Chunks.push_back({ chunkFirst, count });
+    }
+
+    // Transforms without a HierarchyComponent are roots of their own
+    m_DenseSlots.assign(transforms.Size(), NOT_IN_ORDER);
+    m_LooseCount = static_cast<uint32_t>(transforms.Size());
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        if (m_TransformIndices[slot] != NOT_IN_ORDER) {
+            m_DenseSlots[m_TransformIndices[slot]] = slot;
+            m_LooseCount--;
+        }
+    }
+
+    // Later adds / removes are patched from the pool's layout log
+    transforms.SetTrackLayout(true);
+    m_CoveringDirtyCount = NOT_IN_ORDER;
+    m_TransformPool = &transforms;
+    m_TransformLayoutCursor = transforms.GetLayoutCursor();
+    m_LayoutChanged = false;
+}
+
+bool TransformSystem::PatchPropagationData(ComponentArray<TransformComponent>& transforms) {
+    PROFILE_FUNCTION();
+    const uint32_t* first = nullptr;
+    const uint32_t* last = nullptr;
+    if (!transforms.GetLayoutChanges(m_TransformLayoutCursor, first, last) ||
+        static_cast<size_t>(last - first) * 4 > transforms.Size()) {
+        return false;
+    }
+
+    // Drop the old mapping of every index whose occupant changed; slots that lose it are
+    // marked PATCH_PENDING until the new occupants are mapped
+    m_PatchedSlots.clear();
+    for (const uint32_t* it = first; it != last; ++it) {
+        if (*it >= m_DenseSlots.size() || m_DenseSlots[*it] == PATCH_PENDING) {
+            continue;
+        }
+        const uint32_t slot = m_DenseSlots[*it];
+        if (slot == NOT_IN_ORDER) {
+            m_LooseCount--;
+        } else {
+            m_TransformIndices[slot] = PATCH_PENDING;
+            m_PatchedSlots.push_back(slot);
+        }
+        m_DenseSlots[*it] = PATCH_PENDING;
+    }
+    m_DenseSlots.resize(transforms.Size(), PATCH_PENDING);
+
+    // Map the current occupants. A component that only moved still holds the world matrix
+    // of its slot; anything else (new, or re-added after a removal) is queued as dirty
+    for (const uint32_t* it = first; it != last; ++it) {
+        const uint32_t index = *it;
+        if (index >= m_DenseSlots.size() || m_DenseSlots[index] != PATCH_PENDING) {
+            continue;
+        }
+        const EntityID entity = transforms.GetEntity(index);
+        const TransformComponent& transform = transforms.At(index);
+        const uint32_t slot = FindSlot(entity);
+        m_DenseSlots[index] = slot;
+        if (slot == NOT_IN_ORDER) {
+            m_LooseCount++;
+            if (transform.worldVersion != transform.localVersion ||
+                std::memcmp(&transform.worldMatrix, &transform.localMatrix, sizeof(Mat3x4)) != 0) {
+                m_DirtyEntities.push_back(entity);
+            }
+            continue;
+        }
+        if (m_TransformIndices[slot] != PATCH_PENDING || transform.worldVersion != transform.localVersion ||
+            std::memcmp(&transform.worldMatrix, &m_WorldMatrices[slot], sizeof(Mat3x4)) != 0) {
+            m_DirtyEntities.push_back(entity);
+        }
+        m_TransformIndices[slot] = index;
+    }
+
+    // Nodes that lost their TransformComponent now pass their parent's matrix through
+    for (uint32_t slot : m_PatchedSlots) {
+        if (m_TransformIndices[slot] == PATCH_PENDING) {
+            m_TransformIndices[slot] = NOT_IN_ORDER;
+            m_DirtyEntities.push_back(m_HierarchyOrdered[slot]);
+        }
+    }
+
+    m_TransformLayoutCursor = transforms.GetLayoutCursor();
+    return true;
+}
+
+uint32_t TransformSystem::PropagateRange(ComponentArray<TransformComponent>& transforms,
+                                         uint32_t first, uint32_t last) {
+    uint32_t updated = 0;
+    for (uint32_t slot = first; slot < last; ++slot) {
+        const uint32_t parent = m_ParentSlots[slot];
+        const uint32_t index = m_TransformIndices[slot];
+
+        // Without a TransformComponent the node passes its parent's matrix through
+        if (index == NOT_IN_ORDER) {
+            m_WorldMatrices[slot] = parent != NOT_IN_ORDER ? m_WorldMatrices[parent] : Mat3x4();
+            continue;
+        }
+
+        TransformComponent& transform = transforms.At(index);
+        Mat3x4& world = m_WorldMatrices[slot];
+        if (parent == NOT_IN_ORDER) {
+            world = transform.localMatrix;
+            transform.parentVersion = 0;
+        } else {
+            SIMD::MulAffine(m_WorldMatrices[parent], transform.localMatrix, world);
+            const uint32_t parentIndex = m_TransformIndices[parent];
+            transform.parentVersion = parentIndex != NOT_IN_ORDER ? transforms.At(parentIndex).worldVersion : 0;
+        }
+        transform.worldMatrix = world;
+        transform.worldVersion = transform.localVersion;
+        transforms.MarkChangedAt(index);
+        updated++;
+    }
+    return updated;
+}
+
+void TransformSystem::UpdateLoose(ComponentArray<TransformComponent>& transforms, uint32_t index) {
+    TransformComponent& transform = transforms.At(index);
+    transform.worldMatrix = transform.localMatrix;
+    transform.worldVersion = transform.localVersion;
+    transform.parentVersion = 0;
+    transforms.MarkChangedAt(index);
+}
+
+void TransformSystem::SetParent(EntityID entityID, EntityID parentID) {
+    if (!HasHierarchy(entityID)) {
+        ENGINE_WARN("TransformSystem: entity {} has no HierarchyComponent", entityID);
+        return;
+    }
+    if (parentID != 0 && !HasHierarchy(parentID)) {
+        ENGINE_WARN("TransformSystem: parent {} has no HierarchyComponent", parentID);
+        return;
+    }
+    for (EntityID ancestor = parentID; HasHierarchy(ancestor);
+         ancestor = m_Registry->GetComponent<const HierarchyComponent>(ancestor).parent) {
+        if (ancestor == entityID) {
+            ENGINE_WARN("TransformSystem: cannot parent {} to its own descendant {}", entityID, parentID);
+            return;
+        }
+    }
+
+    // Past the per-frame budget the order is rebuilt once by the next Update instead
+    if (!m_OrderDirty && ++m_EditsThisFrame > INCREMENTAL_EDIT_BUDGET) {
+        MarkOrderDirty();
+    }
+    m_LayoutChanged = true;
+
+    uint32_t slot = NOT_IN_ORDER;
+    uint32_t count = 0;
+    uint32_t target = static_cast<uint32_t>(m_HierarchyOrdered.size());
+    if (!m_OrderDirty) {
+        slot = FindSlot(entityID);
+        count = slot != NOT_IN_ORDER ? m_SubtreeSizes[slot] : 0;
+        if (parentID != 0) {
+            // End of the new parent's range (taken before anything moves)
+            const uint32_t parentSlot = FindSlot(parentID);
+            if (parentSlot == NOT_IN_ORDER) {
+                MarkOrderDirty();
+            } else {
+                target = parentSlot + m_SubtreeSizes[parentSlot];
+            }
+        }
+    }
+    if (slot != NOT_IN_ORDER && !m_OrderDirty) {
+        AdjustAncestorSizes(m_Registry->GetComponent<const HierarchyComponent>(entityID).parent,
+                            -static_cast<int64_t>(count));
+    }
+
+    Unlink(entityID);
+    LinkLast(entityID, parentID);
+
+    const uint32_t depth = parentID != 0 ? m_Registry->GetComponent<const HierarchyComponent>(parentID).depth + 1 : 0;
+    const int64_t depthDelta = static_cast<int64_t>(depth) -
+                               m_Registry->GetComponent<const HierarchyComponent>(entityID).depth;
+
+    if (m_OrderDirty) {
+        return;  // Depths are repaired by the rebuild
+    }
+
+    if (slot != NOT_IN_ORDER) {
+        // Subtree move: shift depths, then rotate the block to the end of the parent's range
+        if (depthDelta != 0) {
+            for (uint32_t i = slot; i < slot + count; ++i) {
+                auto& node = m_Registry->GetComponent<HierarchyComponent>(m_HierarchyOrdered[i]);
+                node.depth = static_cast<uint32_t>(node.depth + depthDelta);
+            }
+        }
+        if (target > slot + count) {
+            std::rotate(m_HierarchyOrdered.begin() + slot, m_HierarchyOrdered.begin() + slot + count,
+                        m_HierarchyOrdered.begin() + target);
+            std::rotate(m_SubtreeSizes.begin() + slot, m_SubtreeSizes.begin() + slot + count,
+                        m_SubtreeSizes.begin() + target);
+            ReindexSlots(slot, target);
+        } else if (target < slot) {
+            std::rotate(m_HierarchyOrdered.begin() + target, m_HierarchyOrdered.begin() + slot,
+                        m_HierarchyOrdered.begin() + slot + count);
+            std::rotate(m_SubtreeSizes.begin() + target, m_SubtreeSizes.begin() + slot,
+                        m_SubtreeSizes.begin() + slot + count);
+            ReindexSlots(target, slot + count);
+        }
+        AdjustAncestorSizes(parentID, count);
+        return;
+    }
+
+    // New to the order: insert the entity's whole (linked) subtree as one block
+    CollectSubtree(entityID, m_Scratch);
+    for (EntityID entity : m_Scratch) {
+        if (FindSlot(entity) != NOT_IN_ORDER) {
+            MarkOrderDirty();  // Part of it is already placed elsewhere
+            return;
+        }
+    }
+    for (EntityID entity : m_Scratch) {
+        auto& node = m_Registry->GetComponent<HierarchyComponent>(entity);
+        node.depth = entity == entityID
+            ? depth : m_Registry->GetComponent<const HierarchyComponent>(node.parent).depth + 1;
+    }
+
+    const uint32_t blockSize = static_cast<uint32_t>(m_Scratch.size());
+    m_HierarchyOrdered.insert(m_HierarchyOrdered.begin() + target, m_Scratch.begin(), m_Scratch.end());
+    m_SubtreeSizes.insert(m_SubtreeSizes.begin() + target, blockSize, 1);
+    ReindexSlots(target, static_cast<uint32_t>(m_HierarchyOrdered.size()));
+    for (uint32_t i = target + blockSize; i-- > target + 1;) {
+        const EntityID parent = m_Registry->GetComponent<const HierarchyComponent>(m_HierarchyOrdered[i]).parent;
+        m_SubtreeSizes[FindSlot(parent)] += m_SubtreeSizes[i];
+    }
+    AdjustAncestorSizes(parentID, blockSize);
+}
+
+void TransformSystem::RemoveFromHierarchy(EntityID entityID) {
+    if (!HasHierarchy(entityID)) {
+        return;
+    }
+    if (!m_OrderDirty && ++m_EditsThisFrame > INCREMENTAL_EDIT_BUDGET) {
+        MarkOrderDirty();
+    }
+    m_LayoutChanged = true;
+
+    const uint32_t slot = m_OrderDirty ? NOT_IN_ORDER : FindSlot(entityID);
+    if (slot != NOT_IN_ORDER) {
+        const uint32_t count = m_SubtreeSizes[slot];
+        AdjustAncestorSizes(m_Registry->GetComponent<const HierarchyComponent>(entityID).parent,
+                            -static_cast<int64_t>(count));
+        for (uint32_t i = slot; i < slot + count; ++i) {
+            SetSlot(m_HierarchyOrdered[i], NOT_IN_ORDER);
+        }
+        m_HierarchyOrdered.erase(m_HierarchyOrdered.begin() + slot, m_HierarchyOrdered.begin() + slot + count);
+        m_SubtreeSizes.erase(m_SubtreeSizes.begin() + slot, m_SubtreeSizes.begin() + slot + count);
+        ReindexSlots(slot, static_cast<uint32_t>(m_HierarchyOrdered.size()));
+    }
+    Unlink(entityID);
+}
+
+bool TransformSystem::GetSubtreeRange(EntityID entityID, uint32_t& first, uint32_t& count) const {
+    const uint32_t slot = m_OrderDirty ? NOT_IN_ORDER : FindSlot(entityID);
+    if (slot == NOT_IN_ORDER) {
+        return false;
+    }
+    first = slot;
+    count = m_SubtreeSizes[slot];
+    return true;
+}
+
+bool TransformSystem::HasHierarchy(EntityID entityID) {
+    return entityID != 0 && m_Registry->IsValid(entityID) &&
+           m_Registry->GetSignature(entityID).test(m_Registry->GetComponentType<HierarchyComponent>());
+}
+
+uint32_t TransformSystem::FindSlot(EntityID entityID) const {
+    const uint32_t index = GetEntityIndex(entityID);
+    if (index >= m_OrderIndex.size()) {
+        return NOT_IN_ORDER;
+    }
+    const uint32_t slot = m_OrderIndex[index];
+    return slot < m_HierarchyOrdered.size() && m_HierarchyOrdered[slot] == entityID ? slot : NOT_IN_ORDER;
+}
+
+void TransformSystem::SetSlot(EntityID entityID, uint32_t slot) {
+    const uint32_t index = GetEntityIndex(entityID);
+    if (index >= m_OrderIndex.size()) {
+        m_OrderIndex.resize(static_cast<size_t>(index) + 1, NOT_IN_ORDER);
+    }
+    m_OrderIndex[index] = slot;
+}
+
+void TransformSystem::ReindexSlots(uint32_t first, uint32_t last) {
+    for (uint32_t slot = first; slot < last; ++slot) {
+        SetSlot(m_HierarchyOrdered[slot], slot);
+    }
+}
+
+void TransformSystem::Unlink(EntityID entityID) {
+    auto& node = m_Registry->GetComponent<HierarchyComponent>(entityID);
+    const EntityID parent = HasHierarchy(node.parent) ? node.parent : 0;
+
+    EntityID previous = HasHierarchy(node.prevSibling) ? node.prevSibling : 0;
+    if (previous == 0 && parent != 0) {
+        // Links written without prevSibling: find the predecessor the slow way
+        EntityID sibling = m_Registry->GetComponent<const HierarchyComponent>(parent).firstChild;
+        while (HasHierarchy(sibling) && sibling != entityID) {
+            const EntityID next = m_Registry->GetComponent<const HierarchyComponent>(sibling).nextSibling;
+            if (next == entityID) {
+                previous = sibling;
+                break;
+            }
+            sibling = next;
+        }
+    }
+
+    const EntityID next = HasHierarchy(node.nextSibling) ? node.nextSibling : 0;
+    if (previous != 0) {
+        m_Registry->GetComponent<HierarchyComponent>(previous).nextSibling = next;
+    } else if (parent != 0 && m_Registry->GetComponent<const HierarchyComponent>(parent).firstChild == entityID) {
+        m_Registry->GetComponent<HierarchyComponent>(parent).firstChild = next;
+    }
+    if (next != 0) {
+        m_Registry->GetComponent<HierarchyComponent>(next).prevSibling = previous;
+    } else if (parent != 0 && m_Registry->GetComponent<const HierarchyComponent>(parent).lastChild == entityID) {
+        m_Registry->GetComponent<HierarchyComponent>(parent).lastChild = previous;
+    }
+
+    node.parent = 0;
+    node.prevSibling = 0;
+    node.nextSibling = 0;
+}
+
+void TransformSystem::LinkLast(EntityID entityID, EntityID parentID) {
+    auto& node = m_Registry->GetComponent<HierarchyComponent>(entityID);
+    node.parent = parentID;
+    node.prevSibling = 0;
+    node.nextSibling = 0;
+    if (parentID == 0) {
+        return;
+    }
+
+    auto& parentNode = m_Registry->GetComponent<HierarchyComponent>(parentID);
+    EntityID last = HasHierarchy(parentNode.lastChild) ? parentNode.lastChild : 0;
+    if (last == 0 && HasHierarchy(parentNode.firstChild)) {
+        // Links written without lastChild
+        last = parentNode.firstChild;
+        EntityID next = m_Registry->GetComponent<const HierarchyComponent>(last).nextSibling;
+        while (HasHierarchy(next)) {
+            last = next;
+            next = m_Registry->GetComponent<const HierarchyComponent>(last).nextSibling;
+        }
+    }
+
+    if (last != 0) {
+        m_Registry->GetComponent<HierarchyComponent>(last).nextSibling = entityID;
+        node.prevSibling = last;
+    } else {
+        parentNode.firstChild = entityID;
+    }
+    parentNode.lastChild = entityID;
+}
+
+void TransformSystem::AdjustAncestorSizes(EntityID parentID, int64_t delta) {
+    for (EntityID ancestor = parentID; HasHierarchy(ancestor);
+         ancestor = m_Registry->GetComponent<const HierarchyComponent>(ancestor).parent) {
+        const uint32_t slot = FindSlot(ancestor);
+        if (slot == NOT_IN_ORDER) {
+            MarkOrderDirty();
+            return;
+        }
+        m_SubtreeSizes[slot] = static_cast<uint32_t>(m_SubtreeSizes[slot] + delta);
+    }
+}
+
+void TransformSystem::CollectSubtree(EntityID root, std::vector<EntityID>& out) {
+    out.clear();
+    const size_t limit = m_Registry->Query<HierarchyComponent>().size();
+
+    // Pre-order walk along the links: down to the first child, else to the next
+    // sibling of the nearest ancestor that has one
+    EntityID entity = root;
+    while (entity != 0 && out.size() < limit) {
+        out.push_back(entity);
+        EntityID next = m_Registry->GetComponent<const HierarchyComponent>(entity).firstChild;
+        if (!HasHierarchy(next)) {
+            next = 0;
+            for (EntityID up = entity; up != root && next == 0;) {
+                const auto& node = m_Registry->GetComponent<const HierarchyComponent>(up);
+                if (HasHierarchy(node.nextSibling)) {
+                    next = node.nextSibling;
+                } else {
+                    up = HasHierarchy(node.parent) ? node.parent : root;
+                }
+            }
+        }
+        entity = next;
+    }
+}
+
+} // namespace MyEngine
@@ -11,6 +11,7 @@
 #include "Registry.h"
 #include "Components.h"
 #include "Core/Log.h"
+#include "Core/Profiler.h"
 #include <vector>
 #include <algorithm>
 
@@ -18,131 +19,100 @@ namespace MyEngine {
 
 /**
  * @brief High-performance transform system with linear hierarchy traversal
- * 
+ *
  * Key features:
  * - Flattened tree structure (no recursion)
- * - Topological sorting for correct parent-before-child update order
- * - Version-based lazy evaluation (only update when needed)
+ * - Depth-first order: parents before children, every subtree a contiguous range
+ * - Incremental hierarchy edits (no re-sorting)
+ * - Dirty-list updates (a static scene costs nothing per frame)
  * - Cache-friendly linear iteration
  * - SIMD-friendly (future optimization)
+ *
+ * 层级编辑（AddToHierarchy / SetParent / RemoveFromHierarchy）立即更新
+ * HierarchyComponent 链接（O(1)）与子树 depth（O(子树)）。有序数组中每个子树占据
+ * 连续区间 [slot, slot + subtreeSize)：移动子树就是把这段区间旋转到新父节点区间末尾，
+ * 代价为子树大小加上被挪动的区间长度（memmove），不做排序。
+ * 一帧内编辑超过 INCREMENTAL_EDIT_BUDGET 次后停止逐次维护，
+ * 由下一次 Update 做一次线性重排（一次 DFS）。
+ * 在系统之外增删的层级实体（Prefab、编辑器等）也会在 Update 时触发一次线性重排。
+ *
+ * 传播：世界矩阵按有序数组存放（SoA，与 m_HierarchyOrdered 同序），并缓存父节点槽位与
+ * TransformComponent 的 Dense 下标，每帧不做稀疏查找。子树大于 PROPAGATION_GRAIN 的节点
+ * （靠近根的"主干"，数量很少）先串行计算；其余是若干完整的小子树，按连续区间分块并行
+ * （SystemScheduler::ParallelRange）。矩阵乘法使用 SIMD::MulAffine（3x4 仿射）。
+ * 没有 HierarchyComponent 的 Transform 视为独立根节点，世界矩阵 = 局部矩阵。
+ * 脏列表：局部变换的写入方通过 MarkDirty（SetLocalPosition 等与脚本绑定已自动调用）登记实体，
+ * Update 只重算这些节点所在的子树 [slot, slot + subtreeSize)，按层级顺序处理，被祖先子树覆盖的
+ * 脏节点自动合并；脏列表为空时除几次 O(1) 检查外不做任何事。层级变化时整体重算一次；
+ * TransformComponent 池的增删只按池的布局日志（SetTrackLayout）修补变化的 Dense 下标，
+ * 新增或失去 Transform 的节点按脏节点处理。
+ * 绕过 MarkDirty 直接改写 TransformComponent 的代码需要自己调用 MarkDirty（或 MarkAllDirty）。
+ * 更新后 worldVersion = localVersion。
  */
 class TransformSystem {
 public:
+    static constexpr uint32_t INCREMENTAL_EDIT_BUDGET = 64;
+    static constexpr uint32_t PROPAGATION_GRAIN = 2048;
+    static constexpr uint32_t COVERAGE_REPROBE = 64;
+
     TransformSystem(Registry* registry) : m_Registry(registry) {}
-    
-    /**
-     * @brief Rebuild hierarchy-ordered entity list
-     * Call this when hierarchy changes (parent/child relationships modified)
-     */
-    void RebuildHierarchyOrder() {
-        m_HierarchyOrdered.clear();
-        
-        // Get all entities with HierarchyComponent
-        auto hierarchyEntities = m_Registry->GetEntitiesWith<HierarchyComponent>();
-        
-        // Sort by depth (topological order: parents before children)
-        std::sort(hierarchyEntities.begin(), hierarchyEntities.end(),
-            [this](EntityID a, EntityID b) {
-                auto& ha = m_Registry->GetComponent<HierarchyComponent>(a);
-                auto& hb = m_Registry->GetComponent<HierarchyComponent>(b);
-                return ha.depth < hb.depth;
-            });
-        
-        m_HierarchyOrdered = std::move(hierarchyEntities);
-        
-        ENGINE_INFO("TransformSystem: Rebuilt hierarchy order ({} entities)", m_HierarchyOrdered.size());
-    }
-    
+
+    /**
+     * @brief Rebuild hierarchy-ordered entity list from the HierarchyComponent links
+     * One linear depth-first pass; also repairs depth / prevSibling / lastChild
+     */
+    void RebuildHierarchyOrder();
+
     /**
      * @brief Update all transforms in hierarchy order
-     * Uses version-based lazy evaluation - only updates when needed
-     */
-    void Update() {
-        if (m_HierarchyOrdered.empty()) {
-            return;
-        }
-        
-        uint32_t updatedCount = 0;
-        
-        // Linear traversal (no recursion!)
-        for (EntityID entityID : m_HierarchyOrdered) {
-            auto& hierarchy = m_Registry->GetComponent<HierarchyComponent>(entityID);
-            auto& transform = m_Registry->GetComponent<TransformComponent>(entityID);
-            
-            // Root entity (no parent)
-            if (hierarchy.IsRoot()) {
-                // Check if local transform changed
-                if (transform.worldVersion != transform.localVersion) {
-                    transform.worldMatrix = transform.localMatrix;
-                    transform.worldVersion++;
-                    updatedCount++;
-                }
-            }
-            // Child entity
-            else {
-                auto& parentTransform = m_Registry->GetComponent<TransformComponent>(hierarchy.parent);
-                
-                // Only update if needed (version-based check)
-                if (transform.NeedsUpdate(parentTransform.worldVersion)) {
-                    transform.worldMatrix = parentTransform.worldMatrix * transform.localMatrix;
-                    transform.parentVersion = parentTransform.worldVersion;
-                    transform.worldVersion++;
-                    updatedCount++;
-                }
-            }
-        }
-        
-        // Debug logging (can be removed in production)
-        if (updatedCount > 0) {
-            ENGINE_TRACE("TransformSystem: Updated {} / {} transforms", updatedCount, m_HierarchyOrdered.size());
-        }
-    }
-    
+     * Applies pending hierarchy fix-ups first, then uses version-based lazy evaluation
+     */
+    void Update();
+
     /**
      * @brief Add entity to hierarchy with optional parent
+     * An entity already in the hierarchy is moved (with its subtree) and becomes the last child
      */
     void AddToHierarchy(EntityID entityID, EntityID parentID = 0) {
-        auto& hierarchy = m_Registry->GetComponent<HierarchyComponent>(entityID);
-        hierarchy.parent = parentID;
-        
-        if (parentID != 0) {
-            // Update parent's child list
-            auto& parentHierarchy = m_Registry->GetComponent<HierarchyComponent>(parentID);
-            
-            // Add as first child (or sibling if parent already has children)
-            if (parentHierarchy.firstChild == 0) {
-                parentHierarchy.firstChild = entityID;
-            } else {
-                // Find last sibling
-                EntityID lastSibling = parentHierarchy.firstChild;
-                while (true) {
-                    auto& siblingHierarchy = m_Registry->GetComponent<HierarchyComponent>(lastSibling);
-                    if (siblingHierarchy.nextSibling == 0) {
-                        siblingHierarchy.nextSibling = entityID;
-                        break;
-                    }
-                    lastSibling = siblingHierarchy.nextSibling;
-                }
-            }
-            
-            // Calculate depth
-            auto& parentHierarchyRef = m_Registry->GetComponent<HierarchyComponent>(parentID);
-            hierarchy.depth = parentHierarchyRef.depth + 1;
-        } else {
-            hierarchy.depth = 0; // Root entity
-        }
-        
-        // Rebuild hierarchy order
-        RebuildHierarchyOrder();
+        SetParent(entityID, parentID);
     }
-    
+
+    /**
+     * @brief Reparent entity and its subtree (0 = make it a root)
+     */
+    void SetParent(EntityID entityID, EntityID parentID);
+
+    /**
+     * @brief Detach entity and drop its subtree from the update order
+     * Call before destroying the subtree; live entities rejoin as a root on the next rebuild
+     */
+    void RemoveFromHierarchy(EntityID entityID);
+
+    /**
+     * @brief Apply a deferred re-layout now instead of at the next Update
+     */
+    void FlushHierarchyChanges();
+
     /**
      * @brief Get world matrix for entity
      */
-    const Mat4& GetWorldMatrix(EntityID entityID) const {
-        return m_Registry->GetComponent<TransformComponent>(entityID).worldMatrix;
+    const Mat3x4& GetWorldMatrix(EntityID entityID) const {
+        return m_Registry->GetComponent<const TransformComponent>(entityID).worldMatrix;
     }
-    
+
+    /**
+     * @brief Queue entity's world matrix (and its subtree) for the next Update
+     * Call after writing TransformComponent local fields directly; main thread only
+     */
+    void MarkDirty(EntityID entityID) {
+        m_DirtyEntities.push_back(entityID);
+    }
+
+    /**
+     * @brief Recompute every world matrix on the next Update
+     */
+    void MarkAllDirty() { m_AllDirty = true; }
+
     /**
      * @brief Set local position (marks transform as dirty)
      */
@@ -150,8 +120,19 @@ public:
         auto& transform = m_Registry->GetComponent<TransformComponent>(entityID);
         transform.localPosition = position;
         transform.UpdateLocalMatrix();
+        MarkDirty(entityID);
+    }
+
+    /**
+     * @brief Set local rotation (marks transform as dirty)
+     */
+    void SetLocalRotation(EntityID entityID, const Quat& rotation) {
+        auto& transform = m_Registry->GetComponent<TransformComponent>(entityID);
+        transform.localRotation = rotation;
+        transform.UpdateLocalMatrix();
+        MarkDirty(entityID);
     }
-    
+
     /**
      * @brief Set local scale (marks transform as dirty)
      */
@@ -159,21 +140,132 @@ public:
         auto& transform = m_Registry->GetComponent<TransformComponent>(entityID);
         transform.localScale = scale;
         transform.UpdateLocalMatrix();
+        MarkDirty(entityID);
     }
-    
+
     /**
      * @brief Get hierarchy-ordered entity list (for debugging)
      */
     const std::vector<EntityID>& GetHierarchyOrdered() const {
         return m_HierarchyOrdered;
     }
-    
+
+    /**
+     * @brief Range of entity's subtree in GetHierarchyOrdered() (after pending fix-ups)
+     * @return false if the entity is not in the order
+     */
+    bool GetSubtreeRange(EntityID entityID, uint32_t& first, uint32_t& count) const;
+
+private:
+    static constexpr uint32_t NOT_IN_ORDER = ~0u;
+    static constexpr uint32_t PATCH_PENDING = ~0u - 1;  // Mapping dropped by PatchPropagationData, not yet re-added
+
+    bool HasHierarchy(EntityID entityID);
+    uint32_t FindSlot(EntityID entityID) const;
+    void SetSlot(EntityID entityID, uint32_t slot);
+    void ReindexSlots(uint32_t first, uint32_t last);
+
+    /**
+     * @brief Remove entity from its parent's child list (links only)
+     */
+    void Unlink(EntityID entityID);
+
+    /**
+     * @brief Append entity as the last child of parentID (links only)
+     */
+    void LinkLast(EntityID entityID, EntityID parentID);
+
+    /**
+     * @brief Append nodes that name a parent but are missing from its child list
+     * (e.g. AddComponent(entity, HierarchyComponent(parent)) without SetParent); also repairs lastChild
+     */
+    void LinkOrphans(const std::vector<EntityID>& hierarchyEntities);
+
+    /**
+     * @brief Add delta to the subtree size of parentID and all of its ancestors
+     */
+    void AdjustAncestorSizes(EntityID parentID, int64_t delta);
+
+    /**
+     * @brief Depth-first walk of entity's subtree following the links
+     */
+    void CollectSubtree(EntityID root, std::vector<EntityID>& out);
+
+    void MarkOrderDirty() { m_OrderDirty = true; }
+
+    /**
+     * @brief Refresh parent slots, transform indices and the parallel partition
+     */
+    void RebuildPropagationData(ComponentArray<TransformComponent>& transforms);
+
+    /**
+     * @brief Apply the transform pool's layout log to the cached dense indices
+     * @return false if the log is gone or too long; the caller rebuilds instead
+     */
+    bool PatchPropagationData(ComponentArray<TransformComponent>& transforms);
+
+    /**
+     * @brief Recompute every world matrix (spine, then chunks and loose transforms in parallel)
+     */
+    uint32_t PropagateAll(ComponentArray<TransformComponent>& transforms);
+
+    /**
+     * @brief Recompute the subtrees of the dirty list only
+     */
+    uint32_t PropagateDirty(ComponentArray<TransformComponent>& transforms);
+
+    /**
+     * @brief Recompute world matrices of slots [first, last); parents of first must be current
+     * @return Number of world matrices updated
+     */
+    uint32_t PropagateRange(ComponentArray<TransformComponent>& transforms, uint32_t first, uint32_t last);
+
+    /**
+     * @brief World = local for a transform outside the hierarchy (dense index)
+     */
+    void UpdateLoose(ComponentArray<TransformComponent>& transforms, uint32_t index);
+
 private:
     Registry* m_Registry;
-    
-    // Hierarchy-ordered entity list (topologically sorted)
-    // Parents always appear before their children
+
+    // Hierarchy-ordered entity list (depth-first)
+    // Parents always appear before their children; subtree of slot i is [i, i + m_SubtreeSizes[i])
     std::vector<EntityID> m_HierarchyOrdered;
+    std::vector<uint32_t> m_SubtreeSizes;
+    std::vector<uint32_t> m_OrderIndex;  // Entity index -> slot
+
+    bool m_OrderDirty = false;           // Needs a full re-layout
+    bool m_LayoutChanged = true;         // Order changed since the propagation data was built
+    uint32_t m_EditsThisFrame = 0;
+    std::vector<EntityID> m_Scratch;
+
+    // Propagation data, parallel to m_HierarchyOrdered
+    std::vector<Mat3x4> m_WorldMatrices;
+    std::vector<uint32_t> m_ParentSlots;       // NOT_IN_ORDER for roots
+    std::vector<uint32_t> m_TransformIndices;  // Dense index in the TransformComponent pool
+
+    // Parallel partition: spine slots run serially first, then whole-subtree chunks in parallel
+    struct PropagationChunk {
+        uint32_t First;
+        uint32_t Last;
+    };
+    std::vector<uint32_t> m_SpineSlots;
+    std::vector<PropagationChunk> m_Chunks;
+    std::vector<uint32_t> m_DenseSlots;        // Dense index -> slot; NOT_IN_ORDER = outside the hierarchy
+    uint32_t m_LooseCount = 0;                 // Transforms outside the hierarchy
+
+    // Dirty list (entities whose local transform changed since the last Update)
+    std::vector<EntityID> m_DirtyEntities;
+    bool m_AllDirty = false;
+    std::vector<uint32_t> m_DirtySlots;
+    std::vector<PropagationChunk> m_DirtyRanges;
+    std::vector<uint8_t> m_DirtyFlags;         // Per slot, all zero between updates
+    uint32_t m_CoveringDirtyCount = ~0u;       // Dirty lists this long take the full pass (see PropagateDirty)
+    uint32_t m_CoveringSkips = 0;
+
+    const ComponentArray<TransformComponent>* m_TransformPool = nullptr;
+    uint64_t m_TransformLayoutCursor = 0;
+    std::vector<uint32_t> m_PatchedSlots;
 };
 
 } // namespace MyEngine
@@ -11,8 +11,10 @@
 #include <imgui.h>
 #include <glad/gl.h>
 #include <cmath>
+#include <chrono>
 #include "Rendering/Renderer.h"
 #include "Rendering/Shader.h"
+#include "Rendering/OpenGL/GLStateCache.h"
 #include "Rendering/Pass/GeometryPass.h"
 #include "Rendering/Pass/SkyPass.h"
 #include "Rendering/Pass/WaterPass.h"
@@ -57,7 +59,7 @@ void EditorLayer::OnAttach() {
         layout (location = 0) in vec3 a_Position;
         layout (location = 1) in vec3 a_Normal;
         
-        uniform mat4 u_ViewProjection;
+        #include <FrameData>
         uniform mat4 u_Transform;
         
         out vec3 v_Normal;
@@ -80,7 +82,7 @@ void EditorLayer::OnAttach() {
         uniform vec3 u_LightPos;
         uniform vec3 u_LightColor;
         uniform vec3 u_ObjectColor;
-        uniform vec3 u_CameraPos;
+        #include <FrameData>
         
         void main() {
             // Ambient
@@ -179,9 +181,15 @@ void EditorLayer::OnDetach() {
 void EditorLayer::OnUpdate(float deltaTime) {
     // Update Lua scripts (only in play mode or if always updating)
     if (m_ScriptSystem && m_IsPlaying) {
+        m_ScriptSystem->SetTransformSystem(m_TransformSystem.get());
         m_ScriptSystem->Update(deltaTime);
     }
     
+    // World matrices for this frame's rendering
+    if (m_TransformSystem) {
+        m_TransformSystem->Update();
+    }
+    
     // Get viewport panel to check hover state
     ViewportPanel* viewportPanel = nullptr;
     if (m_Panels.size() >= 3) {
@@ -304,7 +312,14 @@ void EditorLayer::OnEvent(Event& event) {
 }
 
 void EditorLayer::SetActiveScene(Registry* registry) {
+    if (registry != m_ActiveRegistry) {
+        m_PlaySnapshot.Release();
+    }
     m_ActiveRegistry = registry;
+    m_TransformSystem = registry ? std::make_unique<TransformSystem>(registry) : nullptr;
+    if (m_TransformSystem) {
+        m_TransformSystem->RebuildHierarchyOrder();
+    }
     ENGINE_INFO("Active scene set");
     
     // Update SceneHierarchyPanel context
@@ -316,6 +331,9 @@ void EditorLayer::SetActiveScene(Registry* registry) {
     } else {
         ENGINE_WARN("Not enough panels to update SceneHierarchyPanel");
     }
+    if (m_Panels.size() >= 2) {
+        std::static_pointer_cast<PropertiesPanel>(m_Panels[1])->SetTransformSystem(m_TransformSystem.get());
+    }
     
     // Auto-create default pass entities at startup
     // TerrainPass - always visible by default
@@ -374,6 +392,7 @@ void EditorLayer::InitializePanels() {
     auto propertiesPanel = std::make_shared<PropertiesPanel>();
     auto viewportPanel = std::make_shared<ViewportPanel>(&m_EditorCamera);
     auto assetBrowserPanel = std::make_shared<AssetBrowserPanel>();
+    auto profilerPanel = std::make_shared<ProfilerPanel>();
     
     // Set up drag-and-drop callback for viewport
     viewportPanel->SetAssetDropCallback([this](const std::string& assetGUID, const Vec2& dropPos) {
@@ -385,6 +404,7 @@ void EditorLayer::InitializePanels() {
     m_Panels.push_back(propertiesPanel);
     m_Panels.push_back(viewportPanel);
     m_Panels.push_back(assetBrowserPanel);
+    m_Panels.push_back(profilerPanel);
     
     ENGINE_INFO("Created {} editor panels", m_Panels.size());
 }
@@ -412,6 +432,7 @@ void EditorLayer::RenderMenuBar() {
             bool sceneHierarchyOpen = m_Panels[0]->IsOpen();
             bool propertiesOpen = m_Panels[1]->IsOpen();
             bool viewportOpen = m_Panels[2]->IsOpen();
+            bool profilerOpen = m_Panels[4]->IsOpen();
             
             if (ImGui::MenuItem("Scene Hierarchy", nullptr, &sceneHierarchyOpen)) {
                 m_Panels[0]->SetOpen(sceneHierarchyOpen);
@@ -422,6 +443,9 @@ void EditorLayer::RenderMenuBar() {
             if (ImGui::MenuItem("Viewport", nullptr, &viewportOpen)) {
                 m_Panels[2]->SetOpen(viewportOpen);
             }
+            if (ImGui::MenuItem("Profiler", nullptr, &profilerOpen)) {
+                m_Panels[4]->SetOpen(profilerOpen);
+            }
             ImGui::Separator();
             if (ImGui::MenuItem("Use Scene Camera", nullptr, &m_UseSceneCamera)) {
                 if (m_UseSceneCamera) {
@@ -628,68 +652,72 @@ void EditorLayer::RenderViewport(ViewportPanel* viewport) {
     
     if (m_UseSceneCamera && m_ActiveRegistry) {
         // Use scene camera (MainCamera entity)
-        auto cameraEntities = m_ActiveRegistry->GetEntitiesWith<TagComponent, TransformComponent>();
-        bool foundCamera = false;
-        for (auto entityID : cameraEntities) {
-            Entity entity(entityID, m_ActiveRegistry);
-            auto& tag = entity.GetComponent<TagComponent>();
-            if (tag.Tag == "MainCamera") {
-                auto& transform = entity.GetComponent<TransformComponent>();
-                
-                // Ensure transform is up-to-date
-                if (transform.localVersion != transform.worldVersion) {
-                    transform.UpdateLocalMatrix();
+        // Read-only search: a mutable view would mark every visited Tag / Transform changed
+        EntityID cameraEntity = NULL_ENTITY;
+        m_ActiveRegistry->GetView<const TagComponent, const TransformComponent>().Each(
+            [&](EntityID entity, const TagComponent& tag, const TransformComponent&) {
+                if (tag.Tag != "MainCamera") {
+                    return true;
                 }
+                cameraEntity = entity;
+                return false;
+            });
+        
+        bool foundCamera = cameraEntity != NULL_ENTITY;
+        if (foundCamera) {
+            const auto& transform = m_ActiveRegistry->GetComponent<const TransformComponent>(cameraEntity);
+            
+            // Ensure transform is up-to-date (the only write, on the camera alone)
+            if (transform.localVersion != transform.worldVersion) {
+                m_ActiveRegistry->GetComponent<TransformComponent>(cameraEntity).UpdateLocalMatrix();
+            }
+            
+            cameraPos = transform.localPosition;
+            
+            // Apply rotation to camera basis vectors
+            // Quaternion rotation: v' = q * v * q^(-1)
+            // For unit quaternions: q^(-1) = conjugate(q)
+            Quat q = transform.localRotation;
+            
+            // Helper lambda to rotate a vector by quaternion
+            auto rotateVec = [](const Quat& q, const Vec3& v) -> Vec3 {
+                // q * v * q^(-1) where v is treated as quaternion (0, v)
+                float qx = q.x, qy = q.y, qz = q.z, qw = q.w;
+                float vx = v.x, vy = v.y, vz = v.z;
                 
-                cameraPos = transform.localPosition;
-                
-                // Apply rotation to camera basis vectors
-                // Quaternion rotation: v' = q * v * q^(-1)
-                // For unit quaternions: q^(-1) = conjugate(q)
-                Quat q = transform.localRotation;
-                
-                // Helper lambda to rotate a vector by quaternion
-                auto rotateVec = [](const Quat& q, const Vec3& v) -> Vec3 {
-                    // q * v * q^(-1) where v is treated as quaternion (0, v)
-                    float qx = q.x, qy = q.y, qz = q.z, qw = q.w;
-                    float vx = v.x, vy = v.y, vz = v.z;
-                    
-                    // First: q * v
-                    float tx = qw * vx + qy * vz - qz * vy;
-                    float ty = qw * vy + qz * vx - qx * vz;
-                    float tz = qw * vz + qx * vy - qy * vx;
-                    float tw = -qx * vx - qy * vy - qz * vz;
-                    
-                    // Second: result * q^(-1) = result * conjugate(q)
-                    float rx = tw * (-qx) + tx * qw + ty * (-qz) - tz * (-qy);
-                    float ry = tw * (-qy) + ty * qw + tz * (-qx) - tx * (-qz);
-                    float rz = tw * (-qz) + tz * qw + tx * (-qy) - ty * (-qx);
-                    
-                    return Vec3(rx, ry, rz);
-                };
-                
-                // Camera default orientation: forward=-Z, up=+Y, right=+X
-                Vec3 forward = rotateVec(q, Vec3(0, 0, -1));
-                Vec3 up = rotateVec(q, Vec3(0, 1, 0));
-                Vec3 right = rotateVec(q, Vec3(1, 0, 0));
+                // First: q * v
+                float tx = qw * vx + qy * vz - qz * vy;
+                float ty = qw * vy + qz * vx - qx * vz;
+                float tz = qw * vz + qx * vy - qy * vx;
+                float tw = -qx * vx - qy * vy - qz * vz;
                 
-                // Build view matrix: inverse of camera transform
-                viewMatrix.Identity();
-                // Rotation part (transpose of camera basis)
-                viewMatrix.m[0] = right.x;   viewMatrix.m[4] = right.y;   viewMatrix.m[8] = right.z;
-                viewMatrix.m[1] = up.x;      viewMatrix.m[5] = up.y;      viewMatrix.m[9] = up.z;
-                viewMatrix.m[2] = -forward.x; viewMatrix.m[6] = -forward.y; viewMatrix.m[10] = -forward.z;
-                // Translation part
-                viewMatrix.m[12] = -Vec3::Dot(right, cameraPos);
-                viewMatrix.m[13] = -Vec3::Dot(up, cameraPos);
-                viewMatrix.m[14] = Vec3::Dot(forward, cameraPos);
-                viewMatrix.m[15] = 1.0f;
+                // Second: result * q^(-1) = result * conjugate(q)
+                float rx = tw * (-qx) + tx * qw + ty * (-qz) - tz * (-qy);
+                float ry = tw * (-qy) + ty * qw + tz * (-qx) - tx * (-qz);
+                float rz = tw * (-qz) + tz * qw + tx * (-qy) - ty * (-qx);
                 
-                // Use same projection as editor camera
-                projectionMatrix = m_EditorCamera.GetProjectionMatrix();
-                foundCamera = true;
-                break;
-            }
+                return Vec3(rx, ry, rz);
+            };
+            
+            // Camera default orientation: forward=-Z, up=+Y, right=+X
+            Vec3 forward = rotateVec(q, Vec3(0, 0, -1));
+            Vec3 up = rotateVec(q, Vec3(0, 1, 0));
+            Vec3 right = rotateVec(q, Vec3(1, 0, 0));
+            
+            // Build view matrix: inverse of camera transform
+            viewMatrix.Identity();
+            // Rotation part (transpose of camera basis)
+            viewMatrix.m[0] = right.x;   viewMatrix.m[4] = right.y;   viewMatrix.m[8] = right.z;
+            viewMatrix.m[1] = up.x;      viewMatrix.m[5] = up.y;      viewMatrix.m[9] = up.z;
+            viewMatrix.m[2] = -forward.x; viewMatrix.m[6] = -forward.y; viewMatrix.m[10] = -forward.z;
+            // Translation part
+            viewMatrix.m[12] = -Vec3::Dot(right, cameraPos);
+            viewMatrix.m[13] = -Vec3::Dot(up, cameraPos);
+            viewMatrix.m[14] = Vec3::Dot(forward, cameraPos);
+            viewMatrix.m[15] = 1.0f;
+            
+            // Use same projection as editor camera
+            projectionMatrix = m_EditorCamera.GetProjectionMatrix();
         }
         
         if (!foundCamera) {
@@ -716,43 +744,30 @@ void EditorLayer::RenderViewport(ViewportPanel* viewport) {
         if (!m_ViewportShader) return;
         
         // Enable depth testing
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(GL_LESS);
-        glDisable(GL_CULL_FACE);
+        GLStateCache::Enable(GL_DEPTH_TEST);
+        GLStateCache::DepthFunc(GL_LESS);
+        GLStateCache::Disable(GL_CULL_FACE);
         
-        // Begin scene with editor camera
+        // Begin scene with editor camera (uploads view-projection / camera position as FrameData)
         Renderer::BeginScene(viewMatrix, projectionMatrix);
         
         // Bind shader
         m_ViewportShader->Bind();
         
-        // Set view-projection matrix
-        Mat4 viewProjectionMatrix = projectionMatrix * viewMatrix;
-        m_ViewportShader->SetMat4("u_ViewProjection", viewProjectionMatrix);
-        m_ViewportShader->SetFloat3("u_CameraPos", cameraPos);
-        
         // Render all entities with MeshFilterComponent
-        auto view = m_ActiveRegistry->GetEntitiesWith<TransformComponent, MeshFilterComponent>();
-        for (EntityID entityID : view) {
-            Entity entity(entityID, m_ActiveRegistry);
-            
-            auto& transform = entity.GetComponent<TransformComponent>();
-            auto& meshFilter = entity.GetComponent<MeshFilterComponent>();
+        m_ActiveRegistry->GetView<const TransformComponent, const MeshFilterComponent>().Each(
+            [this](const TransformComponent& transform, const MeshFilterComponent& meshFilter) {
+                // Cached world matrix (TransformSystem keeps it current)
+                const Mat4 modelMatrix = transform.GetWorldMatrix();
             
-            // Build model matrix from transform
-            Mat4 translationMat = Mat4::Translation(transform.localPosition);
-            Mat4 rotationMat = Mat4(); // Identity for now
-            Mat4 scaleMat = Mat4::Scale(transform.localScale);
-            Mat4 modelMatrix = translationMat * rotationMat * scaleMat;
+                // Set model matrix uniform
+                m_ViewportShader->SetMat4("u_Transform", modelMatrix);
             
-            // Set model matrix uniform
-            m_ViewportShader->SetMat4("u_Transform", modelMatrix);
-            
-            // Render the mesh
-            if (meshFilter.mesh) {
-                Renderer::DrawMesh(*meshFilter.mesh, modelMatrix);
-            }
-        }
+                // Render the mesh
+                if (meshFilter.mesh) {
+                    Renderer::DrawMesh(*meshFilter.mesh, modelMatrix);
+                }
+            });
         
         // End scene
         Renderer::EndScene();
@@ -828,6 +843,7 @@ void EditorLayer::OnAssetDropped(const std::string& assetGUID, const Vec2& dropP
             auto& transform = entity.AddComponent<TransformComponent>();
             transform.localPosition = worldPosition;
             transform.localScale = Vec3(1.0f, 1.0f, 1.0f);
+            transform.UpdateLocalMatrix();
             
             // Load the actual mesh from file
             try {
@@ -863,6 +879,7 @@ void EditorLayer::OnAssetDropped(const std::string& assetGUID, const Vec2& dropP
             auto& transform = entity.AddComponent<TransformComponent>();
             transform.localPosition = Vec3(0.0f, 0.0f, 0.0f);
             transform.localScale = Vec3(1.0f, 1.0f, 1.0f);
+            transform.UpdateLocalMatrix();
             
             // Add to scene graph
             auto sceneNode = m_SceneGraph.CreateNode(newEntityID, metadata->name);
@@ -983,8 +1000,14 @@ void EditorLayer::EnterPlayMode() {
     // Switch application to Game mode
     Application::Get().SetMode(EngineMode::Game);
     
-    // Save editor camera state
-    // TODO: Save scene state for restoration on exit
+    // Save scene state; pools are copied lazily on first write during play
+    if (m_ActiveRegistry) {
+        const auto start = std::chrono::steady_clock::now();
+        m_PlaySnapshot.Capture(*m_ActiveRegistry, RegistrySnapshot::Mode::CopyOnWrite);
+        const auto end = std::chrono::steady_clock::now();
+        ENGINE_INFO("Scene snapshot captured ({} entities, {} ms)", m_ActiveRegistry->GetEntityCount(),
+                    std::chrono::duration<double, std::milli>(end - start).count());
+    }
     
     // Disable editor-specific features
     // TODO: Disable gizmos, selection, etc.
@@ -997,8 +1020,18 @@ void EditorLayer::ExitPlayMode() {
     // Switch application back to Editor mode
     Application::Get().SetMode(EngineMode::Editor);
     
-    // Restore editor camera state
-    // TODO: Restore scene state
+    // Restore scene state
+    if (m_ActiveRegistry && m_PlaySnapshot.IsCaptured()) {
+        const auto start = std::chrono::steady_clock::now();
+        m_PlaySnapshot.Restore(*m_ActiveRegistry);
+        const auto end = std::chrono::steady_clock::now();
+        ENGINE_INFO("Scene snapshot restored ({} entities, {} ms)", m_ActiveRegistry->GetEntityCount(),
+                    std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    m_PlaySnapshot.Release();
+    if (m_ActiveRegistry && !m_ActiveRegistry->IsValid(m_SelectedEntity)) {
+        m_SelectedEntity = 0;
+    }
     
     // Re-enable editor-specific features
     // TODO: Re-enable gizmos, selection, etc.
@@ -12,11 +12,14 @@
 #include "Panel.h"
 #include "EditorCamera.h"
 #include "ECS/Registry.h"
+#include "ECS/RegistrySnapshot.h"
+#include "ECS/TransformSystem.h"
 #include "Scene/SceneNode.h"
 #include "Panels/SceneHierarchyPanel.h"
 #include "Panels/PropertiesPanel.h"
 #include "Panels/ViewportPanel.h"
 #include "Panels/AssetBrowserPanel.h"
+#include "Panels/ProfilerPanel.h"
 #include "Rendering/Pass/RenderPass.h"
 #include <vector>
 #include <memory>
@@ -110,6 +113,7 @@ private:
     // 场景和 ECS
     Registry* m_ActiveRegistry = nullptr;
     SceneGraph m_SceneGraph;
+    std::unique_ptr<TransformSystem> m_TransformSystem;  // World matrices read by the viewport
     
     // 编辑器状态
     EntityID m_SelectedEntity = 0;
@@ -135,6 +139,7 @@ private:
     
     // Play mode state
     bool m_IsPlaying = false;
+    RegistrySnapshot m_PlaySnapshot;  // Edit-time scene, restored by ExitPlayMode
     
     // Script system pointer (non-owning)
     ScriptSystem* m_ScriptSystem = nullptr;
@@ -0,0 +1,252 @@
+/******************************************************************************
+ * File: ProfilerPanel.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Profiler panel implementation
+ ******************************************************************************/
+
+#include "ProfilerPanel.h"
+#include <imgui.h>
+#include <algorithm>
+#include <vector>
+
+namespace MyEngine {
+
+static ImU32 ColorForName(const char* name) {
+    // Stable per-name color (FNV-1a over the scope name)
+    uint32_t hash = 2166136261u;
+    for (const char* c = name; *c; ++c) {
+        hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+    }
+    int r = 90 + (hash & 0x7F);
+    int g = 90 + ((hash >> 8) & 0x7F);
+    int b = 90 + ((hash >> 16) & 0x7F);
+    return IM_COL32(r, g, b, 255);
+}
+
+ProfilerPanel::ProfilerPanel()
+    : Panel("Profiler", false)
+{
+}
+
+void ProfilerPanel::OnUIRender() {
+    if (!m_IsOpen) return;
+    
+    ImGui::Begin(m_Name.c_str(), &m_IsOpen);
+    
+    bool enabled = Profiler::IsEnabled();
+    if (ImGui::Checkbox("Enabled", &enabled)) {
+        Profiler::SetEnabled(enabled);
+    }
+    ImGui::SameLine();
+    if (ImGui::Checkbox("Pause", &m_Paused)) {
+        // Freeze a copy so selection stays stable while new frames arrive
+        if (m_Paused) m_Snapshot = Profiler::GetHistory();
+        else m_Snapshot.clear();
+        m_SelectedFrame = -1;
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(200.0f);
+    ImGui::InputText("##ExportPath", m_ExportPath, sizeof(m_ExportPath));
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome Trace")) {
+        Profiler::ExportChromeTrace(m_ExportPath);
+    }
+    
+    const auto& history = m_Paused ? m_Snapshot : Profiler::GetHistory();
+    if (history.empty()) {
+        ImGui::TextDisabled("No frames recorded");
+        ImGui::End();
+        return;
+    }
+    
+    RenderFrameGraph(history);
+    
+    int index = m_SelectedFrame >= 0 && m_SelectedFrame < static_cast<int>(history.size())
+        ? m_SelectedFrame
+        : static_cast<int>(history.size()) - 1;
+    const ProfileFrame& frame = history[index];
+    
+    ImGui::Text("Frame %llu: %.3f ms (%zu scopes)",
+        static_cast<unsigned long long>(frame.FrameIndex), frame.DurationMs, frame.Nodes.size());
+    
+    if (ImGui::BeginTabBar("ProfilerViews")) {
+        if (ImGui::BeginTabItem("Timeline")) {
+            ImGui::SliderFloat("Zoom", &m_TimelineZoom, 1.0f, 50.0f, "%.1fx");
+            RenderFlameGraph(frame);
+            ImGui::EndTabItem();
+        }
+        if (ImGui::BeginTabItem("Call Tree")) {
+            RenderCallTree(frame);
+            ImGui::EndTabItem();
+        }
+        ImGui::EndTabBar();
+    }
+    
+    ImGui::End();
+}
+
+void ProfilerPanel::RenderFrameGraph(const std::deque<ProfileFrame>& history) {
+    std::vector<float> durations;
+    durations.reserve(history.size());
+    float maxMs = 1.0f;
+    for (const auto& frame : history) {
+        durations.push_back(static_cast<float>(frame.DurationMs));
+        maxMs = std::max(maxMs, durations.back());
+    }
+    
+    ImGui::PlotHistogram("##FrameTimes", durations.data(), static_cast<int>(durations.size()),
+        0, "Frame time (ms)", 0.0f, maxMs * 1.1f, ImVec2(-1.0f, 60.0f));
+    
+    // Pick a historical frame while paused
+    if (m_Paused && ImGui::IsItemHovered() && ImGui::IsMouseClicked(ImGuiMouseButton_Left)) {
+        float t = (ImGui::GetIO().MousePos.x - ImGui::GetItemRectMin().x) / ImGui::GetItemRectSize().x;
+        m_SelectedFrame = std::clamp(static_cast<int>(t * durations.size()), 0,
+                                     static_cast<int>(durations.size()) - 1);
+    }
+}
+
+void ProfilerPanel::RenderFlameGraph(const ProfileFrame& frame) {
+    const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+    const double frameMs = std::max(frame.DurationMs, 0.001);
+    
+    // Track layout: one lane per thread, one row per depth
+    uint32_t threadCount = 0;
+    std::vector<uint32_t> maxDepth;
+    for (const auto& node : frame.Nodes) {
+        threadCount = std::max(threadCount, node.ThreadIndex + 1);
+        if (maxDepth.size() < threadCount) maxDepth.resize(threadCount, 0);
+        maxDepth[node.ThreadIndex] = std::max(maxDepth[node.ThreadIndex], node.Depth);
+    }
+    
+    float contentHeight = 0.0f;
+    for (uint32_t t = 0; t < threadCount; ++t) {
+        contentHeight += rowHeight * (maxDepth[t] + 2);
+    }
+    
+    ImGui::BeginChild("Timeline", ImVec2(0, 0), true, ImGuiWindowFlags_HorizontalScrollbar);
+    
+    float width = ImGui::GetContentRegionAvail().x * m_TimelineZoom;
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    ImGui::Dummy(ImVec2(width, contentHeight));
+    
+    std::vector<float> laneOffset(threadCount, 0.0f);
+    float offset = 0.0f;
+    for (uint32_t t = 0; t < threadCount; ++t) {
+        laneOffset[t] = offset;
+        drawList->AddText(ImVec2(origin.x, origin.y + offset), IM_COL32(200, 200, 200, 255),
+                          Profiler::GetThreadName(t).c_str());
+        offset += rowHeight * (maxDepth[t] + 2);
+    }
+    
+    const ImVec2 mouse = ImGui::GetIO().MousePos;
+    const ProfileNode* hovered = nullptr;
+    
+    for (const auto& node : frame.Nodes) {
+        float x0 = origin.x + static_cast<float>(std::max(node.StartMs, 0.0) / frameMs) * width;
+        float x1 = origin.x + static_cast<float>((node.StartMs + node.DurationMs) / frameMs) * width;
+        x1 = std::max(x1, x0 + 1.0f);
+        float y0 = origin.y + laneOffset[node.ThreadIndex] + rowHeight * (node.Depth + 1);
+        float y1 = y0 + rowHeight - 1.0f;
+        
+        drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), ColorForName(node.Name));
+        
+        // Label only if it fits
+        ImVec2 textSize = ImGui::CalcTextSize(node.Name);
+        if (textSize.x + 4.0f < x1 - x0) {
+            drawList->AddText(ImVec2(x0 + 2.0f, y0), IM_COL32(0, 0, 0, 255), node.Name);
+        }
+        
+        if (mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y1) {
+            hovered = &node;
+        }
+    }
+    
+    if (hovered && ImGui::IsWindowHovered()) {
+        ImGui::BeginTooltip();
+        ImGui::Text("%s", hovered->Name);
+        ImGui::Text("Total: %.3f ms", hovered->DurationMs);
+        ImGui::Text("Self:  %.3f ms", hovered->SelfMs);
+        ImGui::Text("Start: %.3f ms", hovered->StartMs);
+        ImGui::EndTooltip();
+    }
+    
+    ImGui::EndChild();
+}
+
+void ProfilerPanel::RenderCallTree(const ProfileFrame& frame) {
+    const auto& nodes = frame.Nodes;
+    
+    // First child / next sibling links (nodes are depth-first per thread)
+    std::vector<int32_t> firstChild(nodes.size(), -1);
+    std::vector<int32_t> nextSibling(nodes.size(), -1);
+    std::vector<int32_t> lastChild(nodes.size(), -1);
+    std::vector<int32_t> roots;
+    for (int32_t i = 0; i < static_cast<int32_t>(nodes.size()); ++i) {
+        int32_t parent = nodes[i].Parent;
+        if (parent < 0) {
+            roots.push_back(i);
+            continue;
+        }
+        if (firstChild[parent] < 0) firstChild[parent] = i;
+        else nextSibling[lastChild[parent]] = i;
+        lastChild[parent] = i;
+    }
+    
+    if (!ImGui::BeginTable("CallTree", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable |
+                                           ImGuiTableFlags_ScrollY | ImGuiTableFlags_BordersInnerV)) {
+        return;
+    }
+    ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableSetupColumn("Total (ms)", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+    ImGui::TableSetupColumn("Self (ms)", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+    ImGui::TableHeadersRow();
+    
+    // Iterative depth-first draw so deep trees don't recurse
+    std::vector<std::pair<int32_t, bool>> stack;  // (node, isPop)
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it) {
+        stack.push_back({ *it, false });
+    }
+    
+    while (!stack.empty()) {
+        auto [index, isPop] = stack.back();
+        stack.pop_back();
+        if (isPop) {
+            ImGui::TreePop();
+            continue;
+        }
+        
+        const ProfileNode& node = nodes[index];
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        
+        bool leaf = firstChild[index] < 0;
+        ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanFullWidth | ImGuiTreeNodeFlags_DefaultOpen;
+        if (leaf) flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+        
+        ImGui::PushID(index);
+        bool open = ImGui::TreeNodeEx(node.Name, flags, "%s [%s]", node.Name,
+                                      Profiler::GetThreadName(node.ThreadIndex).c_str());
+        ImGui::PopID();
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", node.DurationMs);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", node.SelfMs);
+        
+        if (!leaf && open) {
+            stack.push_back({ index, true });
+            std::vector<int32_t> children;
+            for (int32_t child = firstChild[index]; child >= 0; child = nextSibling[child]) {
+                children.push_back(child);
+            }
+            for (auto it = children.rbegin(); it != children.rend(); ++it) {
+                stack.push_back({ *it, false });
+            }
+        }
+    }
+    
+    ImGui::EndTable();
+}
+
+} // namespace MyEngine
@@ -0,0 +1,45 @@
+/******************************************************************************
+ * File: ProfilerPanel.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: CPU profiler panel (frame graph, flame view, call tree)
+ ******************************************************************************/
+
+#pragma once
+
+#include "Editor/Panel.h"
+#include "Core/Profiler.h"
+#include <cstdint>
+#include <deque>
+
+namespace MyEngine {
+
+/**
+ * @brief 性能分析面板
+ * 
+ * 显示 Profiler 记录的 CPU 帧数据：
+ * - 帧时间曲线（点击暂停后可选择历史帧）
+ * - 火焰图/时间线（每个线程一条轨道）
+ * - 调用树（总耗时 / 自身耗时）
+ * - 导出 Chrome trace
+ */
+class ProfilerPanel : public Panel {
+public:
+    ProfilerPanel();
+    
+    virtual void OnUIRender() override;
+    
+private:
+    void RenderFrameGraph(const std::deque<ProfileFrame>& history);
+    void RenderFlameGraph(const ProfileFrame& frame);
+    void RenderCallTree(const ProfileFrame& frame);
+    
+private:
+    bool m_Paused = false;
+    std::deque<ProfileFrame> m_Snapshot;   // History frozen at pause time
+    int m_SelectedFrame = -1;     // Index into history (-1 = latest)
+    float m_TimelineZoom = 1.0f;
+    char m_ExportPath[256] = "profile_trace.json";
+};
+
+} // namespace MyEngine
@@ -8,6 +8,7 @@
 #include "PropertiesPanel.h"
 #include "ECS/Entity.h"
 #include "ECS/Components.h"
+#include "ECS/TransformSystem.h"
 #include "Rendering/Pass/RenderPass.h"
 #include "Rendering/Pass/WaterPass.h"
 #include "Rendering/Pass/TerrainPass.h"
@@ -87,8 +88,9 @@ void PropertiesPanel::DrawTransformComponent(Entity entity) {
         if (ImGui::DragFloat3("Position", position, 0.1f)) {
             tc.localPosition = Vec3(position[0], position[1], position[2]);
             tc.UpdateLocalMatrix();
-            // Force version sync to ensure rendering passes see the update
-            tc.worldVersion = tc.localVersion;
+            if (m_TransformSystem) {
+                m_TransformSystem->MarkDirty(entity);
+            }
             ENGINE_INFO("Position updated: ({}, {}, {}), version: {}", position[0], position[1], position[2], tc.localVersion);
         }
         
@@ -147,8 +149,9 @@ void PropertiesPanel::DrawTransformComponent(Entity entity) {
         if (ImGui::DragFloat3("Rotation", eulerAngles, 0.5f)) {
             tc.localRotation = eulerToQuat(Vec3(eulerAngles[0], eulerAngles[1], eulerAngles[2]));
             tc.UpdateLocalMatrix();
-            // Force version sync
-            tc.worldVersion = tc.localVersion;
+            if (m_TransformSystem) {
+                m_TransformSystem->MarkDirty(entity);
+            }
         }
         
         // Scale
@@ -156,8 +159,9 @@ void PropertiesPanel::DrawTransformComponent(Entity entity) {
         if (ImGui::DragFloat3("Scale", scale, 0.1f, 0.001f, 1000.0f)) {
             tc.localScale = Vec3(scale[0], scale[1], scale[2]);
             tc.UpdateLocalMatrix();
-            // Force version sync
-            tc.worldVersion = tc.localVersion;
+            if (m_TransformSystem) {
+                m_TransformSystem->MarkDirty(entity);
+            }
         }
         
         // Display version info (for debugging)
@@ -14,6 +14,8 @@
 
 namespace MyEngine {
 
+class TransformSystem;
+
 /**
  * @brief 属性面板
  * 
@@ -41,6 +43,11 @@ public:
      */
     Entity GetSelectedEntity() const { return m_SelectionContext; }
     
+    /**
+     * @brief 变换编辑后通知的 TransformSystem（登记脏实体）
+     */
+    void SetTransformSystem(TransformSystem* transformSystem) { m_TransformSystem = transformSystem; }
+    
 private:
     /**
      * @brief 绘制所有组件
@@ -79,6 +86,7 @@ private:
     
 private:
     Entity m_SelectionContext;      // 当前选中的实体
+    TransformSystem* m_TransformSystem = nullptr;
 };
 
 } // namespace MyEngine
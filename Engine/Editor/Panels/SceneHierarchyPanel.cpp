@@ -7,6 +7,7 @@
 
 #include "SceneHierarchyPanel.h"
 #include "Core/Log.h"
+#include "ECS/Prefab.h"
 #include <imgui.h>
 #include <cstring>
 
@@ -23,13 +24,19 @@ void SceneHierarchyPanel::OnUIRender() {
     ImGui::Begin(m_Name.c_str(), &m_IsOpen);
     
     if (m_Context) {
-        // Traverse all entities
-        auto view = m_Context->GetEntitiesWith<TagComponent>();
-        for (auto entityID : view) {
-            Entity entity{ entityID, m_Context };
+        // Traverse all entities (index loop: a node may create entities)
+        const auto& entities = m_Context->Query<TagComponent>();
+        for (size_t i = 0; i < entities.size(); ++i) {
+            Entity entity{ entities[i], m_Context };
             DrawEntityNode(entity);
         }
         
+        // Deleting swap-and-pops the query above, so it waits until the loop is done
+        if (m_EntityToDelete) {
+            DeleteEntity(m_EntityToDelete);
+            m_EntityToDelete = {};
+        }
+        
         // Background right-click menu
         if (ImGui::BeginPopupContextWindow()) {
             if (ImGui::MenuItem("Create Empty Entity")) {
@@ -99,8 +106,6 @@ void SceneHierarchyPanel::DrawEntityNode(Entity entity) {
     }
     
     // Right-click menu
-    bool entityDeleted = false;
-    
     // Generate unique ID for context menu
     std::string contextMenuID = "EntityContextMenu##" + std::to_string((uint64_t)(uint32_t)entity);
     if (ImGui::BeginPopupContextItem(contextMenuID.c_str())) {
@@ -132,7 +137,7 @@ void SceneHierarchyPanel::DrawEntityNode(Entity entity) {
         ImGui::Separator();
         
         if (ImGui::MenuItem("Delete", "Del")) {
-            entityDeleted = true;
+            m_EntityToDelete = entity;  // Deleted by OnUIRender after the traversal
         }
         
         ImGui::EndPopup();
@@ -159,13 +164,6 @@ void SceneHierarchyPanel::DrawEntityNode(Entity entity) {
         }
         ImGui::TreePop();
     }
-    
-    // Delete entity
-    if (entityDeleted) {
-        m_Context->DestroyEntity(entity);
-        if (m_SelectionContext == entity)
-            m_SelectionContext = {};
-    }
 }
 
 void SceneHierarchyPanel::DrawContextMenu() {
@@ -187,38 +185,17 @@ void SceneHierarchyPanel::DeleteEntity(Entity entity) {
 Entity SceneHierarchyPanel::DuplicateEntity(Entity source) {
     if (!source || !m_Context) return {};
     
-    // Create new entity
-    EntityID newEntityID = m_Context->CreateEntity();
-    Entity newEntity{ newEntityID, m_Context };
-    
-    // Copy TagComponent
-    if (source.HasComponent<TagComponent>()) {
-        auto& srcTag = source.GetComponent<TagComponent>();
-        auto& newTag = newEntity.AddComponent<TagComponent>(srcTag.Tag + " (Copy)");
-    }
-    
-    // Copy TransformComponent
-    if (source.HasComponent<TransformComponent>()) {
-        auto& srcTransform = source.GetComponent<TransformComponent>();
-        auto& newTransform = newEntity.AddComponent<TransformComponent>();
-        newTransform.localPosition = srcTransform.localPosition;
-        newTransform.localRotation = srcTransform.localRotation;
-        newTransform.localScale = srcTransform.localScale;
-    }
-    
-    // Add HierarchyComponent (but don't copy parent/children)
+    // Copy the whole subtree in one batch; the copy is appended after its siblings
+    Prefab prefab = Prefab::FromEntity(*m_Context, source);
+    EntityID parentID = 0;
     if (source.HasComponent<HierarchyComponent>()) {
-        auto& srcHierarchy = source.GetComponent<HierarchyComponent>();
-        auto& newHierarchy = newEntity.AddComponent<HierarchyComponent>();
-        newHierarchy.parent = srcHierarchy.parent; // Keep same parent
+        parentID = source.GetComponent<HierarchyComponent>().parent;
     }
+    Entity newEntity{ prefab.Instantiate(*m_Context, parentID), m_Context };
     
-    // Copy MeshFilterComponent
-    if (source.HasComponent<MeshFilterComponent>()) {
-        auto& srcMesh = source.GetComponent<MeshFilterComponent>();
-        auto& newMesh = newEntity.AddComponent<MeshFilterComponent>();
-        newMesh.MeshHandle = srcMesh.MeshHandle;
-        newMesh.mesh = srcMesh.mesh;
+    if (newEntity.HasComponent<TagComponent>()) {
+        auto& newTag = newEntity.GetComponent<TagComponent>();
+        newTag.Tag += " (Copy)";
     }
     
     return newEntity;
@@ -243,24 +220,25 @@ Entity SceneHierarchyPanel::CreateChildEntity(Entity parent) {
     if (parent.HasComponent<HierarchyComponent>()) {
         auto& parentHierarchy = parent.GetComponent<HierarchyComponent>();
         
+        childHierarchy.depth = parentHierarchy.depth + 1;
+        
         if (parentHierarchy.firstChild == 0) {
             // First child
             parentHierarchy.firstChild = childID;
         } else {
-            // Find last sibling and append
-            EntityID lastSiblingID = parentHierarchy.firstChild;
-            Entity lastSibling{ lastSiblingID, m_Context };
-            
-            while (lastSibling.HasComponent<HierarchyComponent>()) {
-                auto& siblingHierarchy = lastSibling.GetComponent<HierarchyComponent>();
-                if (siblingHierarchy.nextSibling == 0) {
-                    siblingHierarchy.nextSibling = childID;
-                    break;
+            // Append after the last child
+            EntityID lastSiblingID = parentHierarchy.lastChild;
+            if (lastSiblingID == 0) {
+                // Links written without lastChild: find it
+                lastSiblingID = parentHierarchy.firstChild;
+                while (Entity{ lastSiblingID, m_Context }.GetComponent<HierarchyComponent>().nextSibling != 0) {
+                    lastSiblingID = Entity{ lastSiblingID, m_Context }.GetComponent<HierarchyComponent>().nextSibling;
                 }
-                lastSiblingID = siblingHierarchy.nextSibling;
-                lastSibling = Entity{ lastSiblingID, m_Context };
             }
+            Entity{ lastSiblingID, m_Context }.GetComponent<HierarchyComponent>().nextSibling = childID;
+            childHierarchy.prevSibling = lastSiblingID;
         }
+        parentHierarchy.lastChild = childID;
     }
     
     return child;
@@ -68,6 +68,7 @@ private:
 private:
     Registry* m_Context = nullptr;      // Scene context
     Entity m_SelectionContext;          // Currently selected entity
+    Entity m_EntityToDelete;            // Chosen from a context menu this frame
     
     // Rename dialog state
     bool m_RenamingEntity = false;
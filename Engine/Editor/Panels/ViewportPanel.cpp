@@ -7,6 +7,7 @@
 
 #include "ViewportPanel.h"
 #include "Core/Log.h"
+#include "Rendering/OpenGL/GLStateCache.h"
 #include <imgui.h>
 #include <glad/gl.h>
 
@@ -21,7 +22,7 @@ ViewportPanel::~ViewportPanel() {
     // Cleanup framebuffer
     if (m_FramebufferID != 0) {
         glDeleteFramebuffers(1, &m_FramebufferID);
-        glDeleteTextures(1, &m_ColorAttachmentID);
+        GLStateCache::DeleteTexture(m_ColorAttachmentID);
         glDeleteRenderbuffers(1, &m_DepthAttachmentID);
     }
 }
@@ -131,7 +132,7 @@ void ViewportPanel::CreateFramebuffer(uint32_t width, uint32_t height) {
     // Delete old framebuffer
     if (m_FramebufferID != 0) {
         glDeleteFramebuffers(1, &m_FramebufferID);
-        glDeleteTextures(1, &m_ColorAttachmentID);
+        GLStateCache::DeleteTexture(m_ColorAttachmentID);
         glDeleteRenderbuffers(1, &m_DepthAttachmentID);
     }
     
@@ -141,7 +142,7 @@ void ViewportPanel::CreateFramebuffer(uint32_t width, uint32_t height) {
     
     // Create color texture attachment
     glGenTextures(1, &m_ColorAttachmentID);
-    glBindTexture(GL_TEXTURE_2D, m_ColorAttachmentID);
+    GLStateCache::BindTexture(GL_TEXTURE_2D, m_ColorAttachmentID);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -0,0 +1,442 @@
+/******************************************************************************
+ * File: BatchMath.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Batched SoA math kernels (AVX / SSE lanes with scalar tail)
+ ******************************************************************************/
+
+#pragma once
+
+#include "MathTypes.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace MyEngine {
+namespace Batch {
+
+/**
+ * 对 N 个元素做同一种运算的批量接口，输入输出为 SoA 浮点流（x[]、y[]、z[] 分开存放）。
+ *
+ * 每个内核只写一次，以"通道"类型为模板参数实例化：
+ *   LaneAVX    8 宽（__AVX__，有 FMA 时使用乘加融合）
+ *   LaneSSE    4 宽（SSE2 基线）
+ *   LaneScalar 1 宽（尾部元素与无 SIMD 的构建）
+ * MoveMask 把比较结果压成位掩码（第 k 位 = 第 k 个元素），用于按条件压缩输出。
+ * 主循环用最宽的通道处理整块，剩余不足一块的元素由 LaneScalar 处理，
+ * 所以 count 不需要对齐，流指针也不需要对齐。输出可以与输入是同一个流（原地计算）。
+ * 后端由 SIMDKernels.h 在编译期选择（-DMYENGINE_SIMD_AVX2=ON 构建得到 8 宽路径）。
+ */
+
+/**
+ * @brief Mutable / read-only views of SoA streams
+ */
+struct Vec3SoA {
+    float* x;
+    float* y;
+    float* z;
+};
+
+struct ConstVec3SoA {
+    const float* x;
+    const float* y;
+    const float* z;
+
+    ConstVec3SoA(const float* x, const float* y, const float* z) : x(x), y(y), z(z) {}
+    ConstVec3SoA(const Vec3SoA& v) : x(v.x), y(v.y), z(v.z) {}
+};
+
+struct QuatSoA {
+    float* x;
+    float* y;
+    float* z;
+    float* w;
+};
+
+struct ConstQuatSoA {
+    const float* x;
+    const float* y;
+    const float* z;
+    const float* w;
+
+    ConstQuatSoA(const float* x, const float* y, const float* z, const float* w) : x(x), y(y), z(z), w(w) {}
+    ConstQuatSoA(const QuatSoA& q) : x(q.x), y(q.y), z(q.z), w(q.w) {}
+};
+
+// =============================================================================
+// Lanes
+// =============================================================================
+
+struct LaneScalar {
+    using Type = float;
+    using Mask = bool;
+    static constexpr size_t Width = 1;
+
+    static Type Load(const float* p) { return *p; }
+    static void Store(float* p, Type v) { *p = v; }
+    static Type Set(float v) { return v; }
+    static Type Add(Type a, Type b) { return a + b; }
+    static Type Sub(Type a, Type b) { return a - b; }
+    static Type Mul(Type a, Type b) { return a * b; }
+    static Type Div(Type a, Type b) { return a / b; }
+    static Type MulAdd(Type a, Type b, Type c) { return a * b + c; }
+    static Type Sqrt(Type a) { return std::sqrt(a); }
+    static Type Min(Type a, Type b) { return a < b ? a : b; }
+    static Type Max(Type a, Type b) { return a > b ? a : b; }
+    static Mask Less(Type a, Type b) { return a < b; }
+    static Mask Greater(Type a, Type b) { return a > b; }
+    static Type Select(Mask mask, Type ifTrue, Type ifFalse) { return mask ? ifTrue : ifFalse; }
+    static uint32_t MoveMask(Mask mask) { return mask ? 1u : 0u; }
+};
+
+#if defined(MYENGINE_SIMD_SSE)
+struct LaneSSE {
+    using Type = __m128;
+    using Mask = __m128;
+    static constexpr size_t Width = 4;
+
+    static Type Load(const float* p) { return _mm_loadu_ps(p); }
+    static void Store(float* p, Type v) { _mm_storeu_ps(p, v); }
+    static Type Set(float v) { return _mm_set1_ps(v); }
+    static Type Add(Type a, Type b) { return _mm_add_ps(a, b); }
+    static Type Sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+    static Type Mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+    static Type Div(Type a, Type b) { return _mm_div_ps(a, b); }
+    static Type MulAdd(Type a, Type b, Type c) { return SIMD::MulAdd(a, b, c); }
+    static Type Sqrt(Type a) { return _mm_sqrt_ps(a); }
+    static Type Min(Type a, Type b) { return _mm_min_ps(a, b); }
+    static Type Max(Type a, Type b) { return _mm_max_ps(a, b); }
+    static Mask Less(Type a, Type b) { return _mm_cmplt_ps(a, b); }
+    static Mask Greater(Type a, Type b) { return _mm_cmpgt_ps(a, b); }
+    static Type Select(Mask mask, Type ifTrue, Type ifFalse) {
+#if defined(MYENGINE_SIMD_SSE41)
+        return _mm_blendv_ps(ifFalse, ifTrue, mask);
+#else
+        return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+#endif
+    }
+    static uint32_t MoveMask(Mask mask) { return static_cast<uint32_t>(_mm_movemask_ps(mask)); }
+};
+#endif
+
+#if defined(MYENGINE_SIMD_AVX)
+struct LaneAVX {
+    using Type = __m256;
+    using Mask = __m256;
+    static constexpr size_t Width = 8;
+
+    static Type Load(const float* p) { return _mm256_loadu_ps(p); }
+    static void Store(float* p, Type v) { _mm256_storeu_ps(p, v); }
+    static Type Set(float v) { return _mm256_set1_ps(v); }
+    static Type Add(Type a, Type b) { return _mm256_add_ps(a, b); }
+    static Type Sub(Type a, Type b) { return _mm256_sub_ps(a, b); }
+    static Type Mul(Type a, Type b) { return _mm256_mul_ps(a, b); }
+    static Type Div(Type a, Type b) { return _mm256_div_ps(a, b); }
+    static Type MulAdd(Type a, Type b, Type c) {
+#if defined(MYENGINE_SIMD_FMA)
+        return _mm256_fmadd_ps(a, b, c);
+#else
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+    }
+    static Type Sqrt(Type a) { return _mm256_sqrt_ps(a); }
+    static Type Min(Type a, Type b) { return _mm256_min_ps(a, b); }
+    static Type Max(Type a, Type b) { return _mm256_max_ps(a, b); }
+    static Mask Less(Type a, Type b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Mask Greater(Type a, Type b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static Type Select(Mask mask, Type ifTrue, Type ifFalse) { return _mm256_blendv_ps(ifFalse, ifTrue, mask); }
+    static uint32_t MoveMask(Mask mask) { return static_cast<uint32_t>(_mm256_movemask_ps(mask)); }
+};
+#endif
+
+// Widest lane of this build
+#if defined(MYENGINE_SIMD_AVX)
+using LaneWide = LaneAVX;
+#elif defined(MYENGINE_SIMD_SSE)
+using LaneWide = LaneSSE;
+#else
+using LaneWide = LaneScalar;
+#endif
+
+inline constexpr size_t LaneWidth() { return LaneWide::Width; }
+
+namespace Detail {
+
+/**
+ * @brief Run kernel(i) for i = first, first + W, ... over whole blocks of lane L
+ * @return Index of the first element not processed
+ */
+template<typename L, typename Kernel>
+inline size_t RunBlocks(size_t first, size_t count, Kernel&& kernel) {
+    size_t i = first;
+    for (; i + L::Width <= count; i += L::Width) {
+        kernel(i);
+    }
+    return i;
+}
+
+/**
+ * @brief Wide blocks first, then the scalar tail
+ * Body is a generic lambda taking (lane tag, index)
+ */
+template<typename Body>
+inline void ForEachBlock(size_t count, Body&& body) {
+    size_t i = 0;
+#if defined(MYENGINE_SIMD_SSE) || defined(MYENGINE_SIMD_AVX)
+    i = RunBlocks<LaneWide>(i, count, [&](size_t index) { body(LaneWide{}, index); });
+#endif
+    RunBlocks<LaneScalar>(i, count, [&](size_t index) { body(LaneScalar{}, index); });
+}
+
+/**
+ * @brief acos(x) for x in [0, 1], |error| < 2e-8 (Abramowitz & Stegun 4.4.45)
+ */
+template<typename L>
+inline typename L::Type Acos01(typename L::Type x) {
+    typename L::Type poly = L::Set(-0.0012624911f);
+    poly = L::MulAdd(poly, x, L::Set(0.0066700901f));
+    poly = L::MulAdd(poly, x, L::Set(-0.0170881256f));
+    poly = L::MulAdd(poly, x, L::Set(0.0308918810f));
+    poly = L::MulAdd(poly, x, L::Set(-0.0501743046f));
+    poly = L::MulAdd(poly, x, L::Set(0.0889789874f));
+    poly = L::MulAdd(poly, x, L::Set(-0.2145988016f));
+    poly = L::MulAdd(poly, x, L::Set(1.5707963050f));
+    return L::Mul(L::Sqrt(L::Sub(L::Set(1.0f), x)), poly);
+}
+
+/**
+ * @brief sin(x) for x in [0, pi/2] (Taylor to x^11, |error| < 1e-7)
+ */
+template<typename L>
+inline typename L::Type Sin0ToHalfPi(typename L::Type x) {
+    const typename L::Type x2 = L::Mul(x, x);
+    typename L::Type poly = L::Set(-1.0f / 39916800.0f);
+    poly = L::MulAdd(poly, x2, L::Set(1.0f / 362880.0f));
+    poly = L::MulAdd(poly, x2, L::Set(-1.0f / 5040.0f));
+    poly = L::MulAdd(poly, x2, L::Set(1.0f / 120.0f));
+    poly = L::MulAdd(poly, x2, L::Set(-1.0f / 6.0f));
+    poly = L::MulAdd(poly, x2, L::Set(1.0f));
+    return L::Mul(poly, x);
+}
+
+/**
+ * @brief Normalize a quaternion lane; |q| < 0.0001 becomes identity (as Quat::Normalized)
+ */
+template<typename L>
+inline void NormalizeQuat(typename L::Type& x, typename L::Type& y, typename L::Type& z, typename L::Type& w) {
+    using T = typename L::Type;
+    const T lengthSq = L::MulAdd(x, x, L::MulAdd(y, y, L::MulAdd(z, z, L::Mul(w, w))));
+    const T length = L::Sqrt(lengthSq);
+    const typename L::Mask degenerate = L::Less(length, L::Set(0.0001f));
+    const T invLength = L::Div(L::Set(1.0f), L::Max(length, L::Set(0.0001f)));
+    x = L::Select(degenerate, L::Set(0.0f), L::Mul(x, invLength));
+    y = L::Select(degenerate, L::Set(0.0f), L::Mul(y, invLength));
+    z = L::Select(degenerate, L::Set(0.0f), L::Mul(z, invLength));
+    w = L::Select(degenerate, L::Set(1.0f), L::Mul(w, invLength));
+}
+
+} // namespace Detail
+
+// =============================================================================
+// Kernels
+// =============================================================================
+
+/**
+ * @brief out[i] = m * (p[i], 1) for affine m (bottom row ignored, no perspective divide)
+ */
+inline void TransformPoints(const Mat4& m, ConstVec3SoA points, Vec3SoA out, size_t count) {
+    Detail::ForEachBlock(count, [&](auto lane, size_t i) {
+        using L = decltype(lane);
+        const typename L::Type x = L::Load(points.x + i);
+        const typename L::Type y = L::Load(points.y + i);
+        const typename L::Type z = L::Load(points.z + i);
+        auto row = [&](int r) {
+            return L::MulAdd(L::Set(m.m[8 + r]), z,
+                   L::MulAdd(L::Set(m.m[4 + r]), y, L::MulAdd(L::Set(m.m[r]), x, L::Set(m.m[12 + r]))));
+        };
+        L::Store(out.x + i, row(0));
+        L::Store(out.y + i, row(1));
+        L::Store(out.z + i, row(2));
+    });
+}
+
+/**
+ * @brief out[i] = upper-left 3x3 of m * v[i] (directions: no translation)
+ */
+inline void TransformVectors(const Mat4& m, ConstVec3SoA vectors, Vec3SoA out, size_t count) {
+    Detail::ForEachBlock(count, [&](auto lane, size_t i) {
+        using L = decltype(lane);
+        const typename L::Type x = L::Load(vectors.x + i);
+        const typename L::Type y = L::Load(vectors.y + i);
+        const typename L::Type z = L::Load(vectors.z + i);
+        auto row = [&](int r) {
+            return L::MulAdd(L::Set(m.m[8 + r]), z, L::MulAdd(L::Set(m.m[4 + r]), y, L::Mul(L::Set(m.m[r]), x)));
+        };
+        L::Store(out.x + i, row(0));
+        L::Store(out.y + i, row(1));
+        L::Store(out.z + i, row(2));
+    });
+}
+
+/**
+ * @brief Transform normals by the inverse-transpose of m's 3x3 and renormalize
+ *
+ * 法线矩阵取 3x3 的余子式矩阵（= det * 逆转置），只差一个正比例因子，
+ * 结果本来就要归一化，所以不需要除以行列式；det < 0（镜像）时整体取反保持朝向。
+ * 零长度的法线输出为零向量。
+ */
+inline void TransformNormals(const Mat4& m, ConstVec3SoA normals, Vec3SoA out, size_t count) {
+    // a(row, col) of the upper 3x3 (column-major)
+    auto a = [&](int row, int col) { return m.m[col * 4 + row]; };
+    float n[9];  // n[row * 3 + col] = cofactor(row, col)
+    n[0] = a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1);
+    n[1] = a(1, 2) * a(2, 0) - a(1, 0) * a(2, 2);
+    n[2] = a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0);
+    n[3] = a(0, 2) * a(2, 1) - a(0, 1) * a(2, 2);
+    n[4] = a(0, 0) * a(2, 2) - a(0, 2) * a(2, 0);
+    n[5] = a(0, 1) * a(2, 0) - a(0, 0) * a(2, 1);
+    n[6] = a(0, 1) * a(1, 2) - a(0, 2) * a(1, 1);
+    n[7] = a(0, 2) * a(1, 0) - a(0, 0) * a(1, 2);
+    n[8] = a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0);
+    const float det = a(0, 0) * n[0] + a(0, 1) * n[1] + a(0, 2) * n[2];
+    if (det < 0.0f) {
+        for (float& value : n) value = -value;
+    }
+
+    Detail::ForEachBlock(count, [&](auto lane, size_t i) {
+        using L = decltype(lane);
+        using T = typename L::Type;
+        const T x = L::Load(normals.x + i);
+        const T y = L::Load(normals.y + i);
+        const T z = L::Load(normals.z + i);
+        const T rx = L::MulAdd(L::Set(n[0]), x, L::MulAdd(L::Set(n[1]), y, L::Mul(L::Set(n[2]), z)));
+        const T ry = L::MulAdd(L::Set(n[3]), x, L::MulAdd(L::Set(n[4]), y, L::Mul(L::Set(n[5]), z)));
+        const T rz = L::MulAdd(L::Set(n[6]), x, L::MulAdd(L::Set(n[7]), y, L::Mul(L::Set(n[8]), z)));
+        const T lengthSq = L::MulAdd(rx, rx, L::MulAdd(ry, ry, L::Mul(rz, rz)));
+        const typename L::Mask zero = L::Less(lengthSq, L::Set(1e-30f));
+        const T invLength = L::Select(zero, L::Set(0.0f), L::Div(L::Set(1.0f), L::Sqrt(L::Max(lengthSq, L::Set(1e-30f)))));
+        L::Store(out.x + i, L::Mul(rx, invLength));
+        L::Store(out.y + i, L::Mul(ry, invLength));
+        L::Store(out.z + i, L::Mul(rz, invLength));
+    });
+}
+
+/**
+ * @brief out[i] = a[i] * b[i]
+ *
+ * 矩阵保持 AoS（每个 Mat4 连续 16 个 float）：AVX 下每对矩阵 8 次 8 宽乘加，
+ * 与 16 路 SoA 的运算量相同，却省去进出时的转置。out 可以与 a 或 b 是同一数组。
+ */
+inline void MulMat4(const Mat4* a, const Mat4* b, Mat4* out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        SIMD::Mat4Mul(a[i].m, b[i].m, out[i].m);
+    }
+}
+
+/**
+ * @brief out[i] = parent * b[i] (one matrix applied to many, e.g. a bone palette)
+ */
+inline void MulMat4(const Mat4& parent, const Mat4* b, Mat4* out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        SIMD::Mat4Mul(parent.m, b[i].m, out[i].m);
+    }
+}
+
+/**
+ * @brief out[i] = q[i].ToMatrix() (same formula; quaternions are not normalized)
+ *
+ * 9 个旋转系数按通道并行计算，再逐个写入 Mat4（输出为 AoS，供渲染 / 骨骼直接使用）。
+ */
+inline void QuatToMat4(ConstQuatSoA q, Mat4* out, size_t count) {
+    Detail::ForEachBlock(count, [&](auto lane, size_t i) {
+        using L = decltype(lane);
+        using T = typename L::Type;
+        const T x = L::Load(q.x + i);
+        const T y = L::Load(q.y + i);
+        const T z = L::Load(q.z + i);
+        const T w = L::Load(q.w + i);
+        const T one = L::Set(1.0f);
+        const T two = L::Set(2.0f);
+        const T xx = L::Mul(x, x), yy = L::Mul(y, y), zz = L::Mul(z, z);
+        const T xy = L::Mul(x, y), xz = L::Mul(x, z), yz = L::Mul(y, z);
+        const T wx = L::Mul(w, x), wy = L::Mul(w, y), wz = L::Mul(w, z);
+
+        alignas(32) float coefficients[9][L::Width];
+        L::Store(coefficients[0], L::Sub(one, L::Mul(two, L::Add(yy, zz))));
+        L::Store(coefficients[1], L::Mul(two, L::Add(xy, wz)));
+        L::Store(coefficients[2], L::Mul(two, L::Sub(xz, wy)));
+        L::Store(coefficients[3], L::Mul(two, L::Sub(xy, wz)));
+        L::Store(coefficients[4], L::Sub(one, L::Mul(two, L::Add(xx, zz))));
+        L::Store(coefficients[5], L::Mul(two, L::Add(yz, wx)));
+        L::Store(coefficients[6], L::Mul(two, L::Add(xz, wy)));
+        L::Store(coefficients[7], L::Mul(two, L::Sub(yz, wx)));
+        L::Store(coefficients[8], L::Sub(one, L::Mul(two, L::Add(xx, yy))));
+
+        for (size_t k = 0; k < L::Width; k++) {
+            float* m = out[i + k].m;
+            m[0] = coefficients[0][k];
+            m[1] = coefficients[1][k];
+            m[2] = coefficients[2][k];
+            m[3] = 0.0f;
+            m[4] = coefficients[3][k];
+            m[5] = coefficients[4][k];
+            m[6] = coefficients[5][k];
+            m[7] = 0.0f;
+            m[8] = coefficients[6][k];
+            m[9] = coefficients[7][k];
+            m[10] = coefficients[8][k];
+            m[11] = 0.0f;
+            m[12] = 0.0f;
+            m[13] = 0.0f;
+            m[14] = 0.0f;
+            m[15] = 1.0f;
+        }
+    });
+}
+
+/**
+ * @brief out[i] = Quat::Slerp(a[i], b[i], t[i]), t in [0, 1]
+ *
+ * 与 Quat::Slerp 相同的分支逻辑（先归一化、取短弧、夹角很小时退化为归一化线性插值），
+ * 用通道掩码代替分支；acos / sin 用多项式近似（误差 < 1e-7），因为 SSE/AVX 没有三角函数指令。
+ */
+inline void Slerp(ConstQuatSoA a, ConstQuatSoA b, const float* t, QuatSoA out, size_t count) {
+    Detail::ForEachBlock(count, [&](auto lane, size_t i) {
+        using L = decltype(lane);
+        using T = typename L::Type;
+        T ax = L::Load(a.x + i), ay = L::Load(a.y + i), az = L::Load(a.z + i), aw = L::Load(a.w + i);
+        T bx = L::Load(b.x + i), by = L::Load(b.y + i), bz = L::Load(b.z + i), bw = L::Load(b.w + i);
+        const T factor = L::Load(t + i);
+        Detail::NormalizeQuat<L>(ax, ay, az, aw);
+        Detail::NormalizeQuat<L>(bx, by, bz, bw);
+
+        T dot = L::MulAdd(ax, bx, L::MulAdd(ay, by, L::MulAdd(az, bz, L::Mul(aw, bw))));
+        const T sign = L::Select(L::Less(dot, L::Set(0.0f)), L::Set(-1.0f), L::Set(1.0f));
+        dot = L::Min(L::Mul(dot, sign), L::Set(1.0f));
+
+        const T theta = Detail::Acos01<L>(dot);
+        const T sinTheta = L::Max(Detail::Sin0ToHalfPi<L>(theta), L::Set(1e-6f));
+        const T oneMinusT = L::Sub(L::Set(1.0f), factor);
+        T wa = L::Div(Detail::Sin0ToHalfPi<L>(L::Mul(oneMinusT, theta)), sinTheta);
+        T wb = L::Div(Detail::Sin0ToHalfPi<L>(L::Mul(factor, theta)), sinTheta);
+
+        const typename L::Mask linear = L::Greater(dot, L::Set(0.9995f));
+        wa = L::Select(linear, oneMinusT, wa);
+        wb = L::Mul(L::Select(linear, factor, wb), sign);
+
+        T rx = L::MulAdd(wa, ax, L::Mul(wb, bx));
+        T ry = L::MulAdd(wa, ay, L::Mul(wb, by));
+        T rz = L::MulAdd(wa, az, L::Mul(wb, bz));
+        T rw = L::MulAdd(wa, aw, L::Mul(wb, bw));
+
+        // Linear lanes are renormalized (|r| >= ~0.99 there), slerp lanes are unit already
+        const T lengthSq = L::MulAdd(rx, rx, L::MulAdd(ry, ry, L::MulAdd(rz, rz, L::Mul(rw, rw))));
+        const T scale = L::Select(linear, L::Div(L::Set(1.0f), L::Sqrt(lengthSq)), L::Set(1.0f));
+        L::Store(out.x + i, L::Mul(rx, scale));
+        L::Store(out.y + i, L::Mul(ry, scale));
+        L::Store(out.z + i, L::Mul(rz, scale));
+        L::Store(out.w + i, L::Mul(rw, scale));
+    });
+}
+
+} // namespace Batch
+} // namespace MyEngine
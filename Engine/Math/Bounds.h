@@ -0,0 +1,114 @@
+/******************************************************************************
+ * File: Bounds.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Bounding volumes (axis-aligned box, sphere)
+ ******************************************************************************/
+
+#pragma once
+
+#include "MathTypes.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace MyEngine {
+
+/**
+ * @brief Axis-aligned bounding box
+ * Default-constructed box is empty (min > max) and grows with Expand
+ */
+struct AABB {
+    Vec3 min;
+    Vec3 max;
+
+    AABB() : min(1e30f, 1e30f, 1e30f), max(-1e30f, -1e30f, -1e30f) {}
+    AABB(const Vec3& min, const Vec3& max) : min(min), max(max) {}
+
+    bool IsValid() const {
+        return min.x <= max.x && min.y <= max.y && min.z <= max.z;
+    }
+
+    Vec3 GetCenter() const {
+        return (min + max) * 0.5f;
+    }
+
+    // Half size
+    Vec3 GetExtents() const {
+        return (max - min) * 0.5f;
+    }
+
+    void Expand(const Vec3& point) {
+        min = Vec3(std::fmin(min.x, point.x), std::fmin(min.y, point.y), std::fmin(min.z, point.z));
+        max = Vec3(std::fmax(max.x, point.x), std::fmax(max.y, point.y), std::fmax(max.z, point.z));
+    }
+
+    /**
+     * @brief Bounds of count points read with a byte stride (e.g. &vertices[0].Position, sizeof(Vertex))
+     */
+    static AABB FromPoints(const Vec3* points, size_t count, size_t strideBytes = sizeof(Vec3)) {
+        AABB box;
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(points);
+        for (size_t i = 0; i < count; i++) {
+            box.Expand(*reinterpret_cast<const Vec3*>(bytes + i * strideBytes));
+        }
+        return box;
+    }
+
+    /**
+     * @brief Box enclosing this box after an affine transform
+     *
+     * 新中心 = M * 中心；新半长 = |M 的 3x3| * 半长（逐元素取绝对值，Arvo 方法），
+     * 不需要变换 8 个角点。
+     */
+    AABB Transformed(const Mat3x4& matrix) const {
+        const Vec3 center = matrix.TransformPoint(GetCenter());
+        const Vec3 extents = GetExtents();
+        Vec3 worldExtents;
+        float* out = &worldExtents.x;
+        for (int row = 0; row < 3; row++) {
+            out[row] = std::fabs(matrix.At(row, 0)) * extents.x +
+                       std::fabs(matrix.At(row, 1)) * extents.y +
+                       std::fabs(matrix.At(row, 2)) * extents.z;
+        }
+        return AABB(center - worldExtents, center + worldExtents);
+    }
+};
+
+/**
+ * @brief Bounding sphere
+ */
+struct BoundingSphere {
+    Vec3 center;
+    float radius = 0.0f;
+
+    BoundingSphere() = default;
+    BoundingSphere(const Vec3& center, float radius) : center(center), radius(radius) {}
+
+    /**
+     * @brief Sphere around center reaching the farthest point (center usually the AABB center)
+     */
+    static BoundingSphere FromPoints(const Vec3& center, const Vec3* points, size_t count,
+                                     size_t strideBytes = sizeof(Vec3)) {
+        float maxDistanceSq = 0.0f;
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(points);
+        for (size_t i = 0; i < count; i++) {
+            const Vec3 offset = *reinterpret_cast<const Vec3*>(bytes + i * strideBytes) - center;
+            maxDistanceSq = std::fmax(maxDistanceSq, Vec3::Dot(offset, offset));
+        }
+        return BoundingSphere(center, std::sqrt(maxDistanceSq));
+    }
+
+    /**
+     * @brief Sphere after an affine transform (radius scaled by the largest axis scale)
+     */
+    BoundingSphere Transformed(const Mat3x4& matrix) const {
+        float maxScaleSq = 0.0f;
+        for (int col = 0; col < 3; col++) {
+            const float x = matrix.At(0, col), y = matrix.At(1, col), z = matrix.At(2, col);
+            maxScaleSq = std::fmax(maxScaleSq, x * x + y * y + z * z);
+        }
+        return BoundingSphere(matrix.TransformPoint(center), radius * std::sqrt(maxScaleSq));
+    }
+};
+
+} // namespace MyEngine
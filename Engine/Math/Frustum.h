@@ -0,0 +1,128 @@
+/******************************************************************************
+ * File: Frustum.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: View frustum planes and batched bounds culling
+ ******************************************************************************/
+
+#pragma once
+
+#include "MathTypes.h"
+#include "Bounds.h"
+#include "BatchMath.h"
+#include <cstdint>
+
+namespace MyEngine {
+
+/**
+ * @brief World-space bounds as SoA streams (AABB center / half extents + sphere radius)
+ * The sphere shares the AABB center
+ */
+struct BoundsSoA {
+    const float* centerX;
+    const float* centerY;
+    const float* centerZ;
+    const float* extentX;
+    const float* extentY;
+    const float* extentZ;
+    const float* radius;
+};
+
+/**
+ * @brief Six clip planes of a view-projection matrix
+ *
+ * 平面为 (n, d)，n 已归一化，点 p 在内侧当且仅当 dot(n, p) + d >= 0。
+ * 从列主序 view-projection 矩阵的行组合提取（Gribb / Hartmann），OpenGL 裁剪空间 -w..w。
+ */
+struct Frustum {
+    enum PlaneIndex { Left = 0, Right, Bottom, Top, Near, Far, PlaneCount };
+
+    Vec4 planes[PlaneCount];
+
+    static Frustum FromViewProjection(const Mat4& viewProjection) {
+        const float* m = viewProjection.m;
+        auto row = [m](int r) { return Vec4(m[r], m[4 + r], m[8 + r], m[12 + r]); };
+        const Vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+        Frustum frustum;
+        frustum.planes[Left] = r3 + r0;
+        frustum.planes[Right] = r3 - r0;
+        frustum.planes[Bottom] = r3 + r1;
+        frustum.planes[Top] = r3 - r1;
+        frustum.planes[Near] = r3 + r2;
+        frustum.planes[Far] = r3 - r2;
+        for (Vec4& plane : frustum.planes) {
+            const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+            if (length > 0.0f) {
+                plane = plane * (1.0f / length);
+            }
+        }
+        return frustum;
+    }
+
+    float Distance(int plane, const Vec3& point) const {
+        const Vec4& p = planes[plane];
+        return p.x * point.x + p.y * point.y + p.z * point.z + p.w;
+    }
+
+    bool Intersects(const BoundingSphere& sphere) const {
+        for (int i = 0; i < PlaneCount; i++) {
+            if (Distance(i, sphere.center) < -sphere.radius) return false;
+        }
+        return true;
+    }
+
+    bool Intersects(const AABB& box) const {
+        const Vec3 center = box.GetCenter();
+        const Vec3 extents = box.GetExtents();
+        for (int i = 0; i < PlaneCount; i++) {
+            const Vec4& p = planes[i];
+            const float reach = std::fabs(p.x) * extents.x + std::fabs(p.y) * extents.y + std::fabs(p.z) * extents.z;
+            if (Distance(i, center) < -reach) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Append the indices (indexBase + i) of bounds [0, count) that may be visible
+     * @return Number of indices written to visibleOut (room for count needed)
+     *
+     * 每个平面上取 min(球半径, AABB 投影半长) 作为投影范围，两者都是保守的，取较小者更紧。
+     * 一个元素只要在某个平面外侧即被剔除（保守：可能保留少量在角落外侧的物体）。
+     * 按 Batch 通道整块计算（AVX 一次 8 个，SSE 一次 4 个），MoveMask 得到可见位后压缩写出。
+     */
+    size_t Cull(const BoundsSoA& bounds, size_t count, uint32_t indexBase, uint32_t* visibleOut) const {
+        size_t written = 0;
+        Batch::Detail::ForEachBlock(count, [&](auto lane, size_t i) {
+            using L = decltype(lane);
+            using T = typename L::Type;
+            const T cx = L::Load(bounds.centerX + i);
+            const T cy = L::Load(bounds.centerY + i);
+            const T cz = L::Load(bounds.centerZ + i);
+            const T ex = L::Load(bounds.extentX + i);
+            const T ey = L::Load(bounds.extentY + i);
+            const T ez = L::Load(bounds.extentZ + i);
+            const T radius = L::Load(bounds.radius + i);
+
+            // Smallest signed margin over all planes; negative = outside one of them
+            T margin = L::Set(1e30f);
+            for (const Vec4& p : planes) {
+                const T distance = L::MulAdd(L::Set(p.x), cx,
+                                   L::MulAdd(L::Set(p.y), cy, L::MulAdd(L::Set(p.z), cz, L::Set(p.w))));
+                const T boxReach = L::MulAdd(L::Set(std::fabs(p.x)), ex,
+                                   L::MulAdd(L::Set(std::fabs(p.y)), ey, L::Mul(L::Set(std::fabs(p.z)), ez)));
+                margin = L::Min(margin, L::Add(distance, L::Min(radius, boxReach)));
+            }
+
+            uint32_t visibleBits = ~L::MoveMask(L::Less(margin, L::Set(0.0f))) & ((1u << L::Width) - 1u);
+            for (uint32_t k = 0; visibleBits != 0; k++, visibleBits >>= 1) {
+                if (visibleBits & 1u) {
+                    visibleOut[written++] = indexBase + static_cast<uint32_t>(i + k);
+                }
+            }
+        });
+        return written;
+    }
+};
+
+} // namespace MyEngine
@@ -0,0 +1,57 @@
+/******************************************************************************
+ * File: MathSIMD.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Typed SIMD helpers for hot matrix paths (see SIMDKernels.h)
+ ******************************************************************************/
+
+#pragma once
+
+#include "MathTypes.h"
+
+// Backend selection (MYENGINE_SIMD_*) and the raw float kernels live in SIMDKernels.h
+
+namespace MyEngine {
+namespace SIMD {
+
+/**
+ * @brief out = a * b for column-major matrices (same result as Mat4::operator*)
+ *
+ * 结果的第 j 列 = a 的四列按 b 第 j 列的四个分量加权求和。
+ * AVX 下一次计算两列，SSE 下一次一列（见 SIMD::Mat4Mul）；out 可以与 a 或 b 重叠。
+ */
+inline void MulMat4(const Mat4& a, const Mat4& b, Mat4& out) {
+    Mat4Mul(a.m, b.m, out.m);
+}
+
+/**
+ * @brief out = a * b for 3x4 affine matrices (same result as Mat3x4::operator*)
+ *
+ * 结果第 i 行 = a[i][0] * b 行0 + a[i][1] * b 行1 + a[i][2] * b 行2 + (0, 0, 0, a[i][3])。
+ * 每行一次广播乘加，共 9 次乘法 + 12 次加法（向量）；out 可以与 a 或 b 重叠。
+ */
+inline void MulAffine(const Mat3x4& a, const Mat3x4& b, Mat3x4& out) {
+#if defined(MYENGINE_SIMD_SSE)
+    const __m128 b0 = _mm_loadu_ps(b.m + 0);
+    const __m128 b1 = _mm_loadu_ps(b.m + 4);
+    const __m128 b2 = _mm_loadu_ps(b.m + 8);
+    const __m128 translationMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+
+    __m128 r[3];
+    for (int row = 0; row < 3; ++row) {
+        const __m128 ar = _mm_loadu_ps(a.m + row * 4);
+        __m128 sum = _mm_and_ps(ar, translationMask);
+        sum = MulAdd(Swizzle<0, 0, 0, 0>(ar), b0, sum);
+        sum = MulAdd(Swizzle<1, 1, 1, 1>(ar), b1, sum);
+        r[row] = MulAdd(Swizzle<2, 2, 2, 2>(ar), b2, sum);
+    }
+    for (int row = 0; row < 3; ++row) {
+        _mm_storeu_ps(out.m + row * 4, r[row]);
+    }
+#else
+    out = a * b;
+#endif
+}
+
+} // namespace SIMD
+} // namespace MyEngine
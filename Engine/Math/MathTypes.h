@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "SIMDKernels.h"
 #include <cmath>
 #include <iostream>
 
@@ -108,6 +109,38 @@ struct Vec4 {
 
     Vec4() : x(0), y(0), z(0), w(0) {}
     Vec4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+    Vec4 operator+(const Vec4& other) const {
+        Vec4 result;
+        SIMD::Vec4Add(&x, &other.x, &result.x);
+        return result;
+    }
+
+    Vec4 operator-(const Vec4& other) const {
+        Vec4 result;
+        SIMD::Vec4Sub(&x, &other.x, &result.x);
+        return result;
+    }
+
+    Vec4 operator*(float scalar) const {
+        Vec4 result;
+        SIMD::Vec4Scale(&x, scalar, &result.x);
+        return result;
+    }
+
+    float Dot(const Vec4& other) const {
+        return SIMD::Vec4Dot(&x, &other.x);
+    }
+
+    float Length() const {
+        return std::sqrt(Dot(*this));
+    }
+
+    Vec4 Normalized() const {
+        Vec4 result;
+        SIMD::Vec4Normalize(&x, &result.x, 0.0001f);
+        return result;
+    }
 };
 
 /**
@@ -132,10 +165,15 @@ struct Mat3 {
 struct Mat4 {
     float m[16];
 
+    // Tag for temporaries that are fully overwritten (skips the identity fill)
+    struct UninitializedTag {};
+
     Mat4() {
         Identity();
     }
 
+    explicit Mat4(UninitializedTag) {}
+
     void Identity() {
         for (int i = 0; i < 16; i++) m[i] = 0;
         m[0] = m[5] = m[10] = m[15] = 1.0f;
@@ -206,19 +244,14 @@ struct Mat4 {
     }
 
     Mat4 operator*(const Mat4& other) const {
-        Mat4 result;
-        for (int row = 0; row < 4; row++) {
-            for (int col = 0; col < 4; col++) {
-                float sum = 0;
-                for (int i = 0; i < 4; i++) {
-                    sum += m[i * 4 + row] * other.m[col * 4 + i];
-                }
-                result.m[col * 4 + row] = sum;
-            }
-        }
+        Mat4 result{UninitializedTag{}};
+        SIMD::Mat4Mul(m, other.m, result.m);
         return result;
     }
     
+    // Kept scalar: v is usually built from scalars just before the call, and a 128-bit reload
+    // of it stalls on store forwarding; scalar code also auto-vectorizes across loop iterations.
+    // Bulk transforms belong in Batch::TransformPoints (BatchMath.h).
     Vec4 operator*(const Vec4& v) const {
         Vec4 result;
         result.x = m[0] * v.x + m[4] * v.y + m[8] * v.z + m[12] * v.w;
@@ -228,8 +261,26 @@ struct Mat4 {
         return result;
     }
 
+    Mat4 Transposed() const {
+        Mat4 result{UninitializedTag{}};
+        SIMD::Mat4Transpose(m, result.m);
+        return result;
+    }
+
+    /**
+     * @brief General inverse (any invertible matrix, incl. projection / view-projection)
+     * Returns identity for a singular matrix
+     */
     Mat4 Inverted() const {
-        // Simplified inverse for translation + rotation matrices only (orthonormal)
+        Mat4 result{UninitializedTag{}};
+        SIMD::Mat4Inverse(m, result.m);
+        return result;
+    }
+
+    /**
+     * @brief Cheaper inverse for rotation + translation matrices only (orthonormal)
+     */
+    Mat4 InvertedOrthonormal() const {
         Mat4 result;
         // Transpose of rotation part
         for (int i = 0; i < 3; i++) {
@@ -259,12 +310,26 @@ struct Quat {
         return Quat(0, 0, 0, 1);
     }
     
+    // Hamilton product: (a * b) applies b first, then a
+    Quat operator*(const Quat& other) const {
+        Quat result;
+        SIMD::QuatMul(&x, &other.x, &result.x);
+        return result;
+    }
+
+    float Dot(const Quat& other) const {
+        return SIMD::Vec4Dot(&x, &other.x);
+    }
+
+    Quat Conjugate() const {
+        return Quat(-x, -y, -z, w);
+    }
+
     // Normalize quaternion
     Quat Normalized() const {
-        float len = sqrtf(x * x + y * y + z * z + w * w);
-        if (len < 0.0001f)
-            return Quat(0, 0, 0, 1);
-        return Quat(x / len, y / len, z / len, w / len);
+        Quat result;  // identity if too short
+        SIMD::Vec4Normalize(&x, &result.x, 0.0001f);
+        return result;
     }
     
     // Spherical linear interpolation
@@ -272,25 +337,20 @@ struct Quat {
         Quat qa = a.Normalized();
         Quat qb = b.Normalized();
         
-        float dot = qa.x * qb.x + qa.y * qb.y + qa.z * qb.z + qa.w * qb.w;
+        float dot = qa.Dot(qb);
         
         // If negative dot, negate one quaternion
+        float sign = 1.0f;
         if (dot < 0.0f) {
-            qb.x = -qb.x;
-            qb.y = -qb.y;
-            qb.z = -qb.z;
-            qb.w = -qb.w;
+            sign = -1.0f;
             dot = -dot;
         }
         
         // If quaternions are very close, use linear interpolation
+        Quat result;
         if (dot > 0.9995f) {
-            return Quat(
-                qa.x + t * (qb.x - qa.x),
-                qa.y + t * (qb.y - qa.y),
-                qa.z + t * (qb.z - qa.z),
-                qa.w + t * (qb.w - qa.w)
-            ).Normalized();
+            SIMD::Vec4Blend(&qa.x, 1.0f - t, &qb.x, sign * t, &result.x);
+            return result.Normalized();
         }
         
         float theta = acosf(dot);
@@ -298,12 +358,8 @@ struct Quat {
         float wa = sinf((1.0f - t) * theta) / sinTheta;
         float wb = sinf(t * theta) / sinTheta;
         
-        return Quat(
-            wa * qa.x + wb * qb.x,
-            wa * qa.y + wb * qb.y,
-            wa * qa.z + wb * qb.z,
-            wa * qa.w + wb * qb.w
-        );
+        SIMD::Vec4Blend(&qa.x, wa, &qb.x, sign * wb, &result.x);
+        return result;
     }
     
     // Convert quaternion to rotation matrix
@@ -344,4 +400,135 @@ struct Quat {
     }
 };
 
+/**
+ * @brief 3x4 affine matrix (row-major, implicit last row 0 0 0 1)
+ *
+ * 每行 4 个 float：[r0 r1 r2 t]，平移在第 4 列。比 Mat4 少存一行（48 字节 vs 64 字节），
+ * 行布局可直接作为 3 个 vec4 上传；与 Mat4 的乘法、求逆都只做仿射部分。
+ */
+struct Mat3x4 {
+    float m[12];
+
+    Mat3x4() {
+        Identity();
+    }
+
+    void Identity() {
+        for (int i = 0; i < 12; i++) m[i] = 0;
+        m[0] = m[5] = m[10] = 1.0f;
+    }
+
+    float& At(int row, int col) { return m[row * 4 + col]; }
+    float At(int row, int col) const { return m[row * 4 + col]; }
+
+    Vec3 GetTranslation() const {
+        return Vec3(m[3], m[7], m[11]);
+    }
+
+    /**
+     * @brief Build T * R * S directly (no matrix products)
+     * Rotation need not be normalized; it is scaled by 2 / |q|^2
+     */
+    static Mat3x4 FromTRS(const Vec3& position, const Quat& rotation, const Vec3& scale) {
+        const float lengthSq = rotation.x * rotation.x + rotation.y * rotation.y +
+                               rotation.z * rotation.z + rotation.w * rotation.w;
+        const float s = lengthSq > 0.0f ? 2.0f / lengthSq : 0.0f;
+        const float xs = rotation.x * s, ys = rotation.y * s, zs = rotation.z * s;
+        const float xx = rotation.x * xs, yy = rotation.y * ys, zz = rotation.z * zs;
+        const float xy = rotation.x * ys, xz = rotation.x * zs, yz = rotation.y * zs;
+        const float wx = rotation.w * xs, wy = rotation.w * ys, wz = rotation.w * zs;
+
+        Mat3x4 result;
+        result.m[0] = (1.0f - (yy + zz)) * scale.x;
+        result.m[1] = (xy - wz) * scale.y;
+        result.m[2] = (xz + wy) * scale.z;
+        result.m[3] = position.x;
+
+        result.m[4] = (xy + wz) * scale.x;
+        result.m[5] = (1.0f - (xx + zz)) * scale.y;
+        result.m[6] = (yz - wx) * scale.z;
+        result.m[7] = position.y;
+
+        result.m[8] = (xz - wy) * scale.x;
+        result.m[9] = (yz + wx) * scale.y;
+        result.m[10] = (1.0f - (xx + yy)) * scale.z;
+        result.m[11] = position.z;
+        return result;
+    }
+
+    static Mat3x4 FromMat4(const Mat4& matrix) {
+        Mat3x4 result;
+        for (int row = 0; row < 3; row++) {
+            for (int col = 0; col < 4; col++) {
+                result.m[row * 4 + col] = matrix.m[col * 4 + row];
+            }
+        }
+        return result;
+    }
+
+    Mat4 ToMat4() const {
+        Mat4 result;
+        for (int row = 0; row < 3; row++) {
+            for (int col = 0; col < 4; col++) {
+                result.m[col * 4 + row] = m[row * 4 + col];
+            }
+        }
+        return result;
+    }
+
+    Mat3x4 operator*(const Mat3x4& other) const {
+        Mat3x4 result;
+        for (int row = 0; row < 3; row++) {
+            const float* a = m + row * 4;
+            for (int col = 0; col < 4; col++) {
+                result.m[row * 4 + col] = a[0] * other.m[col] + a[1] * other.m[4 + col] + a[2] * other.m[8 + col];
+            }
+            result.m[row * 4 + 3] += a[3];
+        }
+        return result;
+    }
+
+    Vec3 TransformPoint(const Vec3& p) const {
+        return Vec3(m[0] * p.x + m[1] * p.y + m[2] * p.z + m[3],
+                    m[4] * p.x + m[5] * p.y + m[6] * p.z + m[7],
+                    m[8] * p.x + m[9] * p.y + m[10] * p.z + m[11]);
+    }
+
+    Vec3 TransformVector(const Vec3& v) const {
+        return Vec3(m[0] * v.x + m[1] * v.y + m[2] * v.z,
+                    m[4] * v.x + m[5] * v.y + m[6] * v.z,
+                    m[8] * v.x + m[9] * v.y + m[10] * v.z);
+    }
+
+    /**
+     * @brief General affine inverse (any invertible linear part, including non-uniform scale)
+     * 线性部分的逆 = 伴随矩阵 / 行列式（由列向量叉积得到），平移 = -inv(L) * t。
+     * 奇异矩阵返回单位矩阵。
+     */
+    Mat3x4 Inverted() const {
+        const Vec3 c0(m[0], m[4], m[8]);
+        const Vec3 c1(m[1], m[5], m[9]);
+        const Vec3 c2(m[2], m[6], m[10]);
+        // Rows of the inverse are the cross products of the columns
+        const Vec3 r0 = Vec3::Cross(c1, c2);
+        const Vec3 r1 = Vec3::Cross(c2, c0);
+        const Vec3 r2 = Vec3::Cross(c0, c1);
+        const float det = Vec3::Dot(c0, r0);
+        if (std::fabs(det) < 1e-12f) {
+            return Mat3x4();
+        }
+        const float invDet = 1.0f / det;
+
+        Mat3x4 result;
+        const Vec3 rows[3] = { r0 * invDet, r1 * invDet, r2 * invDet };
+        for (int row = 0; row < 3; row++) {
+            result.m[row * 4 + 0] = rows[row].x;
+            result.m[row * 4 + 1] = rows[row].y;
+            result.m[row * 4 + 2] = rows[row].z;
+            result.m[row * 4 + 3] = -(rows[row].x * m[3] + rows[row].y * m[7] + rows[row].z * m[11]);
+        }
+        return result;
+    }
+};
+
 } // namespace MyEngine
@@ -0,0 +1,372 @@
+/******************************************************************************
+ * File: SIMDKernels.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: SIMD backend for the math types (SSE2 / SSE4.1 / AVX / FMA, scalar fallback)
+ ******************************************************************************/
+
+#pragma once
+
+#include <cmath>
+
+/**
+ * 后端在编译期按编译器目标选择（-msse4.1 / -mavx2 -mfma / MSVC /arch:AVX2 等）：
+ *   MYENGINE_SIMD_SSE    SSE2（x86-64 基线）
+ *   MYENGINE_SIMD_SSE41  点积用 _mm_dp_ps
+ *   MYENGINE_SIMD_AVX    矩阵乘法一次计算两列
+ *   MYENGINE_SIMD_FMA    乘加融合
+ * 定义 MYENGINE_SIMD_FORCE_SCALAR 可强制使用标量实现（对照测试用）。
+ *
+ * 内核只接受 float 指针（列主序矩阵、xyzw 四元数），不依赖 MathTypes.h，
+ * 由 Mat4 / Vec4 / Quat 的成员函数调用；输出可以与输入重叠。
+ */
+#if !defined(MYENGINE_SIMD_FORCE_SCALAR)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define MYENGINE_SIMD_SSE 1
+        #include <emmintrin.h>
+    #endif
+    #if defined(MYENGINE_SIMD_SSE) && (defined(__SSE4_1__) || defined(__AVX__))
+        #define MYENGINE_SIMD_SSE41 1
+        #include <smmintrin.h>
+    #endif
+    #if defined(__AVX__)
+        #define MYENGINE_SIMD_AVX 1
+        #include <immintrin.h>
+    #endif
+    #if defined(MYENGINE_SIMD_AVX) && (defined(__FMA__) || defined(__AVX2__))
+        #define MYENGINE_SIMD_FMA 1
+    #endif
+#endif
+
+namespace MyEngine {
+namespace SIMD {
+
+inline constexpr const char* BackendName() {
+#if defined(MYENGINE_SIMD_FMA)
+    return "AVX + FMA";
+#elif defined(MYENGINE_SIMD_AVX)
+    return "AVX";
+#elif defined(MYENGINE_SIMD_SSE41)
+    return "SSE4.1";
+#elif defined(MYENGINE_SIMD_SSE)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
+
+#if defined(MYENGINE_SIMD_SSE)
+
+inline __m128 MulAdd(__m128 a, __m128 b, __m128 c) {
+#if defined(MYENGINE_SIMD_FMA)
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+template<int X, int Y, int Z, int W>
+inline __m128 Swizzle(__m128 v) {
+    return _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(v), _MM_SHUFFLE(W, Z, Y, X)));
+}
+
+// Dot product broadcast to all lanes
+inline __m128 Dot4(__m128 a, __m128 b) {
+#if defined(MYENGINE_SIMD_SSE41)
+    return _mm_dp_ps(a, b, 0xFF);
+#else
+    __m128 product = _mm_mul_ps(a, b);
+    product = _mm_add_ps(product, Swizzle<2, 3, 0, 1>(product));
+    return _mm_add_ps(product, Swizzle<1, 0, 3, 2>(product));
+#endif
+}
+
+// Column of out = a * column
+inline __m128 MulColumn(__m128 a0, __m128 a1, __m128 a2, __m128 a3, __m128 column) {
+    __m128 sum = _mm_mul_ps(a0, Swizzle<0, 0, 0, 0>(column));
+    sum = MulAdd(a1, Swizzle<1, 1, 1, 1>(column), sum);
+    sum = MulAdd(a2, Swizzle<2, 2, 2, 2>(column), sum);
+    return MulAdd(a3, Swizzle<3, 3, 3, 3>(column), sum);
+}
+
+#endif // MYENGINE_SIMD_SSE
+
+// =============================================================================
+// Mat4 (column-major float[16])
+// =============================================================================
+
+inline void Mat4Mul(const float* a, const float* b, float* out) {
+#if defined(MYENGINE_SIMD_AVX)
+    const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 0));
+    const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+    const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+    const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+    auto columns = [&](__m256 bc) {
+        __m256 r = _mm256_mul_ps(a0, _mm256_shuffle_ps(bc, bc, 0x00));
+#if defined(MYENGINE_SIMD_FMA)
+        r = _mm256_fmadd_ps(a1, _mm256_shuffle_ps(bc, bc, 0x55), r);
+        r = _mm256_fmadd_ps(a2, _mm256_shuffle_ps(bc, bc, 0xAA), r);
+        return _mm256_fmadd_ps(a3, _mm256_shuffle_ps(bc, bc, 0xFF), r);
+#else
+        r = _mm256_add_ps(r, _mm256_mul_ps(a1, _mm256_shuffle_ps(bc, bc, 0x55)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(a2, _mm256_shuffle_ps(bc, bc, 0xAA)));
+        return _mm256_add_ps(r, _mm256_mul_ps(a3, _mm256_shuffle_ps(bc, bc, 0xFF)));
+#endif
+    };
+    const __m256 r01 = columns(_mm256_loadu_ps(b));
+    const __m256 r23 = columns(_mm256_loadu_ps(b + 8));
+    _mm256_storeu_ps(out, r01);
+    _mm256_storeu_ps(out + 8, r23);
+#elif defined(MYENGINE_SIMD_SSE)
+    const __m128 a0 = _mm_loadu_ps(a + 0);
+    const __m128 a1 = _mm_loadu_ps(a + 4);
+    const __m128 a2 = _mm_loadu_ps(a + 8);
+    const __m128 a3 = _mm_loadu_ps(a + 12);
+    const __m128 r0 = MulColumn(a0, a1, a2, a3, _mm_loadu_ps(b + 0));
+    const __m128 r1 = MulColumn(a0, a1, a2, a3, _mm_loadu_ps(b + 4));
+    const __m128 r2 = MulColumn(a0, a1, a2, a3, _mm_loadu_ps(b + 8));
+    const __m128 r3 = MulColumn(a0, a1, a2, a3, _mm_loadu_ps(b + 12));
+    _mm_storeu_ps(out + 0, r0);
+    _mm_storeu_ps(out + 4, r1);
+    _mm_storeu_ps(out + 8, r2);
+    _mm_storeu_ps(out + 12, r3);
+#else
+    float result[16];
+    for (int col = 0; col < 4; col++) {
+        for (int row = 0; row < 4; row++) {
+            result[col * 4 + row] = a[row] * b[col * 4] + a[4 + row] * b[col * 4 + 1] +
+                                    a[8 + row] * b[col * 4 + 2] + a[12 + row] * b[col * 4 + 3];
+        }
+    }
+    for (int i = 0; i < 16; i++) out[i] = result[i];
+#endif
+}
+
+inline void Mat4MulVec4(const float* m, const float* v, float* out) {
+#if defined(MYENGINE_SIMD_SSE)
+    const __m128 r = MulColumn(_mm_loadu_ps(m), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8),
+                               _mm_loadu_ps(m + 12), _mm_loadu_ps(v));
+    _mm_storeu_ps(out, r);
+#else
+    float result[4];
+    for (int row = 0; row < 4; row++) {
+        result[row] = m[row] * v[0] + m[4 + row] * v[1] + m[8 + row] * v[2] + m[12 + row] * v[3];
+    }
+    for (int i = 0; i < 4; i++) out[i] = result[i];
+#endif
+}
+
+inline void Mat4Transpose(const float* m, float* out) {
+#if defined(MYENGINE_SIMD_SSE)
+    __m128 c0 = _mm_loadu_ps(m), c1 = _mm_loadu_ps(m + 4), c2 = _mm_loadu_ps(m + 8), c3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    _mm_storeu_ps(out, c0);
+    _mm_storeu_ps(out + 4, c1);
+    _mm_storeu_ps(out + 8, c2);
+    _mm_storeu_ps(out + 12, c3);
+#else
+    float result[16];
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            result[row * 4 + col] = m[col * 4 + row];
+        }
+    }
+    for (int i = 0; i < 16; i++) out[i] = result[i];
+#endif
+}
+
+/**
+ * @brief General 4x4 inverse
+ * @return false (out = identity) if the matrix is singular
+ *
+ * SSE 版本按 2x2 分块求逆：M = [A B; C D]，用伴随矩阵与分块行列式
+ * |M| = |A||D| + |B||C| - tr((A#B)(D#C)) 一次算出四个子块，无分支、无除法以外的标量运算。
+ * 分块算法对行主序 / 列主序同样成立（转置的逆 = 逆的转置）。
+ */
+inline bool Mat4Inverse(const float* m, float* out) {
+#if defined(MYENGINE_SIMD_SSE)
+    // 2x2 blocks packed as (m00 m01 m10 m11)
+    auto mat2Mul = [](__m128 a, __m128 b) {
+        return _mm_add_ps(_mm_mul_ps(a, Swizzle<0, 3, 0, 3>(b)),
+                          _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+    };
+    auto mat2AdjMul = [](__m128 a, __m128 b) {  // adj(a) * b
+        return _mm_sub_ps(_mm_mul_ps(Swizzle<3, 3, 0, 0>(a), b),
+                          _mm_mul_ps(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+    };
+    auto mat2MulAdj = [](__m128 a, __m128 b) {  // a * adj(b)
+        return _mm_sub_ps(_mm_mul_ps(a, Swizzle<3, 0, 3, 0>(b)),
+                          _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+    };
+
+    const __m128 v0 = _mm_loadu_ps(m), v1 = _mm_loadu_ps(m + 4), v2 = _mm_loadu_ps(m + 8), v3 = _mm_loadu_ps(m + 12);
+    const __m128 A = _mm_movelh_ps(v0, v1);
+    const __m128 B = _mm_movehl_ps(v1, v0);
+    const __m128 C = _mm_movelh_ps(v2, v3);
+    const __m128 D = _mm_movehl_ps(v3, v2);
+
+    // (|A| |B| |C| |D|)
+    const __m128 detSub = _mm_sub_ps(
+        _mm_mul_ps(_mm_shuffle_ps(v0, v2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(v1, v3, _MM_SHUFFLE(3, 1, 3, 1))),
+        _mm_mul_ps(_mm_shuffle_ps(v0, v2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(v1, v3, _MM_SHUFFLE(2, 0, 2, 0))));
+    const __m128 detA = Swizzle<0, 0, 0, 0>(detSub);
+    const __m128 detB = Swizzle<1, 1, 1, 1>(detSub);
+    const __m128 detC = Swizzle<2, 2, 2, 2>(detSub);
+    const __m128 detD = Swizzle<3, 3, 3, 3>(detSub);
+
+    const __m128 DC = mat2AdjMul(D, C);
+    const __m128 AB = mat2AdjMul(A, B);
+    __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), mat2Mul(B, DC));
+    __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), mat2Mul(C, AB));
+    __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), mat2MulAdj(D, AB));
+    __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), mat2MulAdj(A, DC));
+
+    __m128 trace = _mm_mul_ps(AB, Swizzle<0, 2, 1, 3>(DC));
+    trace = _mm_add_ps(trace, Swizzle<2, 3, 0, 1>(trace));
+    trace = _mm_add_ps(trace, Swizzle<1, 0, 3, 2>(trace));
+    const __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+    if (_mm_cvtss_f32(detM) == 0.0f) {
+        for (int i = 0; i < 16; i++) out[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+        return false;
+    }
+
+    const __m128 rcpDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+    X = _mm_mul_ps(X, rcpDet);
+    Y = _mm_mul_ps(Y, rcpDet);
+    Z = _mm_mul_ps(Z, rcpDet);
+    W = _mm_mul_ps(W, rcpDet);
+
+    _mm_storeu_ps(out + 0, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(out + 4, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(0, 2, 0, 2)));
+    _mm_storeu_ps(out + 8, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(out + 12, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(0, 2, 0, 2)));
+    return true;
+#else
+    // Cofactor expansion
+    float inv[16];
+    inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+    inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+    inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+    inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+    inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+    inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+    inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+    inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+    inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+    inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+    inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+    inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+    inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+    inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+    inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+    inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+    const float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+    if (det == 0.0f) {
+        for (int i = 0; i < 16; i++) out[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+        return false;
+    }
+    const float invDet = 1.0f / det;
+    for (int i = 0; i < 16; i++) out[i] = inv[i] * invDet;
+    return true;
+#endif
+}
+
+// =============================================================================
+// Vec4 / Quat (float[4], quaternions as x y z w)
+// =============================================================================
+
+inline void Vec4Add(const float* a, const float* b, float* out) {
+#if defined(MYENGINE_SIMD_SSE)
+    _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#else
+    for (int i = 0; i < 4; i++) out[i] = a[i] + b[i];
+#endif
+}
+
+inline void Vec4Sub(const float* a, const float* b, float* out) {
+#if defined(MYENGINE_SIMD_SSE)
+    _mm_storeu_ps(out, _mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#else
+    for (int i = 0; i < 4; i++) out[i] = a[i] - b[i];
+#endif
+}
+
+inline void Vec4Scale(const float* a, float s, float* out) {
+#if defined(MYENGINE_SIMD_SSE)
+    _mm_storeu_ps(out, _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(s)));
+#else
+    for (int i = 0; i < 4; i++) out[i] = a[i] * s;
+#endif
+}
+
+inline float Vec4Dot(const float* a, const float* b) {
+#if defined(MYENGINE_SIMD_SSE)
+    return _mm_cvtss_f32(Dot4(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#else
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+#endif
+}
+
+/**
+ * @brief out = wa * a + wb * b
+ */
+inline void Vec4Blend(const float* a, float wa, const float* b, float wb, float* out) {
+#if defined(MYENGINE_SIMD_SSE)
+    _mm_storeu_ps(out, MulAdd(_mm_loadu_ps(b), _mm_set1_ps(wb), _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(wa))));
+#else
+    for (int i = 0; i < 4; i++) out[i] = wa * a[i] + wb * b[i];
+#endif
+}
+
+/**
+ * @brief out = v / |v|; returns false (out untouched) if |v| < minLength
+ */
+inline bool Vec4Normalize(const float* v, float* out, float minLength) {
+#if defined(MYENGINE_SIMD_SSE)
+    const __m128 value = _mm_loadu_ps(v);
+    const __m128 length = _mm_sqrt_ps(Dot4(value, value));
+    if (_mm_cvtss_f32(length) < minLength) {
+        return false;
+    }
+    _mm_storeu_ps(out, _mm_div_ps(value, length));
+    return true;
+#else
+    const float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3]);
+    if (length < minLength) {
+        return false;
+    }
+    for (int i = 0; i < 4; i++) out[i] = v[i] / length;
+    return true;
+#endif
+}
+
+/**
+ * @brief Hamilton product out = a * b (apply b first, then a)
+ */
+inline void QuatMul(const float* a, const float* b, float* out) {
+#if defined(MYENGINE_SIMD_SSE)
+    const __m128 qa = _mm_loadu_ps(a);
+    const __m128 qb = _mm_loadu_ps(b);
+    const __m128 signX = _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f);
+    const __m128 signY = _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f);
+    const __m128 signZ = _mm_setr_ps(-1.0f, 1.0f, 1.0f, -1.0f);
+    __m128 r = _mm_mul_ps(Swizzle<3, 3, 3, 3>(qa), qb);
+    r = MulAdd(_mm_mul_ps(Swizzle<0, 0, 0, 0>(qa), signX), Swizzle<3, 2, 1, 0>(qb), r);
+    r = MulAdd(_mm_mul_ps(Swizzle<1, 1, 1, 1>(qa), signY), Swizzle<2, 3, 0, 1>(qb), r);
+    r = MulAdd(_mm_mul_ps(Swizzle<2, 2, 2, 2>(qa), signZ), Swizzle<1, 0, 3, 2>(qb), r);
+    _mm_storeu_ps(out, r);
+#else
+    const float x = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+    const float y = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+    const float z = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+    const float w = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+    out[0] = x;
+    out[1] = y;
+    out[2] = z;
+    out[3] = w;
+#endif
+}
+
+} // namespace SIMD
+} // namespace MyEngine
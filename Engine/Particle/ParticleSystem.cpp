@@ -7,7 +7,9 @@
 #include "Rendering/OpenGL/OpenGLShader.h"
 #include "Rendering/OpenGL/OpenGLVertexArray.h"
 #include "Rendering/OpenGL/OpenGLBuffer.h"
+#include "Rendering/OpenGL/GLStateCache.h"
 #include "Core/Log.h"
+#include "Core/Profiler.h"
 #include <glad/gl.h>
 #include <cmath>
 #include <random>
@@ -47,6 +49,7 @@ ParticleSystem::ParticleSystem(const ParticleSystemConfig& config)
 ParticleSystem::~ParticleSystem() = default;
 
 void ParticleSystem::Update(float deltaTime) {
+    PROFILE_SCOPE("ParticleSystem::Update");
     if (!m_Playing) return;
     
     m_Time += deltaTime;
@@ -183,13 +186,13 @@ void ParticleSystem::Render(const Mat4& view, const Mat4& projection) {
     }
     
     // Render
-    glEnable(GL_BLEND);
+    GLStateCache::Enable(GL_BLEND);
     if (m_Config.additiveBlending) {
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE);  // Additive blending
+        GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE);  // Additive blending
     } else {
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);  // Alpha blending
+        GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);  // Alpha blending
     }
-    glDepthMask(GL_FALSE);  // Disable depth writes for transparent particles
+    GLStateCache::DepthMask(false);  // Disable depth writes for transparent particles
     
     m_Shader->Bind();
     m_Shader->SetMat4("u_ViewProjection", projection * view);
@@ -197,8 +200,8 @@ void ParticleSystem::Render(const Mat4& view, const Mat4& projection) {
     m_VAO->Bind();
     glDrawArrays(GL_TRIANGLES, 0, m_Pool.GetAliveCount() * 6);
     
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
+    GLStateCache::DepthMask(true);
+    GLStateCache::Disable(GL_BLEND);
 }
 
 void ParticleSystem::BuildVertexData() {
@@ -10,6 +10,15 @@
 #include <sstream>
 #include <iostream>
 
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 namespace MyEngine {
 namespace FileSystem {
 
@@ -101,5 +110,81 @@ std::vector<std::string> ListFilesWithExtension(const std::string& directory,
     return files;
 }
 
+bool MappedFile::Open(const std::string& path, bool sequential) {
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "Failed to open file for mapping: " << path << std::endl;
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!data) {
+        std::cerr << "Failed to map file: " << path << std::endl;
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_File = file;
+    m_Mapping = mapping;
+    m_Data = static_cast<const uint8_t*>(data);
+    m_Size = static_cast<size_t>(size.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Failed to open file for mapping: " << path << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (sequential) {
+        flags |= MAP_POPULATE;  // Whole file is about to be read: fault it in up front
+    }
+#endif
+    void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, flags, fd, 0);
+    ::close(fd);  // The mapping keeps the file referenced
+    if (data == MAP_FAILED) {
+        std::cerr << "Failed to map file: " << path << std::endl;
+        return false;
+    }
+    if (sequential) {
+        madvise(data, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+    }
+    m_Data = static_cast<const uint8_t*>(data);
+    m_Size = static_cast<size_t>(info.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::Close() {
+    if (!m_Data) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(m_Data);
+    CloseHandle(static_cast<HANDLE>(m_Mapping));
+    CloseHandle(static_cast<HANDLE>(m_File));
+    m_File = nullptr;
+    m_Mapping = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(m_Data), m_Size);
+#endif
+    m_Data = nullptr;
+    m_Size = 0;
+}
+
 } // namespace FileSystem
 } // namespace MyEngine
@@ -3,11 +3,12 @@
  * Author: AI Assistant
  * Created: 2026-01-27
  * Description: Cross-platform file system utilities
- * Dependencies: <string>, <vector>, <filesystem> (C++17)
+ * Dependencies: <string>, <vector>, <filesystem> (C++17), mmap / file mapping
  ******************************************************************************/
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <filesystem>
@@ -139,5 +140,36 @@ std::vector<std::string> ListFilesWithExtension(const std::string& directory,
                                                  const std::string& extension,
                                                  bool recursive = false);
 
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * 文件内容按需由操作系统分页载入，不经过用户态缓冲；映射在 Close 或析构时释放。
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Map path; sequential hints the OS to read ahead
+     */
+    bool Open(const std::string& path, bool sequential = true);
+    void Close();
+
+    bool IsOpen() const { return m_Data != nullptr; }
+    const uint8_t* GetData() const { return m_Data; }
+    size_t GetSize() const { return m_Size; }
+
+private:
+    const uint8_t* m_Data = nullptr;
+    size_t m_Size = 0;
+#ifdef _WIN32
+    void* m_File = nullptr;
+    void* m_Mapping = nullptr;
+#endif
+};
+
 } // namespace FileSystem
 } // namespace MyEngine
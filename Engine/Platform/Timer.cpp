@@ -6,7 +6,9 @@
  ******************************************************************************/
 
 #include "Timer.h"
+#include <algorithm>
 #include <iostream>
+#include <thread>
 
 namespace MyEngine {
 
@@ -15,4 +17,94 @@ ScopedTimer::~ScopedTimer() {
     std::cout << "[TIMER] " << m_Name << ": " << time << "ms" << std::endl;
 }
 
+// Remaining time below which we spin instead of sleeping
+static constexpr auto SPIN_THRESHOLD = std::chrono::microseconds(1500);
+
+FixedRateLimiter::FixedRateLimiter(double ticksPerSecond) {
+    SetRate(ticksPerSecond);
+}
+
+void FixedRateLimiter::SetRate(double ticksPerSecond) {
+    m_Rate = ticksPerSecond > 0.0 ? ticksPerSecond : 0.0;
+    m_Interval = m_Rate > 0.0
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_Rate))
+        : Clock::duration::zero();
+    Reset();
+}
+
+void FixedRateLimiter::Reset() {
+    m_NextTick = Clock::now() + m_Interval;
+}
+
+void FixedRateLimiter::WaitForNextTick() {
+    if (m_Interval == Clock::duration::zero()) {
+        return;
+    }
+    
+    auto now = Clock::now();
+    if (now - m_NextTick > m_Interval) {
+        // Too far behind - don't burst, just resume from here
+        m_NextTick = now + m_Interval;
+        return;
+    }
+    
+    // Coarse sleep, leaving a margin for scheduler wake-up latency
+    while (m_NextTick - now > SPIN_THRESHOLD) {
+        std::this_thread::sleep_for(m_NextTick - now - SPIN_THRESHOLD);
+        now = Clock::now();
+    }
+    
+    // Fine spin for the remainder
+    while (Clock::now() < m_NextTick) {
+        std::this_thread::yield();
+    }
+    
+    m_NextTick += m_Interval;
+}
+
+TickStatistics::TickStatistics(size_t capacity)
+    : m_Samples(std::max<size_t>(capacity, 1), 0.0f) {
+    m_Scratch.reserve(m_Samples.size());
+}
+
+void TickStatistics::AddSample(float milliseconds) {
+    m_Samples[m_Next] = milliseconds;
+    m_Next = (m_Next + 1) % m_Samples.size();
+    m_Count = std::min(m_Count + 1, m_Samples.size());
+}
+
+void TickStatistics::Reset() {
+    m_Next = 0;
+    m_Count = 0;
+}
+
+float TickStatistics::GetAverage() const {
+    if (m_Count == 0) return 0.0f;
+    double sum = 0.0;
+    for (size_t i = 0; i < m_Count; ++i) {
+        sum += m_Samples[i];
+    }
+    return static_cast<float>(sum / m_Count);
+}
+
+float TickStatistics::GetMin() const {
+    if (m_Count == 0) return 0.0f;
+    return *std::min_element(m_Samples.begin(), m_Samples.begin() + m_Count);
+}
+
+float TickStatistics::GetMax() const {
+    if (m_Count == 0) return 0.0f;
+    return *std::max_element(m_Samples.begin(), m_Samples.begin() + m_Count);
+}
+
+float TickStatistics::GetPercentile(float percentile) const {
+    if (m_Count == 0) return 0.0f;
+    
+    m_Scratch.assign(m_Samples.begin(), m_Samples.begin() + m_Count);
+    float clamped = std::clamp(percentile, 0.0f, 100.0f);
+    size_t rank = static_cast<size_t>(clamped / 100.0f * (m_Count - 1) + 0.5f);
+    std::nth_element(m_Scratch.begin(), m_Scratch.begin() + rank, m_Scratch.end());
+    return m_Scratch[rank];
+}
+
 } // namespace MyEngine
@@ -9,6 +9,8 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+#include <vector>
 
 namespace MyEngine {
 
@@ -58,6 +60,89 @@ private:
     std::chrono::time_point<std::chrono::high_resolution_clock> m_Start;
 };
 
+/**
+ * @brief Fixed-rate pacer for headless loops
+ * 
+ * Sleeps through the bulk of each interval and spins the last stretch,
+ * because OS sleep granularity (often 1ms or worse) is too coarse to hold
+ * high tick rates. A rate of 0 disables pacing entirely.
+ * 
+ * Usage:
+ *   FixedRateLimiter limiter(60.0);
+ *   while (running) {
+ *       Tick();
+ *       limiter.WaitForNextTick();
+ *   }
+ */
+class FixedRateLimiter {
+public:
+    explicit FixedRateLimiter(double ticksPerSecond = 60.0);
+    
+    /**
+     * @brief Change the target rate (<= 0 = unthrottled)
+     */
+    void SetRate(double ticksPerSecond);
+    double GetRate() const { return m_Rate; }
+    
+    /**
+     * @brief Restart pacing from the current time
+     */
+    void Reset();
+    
+    /**
+     * @brief Block until the next tick is due
+     * 
+     * If the caller has fallen more than one interval behind, the schedule
+     * is re-anchored to now instead of bursting to catch up.
+     */
+    void WaitForNextTick();
+    
+private:
+    using Clock = std::chrono::steady_clock;
+    
+    double m_Rate = 0.0;
+    Clock::duration m_Interval{0};
+    Clock::time_point m_NextTick;
+};
+
+/**
+ * @brief Rolling window of tick durations with percentile queries
+ * 
+ * Keeps the most recent samples in a fixed-size ring so recording a tick
+ * never allocates. Percentiles are computed on demand (report time only).
+ */
+class TickStatistics {
+public:
+    explicit TickStatistics(size_t capacity = 4096);
+    
+    /**
+     * @brief Record one tick duration in milliseconds
+     */
+    void AddSample(float milliseconds);
+    
+    /**
+     * @brief Drop all samples
+     */
+    void Reset();
+    
+    size_t GetSampleCount() const { return m_Count; }
+    float GetAverage() const;
+    float GetMin() const;
+    float GetMax() const;
+    
+    /**
+     * @brief Get percentile over the current window
+     * @param percentile Value in [0, 100]
+     */
+    float GetPercentile(float percentile) const;
+    
+private:
+    std::vector<float> m_Samples;
+    mutable std::vector<float> m_Scratch;
+    size_t m_Next = 0;
+    size_t m_Count = 0;
+};
+
 /**
  * @brief Scoped timer for automatic timing (RAII)
  * 
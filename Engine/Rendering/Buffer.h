@@ -144,4 +144,20 @@ public:
     static IndexBuffer* Create(uint32_t* indices, uint32_t count);
 };
 
+/**
+ * @brief Interface for a uniform buffer (std140 block storage on a fixed binding point)
+ */
+class UniformBuffer {
+public:
+    virtual ~UniformBuffer() = default;
+    
+    // A write at offset 0 starts a new version of the buffer: bytes past size become undefined
+    virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+    
+    virtual uint32_t GetSize() const = 0;
+    virtual uint32_t GetBinding() const = 0;
+    
+    static UniformBuffer* Create(uint32_t size, uint32_t binding);
+};
+
 } // namespace MyEngine
@@ -0,0 +1,22 @@
+/******************************************************************************
+ * File: NullRenderBackend.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Headless RenderBackend implementation
+ ******************************************************************************/
+
+#include "NullRenderBackend.h"
+
+namespace MyEngine {
+
+void NullRenderBackend::BeginFrame() {
+    m_DrawCount = 0;
+    m_IndexCount = 0;
+}
+
+void NullRenderBackend::DrawIndexed(uint32_t indexCount) {
+    m_DrawCount++;
+    m_IndexCount += indexCount;
+}
+
+} // namespace MyEngine
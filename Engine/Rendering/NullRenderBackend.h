@@ -0,0 +1,51 @@
+/******************************************************************************
+ * File: NullRenderBackend.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: RenderBackend that issues no GPU work (headless / CI)
+ ******************************************************************************/
+
+#pragma once
+
+#include "Rendering/RenderBackend.h"
+
+namespace MyEngine {
+
+/**
+ * @brief Backend without a graphics API
+ *
+ * 所有调用都是空操作，只统计绘制次数和索引数，用于无 GPU 的机器上
+ * 测量整帧 CPU 路径（录制、合并、排序、回放）。RendererAPI::None 时由 RenderBackend::Create 创建。
+ */
+class NullRenderBackend : public RenderBackend {
+public:
+    virtual void Init() override {}
+    virtual void Shutdown() override {}
+
+    virtual void BeginFrame() override;
+    virtual void EndFrame() override {}
+
+    virtual void SetViewport(uint32_t /*x*/, uint32_t /*y*/, uint32_t /*width*/, uint32_t /*height*/) override {}
+    virtual void SetClearColor(const Vec4& /*color*/) override {}
+    virtual void Clear() override {}
+
+    virtual void DrawIndexed(uint32_t indexCount) override;
+
+    virtual void SetFrameUniforms(const FrameUniforms& /*frame*/) override {}
+    virtual void SetPassUniforms(const void* /*data*/, uint32_t /*size*/) override {}
+
+    virtual void SetRenderState(const RenderState& /*state*/) override {}
+    virtual void BindShader(Shader* /*shader*/) override {}
+    virtual void BindVertexArray(const VertexArray* /*vertexArray*/) override {}
+    virtual void SetUniform(Shader* /*shader*/, const char* /*name*/, UniformType /*type*/, const float* /*data*/) override {}
+
+    // Since the last BeginFrame
+    uint64_t GetDrawCount() const { return m_DrawCount; }
+    uint64_t GetIndexCount() const { return m_IndexCount; }
+
+private:
+    uint64_t m_DrawCount = 0;
+    uint64_t m_IndexCount = 0;
+};
+
+} // namespace MyEngine
@@ -0,0 +1,347 @@
+/******************************************************************************
+ * File: GLStateCache.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Shadow copy of OpenGL binding / fixed-function state
+ ******************************************************************************/
+
+#include "GLStateCache.h"
+#include <glad/gl.h>
+
+namespace MyEngine {
+
+GLStateCache::State GLStateCache::s_State;
+GLStateStats GLStateCache::s_Stats;
+
+namespace {
+
+constexpr GLenum TEXTURE_TARGETS[GLStateCache::TEXTURE_TARGET_COUNT] = {
+    GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_3D
+};
+
+constexpr GLenum BUFFER_TARGETS[GLStateCache::BUFFER_TARGET_COUNT] = {
+    GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_UNIFORM_BUFFER
+};
+
+constexpr GLenum CAPABILITIES[GLStateCache::CAPABILITY_COUNT] = {
+    GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE, GL_SCISSOR_TEST, GL_STENCIL_TEST
+};
+
+constexpr uint32_t ELEMENT_BUFFER_SLOT = 1;
+constexpr uint32_t UNIFORM_BUFFER_SLOT = 2;
+constexpr uint32_t NOT_TRACKED = UINT32_MAX;
+
+template <uint32_t N>
+uint32_t FindSlot(const GLenum (&table)[N], uint32_t value) {
+    for (uint32_t i = 0; i < N; i++) {
+        if (table[i] == value) return i;
+    }
+    return NOT_TRACKED;
+}
+
+} // namespace
+
+uint32_t GLStateStats::TotalIssued() const {
+    uint32_t total = 0;
+    for (uint32_t count : Issued) total += count;
+    return total;
+}
+
+uint32_t GLStateStats::TotalSkipped() const {
+    uint32_t total = 0;
+    for (uint32_t count : Skipped) total += count;
+    return total;
+}
+
+GLStateCache::State::State() {
+    for (auto& unit : textures) {
+        for (uint32_t& texture : unit) texture = UNKNOWN;
+    }
+    for (uint32_t& buffer : uniformBuffers) buffer = UNKNOWN;
+}
+
+// 计数辅助：调用被发出 / 被跳过
+#define GL_STATE_ISSUED(call) s_Stats.Issued[static_cast<uint32_t>(GLStateCall::call)]++
+#define GL_STATE_SKIPPED(call) s_Stats.Skipped[static_cast<uint32_t>(GLStateCall::call)]++
+
+void GLStateCache::Reset() {
+    s_State = State();
+
+    UseProgram(0);
+    BindVertexArray(0);
+    for (GLenum target : BUFFER_TARGETS) BindBuffer(target, 0);
+    for (uint32_t unit = 0; unit < MAX_TEXTURE_UNITS; unit++) {
+        for (GLenum target : TEXTURE_TARGETS) BindTexture(unit, target, 0);
+    }
+    ActiveTexture(0);
+
+    Enable(GL_DEPTH_TEST);
+    Enable(GL_BLEND);
+    Disable(GL_CULL_FACE);
+    Disable(GL_SCISSOR_TEST);
+    Disable(GL_STENCIL_TEST);
+    BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    DepthFunc(GL_LESS);
+    DepthMask(true);
+    CullFace(GL_BACK);
+    PolygonMode(GL_FILL);
+
+    ResetStats();
+}
+
+void GLStateCache::Invalidate() {
+    s_State = State();
+}
+
+// ============================================================================
+// Bindings
+// ============================================================================
+
+void GLStateCache::UseProgram(uint32_t program) {
+    if (s_State.program == program) {
+        GL_STATE_SKIPPED(Program);
+        return;
+    }
+    glUseProgram(program);
+    s_State.program = program;
+    GL_STATE_ISSUED(Program);
+}
+
+void GLStateCache::BindVertexArray(uint32_t vertexArray) {
+    if (s_State.vertexArray == vertexArray) {
+        GL_STATE_SKIPPED(VertexArray);
+        return;
+    }
+    glBindVertexArray(vertexArray);
+    s_State.vertexArray = vertexArray;
+    // GL_ELEMENT_ARRAY_BUFFER 绑定属于 VAO，换 VAO 后未知
+    s_State.buffers[ELEMENT_BUFFER_SLOT] = UNKNOWN;
+    GL_STATE_ISSUED(VertexArray);
+}
+
+void GLStateCache::BindBuffer(uint32_t target, uint32_t buffer) {
+    const uint32_t slot = FindSlot(BUFFER_TARGETS, target);
+    if (slot != NOT_TRACKED && s_State.buffers[slot] == buffer) {
+        GL_STATE_SKIPPED(Buffer);
+        return;
+    }
+    glBindBuffer(target, buffer);
+    if (slot != NOT_TRACKED) s_State.buffers[slot] = buffer;
+    GL_STATE_ISSUED(Buffer);
+}
+
+void GLStateCache::BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer) {
+    const bool tracked = target == GL_UNIFORM_BUFFER && index < MAX_UNIFORM_BUFFER_BINDINGS;
+    if (tracked && s_State.uniformBuffers[index] == buffer && s_State.buffers[UNIFORM_BUFFER_SLOT] == buffer) {
+        GL_STATE_SKIPPED(Buffer);
+        return;
+    }
+    glBindBufferBase(target, index, buffer);
+    if (tracked) s_State.uniformBuffers[index] = buffer;
+    const uint32_t slot = FindSlot(BUFFER_TARGETS, target);
+    if (slot != NOT_TRACKED) s_State.buffers[slot] = buffer;
+    GL_STATE_ISSUED(Buffer);
+}
+
+void GLStateCache::ActiveTexture(uint32_t unit) {
+    if (s_State.activeUnit == unit) {
+        GL_STATE_SKIPPED(ActiveTexture);
+        return;
+    }
+    glActiveTexture(GL_TEXTURE0 + unit);
+    s_State.activeUnit = unit;
+    GL_STATE_ISSUED(ActiveTexture);
+}
+
+void GLStateCache::BindTexture(uint32_t target, uint32_t texture) {
+    const uint32_t unit = s_State.activeUnit;
+    const uint32_t slot = FindSlot(TEXTURE_TARGETS, target);
+    const bool tracked = unit < MAX_TEXTURE_UNITS && slot != NOT_TRACKED;
+    if (tracked && s_State.textures[unit][slot] == texture) {
+        GL_STATE_SKIPPED(Texture);
+        return;
+    }
+    glBindTexture(target, texture);
+    if (tracked) s_State.textures[unit][slot] = texture;
+    GL_STATE_ISSUED(Texture);
+}
+
+void GLStateCache::BindTexture(uint32_t unit, uint32_t target, uint32_t texture) {
+    // Unit stays selected afterwards (callers may follow with glTexParameter*)
+    ActiveTexture(unit);
+    BindTexture(target, texture);
+}
+
+// ============================================================================
+// Fixed-function state
+// ============================================================================
+
+void GLStateCache::SetEnabled(uint32_t capability, bool enabled) {
+    const uint32_t slot = FindSlot(CAPABILITIES, capability);
+    const uint8_t flag = enabled ? 1 : 0;
+    if (slot != NOT_TRACKED && s_State.capabilities[slot] == flag) {
+        GL_STATE_SKIPPED(Capability);
+        return;
+    }
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+    if (slot != NOT_TRACKED) s_State.capabilities[slot] = flag;
+    GL_STATE_ISSUED(Capability);
+}
+
+void GLStateCache::Enable(uint32_t capability) {
+    SetEnabled(capability, true);
+}
+
+void GLStateCache::Disable(uint32_t capability) {
+    SetEnabled(capability, false);
+}
+
+void GLStateCache::BlendFunc(uint32_t src, uint32_t dst) {
+    if (s_State.blendSrc == src && s_State.blendDst == dst) {
+        GL_STATE_SKIPPED(BlendFunc);
+        return;
+    }
+    glBlendFunc(src, dst);
+    s_State.blendSrc = src;
+    s_State.blendDst = dst;
+    GL_STATE_ISSUED(BlendFunc);
+}
+
+void GLStateCache::DepthFunc(uint32_t func) {
+    if (s_State.depthFunc == func) {
+        GL_STATE_SKIPPED(DepthFunc);
+        return;
+    }
+    glDepthFunc(func);
+    s_State.depthFunc = func;
+    GL_STATE_ISSUED(DepthFunc);
+}
+
+void GLStateCache::DepthMask(bool write) {
+    const uint8_t flag = write ? 1 : 0;
+    if (s_State.depthMask == flag) {
+        GL_STATE_SKIPPED(DepthMask);
+        return;
+    }
+    glDepthMask(write ? GL_TRUE : GL_FALSE);
+    s_State.depthMask = flag;
+    GL_STATE_ISSUED(DepthMask);
+}
+
+void GLStateCache::CullFace(uint32_t face) {
+    if (s_State.cullFace == face) {
+        GL_STATE_SKIPPED(CullFace);
+        return;
+    }
+    glCullFace(face);
+    s_State.cullFace = face;
+    GL_STATE_ISSUED(CullFace);
+}
+
+void GLStateCache::PolygonMode(uint32_t mode) {
+    if (s_State.polygonMode == mode) {
+        GL_STATE_SKIPPED(PolygonMode);
+        return;
+    }
+    glPolygonMode(GL_FRONT_AND_BACK, mode);
+    s_State.polygonMode = mode;
+    GL_STATE_ISSUED(PolygonMode);
+}
+
+// ============================================================================
+// Deletion
+// ============================================================================
+
+void GLStateCache::DeleteTexture(uint32_t texture) {
+    if (texture == 0) return;
+    glDeleteTextures(1, &texture);
+    // GL 删除时会把所有纹理单元上的该名字解绑为 0；名字随后可能被新纹理复用
+    for (auto& unit : s_State.textures) {
+        for (uint32_t& bound : unit) {
+            if (bound == texture) bound = 0;
+        }
+    }
+}
+
+void GLStateCache::DeleteBuffer(uint32_t buffer) {
+    if (buffer == 0) return;
+    glDeleteBuffers(1, &buffer);
+    for (uint32_t& bound : s_State.buffers) {
+        if (bound == buffer) bound = 0;
+    }
+    for (uint32_t& bound : s_State.uniformBuffers) {
+        if (bound == buffer) bound = 0;
+    }
+}
+
+void GLStateCache::DeleteVertexArray(uint32_t vertexArray) {
+    if (vertexArray == 0) return;
+    glDeleteVertexArrays(1, &vertexArray);
+    if (s_State.vertexArray == vertexArray) {
+        s_State.vertexArray = 0;
+        s_State.buffers[ELEMENT_BUFFER_SLOT] = UNKNOWN;
+    }
+}
+
+// ============================================================================
+// Restore
+// ============================================================================
+
+void GLStateCache::Restore(const State& saved, uint32_t mask) {
+    auto differs = [](uint32_t savedValue, uint32_t current) {
+        return savedValue != UNKNOWN && savedValue != current;
+    };
+
+    if (mask & RESTORE_BINDINGS) {
+        if (differs(saved.program, s_State.program)) UseProgram(saved.program);
+        // VAO before GL_ELEMENT_ARRAY_BUFFER (VAO state)
+        if (differs(saved.vertexArray, s_State.vertexArray)) BindVertexArray(saved.vertexArray);
+        for (uint32_t index = 0; index < MAX_UNIFORM_BUFFER_BINDINGS; index++) {
+            if (differs(saved.uniformBuffers[index], s_State.uniformBuffers[index])) {
+                BindBufferBase(GL_UNIFORM_BUFFER, index, saved.uniformBuffers[index]);
+            }
+        }
+        // After the indexed binds, which also move the generic GL_UNIFORM_BUFFER binding
+        for (uint32_t slot = 0; slot < BUFFER_TARGET_COUNT; slot++) {
+            if (differs(saved.buffers[slot], s_State.buffers[slot])) BindBuffer(BUFFER_TARGETS[slot], saved.buffers[slot]);
+        }
+    }
+
+    if (mask & RESTORE_TEXTURES) {
+        for (uint32_t unit = 0; unit < MAX_TEXTURE_UNITS; unit++) {
+            for (uint32_t slot = 0; slot < TEXTURE_TARGET_COUNT; slot++) {
+                if (differs(saved.textures[unit][slot], s_State.textures[unit][slot])) {
+                    BindTexture(unit, TEXTURE_TARGETS[slot], saved.textures[unit][slot]);
+                }
+            }
+        }
+        if (differs(saved.activeUnit, s_State.activeUnit)) ActiveTexture(saved.activeUnit);
+    }
+
+    if (!(mask & RESTORE_FIXED_FUNCTION)) return;
+    for (uint32_t slot = 0; slot < CAPABILITY_COUNT; slot++) {
+        const uint8_t flag = saved.capabilities[slot];
+        if (flag != State::UNKNOWN_FLAG && flag != s_State.capabilities[slot]) {
+            SetEnabled(CAPABILITIES[slot], flag != 0);
+        }
+    }
+    if (saved.depthMask != State::UNKNOWN_FLAG && saved.depthMask != s_State.depthMask) {
+        DepthMask(saved.depthMask != 0);
+    }
+    if (saved.blendSrc != UNKNOWN && saved.blendDst != UNKNOWN &&
+        (saved.blendSrc != s_State.blendSrc || saved.blendDst != s_State.blendDst)) {
+        BlendFunc(saved.blendSrc, saved.blendDst);
+    }
+    if (differs(saved.depthFunc, s_State.depthFunc)) DepthFunc(saved.depthFunc);
+    if (differs(saved.cullFace, s_State.cullFace)) CullFace(saved.cullFace);
+    if (differs(saved.polygonMode, s_State.polygonMode)) PolygonMode(saved.polygonMode);
+}
+
+#undef GL_STATE_ISSUED
+#undef GL_STATE_SKIPPED
+
+} // namespace MyEngine
@@ -0,0 +1,158 @@
+/******************************************************************************
+ * File: GLStateCache.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Shadow copy of OpenGL binding / fixed-function state
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace MyEngine {
+
+/**
+ * @brief Categories of state calls counted by GLStateCache
+ */
+enum class GLStateCall : uint8_t {
+    Program = 0,
+    VertexArray,
+    Buffer,
+    ActiveTexture,
+    Texture,
+    Capability,      // glEnable / glDisable
+    BlendFunc,
+    DepthFunc,
+    DepthMask,
+    CullFace,
+    PolygonMode,
+    Count
+};
+
+/**
+ * @brief Issued vs skipped state calls (since the last ResetStats)
+ */
+struct GLStateStats {
+    static constexpr uint32_t CATEGORY_COUNT = static_cast<uint32_t>(GLStateCall::Count);
+
+    uint32_t Issued[CATEGORY_COUNT] = {};
+    uint32_t Skipped[CATEGORY_COUNT] = {};
+
+    uint32_t GetIssued(GLStateCall call) const { return Issued[static_cast<uint32_t>(call)]; }
+    uint32_t GetSkipped(GLStateCall call) const { return Skipped[static_cast<uint32_t>(call)]; }
+    uint32_t TotalIssued() const;
+    uint32_t TotalSkipped() const;
+};
+
+/**
+ * @brief OpenGL 状态影子缓存
+ *
+ * 记录当前绑定的 program / VAO / buffer / 各纹理单元的纹理，以及 blend、depth、cull、
+ * polygon mode 等固定管线状态；与影子值相同的调用直接跳过。
+ * Pass 需要“保存并恢复”状态时用 Capture / Restore，不再向驱动查询（glGet* / glIsEnabled 会让驱动同步）。
+ *
+ * 前提是引擎内所有相关 GL 调用都经过这里。若外部代码（第三方库）绕过缓存改了状态，
+ * 之后调用 Invalidate。值为 UNKNOWN 的项下次设置时一定会发出 GL 调用。
+ * 只能在 GL 上下文线程使用。
+ */
+class GLStateCache {
+public:
+    static constexpr uint32_t UNKNOWN = UINT32_MAX;
+    static constexpr uint32_t MAX_TEXTURE_UNITS = 32;
+    static constexpr uint32_t TEXTURE_TARGET_COUNT = 4;   // 2D, CUBE_MAP, 2D_ARRAY, 3D
+    static constexpr uint32_t BUFFER_TARGET_COUNT = 3;    // ARRAY, ELEMENT_ARRAY, UNIFORM
+    static constexpr uint32_t CAPABILITY_COUNT = 5;       // DEPTH_TEST, BLEND, CULL_FACE, SCISSOR_TEST, STENCIL_TEST
+    static constexpr uint32_t MAX_UNIFORM_BUFFER_BINDINGS = 16;   // Indexed GL_UNIFORM_BUFFER binding points
+
+    /**
+     * @brief Shadow state; also the value returned by Capture
+     * Capabilities and depth mask: 0 / 1, or UNKNOWN_FLAG
+     */
+    struct State {
+        static constexpr uint8_t UNKNOWN_FLAG = 0xFF;
+
+        uint32_t program = UNKNOWN;
+        uint32_t vertexArray = UNKNOWN;
+        uint32_t buffers[BUFFER_TARGET_COUNT] = { UNKNOWN, UNKNOWN, UNKNOWN };
+        uint32_t uniformBuffers[MAX_UNIFORM_BUFFER_BINDINGS];
+        uint32_t activeUnit = UNKNOWN;
+        uint32_t textures[MAX_TEXTURE_UNITS][TEXTURE_TARGET_COUNT];
+        uint8_t capabilities[CAPABILITY_COUNT] = { UNKNOWN_FLAG, UNKNOWN_FLAG, UNKNOWN_FLAG, UNKNOWN_FLAG, UNKNOWN_FLAG };
+        uint8_t depthMask = UNKNOWN_FLAG;
+        uint32_t blendSrc = UNKNOWN;
+        uint32_t blendDst = UNKNOWN;
+        uint32_t depthFunc = UNKNOWN;
+        uint32_t cullFace = UNKNOWN;
+        uint32_t polygonMode = UNKNOWN;
+
+        State();
+    };
+
+    /**
+     * @brief Issue the engine default state and mark everything known
+     * (depth test on / LESS, alpha blending, no culling, fill, nothing bound)
+     */
+    static void Reset();
+
+    /**
+     * @brief Forget the shadow state (no GL calls); every next set is issued
+     */
+    static void Invalidate();
+
+    // ========== Bindings ==========
+    static void UseProgram(uint32_t program);
+    static void BindVertexArray(uint32_t vertexArray);
+    static void BindBuffer(uint32_t target, uint32_t buffer);
+
+    /**
+     * @brief glBindBufferBase; indexed GL_UNIFORM_BUFFER points are tracked
+     * (also sets the generic target binding, as GL does)
+     */
+    static void BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer);
+
+    /**
+     * @brief Select texture unit (index, not GL_TEXTURE0 + index)
+     */
+    static void ActiveTexture(uint32_t unit);
+    static void BindTexture(uint32_t target, uint32_t texture);
+    static void BindTexture(uint32_t unit, uint32_t target, uint32_t texture);
+
+    // ========== Fixed-function state ==========
+    static void Enable(uint32_t capability);
+    static void Disable(uint32_t capability);
+    static void SetEnabled(uint32_t capability, bool enabled);
+    static void BlendFunc(uint32_t src, uint32_t dst);
+    static void DepthFunc(uint32_t func);
+    static void DepthMask(bool write);
+    static void CullFace(uint32_t face);
+    static void PolygonMode(uint32_t mode);   // GL_FRONT_AND_BACK
+
+    // ========== Object deletion (drops bindings of the deleted name) ==========
+    static void DeleteTexture(uint32_t texture);
+    static void DeleteBuffer(uint32_t buffer);
+    static void DeleteVertexArray(uint32_t vertexArray);
+
+    // ========== Save / restore without glGet ==========
+    // Restore masks
+    static constexpr uint32_t RESTORE_BINDINGS = 1u << 0;         // Program, VAO, buffers (incl. indexed uniform buffers)
+    static constexpr uint32_t RESTORE_TEXTURES = 1u << 1;         // Texture units + active unit
+    static constexpr uint32_t RESTORE_FIXED_FUNCTION = 1u << 2;   // Capabilities, blend, depth, cull, polygon mode
+    static constexpr uint32_t RESTORE_ALL = RESTORE_BINDINGS | RESTORE_TEXTURES | RESTORE_FIXED_FUNCTION;
+
+    static State Capture() { return s_State; }
+
+    /**
+     * @brief Re-issue the known fields of saved (selected by mask) that differ from the current state
+     */
+    static void Restore(const State& saved, uint32_t mask = RESTORE_ALL);
+
+    // ========== Counters ==========
+    static const GLStateStats& GetStats() { return s_Stats; }
+    static void ResetStats() { s_Stats = GLStateStats(); }
+
+private:
+    static State s_State;
+    static GLStateStats s_Stats;
+};
+
+} // namespace MyEngine
@@ -2,10 +2,11 @@
  * File: OpenGLBuffer.cpp
  * Author: AI Assistant
  * Created: 2026-01-27
- * Description: OpenGL implementation of Vertex and Index buffers
+ * Description: OpenGL implementation of Vertex, Index and Uniform buffers
  ******************************************************************************/
 
 #include "OpenGLBuffer.h"
+#include "GLStateCache.h"
 #include <glad/gl.h>
 
 namespace MyEngine {
@@ -24,30 +25,30 @@ VertexBuffer* VertexBuffer::Create(uint32_t size) {
 
 OpenGLVertexBuffer::OpenGLVertexBuffer(float* vertices, uint32_t size) {
     glGenBuffers(1, &m_RendererID);
-    glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+    GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
     glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
 }
 
 OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size) {
     glGenBuffers(1, &m_RendererID);
-    glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+    GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
     glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
 }
 
 OpenGLVertexBuffer::~OpenGLVertexBuffer() {
-    glDeleteBuffers(1, &m_RendererID);
+    GLStateCache::DeleteBuffer(m_RendererID);
 }
 
 void OpenGLVertexBuffer::Bind() const {
-    glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+    GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 }
 
 void OpenGLVertexBuffer::Unbind() const {
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 void OpenGLVertexBuffer::SetData(const void* data, uint32_t size) {
-    glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+    GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
     glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
 }
 
@@ -65,20 +66,55 @@ OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t* indices, uint32_t count)
     
     // GL_ELEMENT_ARRAY_BUFFER is not valid without an active VAO
     // Binding here because OpenGLIndexBuffer is usually bound with a VAO
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+    GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
 }
 
 OpenGLIndexBuffer::~OpenGLIndexBuffer() {
-    glDeleteBuffers(1, &m_RendererID);
+    GLStateCache::DeleteBuffer(m_RendererID);
 }
 
 void OpenGLIndexBuffer::Bind() const {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+    GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
 }
 
 void OpenGLIndexBuffer::Unbind() const {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+// UniformBuffer /////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////
+
+UniformBuffer* UniformBuffer::Create(uint32_t size, uint32_t binding) {
+    return new OpenGLUniformBuffer(size, binding);
+}
+
+OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t size, uint32_t binding)
+    : m_Size(size), m_Binding(binding) {
+    glGenBuffers(1, &m_RendererID);
+    GLStateCache::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+    glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+    
+    // Bound once; shaders pick it up through glUniformBlockBinding
+    GLStateCache::BindBufferBase(GL_UNIFORM_BUFFER, binding, m_RendererID);
+}
+
+OpenGLUniformBuffer::~OpenGLUniformBuffer() {
+    GLStateCache::DeleteBuffer(m_RendererID);
+}
+
+void OpenGLUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset) {
+    GLStateCache::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+    if (offset == 0 && size == m_Size) {
+        glBufferData(GL_UNIFORM_BUFFER, m_Size, data, GL_DYNAMIC_DRAW);
+        return;
+    }
+    if (offset == 0) {
+        // Orphan first: draws still reading the old contents must not stall the upload
+        glBufferData(GL_UNIFORM_BUFFER, m_Size, nullptr, GL_DYNAMIC_DRAW);
+    }
+    glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
 }
 
 } // namespace MyEngine
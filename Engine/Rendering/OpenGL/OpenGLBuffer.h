@@ -2,7 +2,7 @@
  * File: OpenGLBuffer.h
  * Author: AI Assistant
  * Created: 2026-01-27
- * Description: OpenGL implementation of Vertex and Index buffers
+ * Description: OpenGL implementation of Vertex, Index and Uniform buffers
  ******************************************************************************/
 
 #pragma once
@@ -51,4 +51,23 @@ private:
     uint32_t m_Count;
 };
 
+/**
+ * @brief OpenGL implementation of the uniform buffer
+ */
+class OpenGLUniformBuffer : public UniformBuffer {
+public:
+    OpenGLUniformBuffer(uint32_t size, uint32_t binding);
+    virtual ~OpenGLUniformBuffer();
+    
+    void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+    
+    uint32_t GetSize() const override { return m_Size; }
+    uint32_t GetBinding() const override { return m_Binding; }
+    
+private:
+    uint32_t m_RendererID;
+    uint32_t m_Size;
+    uint32_t m_Binding;
+};
+
 } // namespace MyEngine
@@ -6,18 +6,46 @@
  ******************************************************************************/
 
 #include "OpenGLRenderBackend.h"
+#include "GLStateCache.h"
+#include "Core/Log.h"
+#include "Rendering/Shader.h"
+#include "Rendering/VertexArray.h"
 #include <glad/gl.h>
+#include <cstring>
 
 namespace MyEngine {
 
+namespace {
+
+GLenum ToGLCompare(RenderState::Compare compare) {
+    switch (compare) {
+        case RenderState::Compare::Never: return GL_NEVER;
+        case RenderState::Compare::Less: return GL_LESS;
+        case RenderState::Compare::Equal: return GL_EQUAL;
+        case RenderState::Compare::LessOrEqual: return GL_LEQUAL;
+        case RenderState::Compare::Greater: return GL_GREATER;
+        case RenderState::Compare::NotEqual: return GL_NOTEQUAL;
+        case RenderState::Compare::GreaterOrEqual: return GL_GEQUAL;
+        case RenderState::Compare::Always: return GL_ALWAYS;
+    }
+    return GL_LESS;
+}
+
+} // namespace
+
 void OpenGLRenderBackend::Init() {
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // Depth test + alpha blending, shadow state known from here on
+    GLStateCache::Reset();
+
+    // Shared uniform blocks stay bound to their binding points for the lifetime of the context
+    m_FrameUniformBuffer.reset(UniformBuffer::Create(sizeof(FrameUniforms), FrameUniforms::BINDING));
+    m_PassUniformBuffer.reset(UniformBuffer::Create(PassUniforms::MAX_SIZE, PassUniforms::BINDING));
+    m_HasFrameUniforms = false;
 }
 
 void OpenGLRenderBackend::Shutdown() {
-    // No specific shutdown needed for basic OpenGL backend for now
+    m_FrameUniformBuffer.reset();
+    m_PassUniformBuffer.reset();
 }
 
 void OpenGLRenderBackend::BeginFrame() {
@@ -44,4 +72,88 @@ void OpenGLRenderBackend::DrawIndexed(uint32_t indexCount) {
     glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
 }
 
+void OpenGLRenderBackend::SetFrameUniforms(const FrameUniforms& frame) {
+    if (!m_FrameUniformBuffer) return;
+    // Same view again (e.g. a second viewport of a paused scene): the buffer already holds it
+    if (m_HasFrameUniforms && std::memcmp(&frame, &m_LastFrameUniforms, sizeof(FrameUniforms)) == 0) return;
+    m_FrameUniformBuffer->SetData(&frame, sizeof(FrameUniforms));
+    m_LastFrameUniforms = frame;
+    m_HasFrameUniforms = true;
+}
+
+void OpenGLRenderBackend::SetPassUniforms(const void* data, uint32_t size) {
+    if (!m_PassUniformBuffer) return;
+    if (size > PassUniforms::MAX_SIZE) {
+        ENGINE_ERROR("[OpenGLRenderBackend] Pass uniforms too large ({} > {} bytes)", size, PassUniforms::MAX_SIZE);
+        return;
+    }
+    m_PassUniformBuffer->SetData(data, size);
+}
+
+void OpenGLRenderBackend::SetRenderState(const RenderState& state) {
+    // Only the fields that differ from the shadow state reach GL
+    GLStateCache::SetEnabled(GL_DEPTH_TEST, state.depthTest);
+    if (state.depthTest) {
+        GLStateCache::DepthFunc(ToGLCompare(state.depthCompare));
+    }
+    GLStateCache::DepthMask(state.depthWrite);
+
+    GLStateCache::SetEnabled(GL_CULL_FACE, state.cullMode != RenderState::Cull::None);
+    if (state.cullMode != RenderState::Cull::None) {
+        GLStateCache::CullFace(state.cullMode == RenderState::Cull::Front ? GL_FRONT : GL_BACK);
+    }
+
+    GLStateCache::SetEnabled(GL_BLEND, state.blendMode != RenderState::Blend::Opaque);
+    switch (state.blendMode) {
+        case RenderState::Blend::Opaque:
+            break;
+        case RenderState::Blend::Alpha:
+            GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case RenderState::Blend::Additive:
+            GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE);
+            break;
+        case RenderState::Blend::Multiply:
+            GLStateCache::BlendFunc(GL_DST_COLOR, GL_ZERO);
+            break;
+    }
+
+    GLStateCache::PolygonMode(state.wireframe ? GL_LINE : GL_FILL);
+}
+
+void OpenGLRenderBackend::BindShader(Shader* shader) {
+    if (shader) shader->Bind();
+}
+
+void OpenGLRenderBackend::BindVertexArray(const VertexArray* vertexArray) {
+    if (vertexArray) vertexArray->Bind();
+}
+
+void OpenGLRenderBackend::SetUniform(Shader* shader, const char* name, UniformType type, const float* data) {
+    if (!shader) return;
+    switch (type) {
+        case UniformType::Int: {
+            int value;
+            std::memcpy(&value, data, sizeof(int));
+            shader->SetInt(name, value);
+            break;
+        }
+        case UniformType::Float:
+            shader->SetFloat(name, data[0]);
+            break;
+        case UniformType::Float3:
+            shader->SetFloat3(name, Vec3(data[0], data[1], data[2]));
+            break;
+        case UniformType::Float4:
+            shader->SetFloat4(name, Vec4(data[0], data[1], data[2], data[3]));
+            break;
+        case UniformType::Mat4: {
+            Mat4 matrix{Mat4::UninitializedTag{}};
+            std::memcpy(matrix.m, data, sizeof(matrix.m));
+            shader->SetMat4(name, matrix);
+            break;
+        }
+    }
+}
+
 } // namespace MyEngine
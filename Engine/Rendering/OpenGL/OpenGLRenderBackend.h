@@ -8,6 +8,7 @@
 #pragma once
 
 #include "Rendering/RenderBackend.h"
+#include "Rendering/Buffer.h"
 
 namespace MyEngine {
 
@@ -24,6 +25,20 @@ public:
     virtual void Clear() override;
 
     virtual void DrawIndexed(uint32_t indexCount) override;
+
+    virtual void SetFrameUniforms(const FrameUniforms& frame) override;
+    virtual void SetPassUniforms(const void* data, uint32_t size) override;
+
+    virtual void SetRenderState(const RenderState& state) override;
+    virtual void BindShader(Shader* shader) override;
+    virtual void BindVertexArray(const VertexArray* vertexArray) override;
+    virtual void SetUniform(Shader* shader, const char* name, UniformType type, const float* data) override;
+
+private:
+    std::unique_ptr<UniformBuffer> m_FrameUniformBuffer;
+    std::unique_ptr<UniformBuffer> m_PassUniformBuffer;
+    FrameUniforms m_LastFrameUniforms;
+    bool m_HasFrameUniforms = false;
 };
 
 } // namespace MyEngine
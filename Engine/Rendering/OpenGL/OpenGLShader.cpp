@@ -6,13 +6,16 @@
  ******************************************************************************/
 
 #include "OpenGLShader.h"
+#include "GLStateCache.h"
+#include "Rendering/UniformBlocks.h"
+#include "Core/Hash.h"
 #include "Core/Log.h"
 #include "Platform/FileSystem.h"
 #include <glad/gl.h>
 #include <fstream>
 #include <sstream>
 #include <array>
-#include <set>
+#include <algorithm>
 
 namespace MyEngine {
 
@@ -25,6 +28,19 @@ static GLenum ShaderTypeFromString(const std::string& type) {
     return 0;
 }
 
+/**
+ * @brief Replace the `#include <FrameData>` line with the shared block declaration
+ */
+static std::string ExpandFrameDataInclude(const std::string& source) {
+    const std::string_view directive = FrameUniforms::INCLUDE_DIRECTIVE;
+    const size_t pos = source.find(directive);
+    if (pos == std::string::npos) return source;
+    
+    std::string expanded = source;
+    expanded.replace(pos, directive.size(), FrameUniforms::GLSL);
+    return expanded;
+}
+
 Shader* Shader::Create(const std::string& filepath) {
     return new OpenGLShader(filepath);
 }
@@ -109,7 +125,7 @@ void OpenGLShader::Compile(const std::unordered_map<uint32_t, std::string>& shad
     
     for (auto& kv : shaderSources) {
         uint32_t type = kv.first;
-        const std::string& source = kv.second;
+        const std::string source = ExpandFrameDataInclude(kv.second);
         
         uint32_t shader = glCreateShader(type);
         
@@ -163,85 +179,175 @@ void OpenGLShader::Compile(const std::unordered_map<uint32_t, std::string>& shad
         glDetachShader(program, id);
         glDeleteShader(id);
     }
+    
+    ReflectUniforms();
+    BindUniformBlocks();
+}
+
+void OpenGLShader::ReflectUniforms() {
+    m_Uniforms.clear();
+    m_ReportedMissing.clear();
+    
+    int count = 0;
+    int maxLength = 0;
+    glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<char> nameBuffer(std::max(maxLength, 1));
+    
+    auto addUniform = [this](std::string_view name, int location) {
+        m_Uniforms.push_back({ HashString(name), location });
+    };
+    
+    for (int i = 0; i < count; i++) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(m_RendererID, i, maxLength, &length, &size, &type, nameBuffer.data());
+        
+        // Members of uniform blocks have no location (they live in the block's buffer)
+        const int location = glGetUniformLocation(m_RendererID, nameBuffer.data());
+        if (location < 0) continue;
+        
+        const std::string_view name(nameBuffer.data(), length);
+        addUniform(name, location);
+        
+        // Arrays are reported once as "name[0]": also register "name" and every element
+        constexpr std::string_view firstElement = "[0]";
+        if (name.size() > firstElement.size() && name.substr(name.size() - firstElement.size()) == firstElement) {
+            const std::string_view base = name.substr(0, name.size() - firstElement.size());
+            addUniform(base, location);
+            std::string elementName(base);
+            for (int element = 1; element < size; element++) {
+                elementName.resize(base.size());
+                elementName += "[" + std::to_string(element) + "]";
+                const int elementLocation = glGetUniformLocation(m_RendererID, elementName.c_str());
+                if (elementLocation >= 0) addUniform(elementName, elementLocation);
+            }
+        }
+    }
+    
+    std::sort(m_Uniforms.begin(), m_Uniforms.end(),
+              [](const UniformSlot& a, const UniformSlot& b) { return a.id < b.id; });
+    for (size_t i = 1; i < m_Uniforms.size(); i++) {
+        if (m_Uniforms[i].id == m_Uniforms[i - 1].id && m_Uniforms[i].location != m_Uniforms[i - 1].location) {
+            ENGINE_WARN("[OpenGLShader] Uniform name hash collision in shader '{}'", m_Name);
+        }
+    }
+}
+
+void OpenGLShader::BindUniformBlocks() {
+    int count = 0;
+    glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+    
+    char name[64];
+    for (int i = 0; i < count; i++) {
+        GLsizei length = 0;
+        glGetActiveUniformBlockName(m_RendererID, i, sizeof(name), &length, name);
+        const std::string_view blockName(name, length);
+        // GLSL 330 has no layout(binding = N); bind by name instead
+        if (blockName == FrameUniforms::BLOCK_NAME) {
+            glUniformBlockBinding(m_RendererID, i, FrameUniforms::BINDING);
+        } else if (blockName == PassUniforms::BLOCK_NAME) {
+            glUniformBlockBinding(m_RendererID, i, PassUniforms::BINDING);
+        } else {
+            ENGINE_WARN("[OpenGLShader] Unknown uniform block '{}' in shader '{}'", blockName, m_Name);
+        }
+    }
+}
+
+int OpenGLShader::GetUniformLocation(std::string_view name) {
+    const uint64_t id = HashString(name);
+    auto it = std::lower_bound(m_Uniforms.begin(), m_Uniforms.end(), id,
+                               [](const UniformSlot& slot, uint64_t value) { return slot.id < value; });
+    if (it != m_Uniforms.end() && it->id == id) {
+        return it->location;
+    }
+    
+    // Optimized out or misspelled: report once, then ignore silently
+    if (std::find(m_ReportedMissing.begin(), m_ReportedMissing.end(), id) == m_ReportedMissing.end()) {
+        m_ReportedMissing.push_back(id);
+        ENGINE_WARN("[OpenGLShader] Uniform '{}' not found in shader '{}'", name, m_Name);
+    }
+    return -1;
 }
 
 void OpenGLShader::Bind() const {
-    glUseProgram(m_RendererID);
+    GLStateCache::UseProgram(m_RendererID);
 }
 
 void OpenGLShader::Unbind() const {
-    glUseProgram(0);
+    GLStateCache::UseProgram(0);
 }
 
-void OpenGLShader::SetInt(const std::string& name, int value) {
+void OpenGLShader::SetInt(std::string_view name, int value) {
     UploadUniformInt(name, value);
 }
 
-void OpenGLShader::SetBool(const std::string& name, bool value) {
+void OpenGLShader::SetBool(std::string_view name, bool value) {
     UploadUniformInt(name, value ? 1 : 0);
 }
 
-void OpenGLShader::SetFloat(const std::string& name, float value) {
+void OpenGLShader::SetFloat(std::string_view name, float value) {
     UploadUniformFloat(name, value);
 }
 
-void OpenGLShader::SetFloat3(const std::string& name, const Vec3& value) {
+void OpenGLShader::SetFloat3(std::string_view name, const Vec3& value) {
     UploadUniformFloat3(name, value);
 }
 
-void OpenGLShader::SetFloat4(const std::string& name, const Vec4& value) {
+void OpenGLShader::SetFloat4(std::string_view name, const Vec4& value) {
     UploadUniformFloat4(name, value);
 }
 
-void OpenGLShader::SetMat4(const std::string& name, const Mat4& value) {
+void OpenGLShader::SetMat4(std::string_view name, const Mat4& value) {
     UploadUniformMat4(name, value);
 }
 
-void OpenGLShader::UploadUniformInt(const std::string& name, int value) {
-    int location = glGetUniformLocation(m_RendererID, name.c_str());
-    glUniform1i(location, value);
+void OpenGLShader::SetMat4Array(std::string_view name, const Mat4* values, uint32_t count) {
+    UploadUniformMat4Array(name, values, count);
 }
 
-void OpenGLShader::UploadUniformFloat(const std::string& name, float value) {
-    int location = glGetUniformLocation(m_RendererID, name.c_str());
-    glUniform1f(location, value);
+void OpenGLShader::UploadUniformInt(std::string_view name, int value) {
+    const int location = GetUniformLocation(name);
+    if (location != -1) glUniform1i(location, value);
 }
 
-void OpenGLShader::UploadUniformFloat2(const std::string& name, const Vec2& value) {
-    int location = glGetUniformLocation(m_RendererID, name.c_str());
-    glUniform2f(location, value.x, value.y);
+void OpenGLShader::UploadUniformFloat(std::string_view name, float value) {
+    const int location = GetUniformLocation(name);
+    if (location != -1) glUniform1f(location, value);
 }
 
-void OpenGLShader::UploadUniformFloat3(const std::string& name, const Vec3& value) {
-    int location = glGetUniformLocation(m_RendererID, name.c_str());
-    if (location == -1) {
-        ENGINE_WARN("[OpenGLShader] Uniform '{}' not found in shader '{}'", name, m_Name);
-        return;
-    }
-    glUniform3f(location, value.x, value.y, value.z);
+void OpenGLShader::UploadUniformFloat2(std::string_view name, const Vec2& value) {
+    const int location = GetUniformLocation(name);
+    if (location != -1) glUniform2f(location, value.x, value.y);
 }
 
-void OpenGLShader::UploadUniformFloat4(const std::string& name, const Vec4& value) {
-    int location = glGetUniformLocation(m_RendererID, name.c_str());
-    glUniform4f(location, value.x, value.y, value.z, value.w);
+void OpenGLShader::UploadUniformFloat3(std::string_view name, const Vec3& value) {
+    const int location = GetUniformLocation(name);
+    if (location != -1) glUniform3f(location, value.x, value.y, value.z);
 }
 
-void OpenGLShader::UploadUniformMat3(const std::string& name, const Mat3& matrix) {
-    int location = glGetUniformLocation(m_RendererID, name.c_str());
-    glUniformMatrix3fv(location, 1, GL_FALSE, matrix.m);
+void OpenGLShader::UploadUniformFloat4(std::string_view name, const Vec4& value) {
+    const int location = GetUniformLocation(name);
+    if (location != -1) glUniform4f(location, value.x, value.y, value.z, value.w);
 }
 
-void OpenGLShader::UploadUniformMat4(const std::string& name, const Mat4& matrix) {
-    int location = glGetUniformLocation(m_RendererID, name.c_str());
-    if (location != -1) {
-        glUniformMatrix4fv(location, 1, GL_FALSE, matrix.m);
-    } else {
-        static std::set<std::string> loggedMissing;
-        if (loggedMissing.find(name) == loggedMissing.end()) {
-            ENGINE_WARN("Uniform '{}' not found in shader '{}'", name, m_Name);
-            loggedMissing.insert(name);
-        }
-    }
+void OpenGLShader::UploadUniformMat3(std::string_view name, const Mat3& matrix) {
+    const int location = GetUniformLocation(name);
+    if (location != -1) glUniformMatrix3fv(location, 1, GL_FALSE, matrix.m);
+}
+
+void OpenGLShader::UploadUniformMat4(std::string_view name, const Mat4& matrix) {
+    const int location = GetUniformLocation(name);
+    if (location != -1) glUniformMatrix4fv(location, 1, GL_FALSE, matrix.m);
+}
+
+void OpenGLShader::UploadUniformMat4Array(std::string_view name, const Mat4* matrices, uint32_t count) {
+    static_assert(sizeof(Mat4) == 16 * sizeof(float), "Mat4 arrays are uploaded as packed floats");
+    if (count == 0) return;
+    // GL clamps count to the declared array size
+    const int location = GetUniformLocation(name);
+    if (location != -1) glUniformMatrix4fv(location, static_cast<GLsizei>(count), GL_FALSE, matrices[0].m);
 }
 
 // ShaderLibrary implementation
@@ -9,11 +9,15 @@
 
 #include "Rendering/Shader.h"
 #include <cstdint>
+#include <vector>
 
 namespace MyEngine {
 
 /**
  * @brief OpenGL implementation of the shader
+ *
+ * 链接后反射所有活动 uniform，建立按名字哈希排序的位置表；Set* 只做一次哈希 + 二分查找，
+ * 不再调用 glGetUniformLocation。uniform block（FrameData / PassData）在链接后绑定到固定绑定点。
  */
 class OpenGLShader : public Shader {
 public:
@@ -24,31 +28,48 @@ public:
     void Bind() const override;
     void Unbind() const override;
     
-    void SetInt(const std::string& name, int value) override;
-    void SetBool(const std::string& name, bool value) override;
-    void SetFloat(const std::string& name, float value) override;
-    void SetFloat3(const std::string& name, const Vec3& value) override;
-    void SetFloat4(const std::string& name, const Vec4& value) override;
-    void SetMat4(const std::string& name, const Mat4& value) override;
+    void SetInt(std::string_view name, int value) override;
+    void SetBool(std::string_view name, bool value) override;
+    void SetFloat(std::string_view name, float value) override;
+    void SetFloat3(std::string_view name, const Vec3& value) override;
+    void SetFloat4(std::string_view name, const Vec4& value) override;
+    void SetMat4(std::string_view name, const Mat4& value) override;
+    void SetMat4Array(std::string_view name, const Mat4* values, uint32_t count) override;
     
     const std::string& GetName() const override { return m_Name; }
     
-    void UploadUniformInt(const std::string& name, int value);
-    void UploadUniformFloat(const std::string& name, float value);
-    void UploadUniformFloat2(const std::string& name, const Vec2& value);
-    void UploadUniformFloat3(const std::string& name, const Vec3& value);
-    void UploadUniformFloat4(const std::string& name, const Vec4& value);
-    void UploadUniformMat3(const std::string& name, const Mat3& matrix);
-    void UploadUniformMat4(const std::string& name, const Mat4& matrix);
+    /**
+     * @brief Cached location, -1 if the program has no such active uniform (warned once per name)
+     * Arrays resolve both "name" / "name[0]" and every "name[i]"
+     */
+    int GetUniformLocation(std::string_view name);
+    
+    void UploadUniformInt(std::string_view name, int value);
+    void UploadUniformFloat(std::string_view name, float value);
+    void UploadUniformFloat2(std::string_view name, const Vec2& value);
+    void UploadUniformFloat3(std::string_view name, const Vec3& value);
+    void UploadUniformFloat4(std::string_view name, const Vec4& value);
+    void UploadUniformMat3(std::string_view name, const Mat3& matrix);
+    void UploadUniformMat4(std::string_view name, const Mat4& matrix);
+    void UploadUniformMat4Array(std::string_view name, const Mat4* matrices, uint32_t count);
     
 private:
     std::string ReadFile(const std::string& filepath);
     std::unordered_map<uint32_t, std::string> PreProcess(const std::string& source);
     void Compile(const std::unordered_map<uint32_t, std::string>& shaderSources);
+    void ReflectUniforms();
+    void BindUniformBlocks();
     
 private:
+    struct UniformSlot {
+        uint64_t id;        // HashString(name)
+        int location;
+    };
+    
     uint32_t m_RendererID;
     std::string m_Name;
+    std::vector<UniformSlot> m_Uniforms;            // Sorted by id
+    std::vector<uint64_t> m_ReportedMissing;        // Names already warned about
 };
 
 } // namespace MyEngine
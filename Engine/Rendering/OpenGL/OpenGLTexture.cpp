@@ -6,6 +6,7 @@
  ******************************************************************************/
 
 #include "OpenGLTexture.h"
+#include "GLStateCache.h"
 #include "Core/Log.h"
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -28,7 +29,7 @@ OpenGLTexture::OpenGLTexture(const TextureSpecification& spec)
     m_DataFormat = GL_RGBA;
     
     glGenTextures(1, &m_RendererID);
-    glBindTexture(GL_TEXTURE_2D, m_RendererID);
+    GLStateCache::BindTexture(GL_TEXTURE_2D, m_RendererID);
     
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -62,7 +63,7 @@ OpenGLTexture::OpenGLTexture(const std::string& filepath)
         m_DataFormat = dataFormat;
         
         glGenTextures(1, &m_RendererID);
-        glBindTexture(GL_TEXTURE_2D, m_RendererID);
+        GLStateCache::BindTexture(GL_TEXTURE_2D, m_RendererID);
         
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -81,14 +82,14 @@ OpenGLTexture::OpenGLTexture(const std::string& filepath)
         m_InternalFormat = GL_RGBA8;
         m_DataFormat = GL_RGBA;
         glGenTextures(1, &m_RendererID);
-        glBindTexture(GL_TEXTURE_2D, m_RendererID);
+        GLStateCache::BindTexture(GL_TEXTURE_2D, m_RendererID);
         unsigned char whitePixel[4] = {255, 255, 255, 255};
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, whitePixel);
     }
 }
 
 OpenGLTexture::~OpenGLTexture() {
-    glDeleteTextures(1, &m_RendererID);
+    GLStateCache::DeleteTexture(m_RendererID);
 }
 
 void OpenGLTexture::SetData(void* data, uint32_t size) {
@@ -97,13 +98,12 @@ void OpenGLTexture::SetData(void* data, uint32_t size) {
         ENGINE_ERROR("Data must be entire texture!");
         return;
     }
-    glBindTexture(GL_TEXTURE_2D, m_RendererID);
+    GLStateCache::BindTexture(GL_TEXTURE_2D, m_RendererID);
     glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
 }
 
 void OpenGLTexture::Bind(uint32_t slot) const {
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(GL_TEXTURE_2D, m_RendererID);
+    GLStateCache::BindTexture(slot, GL_TEXTURE_2D, m_RendererID);
 }
 
 std::shared_ptr<Texture> TextureLoader::Load(const std::string& filepath) {
@@ -6,6 +6,7 @@
  ******************************************************************************/
 
 #include "OpenGLVertexArray.h"
+#include "GLStateCache.h"
 #include <glad/gl.h>
 
 namespace MyEngine {
@@ -37,15 +38,15 @@ OpenGLVertexArray::OpenGLVertexArray() {
 }
 
 OpenGLVertexArray::~OpenGLVertexArray() {
-    glDeleteVertexArrays(1, &m_RendererID);
+    GLStateCache::DeleteVertexArray(m_RendererID);
 }
 
 void OpenGLVertexArray::Bind() const {
-    glBindVertexArray(m_RendererID);
+    GLStateCache::BindVertexArray(m_RendererID);
 }
 
 void OpenGLVertexArray::Unbind() const {
-    glBindVertexArray(0);
+    GLStateCache::BindVertexArray(0);
 }
 
 void OpenGLVertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vertexBuffer) {
@@ -54,7 +55,7 @@ void OpenGLVertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer>& ver
         return;
     }
     
-    glBindVertexArray(m_RendererID);
+    GLStateCache::BindVertexArray(m_RendererID);
     vertexBuffer->Bind();
     
     const auto& layout = vertexBuffer->GetLayout();
@@ -113,7 +114,7 @@ void OpenGLVertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer>& ver
 }
 
 void OpenGLVertexArray::SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer) {
-    glBindVertexArray(m_RendererID);
+    GLStateCache::BindVertexArray(m_RendererID);
     indexBuffer->Bind();
     
     m_IndexBuffer = indexBuffer;
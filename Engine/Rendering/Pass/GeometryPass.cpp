@@ -13,7 +13,6 @@
 #include "Resource/Mesh.h"
 #include "Core/Log.h"
 #include <imgui.h>
-#include <glad/gl.h>
 
 namespace MyEngine {
 
@@ -27,44 +26,42 @@ void GeometryPass::OnDestroy() {
 }
 
 void GeometryPass::Execute(const SceneView& view, Registry* registry) {
-    if (!m_Shader || !registry) return;
-    
-    // Enable depth testing
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
+    // Standalone use (outside PassManager recording): record, sort and submit immediately
+    RenderBackend* backend = m_Backend ? m_Backend : Renderer::GetBackend();
+    if (!backend) return;
     
-    // Backface culling
-    if (m_EnableBackfaceCulling) {
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
-    } else {
-        glDisable(GL_CULL_FACE);
-    }
-    
-    // Wireframe mode
-    if (m_ShowWireframe) {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-    } else {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-    }
+    backend->SetFrameUniforms(view.GetFrameUniforms());
+    m_Commands.Reset();
+    Record(view, registry, m_Commands);
+    m_Queue.Reset();
+    m_Queue.Add(m_Commands);
+    m_Queue.Sort();
+    backend->Submit(m_Queue);
+}
+
+void GeometryPass::Record(const SceneView& view, Registry* registry, RenderCommandBuffer& commands) {
+    if (!m_Shader || !registry) return;
     
-    // Bind shader
-    m_Shader->Bind();
+    // Depth test, backface culling, wireframe
+    RenderState state;
+    state.depthTest = true;
+    state.depthCompare = RenderState::Compare::Less;
+    state.cullMode = m_EnableBackfaceCulling ? RenderState::Cull::Back : RenderState::Cull::None;
+    state.wireframe = m_ShowWireframe;
     
-    // Set view-projection matrix
-    m_Shader->SetMat4("u_ViewProjection", view.GetViewProjectionMatrix());
+    const uint64_t setupKey = RenderSortKey::Setup(RenderLayer::Opaque);
+    commands.SetState(setupKey, state);
     
-    // Set camera position for lighting
-    m_Shader->SetFloat3("u_CameraPos", view.GetPosition());
+    // View-projection and camera position come from the FrameData block (PassManager uploads it)
     
     // Set lighting uniforms (CRITICAL: must override shader defaults)
     Vec3 lightPos(10.0f, 10.0f, 10.0f);
     Vec3 lightColor(1.0f, 1.0f, 1.0f);
     Vec3 objectColor(0.7f, 0.75f, 0.8f);
     
-    m_Shader->SetFloat3("u_LightPos", lightPos);
-    m_Shader->SetFloat3("u_LightColor", lightColor);
-    m_Shader->SetFloat3("u_ObjectColor", objectColor);
+    commands.SetUniform(setupKey, m_Shader, "u_LightPos", lightPos);
+    commands.SetUniform(setupKey, m_Shader, "u_LightColor", lightColor);
+    commands.SetUniform(setupKey, m_Shader, "u_ObjectColor", objectColor);
     
     // Only log once at startup
     static bool logged = false;
@@ -74,34 +71,49 @@ void GeometryPass::Execute(const SceneView& view, Registry* registry) {
         logged = true;
     }
     
-    // Render all entities with MeshFilterComponent
-    auto entities = registry->GetEntitiesWith<TransformComponent, MeshFilterComponent>();
-    
-    for (EntityID entityID : entities) {
-        Entity entity(entityID, registry);
-        
-        auto& transform = entity.GetComponent<TransformComponent>();
-        auto& meshFilter = entity.GetComponent<MeshFilterComponent>();
-        
-        // Build model matrix from transform
-        Mat4 translationMat = Mat4::Translation(transform.localPosition);
-        Mat4 rotationMat = Mat4(); // TODO: Implement Quat::ToMatrix()
-        Mat4 scaleMat = Mat4::Scale(transform.localScale);
-        Mat4 modelMatrix = translationMat * rotationMat * scaleMat;
-        
-        // Set model matrix uniform
-        m_Shader->SetMat4("u_Transform", modelMatrix);
+    // One draw per mesh, sorted front to back (view-space depth of the object origin)
+    const uint16_t shaderId = RenderSortKey::ShaderID(m_Shader);
+    const float* viewMatrix = view.viewMatrix.m;
+    const float farPlane = view.GetFarPlane();
+    auto recordMesh = [&](const Mesh& mesh, const Mat4& modelMatrix) {
+        const auto& vertexArray = mesh.GetVertexArray();
+        if (!vertexArray || !vertexArray->GetIndexBuffer()) return;
         
-        // Render the mesh
-        if (meshFilter.mesh) {
-            Renderer::DrawMesh(*meshFilter.mesh, modelMatrix);
+        const float x = modelMatrix.m[12], y = modelMatrix.m[13], z = modelMatrix.m[14];
+        const float viewDepth = -(viewMatrix[2] * x + viewMatrix[6] * y + viewMatrix[10] * z + viewMatrix[14]);
+        const uint64_t key = RenderSortKey::Draw(RenderLayer::Opaque, shaderId, 0,
+                                                 RenderSortKey::Depth(viewDepth, farPlane));
+        commands.DrawIndexed(key, m_Shader, vertexArray.get(), vertexArray->GetIndexBuffer()->GetCount(), modelMatrix);
+    };
+    
+    // Frustum-culled list from PassManager
+    if (view.visibleSet && m_UseCulling) {
+        m_LastStats = view.visibleSet->Stats;
+        for (const VisibleMesh& visible : view.visibleSet->Meshes) {
+            recordMesh(*visible.mesh, visible.worldMatrix->ToMat4());
         }
+        return;
     }
+    m_LastStats = CullingStats();
+    
+    // Render all entities with MeshFilterComponent
+    registry->GetView<const TransformComponent, const MeshFilterComponent>().Each(
+        [&recordMesh](const TransformComponent& transform, const MeshFilterComponent& meshFilter) {
+            // Cached world matrix (TransformSystem keeps it current)
+            if (meshFilter.mesh) {
+                recordMesh(*meshFilter.mesh, transform.GetWorldMatrix());
+            }
+        });
 }
 
 void GeometryPass::OnGUI() {
     ImGui::Checkbox("Wireframe Mode", &m_ShowWireframe);
     ImGui::Checkbox("Backface Culling", &m_EnableBackfaceCulling);
+    ImGui::Checkbox("Frustum Culling", &m_UseCulling);
+    if (m_LastStats.Total > 0) {
+        ImGui::Text("Drawn %u / %u (culled %u), %.3f ms",
+                    m_LastStats.Drawn, m_LastStats.Total, m_LastStats.Culled, m_LastStats.CpuMs);
+    }
 }
 
 // Auto-register this pass
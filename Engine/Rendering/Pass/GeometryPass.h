@@ -22,6 +22,9 @@ public:
     
     void Execute(const SceneView& view, Registry* registry) override;
     
+    bool SupportsRecording() const override { return true; }
+    void Record(const SceneView& view, Registry* registry, RenderCommandBuffer& commands) override;
+    
     void OnGUI() override;
     
     void SetShader(Shader* shader) { m_Shader = shader; }
@@ -31,6 +34,10 @@ private:
     Shader* m_Shader = nullptr;
     bool m_ShowWireframe = false;
     bool m_EnableBackfaceCulling = false;
+    bool m_UseCulling = true;           // Draw SceneView::visibleSet when available
+    CullingStats m_LastStats;
+    RenderCommandBuffer m_Commands;     // Execute (standalone) only
+    RenderQueue m_Queue;
 };
 
 } // namespace MyEngine
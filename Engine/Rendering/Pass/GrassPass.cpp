@@ -9,6 +9,7 @@
 #include "Rendering/Renderer.h"
 #include "Rendering/RenderBackend.h"
 #include "Rendering/OpenGL/OpenGLShader.h"
+#include "Rendering/OpenGL/GLStateCache.h"
 #include "ECS/Components.h"
 #include "ECS/Entity.h"
 #include "Core/Log.h"
@@ -19,6 +20,27 @@
 
 namespace MyEngine {
 
+namespace {
+
+/**
+ * @brief std140 "PassData" block of the grass shader (both stages declare it identically)
+ */
+struct GrassPassUniforms {
+    Vec3 GrassColor;
+    float GrassHeight;
+    Vec3 GrassTipColor;
+    float WindStrength;
+    Vec3 WindDirection;
+    float WindSpeed;
+    Vec3 LightDir;
+    float Time;
+    Vec3 LightColor;
+    float Padding = 0.0f;
+};
+static_assert(sizeof(GrassPassUniforms) == 80, "std140 layout of the grass PassData block");
+
+} // namespace
+
 void GrassPass::OnCreate(RenderBackend* backend) {
     m_Backend = backend;
     
@@ -40,47 +62,36 @@ void GrassPass::OnDestroy() {
 void GrassPass::Execute(const SceneView& view, Registry* registry) {
     // Lazy initialization on first execute
     if (!m_Shader || !m_GrassMesh) {
-        // Save OpenGL state before creating resources
-        GLint oldVAO, oldArrayBuffer, oldElementBuffer;
-        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &oldVAO);
-        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &oldArrayBuffer);
-        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &oldElementBuffer);
-        GLint oldProgram;
-        glGetIntegerv(GL_CURRENT_PROGRAM, &oldProgram);
+        // Save OpenGL bindings before creating resources
+        const GLStateCache::State savedBindings = GLStateCache::Capture();
         
         CreateGrassField();
         CreateGrassShader();
         
-        // Restore OpenGL state after creating resources
-        glBindVertexArray(oldVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, oldArrayBuffer);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, oldElementBuffer);
-        glUseProgram(oldProgram);
+        // Restore OpenGL bindings after creating resources
+        GLStateCache::Restore(savedBindings, GLStateCache::RESTORE_BINDINGS);
         
         ENGINE_INFO("[GrassPass] Resources initialized on first execute");
     }
     
     if (!m_Shader || !m_GrassMesh) return;
     
-    // Save current OpenGL state
-    GLboolean wasBlendEnabled = glIsEnabled(GL_BLEND);
-    GLboolean wasDepthMaskEnabled;
-    glGetBooleanv(GL_DEPTH_WRITEMASK, &wasDepthMaskEnabled);
-    GLboolean wasCullFaceEnabled = glIsEnabled(GL_CULL_FACE);
+    // Save current OpenGL state (shadow copy, no glGet)
+    const GLStateCache::State savedState = GLStateCache::Capture();
     
     // Update time for wind animation
     m_Time += 0.016f;  // Approximate 60fps
     
     // Enable alpha blending for grass transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLStateCache::Enable(GL_BLEND);
+    GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     // Enable depth test but disable depth writing for correct alpha blending
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_FALSE);
+    GLStateCache::Enable(GL_DEPTH_TEST);
+    GLStateCache::DepthMask(false);
     
     // Disable backface culling to see grass from both sides
-    glDisable(GL_CULL_FACE);
+    GLStateCache::Disable(GL_CULL_FACE);
     
     // Bind shader
     m_Shader->Bind();
@@ -88,56 +99,38 @@ void GrassPass::Execute(const SceneView& view, Registry* registry) {
     // Find the GrassPass entity and get its transform
     Mat4 modelMatrix = Mat4(); // Identity matrix by default
     if (registry) {
-        auto entities = registry->GetEntitiesWith<PassComponent, TransformComponent>();
-        for (auto entityID : entities) {
-            Entity entity(entityID, registry);
-            auto& passComp = entity.GetComponent<PassComponent>();
-            if (passComp.pass == this) {
-                auto& transform = entity.GetComponent<TransformComponent>();
-                modelMatrix = transform.localMatrix;
-                break;
-            }
-        }
+        registry->GetView<const PassComponent, const TransformComponent>().Each(
+            [&](const PassComponent& passComp, const TransformComponent& transform) {
+                if (passComp.pass == this) {
+                    modelMatrix = transform.localMatrix.ToMat4();
+                    return false;
+                }
+                return true;
+            });
     }
     
-    // Set uniforms
-    m_Shader->SetMat4("u_ViewProjection", view.GetViewProjectionMatrix());
+    // Set uniforms (u_ViewProjection: FrameData block)
     m_Shader->SetMat4("u_Model", modelMatrix);
     
-    // Grass properties
-    m_Shader->SetFloat3("u_GrassColor", m_GrassColor);
-    m_Shader->SetFloat3("u_GrassTipColor", m_GrassTipColor);
-    m_Shader->SetFloat("u_GrassHeight", m_GrassHeight);
-    
-    // Wind animation
-    m_Shader->SetFloat3("u_WindDirection", m_WindDirection.Normalized());
-    m_Shader->SetFloat("u_WindStrength", m_WindStrength);
-    m_Shader->SetFloat("u_WindSpeed", m_WindSpeed);
-    m_Shader->SetFloat("u_Time", m_Time);
-    
-    // Lighting
-    m_Shader->SetFloat3("u_LightDir", Vec3(0.3f, -0.7f, 0.5f).Normalized());
-    m_Shader->SetFloat3("u_LightColor", Vec3(1.0f, 0.98f, 0.9f));
+    // Grass properties, wind animation and lighting: one PassData upload
+    GrassPassUniforms uniforms;
+    uniforms.GrassColor = m_GrassColor;
+    uniforms.GrassTipColor = m_GrassTipColor;
+    uniforms.GrassHeight = m_GrassHeight;
+    uniforms.WindDirection = m_WindDirection.Normalized();
+    uniforms.WindStrength = m_WindStrength;
+    uniforms.WindSpeed = m_WindSpeed;
+    uniforms.Time = m_Time;
+    uniforms.LightDir = Vec3(0.3f, -0.7f, 0.5f).Normalized();
+    uniforms.LightColor = Vec3(1.0f, 0.98f, 0.9f);
+    RenderBackend* backend = m_Backend ? m_Backend : Renderer::GetBackend();
+    if (backend) backend->SetPassUniforms(&uniforms, sizeof(uniforms));
     
     // Render grass
     Renderer::DrawMesh(*m_GrassMesh, modelMatrix);
     
     // Restore OpenGL state to previous values
-    if (wasDepthMaskEnabled) {
-        glDepthMask(GL_TRUE);
-    } else {
-        glDepthMask(GL_FALSE);
-    }
-    
-    if (!wasBlendEnabled) {
-        glDisable(GL_BLEND);
-    }
-    
-    if (wasCullFaceEnabled) {
-        glEnable(GL_CULL_FACE);
-    } else {
-        glDisable(GL_CULL_FACE);
-    }
+    GLStateCache::Restore(savedState, GLStateCache::RESTORE_FIXED_FUNCTION);
 }
 
 void GrassPass::OnGUI() {
@@ -263,15 +256,21 @@ void GrassPass::CreateGrassShader() {
         layout(location = 1) in vec3 a_Normal;
         layout(location = 2) in vec2 a_TexCoord;
         
-        uniform mat4 u_ViewProjection;
+        #include <FrameData>
         uniform mat4 u_Model;
-        uniform float u_GrassHeight;
         
-        // Wind parameters
-        uniform vec3 u_WindDirection;
-        uniform float u_WindStrength;
-        uniform float u_WindSpeed;
-        uniform float u_Time;
+        // Must match GrassPassUniforms
+        layout(std140) uniform PassData {
+            vec3 u_GrassColor;
+            float u_GrassHeight;
+            vec3 u_GrassTipColor;
+            float u_WindStrength;
+            vec3 u_WindDirection;
+            float u_WindSpeed;
+            vec3 u_LightDir;
+            float u_Time;
+            vec3 u_LightColor;
+        };
         
         out vec3 v_Normal;
         out vec2 v_TexCoord;
@@ -308,10 +307,18 @@ void GrassPass::CreateGrassShader() {
         in vec2 v_TexCoord;
         in float v_Height;
         
-        uniform vec3 u_GrassColor;
-        uniform vec3 u_GrassTipColor;
-        uniform vec3 u_LightDir;
-        uniform vec3 u_LightColor;
+        // Must match GrassPassUniforms
+        layout(std140) uniform PassData {
+            vec3 u_GrassColor;
+            float u_GrassHeight;
+            vec3 u_GrassTipColor;
+            float u_WindStrength;
+            vec3 u_WindDirection;
+            float u_WindSpeed;
+            vec3 u_LightDir;
+            float u_Time;
+            vec3 u_LightColor;
+        };
         
         out vec4 FragColor;
         
@@ -8,6 +8,7 @@
 #include "PostProcessPass.h"
 #include "Rendering/Renderer.h"
 #include "Rendering/RenderBackend.h"
+#include "Rendering/OpenGL/GLStateCache.h"
 #include "Core/Log.h"
 #include <imgui.h>
 #include <glad/gl.h>
@@ -15,11 +16,39 @@
 
 namespace MyEngine {
 
+namespace {
+
+/**
+ * @brief std140 "PassData" block of the post-process shader (scalars only: tightly packed)
+ */
+struct PostProcessPassUniforms {
+    float Time;
+    int32_t EnableBloom;        // GLSL bool: 4 bytes
+    int32_t EnableVignette;
+    int32_t EnableChromaticAberration;
+    int32_t EnableFilmGrain;
+    float Exposure;
+    float Contrast;
+    float Saturation;
+    float Brightness;
+    float BloomIntensity;
+    float BloomThreshold;
+    float VignetteIntensity;
+    float VignetteRadius;
+    float ChromaticAberrationStrength;
+    float FilmGrainIntensity;
+    float Padding = 0.0f;
+};
+static_assert(sizeof(PostProcessPassUniforms) == 64, "std140 layout of the post-process PassData block");
+
+} // namespace
+
 PostProcessPass::PostProcessPass() {
     SetPriority(1000); // Render last, after all other passes
 }
 
 void PostProcessPass::OnCreate(RenderBackend* backend) {
+    m_Backend = backend;
     ENGINE_INFO("[PostProcessPass] OnCreate called");
     try {
         CreateFullscreenQuad();
@@ -31,14 +60,14 @@ void PostProcessPass::OnCreate(RenderBackend* backend) {
         if (m_FallbackWhiteTex == 0) {
             GLuint tex = 0;
             glGenTextures(1, &tex);
-            glBindTexture(GL_TEXTURE_2D, tex);
+            GLStateCache::BindTexture(GL_TEXTURE_2D, tex);
             unsigned char white[4] = { 255, 255, 255, 255 };
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            GLStateCache::BindTexture(GL_TEXTURE_2D, 0);
             m_FallbackWhiteTex = tex;
         }
 
@@ -54,16 +83,16 @@ void PostProcessPass::OnDestroy() {
     m_PostProcessShader.reset();
 
     if (m_FallbackWhiteTex) {
-        glDeleteTextures(1, &m_FallbackWhiteTex);
+        GLStateCache::DeleteTexture(m_FallbackWhiteTex);
         m_FallbackWhiteTex = 0;
     }
 
     if (m_QuadVAO) {
-        glDeleteVertexArrays(1, &m_QuadVAO);
+        GLStateCache::DeleteVertexArray(m_QuadVAO);
         m_QuadVAO = 0;
     }
     if (m_QuadVBO) {
-        glDeleteBuffers(1, &m_QuadVBO);
+        GLStateCache::DeleteBuffer(m_QuadVBO);
         m_QuadVBO = 0;
     }
 }
@@ -84,8 +113,8 @@ void PostProcessPass::CreateFullscreenQuad() {
     glGenVertexArrays(1, &m_QuadVAO);
     glGenBuffers(1, &m_QuadVBO);
 
-    glBindVertexArray(m_QuadVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_QuadVBO);
+    GLStateCache::BindVertexArray(m_QuadVAO);
+    GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_QuadVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
 
     // Position attribute
@@ -96,7 +125,7 @@ void PostProcessPass::CreateFullscreenQuad() {
     glEnableVertexAttribArray(1);
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
 
-    glBindVertexArray(0);
+    GLStateCache::BindVertexArray(0);
 
     ENGINE_INFO("[PostProcessPass] Created fullscreen quad");
 }
@@ -120,33 +149,37 @@ void PostProcessPass::CreatePostProcessShader() {
         in vec2 v_TexCoord;
 
         uniform sampler2D u_ScreenTexture;
-        uniform float u_Time;
 
-        // Effect toggles
-        uniform bool u_EnableBloom;
-        uniform bool u_EnableVignette;
-        uniform bool u_EnableChromaticAberration;
-        uniform bool u_EnableFilmGrain;
+        // Must match PostProcessPassUniforms
+        layout(std140) uniform PassData {
+            float u_Time;
 
-        // Color grading
-        uniform float u_Exposure;
-        uniform float u_Contrast;
-        uniform float u_Saturation;
-        uniform float u_Brightness;
+            // Effect toggles
+            bool u_EnableBloom;
+            bool u_EnableVignette;
+            bool u_EnableChromaticAberration;
+            bool u_EnableFilmGrain;
 
-        // Bloom
-        uniform float u_BloomIntensity;
-        uniform float u_BloomThreshold;
+            // Color grading
+            float u_Exposure;
+            float u_Contrast;
+            float u_Saturation;
+            float u_Brightness;
 
-        // Vignette
-        uniform float u_VignetteIntensity;
-        uniform float u_VignetteRadius;
+            // Bloom
+            float u_BloomIntensity;
+            float u_BloomThreshold;
 
-        // Chromatic aberration
-        uniform float u_ChromaticAberrationStrength;
+            // Vignette
+            float u_VignetteIntensity;
+            float u_VignetteRadius;
 
-        // Film grain
-        uniform float u_FilmGrainIntensity;
+            // Chromatic aberration
+            float u_ChromaticAberrationStrength;
+
+            // Film grain
+            float u_FilmGrainIntensity;
+        };
 
         out vec4 FragColor;
 
@@ -241,88 +274,48 @@ void PostProcessPass::Execute(const SceneView& view, Registry* registry) {
 
     m_Time += 0.016f; // Approximate 60 FPS
 
-    // Save GL state (minimal set to avoid state leakage causing black regions)
-    GLboolean wasDepthTest = glIsEnabled(GL_DEPTH_TEST);
-    GLboolean wasCullFace  = glIsEnabled(GL_CULL_FACE);
-    GLboolean wasBlend     = glIsEnabled(GL_BLEND);
-    GLboolean oldDepthMask;
-    glGetBooleanv(GL_DEPTH_WRITEMASK, &oldDepthMask);
-
-    GLint oldDepthFunc = GL_LESS;
-    glGetIntegerv(GL_DEPTH_FUNC, &oldDepthFunc);
-
-    GLint oldProgram = 0;
-    glGetIntegerv(GL_CURRENT_PROGRAM, &oldProgram);
-
-    GLint oldVAO = 0;
-    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &oldVAO);
-
-    GLint oldActiveTex = 0;
-    glGetIntegerv(GL_ACTIVE_TEXTURE, &oldActiveTex);
-
-    GLint oldTex2D = 0;
-    glActiveTexture(GL_TEXTURE0);
-    glGetIntegerv(GL_TEXTURE_BINDING_2D, &oldTex2D);
+    // Save GL state to avoid state leakage causing black regions (shadow copy, no glGet)
+    const GLStateCache::State savedState = GLStateCache::Capture();
 
     // Setup for fullscreen
-    glDisable(GL_DEPTH_TEST);
-    glDepthMask(GL_FALSE);
-    glDisable(GL_CULL_FACE);
-    glDisable(GL_BLEND);
+    GLStateCache::Disable(GL_DEPTH_TEST);
+    GLStateCache::DepthMask(false);
+    GLStateCache::Disable(GL_CULL_FACE);
+    GLStateCache::Disable(GL_BLEND);
 
     m_PostProcessShader->Bind();
 
     // Bind screen texture (TODO: replace with real framebuffer color attachment).
     // Fallback to a white texture to avoid sampling black/undefined.
-    glActiveTexture(GL_TEXTURE0);
-    if (m_ScreenColorTexture != 0) {
-        glBindTexture(GL_TEXTURE_2D, m_ScreenColorTexture);
-    } else {
-        glBindTexture(GL_TEXTURE_2D, m_FallbackWhiteTex);
-    }
+    GLStateCache::BindTexture(0, GL_TEXTURE_2D, m_ScreenColorTexture != 0 ? m_ScreenColorTexture : m_FallbackWhiteTex);
 
-    // Set uniforms
+    // Set uniforms: sampler unit, then every effect parameter in one PassData upload
     m_PostProcessShader->SetInt("u_ScreenTexture", 0);
-    m_PostProcessShader->SetFloat("u_Time", m_Time);
-
-    m_PostProcessShader->SetBool("u_EnableBloom", m_EnableBloom);
-    m_PostProcessShader->SetBool("u_EnableVignette", m_EnableVignette);
-    m_PostProcessShader->SetBool("u_EnableChromaticAberration", m_EnableChromaticAberration);
-    m_PostProcessShader->SetBool("u_EnableFilmGrain", m_EnableFilmGrain);
-
-    m_PostProcessShader->SetFloat("u_Exposure", m_Exposure);
-    m_PostProcessShader->SetFloat("u_Contrast", m_Contrast);
-    m_PostProcessShader->SetFloat("u_Saturation", m_Saturation);
-    m_PostProcessShader->SetFloat("u_Brightness", m_Brightness);
 
-    m_PostProcessShader->SetFloat("u_BloomIntensity", m_BloomIntensity);
-    m_PostProcessShader->SetFloat("u_BloomThreshold", m_BloomThreshold);
-
-    m_PostProcessShader->SetFloat("u_VignetteIntensity", m_VignetteIntensity);
-    m_PostProcessShader->SetFloat("u_VignetteRadius", m_VignetteRadius);
-
-    m_PostProcessShader->SetFloat("u_ChromaticAberrationStrength", m_ChromaticAberrationStrength);
-    m_PostProcessShader->SetFloat("u_FilmGrainIntensity", m_FilmGrainIntensity);
-
-    glBindVertexArray(m_QuadVAO);
+    PostProcessPassUniforms uniforms;
+    uniforms.Time = m_Time;
+    uniforms.EnableBloom = m_EnableBloom;
+    uniforms.EnableVignette = m_EnableVignette;
+    uniforms.EnableChromaticAberration = m_EnableChromaticAberration;
+    uniforms.EnableFilmGrain = m_EnableFilmGrain;
+    uniforms.Exposure = m_Exposure;
+    uniforms.Contrast = m_Contrast;
+    uniforms.Saturation = m_Saturation;
+    uniforms.Brightness = m_Brightness;
+    uniforms.BloomIntensity = m_BloomIntensity;
+    uniforms.BloomThreshold = m_BloomThreshold;
+    uniforms.VignetteIntensity = m_VignetteIntensity;
+    uniforms.VignetteRadius = m_VignetteRadius;
+    uniforms.ChromaticAberrationStrength = m_ChromaticAberrationStrength;
+    uniforms.FilmGrainIntensity = m_FilmGrainIntensity;
+    RenderBackend* backend = m_Backend ? m_Backend : Renderer::GetBackend();
+    if (backend) backend->SetPassUniforms(&uniforms, sizeof(uniforms));
+
+    GLStateCache::BindVertexArray(m_QuadVAO);
     glDrawArrays(GL_TRIANGLES, 0, 6);
-    glBindVertexArray(0);
-
-    // Restore texture bindings
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, oldTex2D);
-    glActiveTexture(oldActiveTex);
-
-    // Restore shader program/VAO
-    glUseProgram(oldProgram);
-    glBindVertexArray(oldVAO);
-
-    // Restore depth/cull/blend state
-    if (wasDepthTest) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
-    if (wasCullFace)  glEnable(GL_CULL_FACE);  else glDisable(GL_CULL_FACE);
-    if (wasBlend)     glEnable(GL_BLEND);      else glDisable(GL_BLEND);
-    glDepthMask(oldDepthMask ? GL_TRUE : GL_FALSE);
-    glDepthFunc(oldDepthFunc);
+
+    // Restore texture bindings, shader program/VAO and depth/cull/blend state
+    GLStateCache::Restore(savedState);
 }
 
 void PostProcessPass::OnGUI() {
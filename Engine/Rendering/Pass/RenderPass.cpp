@@ -8,6 +8,8 @@
 #include "RenderPass.h"
 #include "Rendering/RenderBackend.h"
 #include "Core/Log.h"
+#include "Core/Profiler.h"
+#include "ECS/SystemScheduler.h"
 #include <glad/gl.h>
 #include <algorithm>
 
@@ -61,6 +63,7 @@ RenderPass* PassManager::GetPass(const char* name) {
 }
 
 void PassManager::OnCreate(RenderBackend* backend) {
+    m_Backend = backend;
     for (auto& pass : m_Passes) {
         pass->OnCreate(backend);
     }
@@ -71,6 +74,8 @@ void PassManager::OnDestroy() {
         pass->OnDestroy();
     }
     m_Passes.clear();
+    m_Queue.Reset();
+    m_PassCommands.clear();
 }
 
 void PassManager::OnResize(uint32_t width, uint32_t height) {
@@ -80,11 +85,77 @@ void PassManager::OnResize(uint32_t width, uint32_t height) {
 }
 
 void PassManager::Execute(const SceneView& view, Registry* registry) {
-    for (auto& pass : m_Passes) {
-        if (pass->IsEnabled()) {
-            pass->Execute(view, registry);
+    PROFILE_SCOPE("PassManager::Execute");
+    
+    // Cull once per view; every pass gets the same compact visible list
+    SceneView culledView = view;
+    if (m_CullingEnabled && registry) {
+        culledView.visibleSet = &m_Culler.Cull(view.GetViewProjectionMatrix(), *registry);
+    }
+    
+    // FrameData block: one upload per view instead of u_ViewProjection / u_CameraPos in every pass
+    if (m_Backend) {
+        m_Backend->SetFrameUniforms(view.GetFrameUniforms());
+    }
+    
+    m_CommandStats = ReplayStats();
+    const bool recording = m_RecordingEnabled && m_Backend;
+    size_t index = 0;
+    while (index < m_Passes.size()) {
+        RenderPass* pass = m_Passes[index].get();
+        if (!pass->IsEnabled()) {
+            index++;
+            continue;
+        }
+        if (!recording || !pass->SupportsRecording()) {
+            PROFILE_SCOPE(pass->GetName());
+            pass->Execute(culledView, registry);
+            index++;
+            continue;
+        }
+        
+        // Run of recording passes up to the next enabled immediate pass
+        m_RecordingPasses.clear();
+        for (; index < m_Passes.size(); index++) {
+            RenderPass* next = m_Passes[index].get();
+            if (!next->IsEnabled()) continue;
+            if (!next->SupportsRecording()) break;
+            m_RecordingPasses.push_back(static_cast<uint32_t>(index));
+        }
+        ExecuteRecorded(culledView, registry);
+    }
+}
+
+void PassManager::ExecuteRecorded(const SceneView& view, Registry* registry) {
+    if (m_PassCommands.size() < m_Passes.size()) {
+        m_PassCommands.resize(m_Passes.size());
+    }
+    
+    // One task per pass; the pass index (= priority order) becomes the top byte of every key
+    {
+        PROFILE_SCOPE("PassManager::Record");
+        const uint32_t count = static_cast<uint32_t>(m_RecordingPasses.size());
+        SystemScheduler::ParallelRange(count, 1, [this, &view, registry](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                const uint32_t passIndex = m_RecordingPasses[i];
+                RenderCommandBuffer& commands = m_PassCommands[passIndex];
+                commands.Reset(static_cast<uint8_t>(std::min<uint32_t>(passIndex, 255)));
+                m_Passes[passIndex]->Record(view, registry, commands);
+            }
+        });
+    }
+    
+    {
+        PROFILE_SCOPE("PassManager::SortCommands");
+        m_Queue.Reset();
+        for (uint32_t passIndex : m_RecordingPasses) {
+            m_Queue.Add(m_PassCommands[passIndex]);
         }
+        m_Queue.Sort();
     }
+    
+    PROFILE_SCOPE("PassManager::Submit");
+    m_CommandStats += m_Backend->Submit(m_Queue);
 }
 
 void PassManager::SetPassEnabled(const char* name, bool enabled) {
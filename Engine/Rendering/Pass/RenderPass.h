@@ -9,6 +9,9 @@
 
 #include "Math/MathTypes.h"
 #include "Rendering/Camera.h"
+#include "Rendering/VisibilityCuller.h"
+#include "Rendering/RenderCommandBuffer.h"
+#include "Rendering/UniformBlocks.h"
 #include "ECS/Registry.h"
 #include <string>
 #include <memory>
@@ -70,6 +73,9 @@ struct SceneView {
     float nearPlane = 0.1f;
     float farPlane = 1000.0f;
     
+    // Frustum-culled mesh entities for this view (set by PassManager; null = not culled)
+    const VisibleSet* visibleSet = nullptr;
+    
     SceneView() = default;
     
     SceneView(const Mat4& view, const Mat4& proj, const Vec3& camPos)
@@ -85,6 +91,16 @@ struct SceneView {
     Vec3 GetPosition() const { return cameraPosition; }
     float GetNearPlane() const { return nearPlane; }
     float GetFarPlane() const { return farPlane; }
+    
+    FrameUniforms GetFrameUniforms() const {
+        FrameUniforms frame;
+        frame.ViewProjection = viewProjectionMatrix;
+        frame.View = viewMatrix;
+        frame.Projection = projectionMatrix;
+        frame.CameraPosition = cameraPosition;
+        frame.FarPlane = farPlane;
+        return frame;
+    }
 };
 
 // ============================================================================
@@ -108,6 +124,15 @@ public:
     // ========== Execution ==========
     virtual void Execute(const SceneView& view, Registry* registry) = 0;
     
+    // ========== Command recording ==========
+    /**
+     * @brief Passes returning true are recorded by PassManager instead of executed
+     * Record may run on a worker thread alongside other passes' Record:
+     * it must not call the graphics API or modify shared state
+     */
+    virtual bool SupportsRecording() const { return false; }
+    virtual void Record(const SceneView& view, Registry* registry, RenderCommandBuffer& commands) {}
+    
     // ========== GUI configuration (Editor) ==========
     virtual void OnGUI() {}
     
@@ -244,9 +269,36 @@ public:
     
     std::vector<RenderPass*> GetAllPasses();
     
+    /**
+     * @brief Frustum culling before the passes run (on by default)
+     * When disabled, SceneView::visibleSet stays null and passes draw everything
+     */
+    void SetCullingEnabled(bool enabled) { m_CullingEnabled = enabled; }
+    bool IsCullingEnabled() const { return m_CullingEnabled; }
+    const CullingStats& GetCullingStats() const { return m_Culler.GetVisibleSet().Stats; }
+    
+    /**
+     * @brief Record SupportsRecording passes into command buffers (on by default)
+     * Consecutive recording passes are recorded in parallel, merged, sorted and
+     * submitted to the backend together; other passes still run Execute in priority order
+     */
+    void SetRecordingEnabled(bool enabled) { m_RecordingEnabled = enabled; }
+    bool IsRecordingEnabled() const { return m_RecordingEnabled; }
+    const ReplayStats& GetCommandStats() const { return m_CommandStats; }
+    
 private:
     std::vector<std::unique_ptr<RenderPass>> m_Passes;
+    VisibilityCuller m_Culler;
+    bool m_CullingEnabled = true;
+    
+    RenderBackend* m_Backend = nullptr;
+    bool m_RecordingEnabled = true;
+    std::vector<uint32_t> m_RecordingPasses;           // Current run (indices into m_Passes)
+    std::vector<RenderCommandBuffer> m_PassCommands;   // Per pass index
+    RenderQueue m_Queue;                               // Merged + sorted run
+    ReplayStats m_CommandStats;                        // Last Execute
     
+    void ExecuteRecorded(const SceneView& view, Registry* registry);
     void SortPassesByPriority();
 };
 
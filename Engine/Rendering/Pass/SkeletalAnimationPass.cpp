@@ -5,6 +5,7 @@
 
 #include "SkeletalAnimationPass.h"
 #include "Rendering/OpenGL/OpenGLShader.h"
+#include "Rendering/OpenGL/GLStateCache.h"
 #include "Core/Log.h"
 #include <fstream>
 #include <sstream>
@@ -51,7 +52,8 @@ void SkeletalAnimationPass::CreateAnimatedModel() {
     }
     
     // Create animator
-    m_Animator = std::make_unique<Animator>(m_Animation.get());
+    m_Animator.reset();   // Returns its palette range before the new one allocates
+    m_Animator = std::make_unique<Animator>(m_Animation.get(), &m_BonePalette);
     
     ENGINE_INFO("[SkeletalAnimationPass] Model loaded successfully");
 }
@@ -99,12 +101,12 @@ void SkeletalAnimationPass::LoadTextures() {
     
     // Create fallback white texture
     glGenTextures(1, &m_WhiteTexture);
-    glBindTexture(GL_TEXTURE_2D, m_WhiteTexture);
+    GLStateCache::BindTexture(GL_TEXTURE_2D, m_WhiteTexture);
     unsigned char whitePixel[4] = { 255, 255, 255, 255 };
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, whitePixel);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLStateCache::BindTexture(GL_TEXTURE_2D, 0);
     ENGINE_INFO("[SkeletalAnimationPass] White texture created");
     
     // TODO: Texture loading is currently disabled due to STB_IMAGE_IMPLEMENTATION conflicts
@@ -126,20 +128,18 @@ void SkeletalAnimationPass::Execute(const SceneView& view, Registry* registry) {
     // Update animation (assuming 60fps)
     m_Animator->UpdateAnimation(0.016f);
     
-    // Save OpenGL state
-    GLboolean wasDepthTestEnabled = glIsEnabled(GL_DEPTH_TEST);
-    GLboolean wasCullFaceEnabled = glIsEnabled(GL_CULL_FACE);
+    // Save OpenGL state (shadow copy, no glIsEnabled)
+    const GLStateCache::State savedState = GLStateCache::Capture();
     
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_BACK);
+    GLStateCache::Enable(GL_DEPTH_TEST);
+    GLStateCache::Enable(GL_CULL_FACE);
+    GLStateCache::CullFace(GL_BACK);
     
     // Bind shader
     m_Shader->Bind();
     
     // Bind diffuse texture (or white fallback)
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_DiffuseTextureID ? m_DiffuseTextureID : m_WhiteTexture);
+    GLStateCache::BindTexture(0, GL_TEXTURE_2D, m_DiffuseTextureID ? m_DiffuseTextureID : m_WhiteTexture);
     m_Shader->SetInt("texture_diffuse1", 0);
     
     // Setup matrices
@@ -158,12 +158,9 @@ void SkeletalAnimationPass::Execute(const SceneView& view, Registry* registry) {
     m_Shader->SetMat4("view", viewMat);
     m_Shader->SetMat4("model", model);
     
-    // Upload bone matrices
-    auto transforms = m_Animator->GetFinalBoneMatrices();
-    for (size_t i = 0; i < transforms.size(); ++i) {
-        std::string uniformName = "finalBonesMatrices[" + std::to_string(i) + "]";
-        m_Shader->SetMat4(uniformName, transforms[i]);
-    }
+    // Upload bone matrices: the instance's palette range, in place, as one array upload
+    std::span<const Mat4> bones = m_Animator->GetFinalBoneMatrices();
+    m_Shader->SetMat4Array("finalBonesMatrices", bones.data(), static_cast<uint32_t>(bones.size()));
     
     // Draw mesh
     auto vao = m_AnimatedMesh->GetVertexArray();
@@ -175,18 +172,17 @@ void SkeletalAnimationPass::Execute(const SceneView& view, Registry* registry) {
     m_Shader->Unbind();
     
     // Restore OpenGL state
-    if (!wasDepthTestEnabled) glDisable(GL_DEPTH_TEST);
-    if (!wasCullFaceEnabled) glDisable(GL_CULL_FACE);
+    GLStateCache::Restore(savedState, GLStateCache::RESTORE_FIXED_FUNCTION);
 }
 
 void SkeletalAnimationPass::OnDestroy() {
     if (m_DiffuseTextureID) {
-        glDeleteTextures(1, &m_DiffuseTextureID);
+        if (m_DiffuseTextureID != m_WhiteTexture) GLStateCache::DeleteTexture(m_DiffuseTextureID);
         m_DiffuseTextureID = 0;
     }
     
     if (m_WhiteTexture) {
-        glDeleteTextures(1, &m_WhiteTexture);
+        GLStateCache::DeleteTexture(m_WhiteTexture);
         m_WhiteTexture = 0;
     }
     
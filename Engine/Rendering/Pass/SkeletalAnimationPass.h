@@ -50,6 +50,7 @@ private:
     std::unique_ptr<AnimatedModelLoader> m_ModelLoader;
     std::shared_ptr<AnimatedMesh> m_AnimatedMesh;
     std::shared_ptr<Animation> m_Animation;
+    BonePalette m_BonePalette;              // Bone matrices of every animated instance, one range each
     std::unique_ptr<Animator> m_Animator;
     
     // Rendering resources
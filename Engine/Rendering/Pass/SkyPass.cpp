@@ -9,6 +9,7 @@
 #include "Rendering/Renderer.h"
 #include "Rendering/RenderBackend.h"
 #include "Rendering/OpenGL/OpenGLShader.h"
+#include "Rendering/OpenGL/GLStateCache.h"
 #include "Core/Log.h"
 #include <imgui.h>
 #include <glad/gl.h>
@@ -37,16 +38,13 @@ void SkyPass::OnDestroy() {
 void SkyPass::Execute(const SceneView& view, Registry* registry) {
     if (!m_Shader || !m_SkyMesh) return;
 
-    // 保存并在渲染后恢复面剔除状态，避免影响其它 pass 导致黑块
-    GLboolean wasCull = glIsEnabled(GL_CULL_FACE);
-    if (wasCull) {
-        glDisable(GL_CULL_FACE);
-    }
+    // 保存并在渲染后恢复面剔除 / 深度状态，避免影响其它 pass 导致黑块（读影子状态，不查询 GL）
+    const GLStateCache::State savedState = GLStateCache::Capture();
+    GLStateCache::Disable(GL_CULL_FACE);
 
     // Disable depth writing (but keep depth test)
-    glDepthMask(GL_FALSE);
-    glDepthFunc(GL_LEQUAL);
-    // glDisable(GL_CULL_FACE); // 不再直接调用（已通过 wasCull 控制）
+    GLStateCache::DepthMask(false);
+    GLStateCache::DepthFunc(GL_LEQUAL);
 
     // Bind shader
     m_Shader->Bind();
@@ -72,14 +70,8 @@ void SkyPass::Execute(const SceneView& view, Registry* registry) {
     // Render sky sphere
     Renderer::DrawMesh(*m_SkyMesh, Mat4());
 
-    // Restore depth writing
-    glDepthMask(GL_TRUE);
-    glDepthFunc(GL_LESS);
-
-    // 恢复原来的面剔除状态
-    if (wasCull) {
-        glEnable(GL_CULL_FACE);
-    }
+    // Restore depth writing / culling
+    GLStateCache::Restore(savedState, GLStateCache::RESTORE_FIXED_FUNCTION);
 }
 
 void SkyPass::OnGUI() {
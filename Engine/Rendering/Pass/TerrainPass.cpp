@@ -8,6 +8,7 @@
 #include "TerrainPass.h"
 #include "Rendering/Renderer.h"
 #include "Rendering/RenderBackend.h"
+#include "Rendering/OpenGL/GLStateCache.h"
 #include "Core/Log.h"
 #include "ECS/Entity.h"
 #include "ECS/Components.h"
@@ -148,7 +149,7 @@ void TerrainPass::CreateTerrainShader() {
         layout(location = 1) in vec3 a_Normal;
         layout(location = 2) in vec2 a_TexCoord;
         
-        uniform mat4 u_ViewProjection;
+        #include <FrameData>
         uniform mat4 u_Model;
         
         out vec3 v_WorldPos;
@@ -179,7 +180,7 @@ void TerrainPass::CreateTerrainShader() {
         in vec2 v_TexCoord;
         in float v_Height;
         
-        uniform vec3 u_CameraPos;
+        #include <FrameData>
         uniform vec3 u_GrassColor;
         uniform vec3 u_RockColor;
         uniform vec3 u_SandColor;
@@ -302,20 +303,19 @@ void TerrainPass::CreateTerrainShader() {
 void TerrainPass::Execute(const SceneView& view, Registry* registry) {
     if (!m_TerrainMesh || !m_TerrainShader) return;
     
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_BACK);
+    GLStateCache::Enable(GL_DEPTH_TEST);
+    GLStateCache::DepthFunc(GL_LESS);
+    GLStateCache::Enable(GL_CULL_FACE);
+    GLStateCache::CullFace(GL_BACK);
     
     if (m_ShowWireframe) {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        GLStateCache::PolygonMode(GL_LINE);
     } else {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        GLStateCache::PolygonMode(GL_FILL);
     }
     
+    // u_ViewProjection / u_CameraPos: FrameData block
     m_TerrainShader->Bind();
-    m_TerrainShader->SetMat4("u_ViewProjection", view.GetViewProjectionMatrix());
-    m_TerrainShader->SetFloat3("u_CameraPos", view.GetPosition());
     m_TerrainShader->SetFloat3("u_GrassColor", m_GrassColor);
     m_TerrainShader->SetFloat3("u_RockColor", m_RockColor);
     m_TerrainShader->SetFloat3("u_SandColor", m_SandColor);
@@ -325,14 +325,13 @@ void TerrainPass::Execute(const SceneView& view, Registry* registry) {
     Mat4 modelMatrix = Mat4(); // Identity matrix
     bool foundEntity = false;
     if (registry) {
-        auto entities = registry->GetEntitiesWith<PassComponent, TransformComponent>();
-        for (auto entityID : entities) {
-            Entity entity(entityID, registry);
-            auto& passComp = entity.GetComponent<PassComponent>();
-            // Check if this entity corresponds to this terrain pass
-            if (passComp.pass == this) {
-                auto& transform = entity.GetComponent<TransformComponent>();
-                modelMatrix = transform.localMatrix;
+        registry->GetView<const PassComponent, const TransformComponent>().Each(
+            [&](const PassComponent& passComp, const TransformComponent& transform) {
+                // Check if this entity corresponds to this terrain pass
+                if (passComp.pass != this) {
+                    return true;
+                }
+                modelMatrix = transform.localMatrix.ToMat4();
                 foundEntity = true;
                 
                 // Debug: Log transform info every 10 frames
@@ -342,9 +341,8 @@ void TerrainPass::Execute(const SceneView& view, Registry* registry) {
                         transform.localPosition.x, transform.localPosition.y, transform.localPosition.z,
                         modelMatrix.m[12], modelMatrix.m[13], modelMatrix.m[14]);
                 }
-                break;
-            }
-        }
+                return false;
+            });
     }
     
     if (!foundEntity) {
@@ -360,7 +358,7 @@ void TerrainPass::Execute(const SceneView& view, Registry* registry) {
     
     Renderer::DrawMesh(*m_TerrainMesh, modelMatrix);
     
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    GLStateCache::PolygonMode(GL_FILL);
 }
 
 void TerrainPass::OnGUI() {
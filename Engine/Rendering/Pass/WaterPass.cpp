@@ -9,6 +9,7 @@
 #include "WaterPass.h"
 #include "Rendering/Renderer.h"
 #include "Rendering/RenderBackend.h"
+#include "Rendering/OpenGL/GLStateCache.h"
 #include "Core/Log.h"
 #include "ECS/Entity.h"
 #include "ECS/Components.h"
@@ -18,11 +19,35 @@
 
 namespace MyEngine {
 
+namespace {
+
+/**
+ * @brief std140 "PassData" block of the water shader (both stages declare it identically)
+ */
+struct WaterPassUniforms {
+    Vec3 WaterColor;
+    float Transparency;
+    Vec3 SunDirection;
+    float Time;
+    float WaveAmplitude;
+    float WaveFrequency;
+    float WaveSpeed;
+    float NormalStrength;
+    float NormalScale;
+    int32_t UseNormalMap;       // GLSL bool: 4 bytes
+    int32_t UseReflectionMap;
+    float Padding = 0.0f;
+};
+static_assert(sizeof(WaterPassUniforms) == 64, "std140 layout of the water PassData block");
+
+} // namespace
+
 WaterPass::WaterPass() {
     SetPriority(90); // Render after most opaque objects for proper transparency
 }
 
 void WaterPass::OnCreate(RenderBackend* backend) {
+    m_Backend = backend;
     CreateWaterPlane();
     CreateWaterShader();
     LoadTextures();
@@ -101,12 +126,23 @@ void WaterPass::CreateWaterShader() {
         layout(location = 2) in vec2 a_TexCoord;
 
         // Add model and normal matrix uniforms
-        uniform mat4 u_ViewProjection;
+        #include <FrameData>
         uniform mat4 u_Model;
-        uniform float u_Time;
-        uniform float u_WaveAmplitude;
-        uniform float u_WaveFrequency;
-        uniform float u_WaveSpeed;
+
+        // Must match WaterPassUniforms
+        layout(std140) uniform PassData {
+            vec3 u_WaterColor;
+            float u_Transparency;
+            vec3 u_SunDirection;
+            float u_Time;
+            float u_WaveAmplitude;
+            float u_WaveFrequency;
+            float u_WaveSpeed;
+            float u_NormalStrength;
+            float u_NormalScale;
+            bool u_UseNormalMap;
+            bool u_UseReflectionMap;
+        };
 
         out vec3 v_WorldPos;
         out vec3 v_Normal;
@@ -165,20 +201,26 @@ void WaterPass::CreateWaterShader() {
         in vec2 v_TexCoord;
         in float v_WaveHeight;
 
-        uniform vec3 u_CameraPos;
-        uniform vec3 u_WaterColor;
-        uniform float u_Transparency;
-        uniform vec3 u_SunDirection;
-        uniform float u_Time;
-        uniform float u_WaveSpeed;
+        #include <FrameData>
+
+        // Must match WaterPassUniforms
+        layout(std140) uniform PassData {
+            vec3 u_WaterColor;
+            float u_Transparency;
+            vec3 u_SunDirection;
+            float u_Time;
+            float u_WaveAmplitude;
+            float u_WaveFrequency;
+            float u_WaveSpeed;
+            float u_NormalStrength;
+            float u_NormalScale;
+            bool u_UseNormalMap;
+            bool u_UseReflectionMap;
+        };
 
         // Texture uniforms
         uniform sampler2D u_NormalMap;
         uniform samplerCube u_ReflectionMap;
-        uniform bool u_UseNormalMap;
-        uniform bool u_UseReflectionMap;
-        uniform float u_NormalStrength;
-        uniform float u_NormalScale;
 
         out vec4 FragColor;
 
@@ -327,10 +369,10 @@ void WaterPass::Execute(const SceneView& view, Registry* registry) {
     m_Time += 0.016f;  // Approximate 60 FPS
 
     // Enable blending for transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_FALSE); // Don't write to depth buffer for transparent water
+    GLStateCache::Enable(GL_BLEND);
+    GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLStateCache::Enable(GL_DEPTH_TEST);
+    GLStateCache::DepthMask(false); // Don't write to depth buffer for transparent water
 
     m_WaterShader->Bind();
 
@@ -345,43 +387,40 @@ void WaterPass::Execute(const SceneView& view, Registry* registry) {
         m_WaterShader->SetInt("u_ReflectionMap", 1);
     }
 
-    // Set shader uniforms
-    m_WaterShader->SetMat4("u_ViewProjection", view.GetViewProjectionMatrix());
-    m_WaterShader->SetFloat3("u_CameraPos", view.GetPosition());
-    m_WaterShader->SetFloat3("u_WaterColor", m_WaterColor);
-    m_WaterShader->SetFloat("u_Transparency", m_Transparency);
-    m_WaterShader->SetFloat("u_Time", m_Time);
-    m_WaterShader->SetFloat("u_WaveAmplitude", m_WaveAmplitude);
-    m_WaterShader->SetFloat("u_WaveFrequency", m_WaveFrequency);
-    m_WaterShader->SetFloat("u_WaveSpeed", m_WaveSpeed);
-    m_WaterShader->SetFloat3("u_SunDirection", Vec3(0.3f, 0.8f, 0.5f));
-
-    // Texture settings
-    m_WaterShader->SetBool("u_UseNormalMap", m_UseNormalMap && m_NormalMap != nullptr);
-    m_WaterShader->SetBool("u_UseReflectionMap", m_UseReflectionMap && m_ReflectionMap != nullptr);
-    m_WaterShader->SetFloat("u_NormalStrength", m_NormalStrength);
-    m_WaterShader->SetFloat("u_NormalScale", m_NormalScale);
+    // Water, wave and texture settings: one PassData upload (view / camera: FrameData block)
+    WaterPassUniforms uniforms;
+    uniforms.WaterColor = m_WaterColor;
+    uniforms.Transparency = m_Transparency;
+    uniforms.SunDirection = Vec3(0.3f, 0.8f, 0.5f);
+    uniforms.Time = m_Time;
+    uniforms.WaveAmplitude = m_WaveAmplitude;
+    uniforms.WaveFrequency = m_WaveFrequency;
+    uniforms.WaveSpeed = m_WaveSpeed;
+    uniforms.NormalStrength = m_NormalStrength;
+    uniforms.NormalScale = m_NormalScale;
+    uniforms.UseNormalMap = m_UseNormalMap && m_NormalMap != nullptr;
+    uniforms.UseReflectionMap = m_UseReflectionMap && m_ReflectionMap != nullptr;
+    RenderBackend* backend = m_Backend ? m_Backend : Renderer::GetBackend();
+    if (backend) backend->SetPassUniforms(&uniforms, sizeof(uniforms));
 
     // Find the WaterPass entity and get its transform
     Mat4 modelMatrix = Mat4(); // Identity matrix - water level is controlled by vertex Y coordinates
     if (registry) {
-        auto entities = registry->GetEntitiesWith<PassComponent, TransformComponent>();
-        for (auto entityID : entities) {
-            Entity entity(entityID, registry);
-            auto& passComp = entity.GetComponent<PassComponent>();
-            // Check if this entity corresponds to this water pass
-            if (passComp.pass == this) {
-                auto& transform = entity.GetComponent<TransformComponent>();
+        registry->GetView<const PassComponent, const TransformComponent>().Each(
+            [&](const PassComponent& passComp, const TransformComponent& transform) {
+                // Check if this entity corresponds to this water pass
+                if (passComp.pass != this) {
+                    return true;
+                }
                 // Only use rotation and scale from transform, ignore translation
                 // Water level is controlled by m_WaterLevel in the mesh vertices
-                modelMatrix = transform.localMatrix;
+                modelMatrix = transform.localMatrix.ToMat4();
                 
                 // Force Y translation to 0 to prevent double-translation
                 // Mat4 is column-major: translation is in indices 12, 13, 14 for X, Y, Z
                 modelMatrix.m[13] = 0.0f;  // Set Y component of translation to 0
-                break;
-            }
-        }
+                return false;
+            });
     }
 
     // Set model matrix uniform
@@ -392,8 +431,8 @@ void WaterPass::Execute(const SceneView& view, Registry* registry) {
 
     Renderer::DrawMesh(*m_WaterMesh, modelMatrix);
 
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
+    GLStateCache::DepthMask(true);
+    GLStateCache::Disable(GL_BLEND);
 }
 
 void WaterPass::OnGUI() {
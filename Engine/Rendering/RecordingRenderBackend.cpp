@@ -0,0 +1,88 @@
+/******************************************************************************
+ * File: RecordingRenderBackend.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Call-logging RenderBackend implementation
+ ******************************************************************************/
+
+#include "RecordingRenderBackend.h"
+
+namespace MyEngine {
+
+RecordedCall& RecordingRenderBackend::Record(RecordedCall::Kind kind) {
+    RecordedCall& call = m_Calls.emplace_back();
+    call.kind = kind;
+    return call;
+}
+
+void RecordingRenderBackend::Init() {
+    if (m_Forward) m_Forward->Init();
+}
+
+void RecordingRenderBackend::Shutdown() {
+    if (m_Forward) m_Forward->Shutdown();
+}
+
+void RecordingRenderBackend::BeginFrame() {
+    m_Calls.clear();
+    if (m_Forward) m_Forward->BeginFrame();
+}
+
+void RecordingRenderBackend::EndFrame() {
+    if (m_Forward) m_Forward->EndFrame();
+}
+
+void RecordingRenderBackend::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    Record(RecordedCall::Kind::SetViewport).value = width;
+    if (m_Forward) m_Forward->SetViewport(x, y, width, height);
+}
+
+void RecordingRenderBackend::SetClearColor(const Vec4& color) {
+    Record(RecordedCall::Kind::SetClearColor);
+    if (m_Forward) m_Forward->SetClearColor(color);
+}
+
+void RecordingRenderBackend::Clear() {
+    Record(RecordedCall::Kind::Clear);
+    if (m_Forward) m_Forward->Clear();
+}
+
+void RecordingRenderBackend::DrawIndexed(uint32_t indexCount) {
+    Record(RecordedCall::Kind::DrawIndexed).value = indexCount;
+    if (m_Forward) m_Forward->DrawIndexed(indexCount);
+}
+
+void RecordingRenderBackend::SetFrameUniforms(const FrameUniforms& frame) {
+    Record(RecordedCall::Kind::SetFrameUniforms);
+    if (m_Forward) m_Forward->SetFrameUniforms(frame);
+}
+
+void RecordingRenderBackend::SetPassUniforms(const void* data, uint32_t size) {
+    Record(RecordedCall::Kind::SetPassUniforms).value = size;
+    if (m_Forward) m_Forward->SetPassUniforms(data, size);
+}
+
+void RecordingRenderBackend::SetRenderState(const RenderState& state) {
+    Record(RecordedCall::Kind::SetRenderState).state = state;
+    if (m_Forward) m_Forward->SetRenderState(state);
+}
+
+void RecordingRenderBackend::BindShader(Shader* shader) {
+    Record(RecordedCall::Kind::BindShader).shader = shader;
+    if (m_Forward) m_Forward->BindShader(shader);
+}
+
+void RecordingRenderBackend::BindVertexArray(const VertexArray* vertexArray) {
+    Record(RecordedCall::Kind::BindVertexArray).vertexArray = vertexArray;
+    if (m_Forward) m_Forward->BindVertexArray(vertexArray);
+}
+
+void RecordingRenderBackend::SetUniform(Shader* shader, const char* name, UniformType type, const float* data) {
+    RecordedCall& call = Record(RecordedCall::Kind::SetUniform);
+    call.shader = shader;
+    call.name = name;
+    call.uniformType = type;
+    if (m_Forward) m_Forward->SetUniform(shader, name, type, data);
+}
+
+} // namespace MyEngine
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * File: RecordingRenderBackend.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: RenderBackend that logs every call (tests, headless capture)
+ ******************************************************************************/
+
+#pragma once
+
+#include "Rendering/RenderBackend.h"
+#include <vector>
+
+namespace MyEngine {
+
+/**
+ * @brief One backend call captured by RecordingRenderBackend
+ */
+struct RecordedCall {
+    enum class Kind : uint8_t {
+        SetViewport, SetClearColor, Clear, SetRenderState,
+        BindShader, BindVertexArray, SetUniform, DrawIndexed,
+        SetFrameUniforms, SetPassUniforms
+    };
+
+    Kind kind;
+    Shader* shader = nullptr;                    // BindShader / SetUniform
+    const VertexArray* vertexArray = nullptr;    // BindVertexArray
+    const char* name = nullptr;                  // SetUniform
+    UniformType uniformType = UniformType::Float;
+    uint32_t value = 0;                          // Index count / viewport width / pass uniform size
+    RenderState state;                           // SetRenderState
+};
+
+/**
+ * @brief Backend that appends every call to a log
+ *
+ * 可选转发给另一个后端（例如包装 OpenGL 后端以抓取一帧的调用序列），
+ * 不转发时等同于带日志的 NullRenderBackend。
+ */
+class RecordingRenderBackend : public RenderBackend {
+public:
+    explicit RecordingRenderBackend(RenderBackend* forwardTo = nullptr) : m_Forward(forwardTo) {}
+
+    virtual void Init() override;
+    virtual void Shutdown() override;
+
+    virtual void BeginFrame() override;
+    virtual void EndFrame() override;
+
+    virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+    virtual void SetClearColor(const Vec4& color) override;
+    virtual void Clear() override;
+
+    virtual void DrawIndexed(uint32_t indexCount) override;
+
+    virtual void SetFrameUniforms(const FrameUniforms& frame) override;
+    virtual void SetPassUniforms(const void* data, uint32_t size) override;
+
+    virtual void SetRenderState(const RenderState& state) override;
+    virtual void BindShader(Shader* shader) override;
+    virtual void BindVertexArray(const VertexArray* vertexArray) override;
+    virtual void SetUniform(Shader* shader, const char* name, UniformType type, const float* data) override;
+
+    const std::vector<RecordedCall>& GetCalls() const { return m_Calls; }
+    void ClearCalls() { m_Calls.clear(); }
+
+private:
+    RecordedCall& Record(RecordedCall::Kind kind);
+
+private:
+    RenderBackend* m_Forward;
+    std::vector<RecordedCall> m_Calls;
+};
+
+} // namespace MyEngine
@@ -7,6 +7,7 @@
 
 #include "RenderBackend.h"
 #include "OpenGL/OpenGLRenderBackend.h"
+#include "NullRenderBackend.h"
 
 namespace MyEngine {
 
@@ -14,7 +15,7 @@ RendererAPI RenderBackend::s_API = RendererAPI::OpenGL;
 
 std::unique_ptr<RenderBackend> RenderBackend::Create() {
     switch (s_API) {
-        case RendererAPI::None: return nullptr;
+        case RendererAPI::None: return std::make_unique<NullRenderBackend>();
         case RendererAPI::OpenGL: return std::make_unique<OpenGLRenderBackend>();
         case RendererAPI::Vulkan: return nullptr; // Not implemented
     }
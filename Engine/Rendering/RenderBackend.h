@@ -8,6 +8,8 @@
 #pragma once
 
 #include "Math/MathTypes.h"
+#include "Rendering/RenderCommandBuffer.h"
+#include "Rendering/UniformBlocks.h"
 #include <memory>
 
 namespace MyEngine {
@@ -37,7 +39,31 @@ public:
 
     virtual void DrawIndexed(uint32_t indexCount) = 0;
 
+    // ========== Shared uniform blocks ==========
+    /**
+     * @brief Upload the FrameData block (once per frame / view; every shader including it reads it)
+     */
+    virtual void SetFrameUniforms(const FrameUniforms& frame) = 0;
+
+    /**
+     * @brief Upload the PassData block of the pass about to draw (at most PassUniforms::MAX_SIZE bytes)
+     */
+    virtual void SetPassUniforms(const void* data, uint32_t size) = 0;
+
+    // ========== Command replay (called by RenderQueue::Replay) ==========
+    virtual void SetRenderState(const RenderState& state) = 0;
+    virtual void BindShader(Shader* shader) = 0;
+    virtual void BindVertexArray(const VertexArray* vertexArray) = 0;
+    virtual void SetUniform(Shader* shader, const char* name, UniformType type, const float* data) = 0;
+
+    /**
+     * @brief Execute recorded commands in queue order (call RenderQueue::Sort first)
+     */
+    virtual ReplayStats Submit(const RenderQueue& queue) { return queue.Replay(*this); }
+
     static RendererAPI GetAPI() { return s_API; }
+    // None selects NullRenderBackend (headless); call before Renderer::Init
+    static void SetAPI(RendererAPI api) { s_API = api; }
     static std::unique_ptr<RenderBackend> Create();
 
 private:
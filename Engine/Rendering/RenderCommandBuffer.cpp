@@ -0,0 +1,284 @@
+/******************************************************************************
+ * File: RenderCommandBuffer.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Render command recording, radix sort and replay
+ ******************************************************************************/
+
+#include "RenderCommandBuffer.h"
+#include "RenderBackend.h"
+#include "Core/Log.h"
+#include <cstring>
+
+namespace MyEngine {
+
+namespace {
+
+// Below this an insertion sort beats the histogram passes
+constexpr size_t RADIX_SORT_THRESHOLD = 64;
+
+} // namespace
+
+ReplayStats& ReplayStats::operator+=(const ReplayStats& other) {
+    Commands += other.Commands;
+    Draws += other.Draws;
+    ShaderBinds += other.ShaderBinds;
+    VertexArrayBinds += other.VertexArrayBinds;
+    StateChanges += other.StateChanges;
+    Uniforms += other.Uniforms;
+    RedundantSkipped += other.RedundantSkipped;
+    return *this;
+}
+
+void RenderCommandBuffer::Reset(uint8_t pass) {
+    m_Commands.clear();
+    m_Keys.clear();
+    m_Payload.clear();
+    m_Pass = pass;
+}
+
+void RenderCommandBuffer::Push(uint64_t key, const RenderCommand& command) {
+    m_Keys.push_back((key & ~RenderSortKey::PASS_MASK) | (static_cast<uint64_t>(m_Pass) << RenderSortKey::PASS_SHIFT));
+    m_Commands.push_back(command);
+}
+
+uint32_t RenderCommandBuffer::PushPayload(const float* data, uint32_t count) {
+    const uint32_t offset = static_cast<uint32_t>(m_Payload.size());
+    m_Payload.resize(offset + count);
+    std::memcpy(m_Payload.data() + offset, data, count * sizeof(float));
+    return offset;
+}
+
+void RenderCommandBuffer::SetViewport(uint64_t key, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    RenderCommand command;
+    command.type = RenderCommandType::SetViewport;
+    command.viewport = { x, y, width, height };
+    Push(key, command);
+}
+
+void RenderCommandBuffer::Clear(uint64_t key, const Vec4& color) {
+    RenderCommand command;
+    command.type = RenderCommandType::Clear;
+    const float data[4] = { color.x, color.y, color.z, color.w };
+    command.clear.colorOffset = PushPayload(data, 4);
+    Push(key, command);
+}
+
+void RenderCommandBuffer::SetState(uint64_t key, const RenderState& state) {
+    RenderCommand command;
+    command.type = RenderCommandType::SetState;
+    command.state = state;
+    Push(key, command);
+}
+
+void RenderCommandBuffer::PushUniform(uint64_t key, Shader* shader, const char* name, UniformType type,
+                                      const float* data, uint32_t count) {
+    RenderCommand command;
+    command.type = RenderCommandType::SetUniform;
+    command.uniform.shader = shader;
+    command.uniform.name = name;
+    command.uniform.type = type;
+    command.uniform.dataOffset = PushPayload(data, count);
+    Push(key, command);
+}
+
+void RenderCommandBuffer::SetUniform(uint64_t key, Shader* shader, const char* name, int value) {
+    // Stored bit-exact in a float slot
+    float bits;
+    std::memcpy(&bits, &value, sizeof(float));
+    PushUniform(key, shader, name, UniformType::Int, &bits, 1);
+}
+
+void RenderCommandBuffer::SetUniform(uint64_t key, Shader* shader, const char* name, float value) {
+    PushUniform(key, shader, name, UniformType::Float, &value, 1);
+}
+
+void RenderCommandBuffer::SetUniform(uint64_t key, Shader* shader, const char* name, const Vec3& value) {
+    const float data[3] = { value.x, value.y, value.z };
+    PushUniform(key, shader, name, UniformType::Float3, data, 3);
+}
+
+void RenderCommandBuffer::SetUniform(uint64_t key, Shader* shader, const char* name, const Vec4& value) {
+    const float data[4] = { value.x, value.y, value.z, value.w };
+    PushUniform(key, shader, name, UniformType::Float4, data, 4);
+}
+
+void RenderCommandBuffer::SetUniform(uint64_t key, Shader* shader, const char* name, const Mat4& value) {
+    PushUniform(key, shader, name, UniformType::Mat4, value.m, 16);
+}
+
+void RenderCommandBuffer::DrawIndexed(uint64_t key, Shader* shader, const VertexArray* vertexArray,
+                                      uint32_t indexCount, const Mat4& transform) {
+    RenderCommand command;
+    command.type = RenderCommandType::DrawIndexed;
+    command.draw = { shader, vertexArray, indexCount, PushPayload(transform.m, 16) };
+    Push(key, command);
+}
+
+void RenderCommandBuffer::DrawIndexed(uint64_t key, Shader* shader, const VertexArray* vertexArray,
+                                      uint32_t indexCount) {
+    RenderCommand command;
+    command.type = RenderCommandType::DrawIndexed;
+    command.draw = { shader, vertexArray, indexCount, NO_TRANSFORM };
+    Push(key, command);
+}
+
+// ============================================================================
+// RenderQueue
+// ============================================================================
+
+void RenderQueue::Reset() {
+    m_Buffers.clear();
+    m_Keys.clear();
+    m_Refs.clear();
+}
+
+void RenderQueue::Add(const RenderCommandBuffer& commands) {
+    const size_t count = commands.GetCommandCount();
+    if (count == 0) return;
+    if (m_Buffers.size() >= MAX_BUFFERS || count > MAX_COMMANDS_PER_BUFFER) {
+        ENGINE_ERROR("[RenderQueue] Too many buffers or commands ({} buffers, {} commands)", m_Buffers.size(), count);
+        return;
+    }
+
+    const uint32_t bufferBits = static_cast<uint32_t>(m_Buffers.size()) << 24;
+    m_Buffers.push_back(&commands);
+    const size_t base = m_Keys.size();
+    m_Keys.resize(base + count);
+    m_Refs.resize(base + count);
+    for (size_t i = 0; i < count; i++) {
+        m_Keys[base + i] = commands.GetKey(i);
+        m_Refs[base + i] = bufferBits | static_cast<uint32_t>(i);
+    }
+}
+
+void RenderQueue::Sort() {
+    const size_t count = m_Keys.size();
+    if (count < 2) return;
+
+    if (count < RADIX_SORT_THRESHOLD) {
+        // Insertion sort (stable)
+        for (size_t i = 1; i < count; i++) {
+            const uint64_t key = m_Keys[i];
+            const uint32_t ref = m_Refs[i];
+            size_t j = i;
+            for (; j > 0 && m_Keys[j - 1] > key; j--) {
+                m_Keys[j] = m_Keys[j - 1];
+                m_Refs[j] = m_Refs[j - 1];
+            }
+            m_Keys[j] = key;
+            m_Refs[j] = ref;
+        }
+        return;
+    }
+
+    // LSD radix sort of (key, ref), 8 bits per pass.
+    // 所有直方图一次遍历算出；某一字节在所有键上相同（例如未使用的 material 位）时跳过该趟。
+    uint32_t histograms[8][256] = {};
+    for (uint64_t key : m_Keys) {
+        for (int digit = 0; digit < 8; digit++) {
+            histograms[digit][(key >> (digit * 8)) & 0xFF]++;
+        }
+    }
+
+    m_KeyScratch.resize(count);
+    m_RefScratch.resize(count);
+    for (int digit = 0; digit < 8; digit++) {
+        uint32_t* histogram = histograms[digit];
+        const uint32_t shift = digit * 8;
+        if (histogram[(m_Keys[0] >> shift) & 0xFF] == count) continue;
+
+        uint32_t offset = 0;
+        for (int bucket = 0; bucket < 256; bucket++) {
+            const uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        for (size_t i = 0; i < count; i++) {
+            const uint64_t key = m_Keys[i];
+            const uint32_t slot = histogram[(key >> shift) & 0xFF]++;
+            m_KeyScratch[slot] = key;
+            m_RefScratch[slot] = m_Refs[i];
+        }
+        m_Keys.swap(m_KeyScratch);
+        m_Refs.swap(m_RefScratch);
+    }
+}
+
+ReplayStats RenderQueue::Replay(RenderBackend& backend) const {
+    ReplayStats stats;
+    stats.Commands = static_cast<uint32_t>(m_Keys.size());
+
+    Shader* boundShader = nullptr;
+    const VertexArray* boundVertexArray = nullptr;
+    RenderState currentState;
+    bool hasState = false;
+
+    auto bindShader = [&](Shader* shader) {
+        if (shader == boundShader) {
+            stats.RedundantSkipped++;
+            return;
+        }
+        backend.BindShader(shader);
+        boundShader = shader;
+        stats.ShaderBinds++;
+    };
+
+    for (size_t i = 0; i < m_Keys.size(); i++) {
+        const RenderCommandBuffer& buffer = GetBuffer(i);
+        const RenderCommand& command = buffer.GetCommand(m_Refs[i] & 0xFFFFFFu);
+        switch (command.type) {
+            case RenderCommandType::SetViewport: {
+                const ViewportCommand& viewport = command.viewport;
+                backend.SetViewport(viewport.x, viewport.y, viewport.width, viewport.height);
+                break;
+            }
+            case RenderCommandType::Clear: {
+                const float* color = buffer.GetPayload(command.clear.colorOffset);
+                backend.SetClearColor(Vec4(color[0], color[1], color[2], color[3]));
+                backend.Clear();
+                break;
+            }
+            case RenderCommandType::SetState: {
+                if (hasState && command.state == currentState) {
+                    stats.RedundantSkipped++;
+                    break;
+                }
+                backend.SetRenderState(command.state);
+                currentState = command.state;
+                hasState = true;
+                stats.StateChanges++;
+                break;
+            }
+            case RenderCommandType::SetUniform: {
+                const UniformCommand& uniform = command.uniform;
+                bindShader(uniform.shader);
+                backend.SetUniform(uniform.shader, uniform.name, uniform.type, buffer.GetPayload(uniform.dataOffset));
+                stats.Uniforms++;
+                break;
+            }
+            case RenderCommandType::DrawIndexed: {
+                const DrawCommand& draw = command.draw;
+                bindShader(draw.shader);
+                if (draw.vertexArray != boundVertexArray) {
+                    backend.BindVertexArray(draw.vertexArray);
+                    boundVertexArray = draw.vertexArray;
+                    stats.VertexArrayBinds++;
+                } else {
+                    stats.RedundantSkipped++;
+                }
+                if (draw.transformOffset != RenderCommandBuffer::NO_TRANSFORM) {
+                    backend.SetUniform(draw.shader, RenderCommandBuffer::TRANSFORM_UNIFORM, UniformType::Mat4,
+                                       buffer.GetPayload(draw.transformOffset));
+                    stats.Uniforms++;
+                }
+                backend.DrawIndexed(draw.indexCount);
+                stats.Draws++;
+                break;
+            }
+        }
+    }
+    return stats;
+}
+
+} // namespace MyEngine
@@ -0,0 +1,294 @@
+/******************************************************************************
+ * File: RenderCommandBuffer.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Recorded draw / bind / state commands with 64-bit sort keys
+ ******************************************************************************/
+
+#pragma once
+
+#include "Math/MathTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MyEngine {
+
+class RenderBackend;
+class Shader;
+class VertexArray;
+
+// ============================================================================
+// Sort Key
+// ============================================================================
+
+enum class RenderLayer : uint8_t {
+    Background = 0,
+    Opaque,
+    Transparent,
+    Overlay
+};
+
+/**
+ * @brief 64-bit render sort key
+ *
+ * | pass 8 | layer 4 | shader 12 | material 16 | depth 24 |
+ *
+ * pass 由 RenderCommandBuffer 在录制时写入（PassManager 中的执行顺序），
+ * 录制方只需给出 layer / shader / material / depth。
+ * shader 为 0 的键是“设置命令”（状态、pass 级 uniform），排在同层所有绘制之前；
+ * 相同键按录制顺序回放（基数排序是稳定的）。
+ */
+struct RenderSortKey {
+    static constexpr uint32_t PASS_SHIFT = 56;
+    static constexpr uint32_t LAYER_SHIFT = 52;
+    static constexpr uint32_t SHADER_SHIFT = 40;
+    static constexpr uint32_t MATERIAL_SHIFT = 24;
+    static constexpr uint32_t DEPTH_BITS = 24;
+    static constexpr uint32_t DEPTH_MAX = (1u << DEPTH_BITS) - 1u;
+    static constexpr uint64_t PASS_MASK = 0xFFull << PASS_SHIFT;
+
+    // State / uniform commands of a layer (before its draws)
+    static constexpr uint64_t Setup(RenderLayer layer) {
+        return static_cast<uint64_t>(layer) << LAYER_SHIFT;
+    }
+
+    static constexpr uint64_t Draw(RenderLayer layer, uint16_t shaderId, uint16_t materialId, uint32_t depth) {
+        return (static_cast<uint64_t>(layer) << LAYER_SHIFT) |
+               (static_cast<uint64_t>(shaderId & 0xFFFu) << SHADER_SHIFT) |
+               (static_cast<uint64_t>(materialId) << MATERIAL_SHIFT) |
+               (depth & DEPTH_MAX);
+    }
+
+    /**
+     * @brief 12-bit id of a shader, never 0 (collisions only cost extra binds)
+     */
+    static uint16_t ShaderID(const Shader* shader) {
+        uint64_t bits = reinterpret_cast<uintptr_t>(shader);
+        bits ^= bits >> 17;
+        bits *= 0x9E3779B97F4A7C15ull;
+        return static_cast<uint16_t>(1u + (bits >> 32) % 0xFFFu);
+    }
+
+    /**
+     * @brief Quantized view depth, front to back (opaque)
+     */
+    static uint32_t Depth(float viewDepth, float farPlane) {
+        const float t = farPlane > 0.0f ? viewDepth / farPlane : 0.0f;
+        const float clamped = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+        return static_cast<uint32_t>(clamped * static_cast<float>(DEPTH_MAX));
+    }
+
+    /**
+     * @brief Quantized view depth, back to front (transparent)
+     */
+    static uint32_t ReverseDepth(float viewDepth, float farPlane) {
+        return DEPTH_MAX - Depth(viewDepth, farPlane);
+    }
+
+    static uint8_t GetPass(uint64_t key) { return static_cast<uint8_t>(key >> PASS_SHIFT); }
+};
+
+// ============================================================================
+// Commands
+// ============================================================================
+
+/**
+ * @brief Fixed-function state applied before draws
+ * Defaults match OpenGLRenderBackend::Init (depth test + alpha blending)
+ */
+struct RenderState {
+    enum class Compare : uint8_t { Never, Less, Equal, LessOrEqual, Greater, NotEqual, GreaterOrEqual, Always };
+    enum class Cull : uint8_t { None, Front, Back };
+    enum class Blend : uint8_t { Opaque, Alpha, Additive, Multiply };
+
+    bool depthTest = true;
+    bool depthWrite = true;
+    Compare depthCompare = Compare::Less;
+    Cull cullMode = Cull::None;
+    Blend blendMode = Blend::Alpha;
+    bool wireframe = false;
+
+    bool operator==(const RenderState& other) const = default;
+};
+
+enum class RenderCommandType : uint8_t {
+    SetViewport,
+    Clear,
+    SetState,
+    SetUniform,
+    DrawIndexed
+};
+
+enum class UniformType : uint8_t {
+    Int,
+    Float,
+    Float3,
+    Float4,
+    Mat4
+};
+
+struct ViewportCommand {
+    uint32_t x, y, width, height;
+};
+
+struct ClearCommand {
+    uint32_t colorOffset;        // Vec4 in the payload
+};
+
+struct UniformCommand {
+    Shader* shader;
+    const char* name;            // Must outlive replay (string literal)
+    uint32_t dataOffset;         // Payload floats
+    UniformType type;
+};
+
+struct DrawCommand {
+    Shader* shader;
+    const VertexArray* vertexArray;
+    uint32_t indexCount;
+    uint32_t transformOffset;    // Mat4 in the payload, NO_TRANSFORM if none
+};
+
+/**
+ * @brief One recorded command (32 bytes); variable-size data lives in the buffer payload
+ */
+struct RenderCommand {
+    RenderCommand() : viewport{} {}
+
+    RenderCommandType type = RenderCommandType::SetViewport;
+    union {
+        ViewportCommand viewport;
+        ClearCommand clear;
+        RenderState state;
+        UniformCommand uniform;
+        DrawCommand draw;
+    };
+};
+
+/**
+ * @brief Counters of one replay
+ */
+struct ReplayStats {
+    uint32_t Commands = 0;
+    uint32_t Draws = 0;
+    uint32_t ShaderBinds = 0;
+    uint32_t VertexArrayBinds = 0;
+    uint32_t StateChanges = 0;
+    uint32_t Uniforms = 0;
+    uint32_t RedundantSkipped = 0;   // Binds / state changes filtered out
+
+    ReplayStats& operator+=(const ReplayStats& other);
+};
+
+// ============================================================================
+// RenderCommandBuffer
+// ============================================================================
+
+/**
+ * @brief 渲染命令缓冲（录制端）
+ *
+ * Pass 在 Record 阶段只写命令（不调用 GL），因此不同 Pass 可以在工作线程上并行录制各自的缓冲。
+ * 命令按录制顺序保存；排序与回放由 RenderQueue 完成。
+ *
+ * 单个缓冲不是线程安全的。Shader / VertexArray 指针只需在回放结束前有效。
+ */
+class RenderCommandBuffer {
+public:
+    static constexpr uint32_t NO_TRANSFORM = UINT32_MAX;
+    static constexpr const char* TRANSFORM_UNIFORM = "u_Transform";
+
+    /**
+     * @brief Clear all commands (capacity kept); pass is written into the top 8 bits of every key
+     */
+    void Reset(uint8_t pass = 0);
+    uint8_t GetPass() const { return m_Pass; }
+
+    // ========== Recording (key without pass bits) ==========
+    void SetViewport(uint64_t key, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+    void Clear(uint64_t key, const Vec4& color);
+    void SetState(uint64_t key, const RenderState& state);
+
+    void SetUniform(uint64_t key, Shader* shader, const char* name, int value);
+    void SetUniform(uint64_t key, Shader* shader, const char* name, float value);
+    void SetUniform(uint64_t key, Shader* shader, const char* name, const Vec3& value);
+    void SetUniform(uint64_t key, Shader* shader, const char* name, const Vec4& value);
+    void SetUniform(uint64_t key, Shader* shader, const char* name, const Mat4& value);
+
+    /**
+     * @brief Indexed triangle draw; transform goes to TRANSFORM_UNIFORM of shader
+     */
+    void DrawIndexed(uint64_t key, Shader* shader, const VertexArray* vertexArray,
+                     uint32_t indexCount, const Mat4& transform);
+    void DrawIndexed(uint64_t key, Shader* shader, const VertexArray* vertexArray, uint32_t indexCount);
+
+    // ========== Access (record order) ==========
+    size_t GetCommandCount() const { return m_Commands.size(); }
+    bool IsEmpty() const { return m_Commands.empty(); }
+    const RenderCommand& GetCommand(size_t i) const { return m_Commands[i]; }
+    uint64_t GetKey(size_t i) const { return m_Keys[i]; }
+    const float* GetPayload(uint32_t offset) const { return m_Payload.data() + offset; }
+
+private:
+    void Push(uint64_t key, const RenderCommand& command);
+    uint32_t PushPayload(const float* data, uint32_t count);
+    void PushUniform(uint64_t key, Shader* shader, const char* name, UniformType type,
+                     const float* data, uint32_t count);
+
+private:
+    std::vector<RenderCommand> m_Commands;
+    std::vector<uint64_t> m_Keys;
+    std::vector<float> m_Payload;
+    uint8_t m_Pass = 0;
+};
+
+// ============================================================================
+// RenderQueue
+// ============================================================================
+
+/**
+ * @brief 合并、排序并回放多个命令缓冲
+ *
+ * Add 只保存缓冲指针，不复制命令和负载数据；Sort 对 (key, 引用) 做稳定的 LSD 基数排序
+ * （相同键按 Add 顺序、再按录制顺序）。RenderBackend::Submit 按排序结果回放，
+ * 并跳过重复的 shader / VAO 绑定和相同的状态。
+ * 已添加的缓冲在 Submit 结束前不能再录制或销毁。
+ */
+class RenderQueue {
+public:
+    static constexpr uint32_t MAX_BUFFERS = 256;
+    static constexpr uint32_t MAX_COMMANDS_PER_BUFFER = 1u << 24;
+
+    void Reset();
+
+    /**
+     * @brief Add a recorded buffer (ignored when empty)
+     */
+    void Add(const RenderCommandBuffer& commands);
+
+    /**
+     * @brief Stable sort of all added commands by key
+     */
+    void Sort();
+
+    size_t GetCommandCount() const { return m_Keys.size(); }
+
+    // Sorted order after Sort, else Add / record order
+    const RenderCommand& GetCommand(size_t i) const { return GetBuffer(i).GetCommand(m_Refs[i] & 0xFFFFFFu); }
+    uint64_t GetKey(size_t i) const { return m_Keys[i]; }
+    const RenderCommandBuffer& GetBuffer(size_t i) const { return *m_Buffers[m_Refs[i] >> 24]; }
+
+    /**
+     * @brief Issue the commands to backend in order, filtering redundant binds / states
+     */
+    ReplayStats Replay(RenderBackend& backend) const;
+
+private:
+    std::vector<const RenderCommandBuffer*> m_Buffers;
+    std::vector<uint64_t> m_Keys;
+    std::vector<uint32_t> m_Refs;       // buffer index << 24 | command index
+    std::vector<uint64_t> m_KeyScratch;
+    std::vector<uint32_t> m_RefScratch;
+};
+
+} // namespace MyEngine
@@ -48,13 +48,23 @@ void Renderer::Clear() {
 }
 
 void Renderer::BeginScene(const Camera& camera, const Mat4& viewMatrix) {
-    if (!s_SceneData) return;
-    s_SceneData->ViewProjectionMatrix = camera.GetProjection() * viewMatrix;
+    BeginScene(viewMatrix, camera.GetProjection());
 }
 
 void Renderer::BeginScene(const Mat4& viewMatrix, const Mat4& projectionMatrix) {
     if (!s_SceneData) return;
     s_SceneData->ViewProjectionMatrix = projectionMatrix * viewMatrix;
+    
+    // FrameData block for shaders drawn between BeginScene / EndScene
+    if (s_RenderBackend) {
+        FrameUniforms frame;
+        frame.ViewProjection = s_SceneData->ViewProjectionMatrix;
+        frame.View = viewMatrix;
+        frame.Projection = projectionMatrix;
+        const Mat4 cameraToWorld = viewMatrix.Inverted();
+        frame.CameraPosition = Vec3(cameraToWorld.m[12], cameraToWorld.m[13], cameraToWorld.m[14]);
+        s_RenderBackend->SetFrameUniforms(frame);
+    }
 }
 
 void Renderer::EndScene() {
@@ -63,8 +73,8 @@ void Renderer::EndScene() {
 void Renderer::Submit(Shader* shader, VertexArray* vertexArray, const Mat4& transform) {
     if (!shader || !vertexArray || !s_RenderBackend) return;
     
+    // View-projection comes from the FrameData block uploaded by BeginScene
     shader->Bind();
-    shader->SetMat4("u_ViewProjection", s_SceneData->ViewProjectionMatrix);
     shader->SetMat4("u_Transform", transform);
     
     vertexArray->Bind();
@@ -91,17 +101,14 @@ void RenderSystem::Render(Registry& registry, const Camera& camera, const Mat4&
     Renderer::BeginScene(camera, viewMatrix);
     
     // Iterate over all entities with MeshFilter and Transform
-    auto view = registry.GetEntitiesWith<MeshFilterComponent, TransformComponent>();
-    
-    for (auto entityID : view) {
-        // auto& meshFilter = registry.GetComponent<MeshFilterComponent>(entityID);
-        auto& transformComp = registry.GetComponent<TransformComponent>(entityID);
-        
-        // In a real system we would use ResourceRegistry to get the mesh from the handle
-        // and Material to get the shader.
-        // For now, this is a placeholder for the logic.
-        (void)transformComp; 
-    }
+    registry.GetView<const MeshFilterComponent, const TransformComponent>().Each(
+        [](const MeshFilterComponent& meshFilter, const TransformComponent& transformComp) {
+            // In a real system we would use ResourceRegistry to get the mesh from the handle
+            // and Material to get the shader.
+            // For now, this is a placeholder for the logic.
+            (void)meshFilter;
+            (void)transformComp;
+        });
     
     Renderer::EndScene();
 }
@@ -7,7 +7,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include "Math/MathTypes.h"
 
@@ -23,12 +25,15 @@ public:
     virtual void Bind() const = 0;
     virtual void Unbind() const = 0;
     
-    virtual void SetInt(const std::string& name, int value) = 0;
-    virtual void SetBool(const std::string& name, bool value) = 0;
-    virtual void SetFloat(const std::string& name, float value) = 0;
-    virtual void SetFloat3(const std::string& name, const Vec3& value) = 0;
-    virtual void SetFloat4(const std::string& name, const Vec4& value) = 0;
-    virtual void SetMat4(const std::string& name, const Mat4& value) = 0;
+    // Uniforms outside the shared blocks (see UniformBlocks.h); names are looked up, never copied
+    virtual void SetInt(std::string_view name, int value) = 0;
+    virtual void SetBool(std::string_view name, bool value) = 0;
+    virtual void SetFloat(std::string_view name, float value) = 0;
+    virtual void SetFloat3(std::string_view name, const Vec3& value) = 0;
+    virtual void SetFloat4(std::string_view name, const Vec4& value) = 0;
+    virtual void SetMat4(std::string_view name, const Mat4& value) = 0;
+    // Whole array in one call (count contiguous matrices starting at name[0])
+    virtual void SetMat4Array(std::string_view name, const Mat4* values, uint32_t count) = 0;
     
     virtual const std::string& GetName() const = 0;
     
@@ -0,0 +1,61 @@
+/******************************************************************************
+ * File: UniformBlocks.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: std140 uniform blocks shared by all shaders (per-frame / per-pass)
+ ******************************************************************************/
+
+#pragma once
+
+#include "Math/MathTypes.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace MyEngine {
+
+/**
+ * @brief Per-frame constants, std140 block "FrameData"
+ *
+ * 每帧由 PassManager::Execute（或旧路径的 Renderer::BeginScene）上传一次，
+ * 所有包含该块的 shader 共享，不再按 pass / draw 逐个设置 u_ViewProjection、u_CameraPos。
+ * Shader 源码中单独一行 `#include <FrameData>` 会在编译前展开为 GLSL 声明（须位于 #version 之后）。
+ */
+struct FrameUniforms {
+    static constexpr const char* BLOCK_NAME = "FrameData";
+    static constexpr uint32_t BINDING = 0;
+    static constexpr const char* INCLUDE_DIRECTIVE = "#include <FrameData>";
+    static constexpr const char* GLSL = R"(
+        layout(std140) uniform FrameData {
+            mat4 u_ViewProjection;
+            mat4 u_View;
+            mat4 u_Projection;
+            vec3 u_CameraPos;
+            float u_FarPlane;
+        };
+    )";
+
+    Mat4 ViewProjection;
+    Mat4 View;
+    Mat4 Projection;
+    Vec3 CameraPosition;
+    float FarPlane = 1000.0f;
+};
+
+static_assert(sizeof(Mat4) == 64 && sizeof(Vec3) == 12, "FrameUniforms assumes tightly packed math types");
+static_assert(offsetof(FrameUniforms, CameraPosition) == 192, "std140: vec3 u_CameraPos at 192");
+static_assert(offsetof(FrameUniforms, FarPlane) == 204, "std140: float fills the vec3 padding");
+static_assert(sizeof(FrameUniforms) == 208, "std140 size of FrameData");
+
+/**
+ * @brief Per-pass constants, std140 block "PassData"
+ *
+ * 布局由各 pass 自行定义（C++ 结构体与 GLSL 声明须一致，注意 std140 对齐：vec3 按 16 字节对齐，
+ * 后面紧跟的 float 可填入其尾部），在绘制前通过 RenderBackend::SetPassUniforms 整块上传一次。
+ */
+struct PassUniforms {
+    static constexpr const char* BLOCK_NAME = "PassData";
+    static constexpr uint32_t BINDING = 1;
+    static constexpr uint32_t MAX_SIZE = 1024;
+};
+
+} // namespace MyEngine
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * File: VisibilityCuller.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Per-view frustum culling implementation
+ ******************************************************************************/
+
+#include "VisibilityCuller.h"
+#include "ECS/Components.h"
+#include "ECS/SystemScheduler.h"
+#include "Resource/Mesh.h"
+#include "Core/Profiler.h"
+#include <algorithm>
+#include <chrono>
+
+namespace MyEngine {
+
+const VisibleSet& VisibilityCuller::Cull(const Mat4& viewProjection, Registry& registry) {
+    PROFILE_SCOPE("VisibilityCuller::Cull");
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // Gather candidates (serial: sparse lookups)
+    m_Candidates.clear();
+    registry.GetView<const TransformComponent, const MeshFilterComponent>().Each(
+        [this](EntityID entity, const TransformComponent& transform, const MeshFilterComponent& meshFilter) {
+            if (meshFilter.mesh) {
+                m_Candidates.push_back({ entity, meshFilter.mesh.get(), &transform.worldMatrix });
+            }
+        });
+
+    const uint32_t count = static_cast<uint32_t>(m_Candidates.size());
+    m_CenterX.resize(count);
+    m_CenterY.resize(count);
+    m_CenterZ.resize(count);
+    m_ExtentX.resize(count);
+    m_ExtentY.resize(count);
+    m_ExtentZ.resize(count);
+    m_Radius.resize(count);
+    m_VisibleIndices.resize(count);
+
+    // World bounds + cull, one chunk per task
+    const Frustum frustum = Frustum::FromViewProjection(viewProjection);
+    const uint32_t chunkCount = (count + CULL_CHUNK - 1) / CULL_CHUNK;
+    m_ChunkCounts.assign(chunkCount, 0);
+    SystemScheduler::ParallelRange(chunkCount, 1, [this, &frustum](uint32_t begin, uint32_t end) {
+        for (uint32_t chunk = begin; chunk < end; chunk++) {
+            ProcessChunk(frustum, chunk);
+        }
+    });
+
+    // Compact in chunk order
+    m_Visible.Meshes.clear();
+    for (uint32_t chunk = 0; chunk < chunkCount; chunk++) {
+        const uint32_t* indices = m_VisibleIndices.data() + chunk * CULL_CHUNK;
+        for (uint32_t i = 0; i < m_ChunkCounts[chunk]; i++) {
+            m_Visible.Meshes.push_back(m_Candidates[indices[i]]);
+        }
+    }
+
+    CullingStats& stats = m_Visible.Stats;
+    stats.Total = count;
+    stats.Drawn = static_cast<uint32_t>(m_Visible.Meshes.size());
+    stats.Culled = stats.Total - stats.Drawn;
+    stats.CpuMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    return m_Visible;
+}
+
+void VisibilityCuller::ProcessChunk(const Frustum& frustum, uint32_t chunk) {
+    const uint32_t first = chunk * CULL_CHUNK;
+    const uint32_t last = std::min<uint32_t>(first + CULL_CHUNK, static_cast<uint32_t>(m_Candidates.size()));
+
+    for (uint32_t i = first; i < last; i++) {
+        const VisibleMesh& candidate = m_Candidates[i];
+        const AABB box = candidate.mesh->GetBounds().Transformed(*candidate.worldMatrix);
+        const Vec3 center = box.GetCenter();
+        const Vec3 extents = box.GetExtents();
+        m_CenterX[i] = center.x;
+        m_CenterY[i] = center.y;
+        m_CenterZ[i] = center.z;
+        m_ExtentX[i] = extents.x;
+        m_ExtentY[i] = extents.y;
+        m_ExtentZ[i] = extents.z;
+        m_Radius[i] = candidate.mesh->GetBoundingSphere().Transformed(*candidate.worldMatrix).radius;
+    }
+
+    const BoundsSoA bounds = {
+        m_CenterX.data() + first, m_CenterY.data() + first, m_CenterZ.data() + first,
+        m_ExtentX.data() + first, m_ExtentY.data() + first, m_ExtentZ.data() + first,
+        m_Radius.data() + first
+    };
+    m_ChunkCounts[chunk] = static_cast<uint32_t>(
+        frustum.Cull(bounds, last - first, first, m_VisibleIndices.data() + first));
+}
+
+} // namespace MyEngine
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * File: VisibilityCuller.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Per-view frustum culling of mesh entities into a compact visible list
+ ******************************************************************************/
+
+#pragma once
+
+#include "ECS/Registry.h"
+#include "Math/MathTypes.h"
+#include "Math/Frustum.h"
+#include <vector>
+
+namespace MyEngine {
+
+class Mesh;
+
+/**
+ * @brief One mesh entity that survived culling
+ * Pointers stay valid until the registry is structurally changed (i.e. for the frame's passes)
+ */
+struct VisibleMesh {
+    EntityID entity;
+    const Mesh* mesh;
+    const Mat3x4* worldMatrix;
+};
+
+struct CullingStats {
+    uint32_t Total = 0;       // Mesh entities tested
+    uint32_t Drawn = 0;       // In the visible list
+    uint32_t Culled = 0;      // Rejected by the frustum
+    double CpuMs = 0.0;       // Gather + bounds + cull + compaction
+};
+
+/**
+ * @brief Result handed to the passes through SceneView::visibleSet
+ */
+struct VisibleSet {
+    std::vector<VisibleMesh> Meshes;
+    CullingStats Stats;
+};
+
+/**
+ * @brief Frustum culling for entities with TransformComponent + MeshFilterComponent
+ *
+ * 每个视图调用一次 Cull：
+ * 1. 串行收集候选（实体、网格、世界矩阵指针）；
+ * 2. 按 CULL_CHUNK 个元素分块并行（SystemScheduler::ParallelRange）：
+ *    用缓存的世界矩阵把网格局部 AABB / 包围球变换到世界空间（Arvo），写入 SoA 数组，
+ *    再用 Frustum::Cull 按 SIMD 通道剔除，块内可见下标写到该块自己的区间；
+ * 3. 按块顺序压缩成 VisibleSet::Meshes（顺序与收集顺序一致，结果与线程数无关）。
+ */
+class VisibilityCuller {
+public:
+    static constexpr uint32_t CULL_CHUNK = 1024;
+
+    /**
+     * @brief Cull against viewProjection; returns the set owned by this culler
+     */
+    const VisibleSet& Cull(const Mat4& viewProjection, Registry& registry);
+
+    const VisibleSet& GetVisibleSet() const { return m_Visible; }
+
+private:
+    void ProcessChunk(const Frustum& frustum, uint32_t chunk);
+
+private:
+    std::vector<VisibleMesh> m_Candidates;
+
+    // World-space bounds (SoA, parallel to m_Candidates)
+    std::vector<float> m_CenterX, m_CenterY, m_CenterZ;
+    std::vector<float> m_ExtentX, m_ExtentY, m_ExtentZ;
+    std::vector<float> m_Radius;
+
+    std::vector<uint32_t> m_VisibleIndices;   // Chunk c writes from c * CULL_CHUNK
+    std::vector<uint32_t> m_ChunkCounts;
+
+    VisibleSet m_Visible;
+};
+
+} // namespace MyEngine
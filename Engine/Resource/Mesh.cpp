@@ -17,6 +17,14 @@ namespace MyEngine {
 Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
     : m_Vertices(vertices), m_Indices(indices) {
     
+    if (!vertices.empty()) {
+        m_Bounds = AABB::FromPoints(&vertices[0].Position, vertices.size(), sizeof(Vertex));
+        m_BoundingSphere = BoundingSphere::FromPoints(m_Bounds.GetCenter(), &vertices[0].Position,
+                                                      vertices.size(), sizeof(Vertex));
+    } else {
+        m_Bounds = AABB(Vec3(0, 0, 0), Vec3(0, 0, 0));
+    }
+    
     m_VertexArray.reset(VertexArray::Create());
     
     auto vb = std::shared_ptr<VertexBuffer>(VertexBuffer::Create((float*)vertices.data(), (uint32_t)(vertices.size() * sizeof(Vertex))));
@@ -10,6 +10,7 @@
 #include <vector>
 #include <memory>
 #include "Math/MathTypes.h"
+#include "Math/Bounds.h"
 #include "Rendering/Buffer.h"
 #include "Rendering/VertexArray.h"
 
@@ -37,10 +38,17 @@ public:
     
     const std::shared_ptr<VertexArray>& GetVertexArray() const { return m_VertexArray; }
     
+    // Local-space bounds, computed once at construction (sphere is centered on the AABB)
+    const AABB& GetBounds() const { return m_Bounds; }
+    const BoundingSphere& GetBoundingSphere() const { return m_BoundingSphere; }
+    
 private:
     std::vector<Vertex> m_Vertices;
     std::vector<uint32_t> m_Indices;
     
+    AABB m_Bounds;
+    BoundingSphere m_BoundingSphere;
+    
     std::shared_ptr<VertexArray> m_VertexArray;
 };
 
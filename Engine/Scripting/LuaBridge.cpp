@@ -7,6 +7,7 @@
 
 #include "LuaBridge.h"
 #include "ECS/Components.h"
+#include "ECS/TransformSystem.h"
 #include "Core/Log.h"
 #include <cstring>
 
@@ -25,6 +26,7 @@ namespace MyEngine {
 // Metatable names
 static const char* VEC3_METATABLE = "MyEngine.Vec3";
 static const char* ENTITY_METATABLE = "MyEngine.Entity";
+static const char* TRANSFORM_SYSTEM_KEY = "MyEngine.TransformSystem";
 
 // =============================================================================
 // Registration
@@ -37,6 +39,20 @@ void LuaBridge::RegisterBindings(lua_State* L) {
     ENGINE_INFO("Lua bindings registered successfully");
 }
 
+void LuaBridge::SetTransformSystem(lua_State* L, TransformSystem* system) {
+    lua_pushlightuserdata(L, system);
+    lua_setfield(L, LUA_REGISTRYINDEX, TRANSFORM_SYSTEM_KEY);
+}
+
+void LuaBridge::MarkTransformDirty(lua_State* L, Entity entity) {
+    lua_getfield(L, LUA_REGISTRYINDEX, TRANSFORM_SYSTEM_KEY);
+    auto* system = static_cast<TransformSystem*>(lua_touserdata(L, -1));
+    lua_pop(L, 1);
+    if (system) {
+        system->MarkDirty(entity);
+    }
+}
+
 // =============================================================================
 // Vec3 Implementation
 // =============================================================================
@@ -286,6 +302,7 @@ int LuaBridge::Entity_SetPosition(lua_State* L) {
     auto& transform = entity.GetComponent<TransformComponent>();
     transform.localPosition = position;
     transform.UpdateLocalMatrix();
+    MarkTransformDirty(L, entity);
     return 0;
 }
 
@@ -334,6 +351,7 @@ int LuaBridge::Entity_SetScale(lua_State* L) {
     auto& transform = entity.GetComponent<TransformComponent>();
     transform.localScale = scale;
     transform.UpdateLocalMatrix();
+    MarkTransformDirty(L, entity);
     return 0;
 }
 
@@ -365,6 +383,8 @@ int LuaBridge::Entity_SetTag(lua_State* L) {
 // Stub implementations when Lua is not available
 
 void LuaBridge::RegisterBindings(lua_State* L) {}
+void LuaBridge::SetTransformSystem(lua_State* L, TransformSystem* system) {}
+void LuaBridge::MarkTransformDirty(lua_State* L, Entity entity) {}
 void LuaBridge::PushEntity(lua_State* L, Entity entity) {}
 Entity LuaBridge::CheckEntity(lua_State* L, int index) { return Entity(); }
 void LuaBridge::PushVec3(lua_State* L, const Vec3& v) {}
@@ -12,6 +12,10 @@
 
 struct lua_State;
 
+namespace MyEngine {
+class TransformSystem;
+}
+
 namespace MyEngine {
 
 /**
@@ -24,6 +28,11 @@ public:
      */
     static void RegisterBindings(lua_State* L);
 
+    /**
+     * @brief TransformSystem that script transform writes report to (nullptr = none)
+     */
+    static void SetTransformSystem(lua_State* L, TransformSystem* system);
+
     // Entity bindings
     static void PushEntity(lua_State* L, Entity entity);
     static Entity CheckEntity(lua_State* L, int index);
@@ -53,6 +62,9 @@ private:
     static int Vec3_index(lua_State* L);
     static int Vec3_newindex(lua_State* L);
 
+    // Queue entity for the active TransformSystem's next Update
+    static void MarkTransformDirty(lua_State* L, Entity entity);
+
     // Entity Lua methods
     static int Entity_GetPosition(lua_State* L);
     static int Entity_SetPosition(lua_State* L);
@@ -11,6 +11,7 @@
 #include "LuaBridge.h"
 #include "ECS/Entity.h"
 #include "Core/Log.h"
+#include "Core/Profiler.h"
 
 namespace MyEngine {
 
@@ -52,20 +53,21 @@ void ScriptSystem::Init() {
 }
 
 void ScriptSystem::Update(float deltaTime) {
+    PROFILE_SCOPE("ScriptSystem::Update");
 #ifdef LUA_SCRIPTING_ENABLED
     if (!m_luaState) {
         return;
     }
 
-    // Get all entities with ScriptComponent
-    auto entities = m_registry->GetEntitiesWith<ScriptComponent>();
+    // The Lua VM is shared; point transform writes at this system's registry
+    LuaBridge::SetTransformSystem(m_luaState, m_transformSystem);
 
-    for (EntityID entityId : entities) {
+    // Scripts may create/destroy entities; View iteration tolerates both
+    m_registry->GetView<ScriptComponent>().Each([&](EntityID entityId, ScriptComponent& script) {
         Entity entity(entityId, m_registry);
-        auto& script = entity.GetComponent<ScriptComponent>();
 
         if (!script.enabled) {
-            continue;
+            return;
         }
 
         // Load script if not loaded
@@ -73,7 +75,7 @@ void ScriptSystem::Update(float deltaTime) {
             if (!script.Load(m_luaState, entity)) {
                 ENGINE_ERROR("Failed to load script for entity {}", entityId);
                 script.enabled = false;
-                continue;
+                return;
             }
         }
 
@@ -84,7 +86,7 @@ void ScriptSystem::Update(float deltaTime) {
 
         // Call OnUpdate
         script.CallOnUpdate(m_luaState, entity, deltaTime);
-    }
+    });
 #endif
 }
 
@@ -97,13 +99,11 @@ void ScriptSystem::Shutdown() {
     }
 
     // Clean up all script components
-    auto entities = m_registry->GetEntitiesWith<ScriptComponent>();
-    for (EntityID entityId : entities) {
+    m_registry->GetView<ScriptComponent>().Each([&](EntityID entityId, ScriptComponent& script) {
         Entity entity(entityId, m_registry);
-        auto& script = entity.GetComponent<ScriptComponent>();
         script.CallOnDestroy(m_luaState, entity);
         script.Cleanup(m_luaState);
-    }
+    });
 
     // Shutdown Lua VM
     LuaVM::Instance().Shutdown();
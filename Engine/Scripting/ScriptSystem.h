@@ -13,6 +13,8 @@ struct lua_State;
 
 namespace MyEngine {
 
+class TransformSystem;
+
 /**
  * @brief System that manages script lifecycle and updates
  */
@@ -30,9 +32,15 @@ public:
      */
     lua_State* GetLuaState() const { return m_luaState; }
 
+    /**
+     * @brief TransformSystem notified of script transform writes (SetPosition / SetScale)
+     */
+    void SetTransformSystem(TransformSystem* transformSystem) { m_transformSystem = transformSystem; }
+
 private:
     Registry* m_registry;
     lua_State* m_luaState;
+    TransformSystem* m_transformSystem = nullptr;
 };
 
 } // namespace MyEngine
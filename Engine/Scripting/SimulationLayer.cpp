@@ -0,0 +1,39 @@
+/******************************************************************************
+ * File: SimulationLayer.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Simulation layer implementation
+ ******************************************************************************/
+
+#include "SimulationLayer.h"
+#include "ScriptSystem.h"
+#include "Core/Log.h"
+
+namespace MyEngine {
+
+SimulationLayer::SimulationLayer(Registry* registry, ScriptSystem* scriptSystem)
+    : Layer("SimulationLayer")
+    , m_Registry(registry)
+    , m_ScriptSystem(scriptSystem)
+    , m_TransformSystem(registry) {
+}
+
+void SimulationLayer::OnAttach() {
+    m_TransformSystem.RebuildHierarchyOrder();
+    if (m_ScriptSystem) {
+        m_ScriptSystem->SetTransformSystem(&m_TransformSystem);
+    }
+    ENGINE_INFO("SimulationLayer attached");
+}
+
+void SimulationLayer::OnUpdate(float deltaTime) {
+    if (!m_Registry) return;
+    
+    if (m_ScriptSystem) {
+        m_ScriptSystem->Update(deltaTime);
+    }
+    
+    m_TransformSystem.Update();
+}
+
+} // namespace MyEngine
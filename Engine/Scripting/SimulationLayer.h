@@ -0,0 +1,44 @@
+/******************************************************************************
+ * File: SimulationLayer.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Render-free layer that ticks scripts and transforms
+ *              (used by headless Server mode)
+ ******************************************************************************/
+
+#pragma once
+
+#include "Core/Layer.h"
+#include "ECS/Registry.h"
+#include "ECS/TransformSystem.h"
+
+namespace MyEngine {
+
+class ScriptSystem;
+
+/**
+ * @brief Simulation-only layer for dedicated servers and soak tests
+ * 
+ * Per tick:
+ * 1. ScriptSystem::Update (gameplay logic)
+ * 2. TransformSystem::Update (world matrices)
+ * 
+ * Never touches the graphics API, so it is safe to push onto an
+ * Application running in EngineMode::Server.
+ */
+class SimulationLayer : public Layer {
+public:
+    SimulationLayer(Registry* registry, ScriptSystem* scriptSystem = nullptr);
+    
+    void OnAttach() override;
+    void OnUpdate(float deltaTime) override;
+    
+    TransformSystem& GetTransformSystem() { return m_TransformSystem; }
+    
+private:
+    Registry* m_Registry;
+    ScriptSystem* m_ScriptSystem;
+    TransformSystem m_TransformSystem;
+};
+
+} // namespace MyEngine
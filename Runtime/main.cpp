@@ -10,6 +10,7 @@
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <cstdlib>
 #include "Core/UUID.h"
 #include "Core/Hash.h"
 #include "Core/StringUtils.h"
@@ -30,6 +31,7 @@
 #include "Rendering/Shader.h"
 #include "Rendering/Camera.h"
 #include "Rendering/Renderer.h"
+#include "Rendering/OpenGL/GLStateCache.h"
 #include "Resource/Mesh.h"
 #ifdef MYENGINE_ASSIMP_ENABLED
 #include "Resource/AssimpMeshLoader.h"
@@ -51,6 +53,7 @@
 #include "Platform/PlatformInfo.h"
 #include "Scripting/ScriptSystem.h"
 #include "Scripting/ScriptComponent.h"
+#include "Scripting/SimulationLayer.h"
 #include <glad/gl.h>
 
 using namespace MyEngine;
@@ -704,8 +707,8 @@ void TestIntegratedVisuals() {
         Renderer::Init();
         
         // 调试：强制关闭深度测试和背面剔除，确保不是遮挡问题
-        glDisable(GL_DEPTH_TEST);
-        glDisable(GL_CULL_FACE);
+        GLStateCache::Disable(GL_DEPTH_TEST);
+        GLStateCache::Disable(GL_CULL_FACE);
 
         // --- Setup Data for Phase 1: Triangle ---
         float triVertices[] = { 
@@ -862,8 +865,8 @@ void TestIntegratedVisuals() {
         // --- Shared Shaders ---
         std::string vertexSrc = R"(
             #version 330 core
+            #include <FrameData>
             layout(location = 0) in vec3 a_Position;
-            uniform mat4 u_ViewProjection;
             uniform mat4 u_Transform;
             void main() { gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0); }
         )";
@@ -946,15 +949,76 @@ void TestIntegratedVisuals() {
 #endif
 }
 
+// Dedicated server: no window, no GL - just simulation at a fixed tick rate
+//   MyEngine --mode server [--server.tick_rate 60] [--server.unthrottled true]
+//            [--server.max_ticks N] [--server.entities N]
+int RunServer() {
+    ENGINE_INFO("Starting MyEngine Server...");
+    
+    Application app("MyEngine Server", EngineMode::Server);
+    
+    auto registry = std::make_shared<Registry>();
+    registry->RegisterComponent<TagComponent>();
+    registry->RegisterComponent<HierarchyComponent>();
+    registry->RegisterComponent<TransformComponent>();
+    registry->RegisterComponent<ScriptComponent>();
+    
+    ScriptSystem scriptSystem(registry.get());
+    scriptSystem.Init();
+    
+    EntityID rootEntityID = registry->CreateEntity();
+    Entity rootEntity(rootEntityID, registry.get());
+    rootEntity.AddComponent<TagComponent>("RootNode");
+    rootEntity.AddComponent<HierarchyComponent>();
+    rootEntity.AddComponent<TransformComponent>(Vec3(0, 0, 0));
+    
+#ifdef LUA_SCRIPTING_ENABLED
+    EntityID orbiterEntityID = registry->CreateEntity();
+    Entity orbiterEntity(orbiterEntityID, registry.get());
+    orbiterEntity.AddComponent<TagComponent>("OrbitingSatellite");
+    orbiterEntity.AddComponent<HierarchyComponent>(rootEntityID);
+    orbiterEntity.AddComponent<TransformComponent>(Vec3(0, 2, 0));
+    orbiterEntity.AddComponent<ScriptComponent>("Runtime/Scripts/Orbiter.lua");
+#endif
+    
+    // Optional synthetic load for soak tests
+    int extraEntities = std::atoi(Config::Get<std::string>("server.entities", "0").c_str());
+    for (int i = 0; i < extraEntities; ++i) {
+        EntityID id = registry->CreateEntity();
+        Entity entity(id, registry.get());
+        entity.AddComponent<HierarchyComponent>(rootEntityID);
+        entity.AddComponent<TransformComponent>(Vec3(static_cast<float>(i), 0, 0));
+    }
+    
+    auto simulationLayer = std::make_shared<SimulationLayer>(registry.get(), &scriptSystem);
+    app.PushLayer(simulationLayer);
+    
+    app.Run();
+    
+    scriptSystem.Shutdown();
+    ModuleRegistry::Get().ShutdownAll();
+    return 0;
+}
+
 int main(int argc, char** argv) {
+    Log::Init();
+    Config::ParseCommandLine(argc, argv);
+    if (Config::Get<std::string>("mode") == "server") {
+        try {
+            return RunServer();
+        }
+        catch (const std::exception& e) {
+            ENGINE_ERROR("Fatal error: {}", e.what());
+            return 1;
+        }
+    }
+    
     std::cout << "========================================" << std::endl;
     std::cout << "   MyEngine Editor" << std::endl;
     std::cout << "   Scene Graph + ECS Architecture" << std::endl;
     std::cout << "========================================" << std::endl;
     
     try {
-        // Initialize log system
-        Log::Init();
         ENGINE_INFO("Starting MyEngine Editor...");
         
         // Create application in Editor mode
@@ -1005,6 +1069,7 @@ int main(int argc, char** argv) {
         modelEntity.AddComponent<HierarchyComponent>(rootEntityID);
         auto& modelTransform = modelEntity.AddComponent<TransformComponent>(Vec3(0, 0, 0)); // Center at origin
         modelTransform.localScale = Vec3(0.1f, 0.1f, 0.1f); // Scale for better viewing
+        modelTransform.UpdateLocalMatrix();
         
         // Add MeshFilterComponent with loaded mesh
         if (loadedMesh) {
@@ -0,0 +1,978 @@
+/******************************************************************************
+ * File: BenchmarkECS.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: ECS storage and iteration micro-benchmarks
+ ******************************************************************************/
+
+#include "Core/Log.h"
+#include "ECS/Registry.h"
+#include "ECS/Components.h"
+#include "ECS/ArchetypeRegistry.h"
+#include "ECS/SystemScheduler.h"
+#include "ECS/Prefab.h"
+#include "ECS/RegistrySnapshot.h"
+#include "ECS/SceneSerializer.h"
+#include "ECS/TransformSystem.h"
+#include "Core/TaskSystem.h"
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <array>
+#include <unordered_map>
+#include <string>
+#include <thread>
+#include <cmath>
+
+using namespace MyEngine;
+
+namespace {
+
+constexpr uint32_t LEGACY_MAX_ENTITIES = 10000;
+
+/**
+ * @brief Copy of the original hash-map based ComponentArray (baseline)
+ */
+template<typename T>
+class LegacyComponentArray {
+public:
+    void InsertData(EntityID entity, T component) {
+        size_t newIndex = m_Size;
+        m_EntityToIndexMap[entity] = newIndex;
+        m_IndexToEntityMap[newIndex] = entity;
+        m_ComponentArray[newIndex] = component;
+        m_Size++;
+    }
+
+    void RemoveData(EntityID entity) {
+        size_t indexOfRemovedEntity = m_EntityToIndexMap[entity];
+        size_t indexOfLastElement = m_Size - 1;
+        m_ComponentArray[indexOfRemovedEntity] = m_ComponentArray[indexOfLastElement];
+
+        EntityID entityOfLastElement = m_IndexToEntityMap[indexOfLastElement];
+        m_EntityToIndexMap[entityOfLastElement] = indexOfRemovedEntity;
+        m_IndexToEntityMap[indexOfRemovedEntity] = entityOfLastElement;
+
+        m_EntityToIndexMap.erase(entity);
+        m_IndexToEntityMap.erase(indexOfLastElement);
+        m_Size--;
+    }
+
+    T& GetData(EntityID entity) {
+        return m_ComponentArray[m_EntityToIndexMap[entity]];
+    }
+
+    size_t GetMemoryUsage() const {
+        // Node-based maps: roughly one node (key, value, next, hash) per entry plus buckets
+        const size_t nodeBytes = sizeof(void*) + sizeof(size_t) + 2 * sizeof(size_t);
+        return sizeof(m_ComponentArray)
+             + (m_EntityToIndexMap.size() + m_IndexToEntityMap.size()) * nodeBytes
+             + (m_EntityToIndexMap.bucket_count() + m_IndexToEntityMap.bucket_count()) * sizeof(void*);
+    }
+
+private:
+    std::array<T, LEGACY_MAX_ENTITIES> m_ComponentArray;
+    std::unordered_map<EntityID, size_t> m_EntityToIndexMap;
+    std::unordered_map<size_t, EntityID> m_IndexToEntityMap;
+    size_t m_Size = 0;
+};
+
+/**
+ * @brief Copy of the original Registry type lookup (typeid name map + shared_ptr copy)
+ */
+class LegacyTypeLookup {
+public:
+    template<typename T>
+    void Register(const std::shared_ptr<ComponentArray<T>>& pool) {
+        m_ComponentTypes[typeid(T).name()] = GetComponentTypeID<T>();
+        m_ComponentArrays[typeid(T).name()] = pool;
+    }
+
+    template<typename T>
+    T& GetComponent(EntityID entity) {
+        return GetComponentArray<T>()->GetData(entity);
+    }
+
+private:
+    template<typename T>
+    std::shared_ptr<ComponentArray<T>> GetComponentArray() {
+        const char* typeName = typeid(T).name();
+        return std::static_pointer_cast<ComponentArray<T>>(m_ComponentArrays[typeName]);
+    }
+
+    std::unordered_map<const char*, ComponentID> m_ComponentTypes;
+    std::unordered_map<const char*, std::shared_ptr<IComponentArray>> m_ComponentArrays;
+};
+
+using Clock = std::chrono::high_resolution_clock;
+
+template<typename Fn>
+double Measure(int iterations, Fn&& fn) {
+    double best = 1e30;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = Clock::now();
+        fn();
+        auto end = Clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+/**
+ * @brief Like Measure, but runs an untimed setup step before each iteration
+ */
+template<typename Setup, typename Fn>
+double MeasureWithSetup(int iterations, Setup&& setup, Fn&& fn) {
+    double best = 1e30;
+    for (int i = 0; i < iterations; ++i) {
+        auto state = setup();
+        auto start = Clock::now();
+        fn(*state);
+        auto end = Clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+void Report(const char* name, double legacyMs, double newMs) {
+    // Below a microsecond (e.g. nothing dirty) the ratio is timer noise
+    if (newMs < 1e-3) {
+        std::printf("  %-28s legacy %9.3f ms   sparse %9.3f ms\n", name, legacyMs, newMs);
+        return;
+    }
+    std::printf("  %-28s legacy %9.3f ms   sparse %9.3f ms   x%.2f\n", name, legacyMs, newMs, legacyMs / newMs);
+}
+
+volatile float g_Sink = 0.0f;
+
+template<typename Storage>
+void Fill(Storage& storage, const std::vector<EntityID>& entities) {
+    for (EntityID entity : entities) {
+        storage.InsertData(entity, TransformComponent(Vec3(static_cast<float>(entity), 0.0f, 0.0f)));
+    }
+}
+
+template<typename Storage>
+float Lookup(Storage& storage, const std::vector<EntityID>& order) {
+    float sum = 0.0f;
+    for (EntityID entity : order) {
+        sum += storage.GetData(entity).localPosition.x;
+    }
+    return sum;
+}
+
+template<typename Storage>
+void RemoveHalf(Storage& storage, const std::vector<EntityID>& order) {
+    for (size_t i = 0; i < order.size() / 2; ++i) {
+        storage.RemoveData(order[i]);
+    }
+}
+
+void BenchmarkComponentStorage(uint32_t count, int iterations) {
+    std::printf("ComponentArray<TransformComponent>, %u entities\n", count);
+
+    std::vector<EntityID> entities(count);
+    for (uint32_t i = 0; i < count; ++i) entities[i] = i;
+    std::vector<EntityID> shuffled = entities;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(1234));
+
+    // Large storage objects live on the heap
+    auto legacyInsert = Measure(iterations, [&] {
+        auto storage = std::make_unique<LegacyComponentArray<TransformComponent>>();
+        Fill(*storage, entities);
+    });
+    auto sparseInsert = Measure(iterations, [&] {
+        auto storage = std::make_unique<ComponentArray<TransformComponent>>();
+        Fill(*storage, entities);
+    });
+    Report("insert", legacyInsert, sparseInsert);
+
+    auto legacy = std::make_unique<LegacyComponentArray<TransformComponent>>();
+    auto sparse = std::make_unique<ComponentArray<TransformComponent>>();
+    Fill(*legacy, entities);
+    Fill(*sparse, entities);
+
+    Report("get (sequential)",
+        Measure(iterations, [&] { g_Sink = Lookup(*legacy, entities); }),
+        Measure(iterations, [&] { g_Sink = Lookup(*sparse, entities); }));
+    Report("get (random)",
+        Measure(iterations, [&] { g_Sink = Lookup(*legacy, shuffled); }),
+        Measure(iterations, [&] { g_Sink = Lookup(*sparse, shuffled); }));
+
+    auto legacyRemove = MeasureWithSetup(iterations,
+        [&] {
+            auto storage = std::make_unique<LegacyComponentArray<TransformComponent>>();
+            Fill(*storage, entities);
+            return storage;
+        },
+        [&](auto& storage) { RemoveHalf(storage, shuffled); });
+    auto sparseRemove = MeasureWithSetup(iterations,
+        [&] {
+            auto storage = std::make_unique<ComponentArray<TransformComponent>>();
+            Fill(*storage, entities);
+            return storage;
+        },
+        [&](auto& storage) { RemoveHalf(storage, shuffled); });
+    Report("remove half (random)", legacyRemove, sparseRemove);
+
+    std::printf("  %-28s legacy %9.1f KB   sparse %9.1f KB\n", "memory",
+                legacy->GetMemoryUsage() / 1024.0, sparse->GetMemoryUsage() / 1024.0);
+
+    auto sparseSmall = std::make_unique<ComponentArray<TransformComponent>>();
+    Fill(*sparseSmall, std::vector<EntityID>(entities.begin(), entities.begin() + count / 100));
+    std::printf("  %-28s legacy %9.1f KB   sparse %9.1f KB\n", "memory (1% populated)",
+                sizeof(LegacyComponentArray<TransformComponent>) / 1024.0,
+                sparseSmall->GetMemoryUsage() / 1024.0);
+}
+
+void BenchmarkViews(uint32_t count, int iterations) {
+    std::printf("Iteration over <TransformComponent, TagComponent>, %u entities (50%% match)\n", count);
+
+    Registry registry;
+    registry.RegisterComponent<TransformComponent>();
+    registry.RegisterComponent<TagComponent>();
+    for (uint32_t i = 0; i < count; ++i) {
+        EntityID entity = registry.CreateEntity();
+        registry.AddComponent(entity, TransformComponent(Vec3(1.0f, 0.0f, 0.0f)));
+        if (i % 2 == 0) {
+            registry.AddComponent(entity, TagComponent("Entity"));
+        }
+    }
+
+    auto snapshot = Measure(iterations, [&] {
+        float sum = 0.0f;
+        for (EntityID entity : registry.GetEntitiesWith<TransformComponent, TagComponent>()) {
+            sum += registry.GetComponent<TransformComponent>(entity).localPosition.x;
+        }
+        g_Sink = sum;
+    });
+    auto query = Measure(iterations, [&] {
+        float sum = 0.0f;
+        for (EntityID entity : registry.Query<TransformComponent, TagComponent>()) {
+            sum += registry.GetComponent<TransformComponent>(entity).localPosition.x;
+        }
+        g_Sink = sum;
+    });
+    auto view = Measure(iterations, [&] {
+        float sum = 0.0f;
+        registry.GetView<TransformComponent, TagComponent>().Each(
+            [&](TransformComponent& transform, TagComponent&) { sum += transform.localPosition.x; });
+        g_Sink = sum;
+    });
+
+    std::printf("  %-28s %9.3f ms\n", "GetEntitiesWith + Get", snapshot);
+    std::printf("  %-28s %9.3f ms\n", "Query + Get", query);
+    std::printf("  %-28s %9.3f ms\n", "View::Each", view);
+}
+
+struct BenchPosition { float X = 0.0f, Y = 0.0f, Z = 0.0f; };
+struct BenchVelocity { float X = 1.0f, Y = 0.5f, Z = 0.25f; };
+struct BenchHealth { float Value = 100.0f; };
+struct BenchFrozen { uint32_t Frames = 0; };
+
+template<typename RegistryType>
+std::vector<EntityID> PopulateStorageComparison(RegistryType& registry, uint32_t count) {
+    std::vector<EntityID> entities;
+    entities.reserve(count);
+    registry.template RegisterComponent<BenchPosition>();
+    registry.template RegisterComponent<BenchVelocity>();
+    registry.template RegisterComponent<BenchHealth>();
+    registry.template RegisterComponent<BenchFrozen>();
+    for (uint32_t i = 0; i < count; ++i) {
+        EntityID entity = registry.CreateEntity();
+        entities.push_back(entity);
+        registry.AddComponent(entity, BenchPosition{});
+        registry.AddComponent(entity, BenchVelocity{});
+        if (i % 3 == 0) {
+            registry.AddComponent(entity, BenchHealth{});
+        }
+    }
+    return entities;
+}
+
+void BenchmarkArchetypes(uint32_t count, int iterations) {
+    std::printf("Sparse-set Registry vs ArchetypeRegistry, %u entities\n", count);
+
+    Registry sparse;
+    ArchetypeRegistry archetypes;
+    const auto sparseEntities = PopulateStorageComparison(sparse, count);
+    const auto archetypeEntities = PopulateStorageComparison(archetypes, count);
+
+    // Iteration-heavy: integrate positions 100 times
+    constexpr int Passes = 100;
+    auto sparseIterate = Measure(iterations, [&] {
+        for (int pass = 0; pass < Passes; ++pass) {
+            sparse.GetView<BenchPosition, BenchVelocity>().Each(
+                [](BenchPosition& p, BenchVelocity& v) {
+                    p.X += v.X * 0.016f; p.Y += v.Y * 0.016f; p.Z += v.Z * 0.016f;
+                });
+        }
+    });
+    auto archetypeIterate = Measure(iterations, [&] {
+        for (int pass = 0; pass < Passes; ++pass) {
+            archetypes.EachChunk<BenchPosition, BenchVelocity>([](ArchetypeChunk& chunk) {
+                BenchPosition* p = chunk.Column<BenchPosition>();
+                const BenchVelocity* v = chunk.Column<BenchVelocity>();
+                for (uint32_t i = 0, n = chunk.Count(); i < n; ++i) {
+                    p[i].X += v[i].X * 0.016f; p[i].Y += v[i].Y * 0.016f; p[i].Z += v[i].Z * 0.016f;
+                }
+            });
+        }
+    });
+    std::printf("  %-28s sparse %9.3f ms   archetype %9.3f ms   x%.2f\n", "iterate x100",
+                sparseIterate, archetypeIterate, sparseIterate / archetypeIterate);
+
+    // Churn-heavy: add and remove a component on every entity
+    auto sparseChurn = Measure(iterations, [&] {
+        for (EntityID entity : sparseEntities) sparse.AddComponent(entity, BenchFrozen{});
+        for (EntityID entity : sparseEntities) sparse.RemoveComponent<BenchFrozen>(entity);
+    });
+    auto archetypeChurn = Measure(iterations, [&] {
+        for (EntityID entity : archetypeEntities) archetypes.AddComponent(entity, BenchFrozen{});
+        for (EntityID entity : archetypeEntities) archetypes.RemoveComponent<BenchFrozen>(entity);
+    });
+    std::printf("  %-28s sparse %9.3f ms   archetype %9.3f ms   x%.2f\n", "add+remove component",
+                sparseChurn, archetypeChurn, sparseChurn / archetypeChurn);
+    std::printf("  archetypes: %zu, chunks: %zu\n", archetypes.GetArchetypeCount(), archetypes.GetChunkCount());
+}
+
+void BenchmarkGetComponent(uint32_t count, int iterations) {
+    std::printf("Registry::GetComponent, %u entities x 3 component types\n", count);
+
+    Registry registry;
+    registry.RegisterComponent<TransformComponent>();
+    registry.RegisterComponent<TagComponent>();
+    registry.RegisterComponent<HierarchyComponent>();
+
+    // Legacy path looks up the same pools through the old name-keyed maps
+    auto transforms = std::make_shared<ComponentArray<TransformComponent>>();
+    auto tags = std::make_shared<ComponentArray<TagComponent>>();
+    auto hierarchies = std::make_shared<ComponentArray<HierarchyComponent>>();
+    LegacyTypeLookup legacy;
+    legacy.Register(transforms);
+    legacy.Register(tags);
+    legacy.Register(hierarchies);
+
+    std::vector<EntityID> entities;
+    for (uint32_t i = 0; i < count; ++i) {
+        EntityID entity = registry.CreateEntity();
+        entities.push_back(entity);
+        registry.AddComponent(entity, TransformComponent(Vec3(1.0f, 0.0f, 0.0f)));
+        registry.AddComponent(entity, TagComponent("Entity"));
+        registry.AddComponent(entity, HierarchyComponent());
+        transforms->InsertData(entity, TransformComponent(Vec3(1.0f, 0.0f, 0.0f)));
+        tags->InsertData(entity, TagComponent("Entity"));
+        hierarchies->InsertData(entity, HierarchyComponent());
+    }
+
+    auto before = Measure(iterations, [&] {
+        float sum = 0.0f;
+        for (EntityID entity : entities) {
+            sum += legacy.GetComponent<TransformComponent>(entity).localPosition.x;
+            sum += static_cast<float>(legacy.GetComponent<TagComponent>(entity).Tag.size());
+            sum += static_cast<float>(legacy.GetComponent<HierarchyComponent>(entity).depth);
+        }
+        g_Sink = sum;
+    });
+    auto after = Measure(iterations, [&] {
+        float sum = 0.0f;
+        for (EntityID entity : entities) {
+            sum += registry.GetComponent<TransformComponent>(entity).localPosition.x;
+            sum += static_cast<float>(registry.GetComponent<TagComponent>(entity).Tag.size());
+            sum += static_cast<float>(registry.GetComponent<HierarchyComponent>(entity).depth);
+        }
+        g_Sink = sum;
+    });
+
+    const double lookups = 3.0 * count;
+    std::printf("  %-28s %9.3f ms (%.1f M lookups/s)\n", "typeid map + shared_ptr", before, lookups / before / 1e3);
+    std::printf("  %-28s %9.3f ms (%.1f M lookups/s)\n", "flat pool table", after, lookups / after / 1e3);
+}
+
+void BenchmarkEntityLifecycle(uint32_t count, int iterations) {
+    std::printf("Entity create/destroy, %u entities\n", count);
+
+    Registry registry;
+    std::vector<EntityID> entities(count);
+
+    auto create = Measure(iterations, [&] {
+        for (uint32_t i = 0; i < count; ++i) entities[i] = registry.CreateEntity();
+        for (uint32_t i = 0; i < count; ++i) registry.DestroyEntity(entities[i]);
+    });
+    // Second round reuses recycled slots from the free list
+    auto recycle = Measure(iterations, [&] {
+        for (uint32_t i = 0; i < count; ++i) entities[i] = registry.CreateEntity();
+        for (uint32_t i = count; i-- > 0;) registry.DestroyEntity(entities[i]);
+    });
+
+    uint32_t valid = 0;
+    for (EntityID entity : entities) valid += registry.IsValid(entity) ? 1 : 0;
+
+    std::printf("  %-28s %9.3f ms (%.1f ns/entity)\n", "create+destroy", create, create * 1e6 / count);
+    std::printf("  %-28s %9.3f ms (%.1f ns/entity)\n", "create+destroy (recycled)", recycle, recycle * 1e6 / count);
+    std::printf("  %-28s %u\n", "stale handles still valid", valid);
+}
+
+void BenchmarkBatchSpawn(uint32_t count, int iterations) {
+    std::printf("Batch spawn, %u entities\n", count);
+
+    auto perEntity = MeasureWithSetup(iterations,
+        [] {
+            auto registry = std::make_unique<Registry>();
+            registry->RegisterComponent<BenchPosition>();
+            registry->RegisterComponent<BenchVelocity>();
+            return registry;
+        },
+        [count](Registry& registry) {
+            for (uint32_t i = 0; i < count; ++i) {
+                EntityID entity = registry.CreateEntity();
+                registry.AddComponent(entity, BenchPosition{});
+                registry.AddComponent(entity, BenchVelocity{});
+            }
+        });
+
+    auto batched = MeasureWithSetup(iterations,
+        [] { return std::make_unique<Registry>(); },
+        [count](Registry& registry) {
+            registry.CreateEntities(count, BenchPosition{}, BenchVelocity{});
+        });
+
+    // 4-entity subtree (root + 2 children + grandchild), count / 4 copies
+    auto prefabSpawn = MeasureWithSetup(iterations,
+        [] {
+            auto registry = std::make_unique<Registry>();
+            registry->RegisterComponent<HierarchyComponent>();
+            EntityID nodes[4];
+            registry->CreateEntities(nodes, 4, BenchPosition{}, BenchVelocity{}, HierarchyComponent{});
+            auto link = [&](EntityID parent, EntityID child, EntityID sibling, uint32_t depth) {
+                auto& node = registry->GetComponent<HierarchyComponent>(child);
+                node.parent = parent;
+                node.nextSibling = sibling;
+                node.depth = depth;
+            };
+            registry->GetComponent<HierarchyComponent>(nodes[0]).firstChild = nodes[1];
+            link(nodes[0], nodes[1], nodes[2], 1);
+            link(nodes[0], nodes[2], 0, 1);
+            registry->GetComponent<HierarchyComponent>(nodes[1]).firstChild = nodes[3];
+            link(nodes[1], nodes[3], 0, 2);
+            auto state = std::make_unique<std::pair<std::unique_ptr<Registry>, Prefab>>();
+            state->second = Prefab::FromEntity(*registry, nodes[0]);
+            state->first = std::move(registry);
+            return state;
+        },
+        [count](std::pair<std::unique_ptr<Registry>, Prefab>& state) {
+            state.second.InstantiateMany(*state.first, count / 4);
+        });
+
+    Registry registry;
+    std::vector<EntityID> entities;
+    auto destroyLoop = MeasureWithSetup(iterations,
+        [&] {
+            entities = registry.CreateEntities(count, BenchPosition{}, BenchVelocity{});
+            return std::make_unique<int>(0);
+        },
+        [&](int&) {
+            for (EntityID entity : entities) registry.DestroyEntity(entity);
+        });
+    auto destroyBatch = MeasureWithSetup(iterations,
+        [&] {
+            entities = registry.CreateEntities(count, BenchPosition{}, BenchVelocity{});
+            return std::make_unique<int>(0);
+        },
+        [&](int&) { registry.DestroyEntities(entities); });
+
+    std::printf("  %-28s %9.3f ms\n", "CreateEntity+AddComponent", perEntity);
+    std::printf("  %-28s %9.3f ms   x%.2f\n", "CreateEntities", batched, perEntity / batched);
+    std::printf("  %-28s %9.3f ms   (%u subtrees)\n", "Prefab::InstantiateMany", prefabSpawn, count / 4);
+    std::printf("  %-28s %9.3f ms\n", "DestroyEntity loop", destroyLoop);
+    std::printf("  %-28s %9.3f ms   x%.2f\n", "DestroyEntities", destroyBatch, destroyLoop / destroyBatch);
+}
+
+void BenchmarkSnapshot(uint32_t count, int iterations) {
+    std::printf("Registry snapshot, %u entities (position, velocity, health, tag)\n", count);
+
+    Registry registry;
+    const auto entities = PopulateStorageComparison(registry, count);
+    registry.RegisterComponent<TagComponent>();
+    for (uint32_t i = 0; i < count; ++i) {
+        registry.AddComponent(entities[i], TagComponent("Entity"));
+    }
+
+    // "Play": move 1% of the entities and destroy another 1%
+    auto play = [&] {
+        for (uint32_t i = 0; i < count / 100; ++i) {
+            registry.GetComponent<BenchPosition>(entities[i]).X += 1.0f;
+        }
+        for (uint32_t i = count / 100; i < count / 50; ++i) {
+            if (registry.IsValid(entities[i])) registry.DestroyEntity(entities[i]);
+        }
+    };
+
+    RegistrySnapshot snapshot;
+    auto copyCapture = Measure(iterations, [&] { snapshot.Capture(registry, RegistrySnapshot::Mode::Copy); });
+    auto copyRestore = MeasureWithSetup(iterations,
+        [&] { play(); return std::make_unique<int>(0); },
+        [&](int&) { snapshot.Restore(registry); });
+    const size_t copyBytes = snapshot.GetMemoryUsage();
+
+    auto cowCapture = Measure(iterations, [&] { snapshot.Capture(registry, RegistrySnapshot::Mode::CopyOnWrite); });
+    // Restore cost includes the lazy copies made by play() (every pool the destroyed entities touched)
+    auto cowPlayRestore = MeasureWithSetup(iterations,
+        [&] { snapshot.Capture(registry, RegistrySnapshot::Mode::CopyOnWrite); return std::make_unique<int>(0); },
+        [&](int&) { play(); snapshot.Restore(registry); });
+    auto cowMoveOnly = MeasureWithSetup(iterations,
+        [&] { snapshot.Capture(registry, RegistrySnapshot::Mode::CopyOnWrite); return std::make_unique<int>(0); },
+        [&](int&) {
+            for (uint32_t i = 0; i < count / 100; ++i) {
+                registry.GetComponent<BenchPosition>(entities[i]).X += 1.0f;
+            }
+            snapshot.Restore(registry);
+        });
+    snapshot.Release();
+
+    std::printf("  %-28s %9.3f ms   (%.1f MB)\n", "Copy: capture", copyCapture, copyBytes / (1024.0 * 1024.0));
+    std::printf("  %-28s %9.3f ms\n", "Copy: restore", copyRestore);
+    std::printf("  %-28s %9.3f ms\n", "CopyOnWrite: capture", cowCapture);
+    std::printf("  %-28s %9.3f ms\n", "CopyOnWrite: play+restore", cowPlayRestore);
+    std::printf("  %-28s %9.3f ms\n", "CopyOnWrite: move+restore", cowMoveOnly);
+}
+
+/**
+ * @brief Pre-incremental TransformSystem::AddToHierarchy: sibling walk + full depth sort per add
+ */
+void LegacyAddToHierarchy(Registry& registry, std::vector<EntityID>& ordered, EntityID entity, EntityID parent) {
+    auto& hierarchy = registry.GetComponent<HierarchyComponent>(entity);
+    hierarchy.parent = parent;
+    if (parent != 0) {
+        auto& parentHierarchy = registry.GetComponent<HierarchyComponent>(parent);
+        if (parentHierarchy.firstChild == 0) {
+            parentHierarchy.firstChild = entity;
+        } else {
+            EntityID last = parentHierarchy.firstChild;
+            while (registry.GetComponent<HierarchyComponent>(last).nextSibling != 0) {
+                last = registry.GetComponent<HierarchyComponent>(last).nextSibling;
+            }
+            registry.GetComponent<HierarchyComponent>(last).nextSibling = entity;
+        }
+        hierarchy.depth = registry.GetComponent<HierarchyComponent>(parent).depth + 1;
+    }
+
+    const auto& entities = registry.Query<HierarchyComponent>();
+    ordered.assign(entities.begin(), entities.end());
+    std::stable_sort(ordered.begin(), ordered.end(), [&registry](EntityID a, EntityID b) {
+        return registry.GetComponent<HierarchyComponent>(a).depth < registry.GetComponent<HierarchyComponent>(b).depth;
+    });
+}
+
+void BenchmarkHierarchy(uint32_t count, int iterations) {
+    std::printf("Transform hierarchy, %u nodes (random parents)\n", count);
+
+    struct HierarchyScene {
+        Registry Scene;
+        std::vector<EntityID> Entities;
+        std::vector<EntityID> Ordered;
+        TransformSystem Transforms{ &Scene };
+    };
+    auto makeScene = [count] {
+        auto scene = std::make_unique<HierarchyScene>();
+        scene->Scene.RegisterComponent<HierarchyComponent>();
+        scene->Scene.RegisterComponent<TransformComponent>();
+        scene->Entities = scene->Scene.CreateEntities(count, HierarchyComponent(), TransformComponent());
+        return scene;
+    };
+
+    std::mt19937 rng(42);
+    std::vector<uint32_t> parents(count, 0);
+    for (uint32_t i = 1; i < count; ++i) {
+        parents[i] = static_cast<uint32_t>(rng() % i);
+    }
+    auto parentOf = [&parents](HierarchyScene& scene, uint32_t i) {
+        return i == 0 ? NULL_ENTITY : scene.Entities[parents[i]];
+    };
+
+    auto legacyBuild = MeasureWithSetup(iterations, makeScene, [&](HierarchyScene& scene) {
+        for (uint32_t i = 0; i < count; ++i) {
+            LegacyAddToHierarchy(scene.Scene, scene.Ordered, scene.Entities[i], parentOf(scene, i));
+        }
+    });
+    auto incrementalBuild = MeasureWithSetup(iterations, makeScene, [&](HierarchyScene& scene) {
+        for (uint32_t i = 0; i < count; ++i) {
+            scene.Transforms.AddToHierarchy(scene.Entities[i], parentOf(scene, i));
+        }
+        scene.Transforms.FlushHierarchyChanges();
+    });
+    Report("Build (one add at a time)", legacyBuild, incrementalBuild);
+
+    // Editor-style: one subtree move per frame
+    auto built = makeScene();
+    for (uint32_t i = 0; i < count; ++i) {
+        built->Transforms.AddToHierarchy(built->Entities[i], parentOf(*built, i));
+    }
+    built->Transforms.FlushHierarchyChanges();
+    constexpr uint32_t Moves = 1000;
+    auto reparent = Measure(iterations, [&] {
+        for (uint32_t k = 0; k < Moves; ++k) {
+            const uint32_t child = 1 + static_cast<uint32_t>(rng() % (count - 1));
+            built->Transforms.SetParent(built->Entities[child], built->Entities[rng() % child]);
+            built->Transforms.FlushHierarchyChanges();
+        }
+    });
+    std::printf("  %-28s %9.3f us\n", "Reparent subtree (per move)", reparent * 1000.0 / Moves);
+}
+
+/**
+ * @brief Serial propagation loop TransformSystem::Update used before the SoA / parallel pass
+ */
+uint32_t LegacyPropagate(Registry& registry, const std::vector<EntityID>& ordered) {
+    uint32_t updated = 0;
+    for (EntityID entityID : ordered) {
+        const auto& hierarchy = registry.GetComponent<const HierarchyComponent>(entityID);
+        auto& transform = registry.GetComponent<TransformComponent>(entityID);
+        if (hierarchy.IsRoot()) {
+            if (transform.worldVersion != transform.localVersion) {
+                transform.worldMatrix = transform.localMatrix;
+                transform.worldVersion = transform.localVersion;
+                updated++;
+            }
+        } else {
+            auto& parentTransform = registry.GetComponent<TransformComponent>(hierarchy.parent);
+            if (transform.NeedsUpdate(parentTransform.worldVersion)) {
+                transform.worldMatrix = parentTransform.worldMatrix * transform.localMatrix;
+                transform.parentVersion = parentTransform.worldVersion;
+                transform.worldVersion = transform.localVersion;
+                updated++;
+            }
+        }
+    }
+    return updated;
+}
+
+/**
+ * @brief World matrix propagation with a fraction of the local transforms changed per frame
+ */
+void BenchmarkTransformPropagation(uint32_t count, int iterations) {
+    std::printf("Transform propagation, %u nodes (random parents)\n", count);
+
+    Registry registry;
+    registry.RegisterComponent<HierarchyComponent>();
+    registry.RegisterComponent<TransformComponent>();
+    const auto entities = registry.CreateEntities(count, HierarchyComponent(), TransformComponent());
+    TransformSystem transforms(&registry);
+    std::mt19937 rng(42);
+    for (uint32_t i = 0; i < count; ++i) {
+        transforms.AddToHierarchy(entities[i], i == 0 ? NULL_ENTITY : entities[rng() % i]);
+    }
+    transforms.Update();
+
+    // Dirtying is untimed; only the propagation pass is measured
+    auto measureFrames = [&](const std::vector<EntityID>& dirty, auto&& propagate) {
+        double best = 1e30;
+        for (int i = 0; i < iterations; ++i) {
+            for (EntityID entity : dirty) {
+                auto& transform = registry.GetComponent<TransformComponent>(entity);
+                transform.localPosition.x += 0.001f;
+                transform.UpdateLocalMatrix();
+                transforms.MarkDirty(entity);
+            }
+            auto start = Clock::now();
+            propagate();
+            auto end = Clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        return best;
+    };
+
+    const uint32_t workers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    for (uint32_t percent : { 0u, 1u, 10u, 100u }) {
+        std::vector<EntityID> dirty;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (rng() % 100 < percent) {
+                dirty.push_back(entities[i]);
+            }
+        }
+
+        const double legacy = measureFrames(dirty, [&] { LegacyPropagate(registry, transforms.GetHierarchyOrdered()); });
+        transforms.Update();
+        const double serial = measureFrames(dirty, [&] { transforms.Update(); });
+        double parallel = serial;
+        if (workers > 0) {
+            TaskSystem::Initialize(workers);
+            parallel = measureFrames(dirty, [&] { transforms.Update(); });
+            TaskSystem::Shutdown();
+        }
+        const std::string label = std::to_string(percent) + "% dirty, " + std::to_string(workers) + " workers";
+        Report(label.c_str(), legacy, parallel);
+        if (workers > 0) {
+            std::printf("  %-28s %9.3f ms (caller only)\n", "", serial);
+        }
+    }
+
+    // Short-lived transforms outside the hierarchy (projectiles, effects) spawned and destroyed
+    // every frame next to 1% moving nodes; the dense indices they shift are patched, not rebuilt
+    std::vector<EntityID> moving;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (rng() % 100 == 0) {
+            moving.push_back(entities[i]);
+        }
+    }
+    std::vector<EntityID> spawned;
+    constexpr uint32_t Spawns = 64;
+    const double churn = measureFrames(moving, [&] {
+        transforms.Update();
+    });
+    double churnFrames = 1e30;
+    for (int i = 0; i < iterations; ++i) {
+        registry.DestroyEntities(spawned);
+        spawned = registry.CreateEntities(Spawns, TransformComponent(Vec3(1, 2, 3)));
+        for (EntityID entity : moving) {
+            transforms.MarkDirty(entity);
+        }
+        auto start = Clock::now();
+        transforms.Update();
+        churnFrames = std::min(churnFrames, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    std::printf("  %-28s %9.3f ms   (%u spawned + %u destroyed per frame; %.3f ms without)\n",
+                "1% dirty + pool churn", churnFrames, Spawns, Spawns, churn);
+}
+
+/**
+ * @brief Binary scene save / load, against reading the same bytes with no parsing at all
+ */
+void BenchmarkSceneFile(uint32_t count, int iterations) {
+    std::printf("Scene file, %u entities (transform, hierarchy, tag)\n", count);
+    const std::string path = "BenchmarkScene.bin";
+
+    Registry source;
+    source.RegisterComponent<TransformComponent>();
+    source.RegisterComponent<HierarchyComponent>();
+    source.RegisterComponent<TagComponent>();
+    const auto entities = source.CreateEntities(count, TransformComponent(), HierarchyComponent());
+    for (uint32_t i = 0; i < count; ++i) {
+        source.AddComponent(entities[i], TagComponent("Entity " + std::to_string(i % 1000)));
+    }
+
+    auto save = Measure(iterations, [&] { SceneSerializer::Save(source, path); });
+    std::ifstream probe(path, std::ios::binary | std::ios::ate);
+    const size_t fileBytes = static_cast<size_t>(probe.tellg());
+    probe.close();
+
+    // Into fresh memory each time, like the pools a load has to fill
+    auto readOnly = Measure(iterations, [&] {
+        std::unique_ptr<char[]> buffer(new char[fileBytes]);
+        std::ifstream in(path, std::ios::binary);
+        in.read(buffer.get(), static_cast<std::streamsize>(fileBytes));
+    });
+    auto load = MeasureWithSetup(iterations,
+        [] { return std::make_unique<Registry>(); },
+        [&](Registry& registry) { SceneSerializer::Load(registry, path); });
+    std::remove(path.c_str());
+
+    std::printf("  %-28s %9.3f ms   (%.1f MB)\n", "Save", save, fileBytes / (1024.0 * 1024.0));
+    std::printf("  %-28s %9.3f ms\n", "Read file only", readOnly);
+    std::printf("  %-28s %9.3f ms\n", "Load (mmap)", load);
+}
+
+/**
+ * @brief Benchmark systems: deliberately math-heavy so scheduling overhead is not dominant
+ */
+class BenchIntegrateSystem : public System {
+public:
+    BenchIntegrateSystem() { Reads<BenchVelocity>(); Writes<BenchPosition>(); }
+    const char* GetName() const override { return "Integrate"; }
+    void Update(Registry& registry, float deltaTime) override {
+        SystemScheduler::ParallelEach<BenchPosition, BenchVelocity>(registry,
+            [deltaTime](BenchPosition& p, const BenchVelocity& v) {
+                for (int k = 0; k < 8; ++k) {
+                    p.X += std::sin(v.X * deltaTime + p.Y) * deltaTime;
+                    p.Y += std::cos(v.Y * deltaTime + p.Z) * deltaTime;
+                    p.Z += v.Z * deltaTime;
+                }
+            });
+    }
+};
+
+class BenchDampSystem : public System {
+public:
+    BenchDampSystem() { Writes<BenchVelocity>(); }
+    const char* GetName() const override { return "Damp"; }
+    void Update(Registry& registry, float deltaTime) override {
+        SystemScheduler::ParallelEach<BenchVelocity>(registry, [deltaTime](BenchVelocity& v) {
+            for (int k = 0; k < 8; ++k) {
+                v.X = v.X * (1.0f - 0.01f * deltaTime) + std::sqrt(std::abs(v.Y)) * 1e-6f;
+            }
+        });
+    }
+};
+
+class BenchHealthSystem : public System {
+public:
+    BenchHealthSystem() { Writes<BenchHealth>(); }
+    const char* GetName() const override { return "Regenerate"; }
+    void Update(Registry& registry, float deltaTime) override {
+        registry.GetView<BenchHealth>().Each([deltaTime](BenchHealth& h) {
+            for (int k = 0; k < 8; ++k) {
+                h.Value = std::min(100.0f, h.Value + std::exp(-h.Value * 0.01f) * deltaTime);
+            }
+        });
+    }
+};
+
+class BenchFrozenSystem : public System {
+public:
+    BenchFrozenSystem() { Reads<BenchPosition>(); Writes<BenchFrozen>(); }
+    const char* GetName() const override { return "Freeze"; }
+    void Update(Registry& registry, float /*deltaTime*/) override {
+        registry.GetView<BenchFrozen, BenchPosition>().Each([](BenchFrozen& f, const BenchPosition& p) {
+            f.Frames += p.X > 0.0f ? 1u : 0u;
+        });
+    }
+};
+
+void BenchmarkChangeDetection(uint32_t count, int iterations) {
+    std::printf("Change detection, %u entities, 1%% modified per frame\n", count);
+
+    Registry registry;
+    const auto entities = PopulateStorageComparison(registry, count);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<uint32_t> pick(0, count - 1);
+
+    float sink = 0.0f;
+    auto fullScan = MeasureWithSetup(iterations,
+        [&] {
+            for (uint32_t i = 0; i < count / 100; ++i) {
+                registry.GetComponent<BenchPosition>(entities[pick(rng)]).X += 1.0f;
+            }
+            return std::make_unique<int>(0);
+        },
+        [&](int&) {
+            registry.GetView<const BenchPosition, const BenchVelocity>().Each(
+                [&](const BenchPosition& p, const BenchVelocity& v) { sink += p.X * v.X; });
+        });
+
+    auto changedOnly = MeasureWithSetup(iterations,
+        [&] {
+            auto since = std::make_unique<int>(static_cast<int>(registry.GetChangeTick()));
+            registry.AdvanceChangeTick();
+            for (uint32_t i = 0; i < count / 100; ++i) {
+                registry.GetComponent<BenchPosition>(entities[pick(rng)]).X += 1.0f;
+            }
+            return since;
+        },
+        [&](int& since) {
+            registry.GetView<const BenchPosition, const BenchVelocity>()
+                .Filter<Changed<BenchPosition>>(static_cast<uint32_t>(since))
+                .Each([&](const BenchPosition& p, const BenchVelocity& v) { sink += p.X * v.X; });
+        });
+
+    std::printf("  %-28s %9.3f ms\n", "View::Each (all)", fullScan);
+    std::printf("  %-28s %9.3f ms   x%.2f\n", "Filter<Changed<T>>", changedOnly, fullScan / changedOnly);
+    if (sink == 0.0f) std::printf("  (sink %f)\n", sink);
+}
+
+void BenchmarkCommandBuffer(uint32_t count, int iterations) {
+    std::printf("Deferred structural changes, %u entities\n", count);
+
+    auto direct = MeasureWithSetup(iterations,
+        [] { return std::make_unique<Registry>(); },
+        [count](Registry& registry) {
+            registry.RegisterComponent<BenchPosition>();
+            registry.RegisterComponent<BenchVelocity>();
+            for (uint32_t i = 0; i < count; ++i) {
+                EntityID entity = registry.CreateEntity();
+                registry.AddComponent(entity, BenchPosition{});
+                registry.AddComponent(entity, BenchVelocity{});
+            }
+        });
+
+    double record = 0.0;
+    auto deferred = MeasureWithSetup(iterations,
+        [] { return std::make_unique<Registry>(); },
+        [count, &record](Registry& registry) {
+            registry.RegisterComponent<BenchPosition>();
+            registry.RegisterComponent<BenchVelocity>();
+            EntityCommandBuffer commands;
+            auto start = Clock::now();
+            for (uint32_t i = 0; i < count; ++i) {
+                EntityID entity = commands.CreateEntity();
+                commands.AddComponent(entity, BenchPosition{});
+                commands.AddComponent(entity, BenchVelocity{});
+            }
+            record = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            commands.Playback(registry);
+        });
+
+    std::printf("  %-28s %9.3f ms\n", "direct create+add", direct);
+    std::printf("  %-28s %9.3f ms (record %.3f ms)\n", "record + playback", deferred, record);
+}
+
+void BenchmarkSystemScheduler(uint32_t count, int iterations) {
+    std::printf("SystemScheduler scaling, %u entities, 4 systems\n", count);
+
+    Registry registry;
+    const auto entities = PopulateStorageComparison(registry, count);
+    for (uint32_t i = 0; i < count; i += 2) {
+        registry.AddComponent(entities[i], BenchFrozen{});
+    }
+
+    SystemScheduler scheduler;
+    scheduler.AddSystem<BenchIntegrateSystem>();
+    scheduler.AddSystem<BenchDampSystem>();
+    scheduler.AddSystem<BenchHealthSystem>();
+    scheduler.AddSystem<BenchFrozenSystem>();
+    std::printf("%s", scheduler.DescribeSchedule().c_str());
+
+    const uint32_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    double serial = 0.0;
+    for (uint32_t workers = 0; workers <= hardware; workers = workers == 0 ? 1 : workers * 2) {
+        if (workers > 0) {
+            TaskSystem::Initialize(workers);
+        }
+        const double ms = Measure(iterations, [&] { scheduler.Update(registry, 0.016f); });
+        if (workers == 0) {
+            serial = ms;
+        }
+        std::printf("  %-28s %9.3f ms   x%.2f\n",
+                    (std::to_string(workers) + " workers + caller").c_str(), ms, serial / ms);
+        if (workers > 0) {
+            TaskSystem::Shutdown();
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Log::Init();
+    // Per-frame ENGINE_TRACE lines would flood the output and land inside the timed regions
+    Log::GetCoreLogger()->SetLevel(LogLevel::Warning);
+
+    int iterations = 10;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = std::max(1, std::atoi(argv[++i]));
+        }
+    }
+
+    std::printf("=== ECS Benchmark (best of %d) ===\n", iterations);
+    BenchmarkComponentStorage(1000, iterations);
+    BenchmarkComponentStorage(LEGACY_MAX_ENTITIES, iterations);
+    BenchmarkViews(LEGACY_MAX_ENTITIES, iterations);
+    BenchmarkArchetypes(LEGACY_MAX_ENTITIES, iterations);
+    BenchmarkGetComponent(100000, iterations);
+    BenchmarkEntityLifecycle(1000000, iterations);
+    BenchmarkBatchSpawn(100000, iterations);
+    BenchmarkSnapshot(100000, iterations);
+    BenchmarkSceneFile(1000000, iterations);
+    BenchmarkHierarchy(2000, iterations);
+    BenchmarkTransformPropagation(100000, iterations);
+    BenchmarkTransformPropagation(1000000, iterations);
+    BenchmarkChangeDetection(100000, iterations);
+    BenchmarkCommandBuffer(100000, iterations);
+    BenchmarkSystemScheduler(200000, iterations);
+    return 0;
+}
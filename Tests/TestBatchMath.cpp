@@ -0,0 +1,308 @@
+/******************************************************************************
+ * File: TestBatchMath.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Batched SoA math kernels vs per-element MathTypes.h loops
+ ******************************************************************************/
+
+#include "Math/MathTypes.h"
+#include "Math/BatchMath.h"
+#include "TestHarness.h"
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+using namespace MyEngine;
+using namespace MyEngine::Test;
+
+namespace {
+
+std::mt19937 g_Rng(4321);
+
+float Random(float lo, float hi) {
+    return std::uniform_real_distribution<float>(lo, hi)(g_Rng);
+}
+
+Mat4 RandomTransform() {
+    Quat rotation = Quat(Random(-1, 1), Random(-1, 1), Random(-1, 1), Random(-1, 1)).Normalized();
+    Mat4 scale = Mat4::Scale(Vec3(Random(0.2f, 3.0f), Random(0.2f, 3.0f), Random(-3.0f, -0.2f)));
+    Mat4 translation = Mat4::Translation(Vec3(Random(-50, 50), Random(-50, 50), Random(-50, 50)));
+    return translation * rotation.ToMatrix() * scale;
+}
+
+/**
+ * @brief N elements as SoA streams plus the same data as AoS MathTypes values
+ */
+struct Vec3Data {
+    std::vector<float> x, y, z;
+    std::vector<Vec3> aos;
+
+    explicit Vec3Data(size_t count) : x(count), y(count), z(count), aos(count) {
+        for (size_t i = 0; i < count; i++) {
+            aos[i] = Vec3(Random(-10, 10), Random(-10, 10), Random(-10, 10));
+            x[i] = aos[i].x;
+            y[i] = aos[i].y;
+            z[i] = aos[i].z;
+        }
+    }
+
+    Batch::Vec3SoA View() { return { x.data(), y.data(), z.data() }; }
+};
+
+struct QuatData {
+    std::vector<float> x, y, z, w;
+    std::vector<Quat> aos;
+
+    explicit QuatData(size_t count) : x(count), y(count), z(count), w(count), aos(count) {
+        for (size_t i = 0; i < count; i++) {
+            aos[i] = Quat(Random(-1, 1), Random(-1, 1), Random(-1, 1), Random(-1, 1));
+            Set(i, aos[i]);
+        }
+    }
+
+    void Set(size_t i, const Quat& q) {
+        aos[i] = q;
+        x[i] = q.x;
+        y[i] = q.y;
+        z[i] = q.z;
+        w[i] = q.w;
+    }
+
+    Batch::QuatSoA View() { return { x.data(), y.data(), z.data(), w.data() }; }
+};
+
+// =============================================================================
+// Tests (odd count exercises the scalar tail)
+// =============================================================================
+
+void TestTransforms(size_t count) {
+    const Mat4 m = RandomTransform();
+    Vec3Data input(count);
+    Vec3Data output(count);
+
+    Batch::TransformPoints(m, input.View(), output.View(), count);
+    bool ok = true;
+    for (size_t i = 0; i < count; i++) {
+        const Vec4 r = m * Vec4(input.aos[i].x, input.aos[i].y, input.aos[i].z, 1.0f);
+        ok &= Near(output.x[i], r.x, 1e-5f) && Near(output.y[i], r.y, 1e-5f) && Near(output.z[i], r.z, 1e-5f);
+    }
+    Check(ok, "TransformPoints matches Mat4 * Vec4(p, 1)");
+
+    Batch::TransformVectors(m, input.View(), output.View(), count);
+    ok = true;
+    for (size_t i = 0; i < count; i++) {
+        const Vec4 r = m * Vec4(input.aos[i].x, input.aos[i].y, input.aos[i].z, 0.0f);
+        ok &= Near(output.x[i], r.x, 1e-5f) && Near(output.y[i], r.y, 1e-5f) && Near(output.z[i], r.z, 1e-5f);
+    }
+    Check(ok, "TransformVectors matches Mat4 * Vec4(v, 0)");
+
+    // Normals: perpendicular to transformed tangents, unit length, orientation kept
+    Batch::TransformNormals(m, input.View(), output.View(), count);
+    const Mat4 normalMatrix = m.Inverted().Transposed();
+    ok = true;
+    for (size_t i = 0; i < count; i++) {
+        const Vec4 r = normalMatrix * Vec4(input.aos[i].x, input.aos[i].y, input.aos[i].z, 0.0f);
+        const Vec3 expected = Vec3(r.x, r.y, r.z).Normalized();
+        ok &= Near(output.x[i], expected.x, 1e-4f) && Near(output.y[i], expected.y, 1e-4f) &&
+              Near(output.z[i], expected.z, 1e-4f);
+    }
+    Check(ok, "TransformNormals matches inverse-transpose");
+
+    // In place
+    Batch::TransformPoints(m, input.View(), input.View(), count);
+    ok = true;
+    for (size_t i = 0; i < count; i++) {
+        const Vec4 r = m * Vec4(input.aos[i].x, input.aos[i].y, input.aos[i].z, 1.0f);
+        ok &= Near(input.x[i], r.x, 1e-5f);
+    }
+    Check(ok, "TransformPoints in place");
+}
+
+void TestMatrices(size_t count) {
+    std::vector<Mat4> a(count), b(count), out(count);
+    for (size_t i = 0; i < count; i++) {
+        a[i] = RandomTransform();
+        b[i] = RandomTransform();
+    }
+    Batch::MulMat4(a.data(), b.data(), out.data(), count);
+    bool ok = true;
+    for (size_t i = 0; i < count; i++) {
+        ok &= std::memcmp(out[i].m, (a[i] * b[i]).m, sizeof(out[i].m)) == 0;
+    }
+    Check(ok, "MulMat4 pairs is bit-exact with operator*");
+
+    if (count == 0) {
+        return;
+    }
+    Batch::MulMat4(a[0], b.data(), out.data(), count);
+    ok = true;
+    for (size_t i = 0; i < count; i++) {
+        ok &= std::memcmp(out[i].m, (a[0] * b[i]).m, sizeof(out[i].m)) == 0;
+    }
+    Check(ok, "MulMat4 one-to-many is bit-exact with operator*");
+}
+
+void TestQuats(size_t count) {
+    QuatData a(count);
+    QuatData b(count);
+    std::vector<float> t(count);
+    for (size_t i = 0; i < count; i++) {
+        t[i] = Random(0.0f, 1.0f);
+    }
+    // Near-identical pairs (lerp path), opposite hemispheres and degenerate input
+    for (size_t i = 0; i + 3 < count; i += 7) {
+        const Quat q = a.aos[i].Normalized();
+        b.Set(i, Quat(q.x + 1e-4f, q.y, q.z, q.w));
+        b.Set(i + 1, Quat(-a.aos[i + 1].x, -a.aos[i + 1].y, -a.aos[i + 1].z, -a.aos[i + 1].w * 0.9f));
+        a.Set(i + 2, Quat(0, 0, 0, 0));
+    }
+
+    std::vector<Mat4> matrices(count);
+    Batch::QuatToMat4(a.View(), matrices.data(), count);
+    bool ok = true;
+    for (size_t i = 0; i < count; i++) {
+        const Mat4 expected = a.aos[i].ToMatrix();
+        for (int k = 0; k < 16; k++) ok &= Near(matrices[i].m[k], expected.m[k], 1e-6f);
+    }
+    Check(ok, "QuatToMat4 matches Quat::ToMatrix");
+
+    QuatData out(count);
+    Batch::Slerp(a.View(), b.View(), t.data(), out.View(), count);
+    ok = true;
+    float maxError = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        const Quat expected = Quat::Slerp(a.aos[i], b.aos[i], t[i]);
+        const float error = std::max(std::max(std::fabs(out.x[i] - expected.x), std::fabs(out.y[i] - expected.y)),
+                                     std::max(std::fabs(out.z[i] - expected.z), std::fabs(out.w[i] - expected.w)));
+        maxError = std::max(maxError, error);
+        ok &= error < 2e-5f;
+    }
+    Check(ok, "Slerp matches Quat::Slerp");
+    std::printf("  slerp max |error| %.2e\n", maxError);
+}
+
+// =============================================================================
+// Benchmarks against the per-element MathTypes.h loops
+// =============================================================================
+
+double ElapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+template<typename ScalarFunc, typename BatchFunc>
+void Compare(const char* name, int repeat, ScalarFunc scalarFunc, BatchFunc batchFunc) {
+    auto start = std::chrono::high_resolution_clock::now();
+    float scalarSink = 0.0f;
+    for (int r = 0; r < repeat; r++) scalarSink += scalarFunc();
+    const double scalarMs = ElapsedMs(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    float batchSink = 0.0f;
+    for (int r = 0; r < repeat; r++) batchSink += batchFunc();
+    const double batchMs = ElapsedMs(start);
+
+    std::printf("  %-20s MathTypes %9.3f ms   batch %9.3f ms   x%.2f   (%g %g)\n", name, scalarMs, batchMs,
+                scalarMs / batchMs, scalarSink, batchSink);
+}
+
+void RunBenchmarks() {
+    constexpr size_t COUNT = 100000;
+    constexpr int REPEAT = 20;
+    std::printf("Micro-benchmarks, %zu elements x %d, lane width %zu\n", COUNT, REPEAT, Batch::LaneWidth());
+
+    const Mat4 m = RandomTransform();
+    Vec3Data points(COUNT);
+    Vec3Data output(COUNT);
+    std::vector<Vec3> aosOutput(COUNT);
+
+    Compare("transform points", REPEAT,
+        [&] {
+            for (size_t i = 0; i < COUNT; i++) {
+                const Vec3& p = points.aos[i];
+                const Vec4 r = m * Vec4(p.x, p.y, p.z, 1.0f);
+                aosOutput[i] = Vec3(r.x, r.y, r.z);
+            }
+            return aosOutput[COUNT / 2].x;
+        },
+        [&] {
+            Batch::TransformPoints(m, points.View(), output.View(), COUNT);
+            return output.x[COUNT / 2];
+        });
+
+    const Mat4 normalMatrix = m.Inverted().Transposed();
+    Compare("transform normals", REPEAT,
+        [&] {
+            for (size_t i = 0; i < COUNT; i++) {
+                const Vec3& n = points.aos[i];
+                const Vec4 r = normalMatrix * Vec4(n.x, n.y, n.z, 0.0f);
+                aosOutput[i] = Vec3(r.x, r.y, r.z).Normalized();
+            }
+            return aosOutput[COUNT / 2].x;
+        },
+        [&] {
+            Batch::TransformNormals(m, points.View(), output.View(), COUNT);
+            return output.x[COUNT / 2];
+        });
+
+    std::vector<Mat4> a(COUNT), b(COUNT), matrices(COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        a[i] = RandomTransform();
+        b[i] = RandomTransform();
+    }
+    Compare("multiply pairs", REPEAT,
+        [&] {
+            for (size_t i = 0; i < COUNT; i++) matrices[i] = a[i] * b[i];
+            return matrices[COUNT / 2].m[5];
+        },
+        [&] {
+            Batch::MulMat4(a.data(), b.data(), matrices.data(), COUNT);
+            return matrices[COUNT / 2].m[5];
+        });
+
+    QuatData qa(COUNT);
+    QuatData qb(COUNT);
+    QuatData qOut(COUNT);
+    std::vector<Quat> aosQuats(COUNT);
+    std::vector<float> t(COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        qa.Set(i, qa.aos[i].Normalized());
+        t[i] = Random(0.0f, 1.0f);
+    }
+
+    Compare("quat to matrix", REPEAT,
+        [&] {
+            for (size_t i = 0; i < COUNT; i++) matrices[i] = qa.aos[i].ToMatrix();
+            return matrices[COUNT / 2].m[5];
+        },
+        [&] {
+            Batch::QuatToMat4(qa.View(), matrices.data(), COUNT);
+            return matrices[COUNT / 2].m[5];
+        });
+
+    Compare("slerp", REPEAT,
+        [&] {
+            for (size_t i = 0; i < COUNT; i++) aosQuats[i] = Quat::Slerp(qa.aos[i], qb.aos[i], t[i]);
+            return aosQuats[COUNT / 2].w;
+        },
+        [&] {
+            Batch::Slerp(qa.View(), qb.View(), t.data(), qOut.View(), COUNT);
+            return qOut.w[COUNT / 2];
+        });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::printf("SIMD backend: %s, batch lane width %zu\n", SIMD::BackendName(), Batch::LaneWidth());
+
+    for (size_t count : { size_t(0), size_t(1), size_t(7), size_t(1003) }) {
+        TestTransforms(count);
+        TestMatrices(count);
+        TestQuats(count);
+    }
+
+    return Test::Finish(argc, argv, RunBenchmarks);
+}
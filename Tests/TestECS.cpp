@@ -0,0 +1,317 @@
+/******************************************************************************
+ * File: TestECS.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: ECS correctness tests (hierarchy / transform propagation / scheduler / command buffers)
+ ******************************************************************************/
+
+#include "Core/Log.h"
+#include "ECS/Registry.h"
+#include "ECS/Components.h"
+#include "ECS/TransformSystem.h"
+#include "ECS/SystemScheduler.h"
+#include "ECS/RegistrySnapshot.h"
+#include "ECS/CommandBuffer.h"
+#include "Core/TaskSystem.h"
+#include "TestHarness.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace MyEngine;
+using namespace MyEngine::Test;
+
+namespace {
+
+bool NearVec(const Vec3& a, const Vec3& b) {
+    return Near(a.x, b.x, 1e-5f) && Near(a.y, b.y, 1e-5f) && Near(a.z, b.z, 1e-5f);
+}
+
+void RegisterTransformComponents(Registry& registry) {
+    registry.RegisterComponent<HierarchyComponent>();
+    registry.RegisterComponent<TransformComponent>();
+}
+
+EntityID CreateNode(Registry& registry, const Vec3& position, EntityID parent) {
+    const EntityID entity = registry.CreateEntity();
+    registry.AddComponent(entity, HierarchyComponent(parent));
+    registry.AddComponent(entity, TransformComponent(position));
+    return entity;
+}
+
+uint32_t CountChangedTransforms(Registry& registry, uint32_t sinceTick) {
+    uint32_t changed = 0;
+    registry.GetView<const TransformComponent>()
+        .Filter<Changed<TransformComponent>>(sinceTick)
+        .Each([&](EntityID, const TransformComponent&) { changed++; });
+    return changed;
+}
+
+// =============================================================================
+// Hierarchy
+// =============================================================================
+
+void TestParentOnlyChildren() {
+    // Nodes that only set HierarchyComponent::parent (no SetParent / AddToHierarchy)
+    Registry registry;
+    RegisterTransformComponents(registry);
+    TransformSystem transforms(&registry);
+
+    const EntityID root = CreateNode(registry, Vec3(10, 0, 0), NULL_ENTITY);
+    const EntityID child = CreateNode(registry, Vec3(1, 0, 0), root);
+    const EntityID grandchild = CreateNode(registry, Vec3(0, 2, 0), child);
+    transforms.Update();
+
+    Check(NearVec(transforms.GetWorldMatrix(child).GetTranslation(), Vec3(11, 0, 0)), "parent-only child inherits its parent");
+    Check(NearVec(transforms.GetWorldMatrix(grandchild).GetTranslation(), Vec3(11, 2, 0)), "parent-only grandchild inherits both");
+    Check(transforms.GetHierarchyOrdered().size() == 3, "parent-only nodes are in the hierarchy order");
+    Check(registry.GetComponent<const HierarchyComponent>(root).firstChild == child &&
+          registry.GetComponent<const HierarchyComponent>(child).firstChild == grandchild,
+          "parent-only nodes linked into the child lists");
+
+    // Linked once: later frames neither rebuild nor repropagate
+    const uint32_t since = registry.GetChangeTick();
+    registry.AdvanceChangeTick();
+    transforms.Update();
+    Check(CountChangedTransforms(registry, since) == 0, "idle frame marks no transform Changed");
+
+    // Mixed with a SetParent sibling: each child listed exactly once
+    const EntityID linked = CreateNode(registry, Vec3(0, 0, 3), NULL_ENTITY);
+    transforms.SetParent(linked, root);
+    const EntityID late = CreateNode(registry, Vec3(0, 0, 5), root);
+    transforms.Update();
+
+    uint32_t children = 0;
+    for (EntityID it = registry.GetComponent<const HierarchyComponent>(root).firstChild; it != NULL_ENTITY && children < 8;
+         it = registry.GetComponent<const HierarchyComponent>(it).nextSibling) {
+        children++;
+    }
+    Check(children == 3, "root lists every child once");
+    Check(NearVec(transforms.GetWorldMatrix(linked).GetTranslation(), Vec3(10, 0, 3)) &&
+          NearVec(transforms.GetWorldMatrix(late).GetTranslation(), Vec3(10, 0, 5)),
+          "children added after the first frame propagate");
+}
+
+void TestReparent() {
+    Registry registry;
+    RegisterTransformComponents(registry);
+    TransformSystem transforms(&registry);
+
+    const EntityID a = CreateNode(registry, Vec3(100, 0, 0), NULL_ENTITY);
+    const EntityID b = CreateNode(registry, Vec3(0, 100, 0), NULL_ENTITY);
+    const EntityID child = CreateNode(registry, Vec3(1, 1, 1), NULL_ENTITY);
+    const EntityID leaf = CreateNode(registry, Vec3(0, 0, 1), NULL_ENTITY);
+    transforms.AddToHierarchy(a);
+    transforms.AddToHierarchy(b);
+    transforms.AddToHierarchy(child, a);
+    transforms.AddToHierarchy(leaf, child);
+    transforms.Update();
+    Check(NearVec(transforms.GetWorldMatrix(leaf).GetTranslation(), Vec3(101, 1, 2)), "leaf under a");
+
+    transforms.SetParent(child, b);
+    transforms.Update();
+    Check(NearVec(transforms.GetWorldMatrix(leaf).GetTranslation(), Vec3(1, 101, 2)), "subtree follows SetParent");
+
+    // Enough other transforms that one dirty entry stays on the partial path
+    for (uint32_t i = 0; i < 32; ++i) {
+        CreateNode(registry, Vec3(0, 0, 0), NULL_ENTITY);
+    }
+    transforms.Update();
+
+    const uint32_t since = registry.GetChangeTick();
+    registry.AdvanceChangeTick();
+    transforms.SetLocalPosition(b, Vec3(0, 0, 0));
+    transforms.Update();
+    Check(NearVec(transforms.GetWorldMatrix(leaf).GetTranslation(), Vec3(1, 1, 2)), "dirty parent updates its subtree");
+    Check(CountChangedTransforms(registry, since) == 3, "only the dirty subtree is marked Changed");
+}
+
+// =============================================================================
+// Transform pool churn (layout log patching)
+// =============================================================================
+
+template<typename T>
+bool Has(Registry& registry, EntityID entity) {
+    return registry.GetComponentStorage<T>()->HasData(entity);
+}
+
+// World of an entity from the HierarchyComponent links; nodes without a transform pass their parent's through
+Mat4 ExpectedWorld(Registry& registry, EntityID entity) {
+    Mat4 world;
+    for (EntityID node = entity; node != NULL_ENTITY;) {
+        if (Has<TransformComponent>(registry, node)) {
+            world = registry.GetComponent<const TransformComponent>(node).localMatrix.ToMat4() * world;
+        }
+        node = Has<HierarchyComponent>(registry, node) ? registry.GetComponent<const HierarchyComponent>(node).parent
+                                                       : NULL_ENTITY;
+    }
+    return world;
+}
+
+bool WorldsMatch(Registry& registry) {
+    bool ok = true;
+    registry.GetView<const TransformComponent>().Each([&](EntityID entity, const TransformComponent& transform) {
+        const Mat4 expected = ExpectedWorld(registry, entity);
+        const Mat4 actual = transform.worldMatrix.ToMat4();
+        for (int i = 0; i < 16; ++i) {
+            ok &= Near(actual.m[i], expected.m[i], 1e-4f);
+        }
+    });
+    return ok;
+}
+
+void TestPoolChurn() {
+    Registry registry;
+    RegisterTransformComponents(registry);
+    TransformSystem transforms(&registry);
+    std::mt19937 rng(99);
+    auto randomPosition = [&rng] {
+        return Vec3(static_cast<float>(rng() % 21) - 10.0f, static_cast<float>(rng() % 21) - 10.0f, 1.0f);
+    };
+
+    std::vector<EntityID> nodes;
+    for (uint32_t i = 0; i < 300; ++i) {
+        nodes.push_back(CreateNode(registry, randomPosition(), NULL_ENTITY));
+        transforms.AddToHierarchy(nodes.back(), i == 0 ? NULL_ENTITY : nodes[rng() % i]);
+    }
+    std::vector<EntityID> loose;
+    transforms.Update();
+    Check(WorldsMatch(registry), "initial propagation");
+
+    // Each frame: spawn / destroy loose transforms, drop and re-add transforms of hierarchy
+    // nodes, move a few nodes; none of it touches the hierarchy order
+    bool ok = true;
+    uint32_t idleFramesChanged = 0;
+    for (int frame = 0; frame < 200; ++frame) {
+        for (uint32_t k = rng() % 4; k > 0; --k) {
+            const EntityID entity = registry.CreateEntity();
+            registry.AddComponent(entity, TransformComponent(randomPosition()));
+            loose.push_back(entity);
+        }
+        for (uint32_t k = rng() % 3; k > 0 && !loose.empty(); --k) {
+            const size_t pick = rng() % loose.size();
+            registry.DestroyEntity(loose[pick]);
+            loose[pick] = loose.back();
+            loose.pop_back();
+        }
+        const EntityID node = nodes[rng() % nodes.size()];
+        if (Has<TransformComponent>(registry, node)) {
+            registry.RemoveComponent<TransformComponent>(node);
+        } else {
+            registry.AddComponent(node, TransformComponent(randomPosition()));
+        }
+        transforms.SetLocalPosition(nodes[rng() % nodes.size()], randomPosition());
+        transforms.Update();
+        ok &= WorldsMatch(registry);
+
+        // Nothing moved: the next frame updates nothing
+        const uint32_t since = registry.GetChangeTick();
+        registry.AdvanceChangeTick();
+        transforms.Update();
+        idleFramesChanged += CountChangedTransforms(registry, since);
+    }
+    Check(ok, "world matrices correct under pool churn");
+    Check(idleFramesChanged == 0, "churn frames leave nothing pending");
+}
+
+// =============================================================================
+// Parallel stages
+// =============================================================================
+
+struct Speed { float value = 0.0f; };
+struct Health { float value = 0.0f; };
+
+class SpeedSystem : public System {
+public:
+    SpeedSystem() { Writes<Speed>(); }
+    void Update(Registry& registry, float) override {
+        registry.GetView<Speed>().Each([](EntityID, Speed& speed) { speed.value += 1.0f; });
+    }
+};
+
+class HealthSystem : public System {
+public:
+    HealthSystem() { Writes<Health>(); }
+    void Update(Registry& registry, float) override {
+        registry.GetView<Health>().Each([](EntityID, Health& health) { health.value -= 1.0f; });
+    }
+};
+
+void TestParallelStageWithSnapshot() {
+    Registry registry;
+    registry.RegisterComponent<Speed>();
+    registry.RegisterComponent<Health>();
+    for (uint32_t i = 0; i < 1000; ++i) {
+        const EntityID entity = registry.CreateEntity();
+        registry.AddComponent(entity, Speed{ 1.0f });
+        registry.AddComponent(entity, Health{ 10.0f });
+    }
+
+    // Pools shared with the snapshot; both systems' first queries are created inside the stage
+    RegistrySnapshot snapshot;
+    snapshot.Capture(registry, RegistrySnapshot::Mode::CopyOnWrite);
+    SystemScheduler scheduler;
+    scheduler.AddSystem<SpeedSystem>();
+    scheduler.AddSystem<HealthSystem>();
+    for (int frame = 0; frame < 3; ++frame) {
+        scheduler.Update(registry, 0.016f);
+    }
+
+    bool ok = true;
+    registry.GetView<const Speed, const Health>().Each([&](EntityID, const Speed& speed, const Health& health) {
+        ok &= speed.value == 4.0f && health.value == 7.0f;
+    });
+    Check(ok, "parallel stage writes every entity");
+
+    snapshot.Restore(registry);
+    registry.GetView<const Speed, const Health>().Each([&](EntityID, const Speed& speed, const Health& health) {
+        ok &= speed.value == 1.0f && health.value == 10.0f;
+    });
+    Check(ok, "snapshot keeps the values from before the parallel stage");
+}
+
+// =============================================================================
+// Command buffers
+// =============================================================================
+
+void TestCommandSortedBeforeCreate() {
+    Registry registry;
+    registry.RegisterComponent<Speed>();
+
+    // As if another thread's system (lower key) used the placeholder: sorting puts its
+    // AddComponent ahead of the CreateEntity
+    EntityCommandBuffer commands;
+    EntityID placeholder = NULL_ENTITY;
+    {
+        CommandSortKey::Scope key(5);
+        placeholder = commands.CreateEntity();
+    }
+    {
+        CommandSortKey::Scope key(1);
+        commands.AddComponent(placeholder, Speed{ 3.0f });
+    }
+    commands.Playback(registry);
+
+    const EntityID entity = commands.Resolve(placeholder);
+    Check(registry.IsValid(entity), "placeholder resolved");
+    Check(registry.IsValid(entity) && Has<Speed>(registry, entity) && registry.GetComponent<const Speed>(entity).value == 3.0f,
+          "command sorted before its CreateEntity still applies");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Log::Init();
+
+    TestParentOnlyChildren();
+    TestReparent();
+    TestPoolChurn();
+
+    TaskSystem::Initialize(4);
+    TestParallelStageWithSnapshot();
+    TaskSystem::Shutdown();
+
+    TestCommandSortedBeforeCreate();
+
+    return Test::Finish(argc, argv, [] {});
+}
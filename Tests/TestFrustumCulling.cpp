@@ -0,0 +1,203 @@
+/******************************************************************************
+ * File: TestFrustumCulling.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Bounding volume / frustum tests and batched culling benchmark
+ ******************************************************************************/
+
+#include "Math/MathTypes.h"
+#include "Math/Bounds.h"
+#include "Math/Frustum.h"
+#include "TestHarness.h"
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+using namespace MyEngine;
+using namespace MyEngine::Test;
+
+namespace {
+
+std::mt19937 g_Rng(777);
+
+float Random(float lo, float hi) {
+    return std::uniform_real_distribution<float>(lo, hi)(g_Rng);
+}
+
+Mat4 MakeViewProjection() {
+    const Mat4 projection = Mat4::Perspective(1.0f, 16.0f / 9.0f, 0.1f, 500.0f);
+    const Mat4 camera = Mat4::Translation(Vec3(0, 5, 20)) * Mat4::Rotation(0.4f, Vec3(0, 1, 0));
+    return projection * camera.Inverted();
+}
+
+// Clip-space test of a point
+bool InsideClip(const Mat4& viewProjection, const Vec3& p) {
+    const Vec4 clip = viewProjection * Vec4(p.x, p.y, p.z, 1.0f);
+    return clip.w > 0 && std::fabs(clip.x) <= clip.w && std::fabs(clip.y) <= clip.w && std::fabs(clip.z) <= clip.w;
+}
+
+void TestBounds() {
+    std::printf("Bounds\n");
+    std::vector<Vec3> points;
+    for (int i = 0; i < 200; i++) points.push_back(Vec3(Random(-1, 3), Random(-2, 2), Random(0, 5)));
+    const AABB box = AABB::FromPoints(points.data(), points.size());
+    const BoundingSphere sphere = BoundingSphere::FromPoints(box.GetCenter(), points.data(), points.size());
+
+    const Mat3x4 world = Mat3x4::FromTRS(Vec3(10, -3, 7), Quat(0.3f, -0.5f, 0.2f, 0.8f), Vec3(2.0f, 0.5f, 1.5f));
+    const AABB worldBox = box.Transformed(world);
+    const BoundingSphere worldSphere = sphere.Transformed(world);
+
+    bool inside = true;
+    for (const Vec3& p : points) {
+        const Vec3 w = world.TransformPoint(p);
+        inside &= w.x >= worldBox.min.x - 1e-4f && w.x <= worldBox.max.x + 1e-4f;
+        inside &= w.y >= worldBox.min.y - 1e-4f && w.y <= worldBox.max.y + 1e-4f;
+        inside &= w.z >= worldBox.min.z - 1e-4f && w.z <= worldBox.max.z + 1e-4f;
+        const Vec3 offset = w - worldSphere.center;
+        inside &= std::sqrt(Vec3::Dot(offset, offset)) <= worldSphere.radius + 1e-4f;
+    }
+    Check(inside, "transformed AABB and sphere contain all transformed points");
+    Check(!AABB().IsValid() && box.IsValid(), "empty AABB is invalid");
+
+    // Strided read (mesh vertices)
+    struct Vertex { Vec3 position; float pad[5]; };
+    std::vector<Vertex> vertices(points.size());
+    for (size_t i = 0; i < points.size(); i++) vertices[i].position = points[i];
+    const AABB strided = AABB::FromPoints(&vertices[0].position, vertices.size(), sizeof(Vertex));
+    Check(std::memcmp(&strided, &box, sizeof(AABB)) == 0, "strided FromPoints");
+}
+
+void TestFrustum() {
+    std::printf("Frustum\n");
+    const Mat4 viewProjection = MakeViewProjection();
+    const Frustum frustum = Frustum::FromViewProjection(viewProjection);
+
+    // Planes agree with the clip-space test for points
+    bool agree = true;
+    for (int i = 0; i < 20000; i++) {
+        const Vec3 p(Random(-300, 300), Random(-100, 100), Random(-500, 100));
+        bool planesInside = true;
+        for (int k = 0; k < Frustum::PlaneCount; k++) planesInside &= frustum.Distance(k, p) >= 0.0f;
+        if (planesInside != InsideClip(viewProjection, p)) {
+            // Allow disagreement only right on a plane (rounding grows with depth: far plane / FMA)
+            float closest = 1e30f;
+            for (int k = 0; k < Frustum::PlaneCount; k++) closest = std::fmin(closest, std::fabs(frustum.Distance(k, p)));
+            agree &= closest < 1e-4f * (1.0f + std::sqrt(Vec3::Dot(p, p)));
+        }
+    }
+    Check(agree, "frustum planes match clip-space containment");
+
+    // A box around a visible point is never culled; far-away boxes are
+    Check(frustum.Intersects(AABB(Vec3(-1, 4, 0), Vec3(1, 6, 2))), "box in front of the camera is visible");
+    Check(!frustum.Intersects(AABB(Vec3(-1, 4, 100), Vec3(1, 6, 102))), "box behind the camera is culled");
+    Check(!frustum.Intersects(BoundingSphere(Vec3(0, 5, 1000), 5.0f)), "sphere beyond far plane is culled");
+}
+
+/**
+ * @brief Random world bounds as SoA streams + reference objects
+ */
+struct BoundsData {
+    std::vector<float> cx, cy, cz, ex, ey, ez, r;
+    std::vector<AABB> boxes;
+    std::vector<BoundingSphere> spheres;
+
+    explicit BoundsData(size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            const Vec3 center(Random(-400, 400), Random(-50, 60), Random(-600, 100));
+            const Vec3 extents(Random(0.1f, 8), Random(0.1f, 8), Random(0.1f, 8));
+            const float radius = std::sqrt(Vec3::Dot(extents, extents)) * Random(0.6f, 1.0f);
+            cx.push_back(center.x); cy.push_back(center.y); cz.push_back(center.z);
+            ex.push_back(extents.x); ey.push_back(extents.y); ez.push_back(extents.z);
+            r.push_back(radius);
+            boxes.push_back(AABB(center - extents, center + extents));
+            spheres.push_back(BoundingSphere(center, radius));
+        }
+    }
+
+    BoundsSoA View() const {
+        return { cx.data(), cy.data(), cz.data(), ex.data(), ey.data(), ez.data(), r.data() };
+    }
+};
+
+// Same rule as Frustum::Cull, one element at a time
+bool ReferenceVisible(const Frustum& frustum, const AABB& box, const BoundingSphere& sphere) {
+    const Vec3 extents = box.GetExtents();
+    for (int k = 0; k < Frustum::PlaneCount; k++) {
+        const Vec4& p = frustum.planes[k];
+        const float boxReach = std::fabs(p.x) * extents.x + std::fabs(p.y) * extents.y + std::fabs(p.z) * extents.z;
+        if (frustum.Distance(k, box.GetCenter()) + std::fmin(sphere.radius, boxReach) < 0.0f) return false;
+    }
+    return true;
+}
+
+void TestCull() {
+    std::printf("Frustum::Cull\n");
+    const Frustum frustum = Frustum::FromViewProjection(MakeViewProjection());
+    for (size_t count : { size_t(0), size_t(5), size_t(8), size_t(13), size_t(10007) }) {
+        BoundsData data(count);
+        std::vector<uint32_t> visible(count);
+        const size_t written = frustum.Cull(data.View(), count, 100, visible.data());
+
+        std::vector<uint32_t> expected;
+        bool conservative = true;
+        for (size_t i = 0; i < count; i++) {
+            if (ReferenceVisible(frustum, data.boxes[i], data.spheres[i])) {
+                expected.push_back(static_cast<uint32_t>(100 + i));
+            }
+            // Never cull something either plain test keeps
+            if (frustum.Intersects(data.boxes[i]) && frustum.Intersects(data.spheres[i])) {
+                conservative &= ReferenceVisible(frustum, data.boxes[i], data.spheres[i]);
+            }
+        }
+        Check(written == expected.size() && std::equal(expected.begin(), expected.end(), visible.begin()),
+              "Cull matches the per-element reference (indices in order)");
+        Check(conservative, "Cull keeps everything both box and sphere tests keep");
+        if (count > 1000) {
+            std::printf("  %zu bounds: %zu visible\n", count, written);
+        }
+    }
+}
+
+void RunBenchmark() {
+    constexpr size_t COUNT = 100000;
+    constexpr int REPEAT = 50;
+    const Frustum frustum = Frustum::FromViewProjection(MakeViewProjection());
+    BoundsData data(COUNT);
+    std::vector<uint32_t> visible(COUNT);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t scalarVisible = 0;
+    for (int r = 0; r < REPEAT; r++) {
+        scalarVisible = 0;
+        for (size_t i = 0; i < COUNT; i++) {
+            if (frustum.Intersects(data.boxes[i])) visible[scalarVisible++] = static_cast<uint32_t>(i);
+        }
+    }
+    const double scalarMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / REPEAT;
+
+    start = std::chrono::high_resolution_clock::now();
+    size_t batchVisible = 0;
+    for (int r = 0; r < REPEAT; r++) {
+        batchVisible = frustum.Cull(data.View(), COUNT, 0, visible.data());
+    }
+    const double batchMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / REPEAT;
+
+    std::printf("Cull %zu bounds (lane width %zu)\n", COUNT, Batch::LaneWidth());
+    std::printf("  %-28s %9.3f ms  (%zu visible)\n", "AABB loop (Intersects)", scalarMs, scalarVisible);
+    std::printf("  %-28s %9.3f ms  (%zu visible)   x%.2f\n", "Frustum::Cull (SoA)", batchMs, batchVisible, scalarMs / batchMs);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::printf("SIMD backend: %s\n", SIMD::BackendName());
+
+    TestBounds();
+    TestFrustum();
+    TestCull();
+
+    return Test::Finish(argc, argv, RunBenchmark);
+}
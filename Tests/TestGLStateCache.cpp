@@ -0,0 +1,503 @@
+/******************************************************************************
+ * File: TestGLStateCache.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: GLStateCache tests against a mock GL (glad function pointers)
+ ******************************************************************************/
+
+#define GLAD_GL_IMPLEMENTATION
+#include <glad/gl.h>
+
+#include "Rendering/OpenGL/GLStateCache.h"
+#include "TestHarness.h"
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <random>
+#include <utility>
+
+using namespace MyEngine;
+using namespace MyEngine::Test;
+
+namespace {
+
+std::mt19937 g_Rng(1357);
+
+uint32_t RandomInt(uint32_t lo, uint32_t hi) {
+    return std::uniform_int_distribution<uint32_t>(lo, hi)(g_Rng);
+}
+
+// ============================================================================
+// Mock GL: the driver-side state the calls produce
+// ============================================================================
+
+struct MockGL {
+    GLuint program = 0;
+    GLuint vertexArray = 0;
+    std::map<GLenum, GLuint> buffers;                         // Context bindings (not ELEMENT_ARRAY)
+    std::map<GLuint, GLuint> elementBuffers;                  // Per VAO
+    std::map<GLuint, GLuint> uniformBindings;                 // Indexed GL_UNIFORM_BUFFER points
+    GLuint activeUnit = 0;
+    std::map<std::pair<GLuint, GLenum>, GLuint> textures;     // (unit, target)
+    std::map<GLenum, bool> capabilities;
+    GLenum blendSrc = GL_ONE;
+    GLenum blendDst = GL_ZERO;
+    GLenum depthFunc = GL_LESS;
+    bool depthMask = true;
+    GLenum cullFace = GL_BACK;
+    GLenum polygonMode = GL_FILL;
+
+    bool operator==(const MockGL& other) const = default;
+};
+
+MockGL* g_Target = nullptr;
+uint32_t g_Calls = 0;
+uint32_t g_Queries = 0;
+
+void GLAD_API_PTR MockUseProgram(GLuint program) { g_Calls++; g_Target->program = program; }
+void GLAD_API_PTR MockBindVertexArray(GLuint vertexArray) { g_Calls++; g_Target->vertexArray = vertexArray; }
+
+void GLAD_API_PTR MockBindBuffer(GLenum target, GLuint buffer) {
+    g_Calls++;
+    if (target == GL_ELEMENT_ARRAY_BUFFER) {
+        g_Target->elementBuffers[g_Target->vertexArray] = buffer;
+    } else {
+        g_Target->buffers[target] = buffer;
+    }
+}
+
+void GLAD_API_PTR MockBindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    g_Calls++;
+    g_Target->uniformBindings[index] = buffer;
+    g_Target->buffers[target] = buffer;
+}
+
+void GLAD_API_PTR MockActiveTexture(GLenum unit) { g_Calls++; g_Target->activeUnit = unit - GL_TEXTURE0; }
+
+void GLAD_API_PTR MockBindTexture(GLenum target, GLuint texture) {
+    g_Calls++;
+    g_Target->textures[{ g_Target->activeUnit, target }] = texture;
+}
+
+void GLAD_API_PTR MockEnable(GLenum capability) { g_Calls++; g_Target->capabilities[capability] = true; }
+void GLAD_API_PTR MockDisable(GLenum capability) { g_Calls++; g_Target->capabilities[capability] = false; }
+void GLAD_API_PTR MockBlendFunc(GLenum src, GLenum dst) { g_Calls++; g_Target->blendSrc = src; g_Target->blendDst = dst; }
+void GLAD_API_PTR MockDepthFunc(GLenum func) { g_Calls++; g_Target->depthFunc = func; }
+void GLAD_API_PTR MockDepthMask(GLboolean flag) { g_Calls++; g_Target->depthMask = flag == GL_TRUE; }
+void GLAD_API_PTR MockCullFace(GLenum face) { g_Calls++; g_Target->cullFace = face; }
+void GLAD_API_PTR MockPolygonMode(GLenum, GLenum mode) { g_Calls++; g_Target->polygonMode = mode; }
+
+// Deleting a bound object reverts its bindings to 0 in the current context
+void GLAD_API_PTR MockDeleteTextures(GLsizei count, const GLuint* textures) {
+    g_Calls++;
+    for (GLsizei i = 0; i < count; i++) {
+        for (auto& [slot, bound] : g_Target->textures) {
+            if (bound == textures[i]) bound = 0;
+        }
+    }
+}
+
+void GLAD_API_PTR MockDeleteBuffers(GLsizei count, const GLuint* buffers) {
+    g_Calls++;
+    for (GLsizei i = 0; i < count; i++) {
+        for (auto& [target, bound] : g_Target->buffers) {
+            if (bound == buffers[i]) bound = 0;
+        }
+        for (auto& [index, bound] : g_Target->uniformBindings) {
+            if (bound == buffers[i]) bound = 0;
+        }
+        GLuint& element = g_Target->elementBuffers[g_Target->vertexArray];
+        if (element == buffers[i]) element = 0;
+    }
+}
+
+void GLAD_API_PTR MockDeleteVertexArrays(GLsizei count, const GLuint* vertexArrays) {
+    g_Calls++;
+    for (GLsizei i = 0; i < count; i++) {
+        g_Target->elementBuffers.erase(vertexArrays[i]);
+        if (g_Target->vertexArray == vertexArrays[i]) g_Target->vertexArray = 0;
+    }
+}
+
+GLboolean GLAD_API_PTR MockIsEnabled(GLenum) { g_Queries++; return GL_FALSE; }
+void GLAD_API_PTR MockGetIntegerv(GLenum, GLint* data) { g_Queries++; *data = 0; }
+void GLAD_API_PTR MockGetBooleanv(GLenum, GLboolean* data) { g_Queries++; *data = GL_FALSE; }
+
+void InstallMockGL() {
+    glad_glUseProgram = MockUseProgram;
+    glad_glBindVertexArray = MockBindVertexArray;
+    glad_glBindBuffer = MockBindBuffer;
+    glad_glBindBufferBase = MockBindBufferBase;
+    glad_glActiveTexture = MockActiveTexture;
+    glad_glBindTexture = MockBindTexture;
+    glad_glEnable = MockEnable;
+    glad_glDisable = MockDisable;
+    glad_glBlendFunc = MockBlendFunc;
+    glad_glDepthFunc = MockDepthFunc;
+    glad_glDepthMask = MockDepthMask;
+    glad_glCullFace = MockCullFace;
+    glad_glPolygonMode = MockPolygonMode;
+    glad_glDeleteTextures = MockDeleteTextures;
+    glad_glDeleteBuffers = MockDeleteBuffers;
+    glad_glDeleteVertexArrays = MockDeleteVertexArrays;
+    glad_glIsEnabled = MockIsEnabled;
+    glad_glGetIntegerv = MockGetIntegerv;
+    glad_glGetBooleanv = MockGetBooleanv;
+}
+
+/**
+ * @brief Start both the cached GPU model and the reference model from GLStateCache::Reset
+ */
+void ResetModels(MockGL& gpu, MockGL& reference) {
+    gpu = MockGL();
+    g_Target = &gpu;
+    GLStateCache::Reset();
+    reference = gpu;
+    g_Calls = 0;
+}
+
+// ============================================================================
+// Random operations: once through the cache, once straight to GL
+// ============================================================================
+
+constexpr GLenum BUFFER_TARGETS[] = { GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_UNIFORM_BUFFER };
+constexpr GLenum TEXTURE_TARGETS[] = { GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP };
+constexpr GLenum CAPABILITIES[] = { GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE, GL_PROGRAM_POINT_SIZE };   // Last one untracked
+constexpr GLenum BLEND_FACTORS[][2] = { { GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA }, { GL_SRC_ALPHA, GL_ONE }, { GL_DST_COLOR, GL_ZERO } };
+constexpr GLenum DEPTH_FUNCS[] = { GL_LESS, GL_LEQUAL, GL_ALWAYS };
+
+struct Operation {
+    uint32_t kind;
+    uint32_t a, b, c;
+};
+
+constexpr uint32_t OPERATION_KINDS = 15;
+
+Operation RandomOperation(bool allowDelete) {
+    Operation op{ RandomInt(0, allowDelete ? OPERATION_KINDS - 1 : OPERATION_KINDS - 4), RandomInt(0, 3), RandomInt(0, 3), RandomInt(0, 2) };
+    return op;
+}
+
+void Apply(const Operation& op, bool cached) {
+    switch (op.kind) {
+        case 0:
+            cached ? GLStateCache::UseProgram(op.a) : glUseProgram(op.a);
+            break;
+        case 1:
+            cached ? GLStateCache::BindVertexArray(op.a) : glBindVertexArray(op.a);
+            break;
+        case 2:
+            cached ? GLStateCache::BindBuffer(BUFFER_TARGETS[op.c], op.a) : glBindBuffer(BUFFER_TARGETS[op.c], op.a);
+            break;
+        case 3:
+            cached ? GLStateCache::ActiveTexture(op.a) : glActiveTexture(GL_TEXTURE0 + op.a);
+            break;
+        case 4:
+            cached ? GLStateCache::BindTexture(TEXTURE_TARGETS[op.c % 2], op.a) : glBindTexture(TEXTURE_TARGETS[op.c % 2], op.a);
+            break;
+        case 5:
+            if (cached) {
+                GLStateCache::BindTexture(op.b, TEXTURE_TARGETS[op.c % 2], op.a);
+            } else {
+                glActiveTexture(GL_TEXTURE0 + op.b);
+                glBindTexture(TEXTURE_TARGETS[op.c % 2], op.a);
+            }
+            break;
+        case 6:
+            if (cached) {
+                GLStateCache::SetEnabled(CAPABILITIES[op.a], op.b & 1);
+            } else if (op.b & 1) {
+                glEnable(CAPABILITIES[op.a]);
+            } else {
+                glDisable(CAPABILITIES[op.a]);
+            }
+            break;
+        case 7:
+            cached ? GLStateCache::BlendFunc(BLEND_FACTORS[op.c][0], BLEND_FACTORS[op.c][1])
+                   : glBlendFunc(BLEND_FACTORS[op.c][0], BLEND_FACTORS[op.c][1]);
+            break;
+        case 8:
+            cached ? GLStateCache::DepthFunc(DEPTH_FUNCS[op.c]) : glDepthFunc(DEPTH_FUNCS[op.c]);
+            break;
+        case 9:
+            cached ? GLStateCache::DepthMask(op.a & 1) : glDepthMask((op.a & 1) ? GL_TRUE : GL_FALSE);
+            break;
+        case 10:
+            if (cached) {
+                GLStateCache::CullFace((op.a & 1) ? GL_FRONT : GL_BACK);
+                GLStateCache::PolygonMode((op.b & 1) ? GL_LINE : GL_FILL);
+            } else {
+                glCullFace((op.a & 1) ? GL_FRONT : GL_BACK);
+                glPolygonMode(GL_FRONT_AND_BACK, (op.b & 1) ? GL_LINE : GL_FILL);
+            }
+            break;
+        case 11:
+            cached ? GLStateCache::BindBufferBase(GL_UNIFORM_BUFFER, op.b, op.a) : glBindBufferBase(GL_UNIFORM_BUFFER, op.b, op.a);
+            break;
+        // Deletions (names are reused by later binds, like glGen* after glDelete*)
+        case 12: {
+            const GLuint name = op.a + 1;
+            cached ? GLStateCache::DeleteTexture(name) : glDeleteTextures(1, &name);
+            break;
+        }
+        case 13: {
+            const GLuint name = op.a + 1;
+            cached ? GLStateCache::DeleteBuffer(name) : glDeleteBuffers(1, &name);
+            break;
+        }
+        case 14: {
+            const GLuint name = op.a + 1;
+            cached ? GLStateCache::DeleteVertexArray(name) : glDeleteVertexArrays(1, &name);
+            break;
+        }
+    }
+}
+
+void TestEquivalence() {
+    std::printf("Cached calls leave GL in the same state as direct calls\n");
+    MockGL gpu, reference;
+    ResetModels(gpu, reference);
+    GLStateCache::ResetStats();
+
+    constexpr int OPERATIONS = 200000;
+    uint32_t cachedCalls = 0, directCalls = 0, deletions = 0;
+    bool same = true;
+    for (int i = 0; i < OPERATIONS; i++) {
+        const Operation op = RandomOperation(true);
+        if (op.kind >= OPERATION_KINDS - 3) deletions++;
+
+        g_Target = &gpu;
+        g_Calls = 0;
+        Apply(op, true);
+        cachedCalls += g_Calls;
+
+        g_Target = &reference;
+        g_Calls = 0;
+        Apply(op, false);
+        directCalls += g_Calls;
+
+        if (!(gpu == reference)) {
+            same = false;
+            std::printf("  diverged at operation %d (kind %u)\n", i, op.kind);
+            break;
+        }
+    }
+    Check(same, "GL state identical after every operation");
+    Check(cachedCalls < directCalls, "cache issues fewer calls");
+
+    const GLStateStats& stats = GLStateCache::GetStats();
+    // Every issued call reached the mock (deletions are not state calls)
+    Check(stats.TotalIssued() + deletions == cachedCalls, "issued counter matches mock calls");
+    Check(stats.TotalSkipped() > 0, "skipped counter counts redundant calls");
+    Check(g_Queries == 0, "no glGet / glIsEnabled");
+    std::printf("  %d operations: %u direct GL calls, %u through the cache (%u skipped)\n",
+                OPERATIONS, directCalls, cachedCalls, stats.TotalSkipped());
+}
+
+void TestCounters() {
+    std::printf("Issued / skipped counters\n");
+    MockGL gpu, reference;
+    ResetModels(gpu, reference);
+    GLStateCache::ResetStats();
+
+    GLStateCache::Enable(GL_DEPTH_TEST);          // Reset enabled it already
+    GLStateCache::Disable(GL_DEPTH_TEST);
+    GLStateCache::Disable(GL_DEPTH_TEST);
+    GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLStateCache::UseProgram(7);
+    GLStateCache::UseProgram(7);
+    GLStateCache::Enable(GL_PROGRAM_POINT_SIZE);  // Untracked: always issued
+    GLStateCache::Enable(GL_PROGRAM_POINT_SIZE);
+
+    const GLStateStats& stats = GLStateCache::GetStats();
+    Check(stats.GetIssued(GLStateCall::Capability) == 3 && stats.GetSkipped(GLStateCall::Capability) == 2, "capability counters");
+    Check(stats.GetIssued(GLStateCall::BlendFunc) == 0 && stats.GetSkipped(GLStateCall::BlendFunc) == 1, "blend counters");
+    Check(stats.GetIssued(GLStateCall::Program) == 1 && stats.GetSkipped(GLStateCall::Program) == 1, "program counters");
+    Check(stats.TotalIssued() == g_Calls, "issued total equals mock GL calls");
+
+    // Element buffer binding belongs to the VAO
+    GLStateCache::BindVertexArray(1);
+    GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 5);
+    GLStateCache::BindVertexArray(2);
+    const uint32_t before = g_Calls;
+    GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 5);
+    Check(g_Calls == before + 1 && gpu.elementBuffers[2] == 5, "element buffer rebound after VAO change");
+
+    // A deleted name can come back as a new object
+    GLStateCache::BindTexture(3, GL_TEXTURE_2D, 9);
+    GLStateCache::DeleteTexture(9);
+    GLStateCache::BindTexture(3, GL_TEXTURE_2D, 9);
+    Check((gpu.textures[{ 3, GL_TEXTURE_2D }] == 9), "texture rebound after its name was deleted");
+
+    // Invalidate: next set always reaches GL
+    GLStateCache::Invalidate();
+    const uint32_t beforeInvalidate = g_Calls;
+    GLStateCache::UseProgram(7);
+    Check(g_Calls == beforeInvalidate + 1, "call issued after Invalidate");
+}
+
+void TestCaptureRestore() {
+    std::printf("Capture / Restore without queries\n");
+    MockGL gpu, reference;
+    bool restored = true;
+    for (int round = 0; round < 2000; round++) {
+        ResetModels(gpu, reference);
+        g_Target = &gpu;
+        for (int i = 0; i < 20; i++) Apply(RandomOperation(false), true);
+
+        const GLStateCache::State saved = GLStateCache::Capture();
+        MockGL expected = gpu;
+        const bool elementKnown = saved.buffers[1] != GLStateCache::UNKNOWN;
+
+        for (int i = 0; i < 20; i++) Apply(RandomOperation(false), true);
+        GLStateCache::Restore(saved);
+
+        if (!elementKnown) {
+            // Restore cannot know an element binding it never saw
+            expected.elementBuffers = gpu.elementBuffers;
+        }
+        // Indexed uniform bindings never set before the capture are unknown to Restore
+        for (auto& [index, buffer] : gpu.uniformBindings) {
+            if (saved.uniformBuffers[index] == GLStateCache::UNKNOWN) expected.uniformBindings[index] = buffer;
+        }
+        // Untracked capabilities are outside the shadow state
+        expected.capabilities[GL_PROGRAM_POINT_SIZE] = gpu.capabilities[GL_PROGRAM_POINT_SIZE];
+        // Element bindings of other VAOs are not context state
+        for (auto& [vertexArray, buffer] : gpu.elementBuffers) {
+            if (vertexArray != expected.vertexArray) expected.elementBuffers[vertexArray] = buffer;
+        }
+        restored &= gpu == expected;
+    }
+    Check(restored, "Restore brings back the captured state");
+
+    // Partial restore leaves the other groups alone
+    ResetModels(gpu, reference);
+    const GLStateCache::State saved = GLStateCache::Capture();
+    GLStateCache::UseProgram(4);
+    GLStateCache::Disable(GL_BLEND);
+    GLStateCache::DepthMask(false);
+    GLStateCache::Restore(saved, GLStateCache::RESTORE_FIXED_FUNCTION);
+    Check(gpu.program == 4 && gpu.capabilities[GL_BLEND] && gpu.depthMask, "RESTORE_FIXED_FUNCTION keeps bindings");
+
+    // Restoring an unchanged state issues nothing
+    const uint32_t before = g_Calls;
+    GLStateCache::Restore(GLStateCache::Capture());
+    Check(g_Calls == before, "Restore of the current state is free");
+    Check(g_Queries == 0, "no glGet / glIsEnabled");
+}
+
+/**
+ * @brief Same GL sequence as the editor passes (sky, terrain, geometry, water, grass, particles, post)
+ */
+void SimulateFrame(uint32_t draws) {
+    // Sky
+    GLStateCache::State saved = GLStateCache::Capture();
+    GLStateCache::Disable(GL_CULL_FACE);
+    GLStateCache::DepthMask(false);
+    GLStateCache::DepthFunc(GL_LEQUAL);
+    GLStateCache::UseProgram(1);
+    GLStateCache::BindVertexArray(1);
+    GLStateCache::Restore(saved, GLStateCache::RESTORE_FIXED_FUNCTION);
+
+    // Terrain
+    GLStateCache::Enable(GL_DEPTH_TEST);
+    GLStateCache::DepthFunc(GL_LESS);
+    GLStateCache::Enable(GL_CULL_FACE);
+    GLStateCache::CullFace(GL_BACK);
+    GLStateCache::PolygonMode(GL_FILL);
+    GLStateCache::UseProgram(2);
+    GLStateCache::BindVertexArray(2);
+    GLStateCache::PolygonMode(GL_FILL);
+
+    // Geometry: setup state, then draws sorted by shader
+    GLStateCache::Enable(GL_DEPTH_TEST);
+    GLStateCache::DepthFunc(GL_LESS);
+    GLStateCache::DepthMask(true);
+    GLStateCache::Disable(GL_CULL_FACE);
+    GLStateCache::Enable(GL_BLEND);
+    GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLStateCache::PolygonMode(GL_FILL);
+    for (uint32_t i = 0; i < draws; i++) {
+        GLStateCache::UseProgram(3 + i * 4 / draws);
+        GLStateCache::BindVertexArray(10 + i % 16);
+    }
+
+    // Water
+    GLStateCache::Enable(GL_BLEND);
+    GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLStateCache::Enable(GL_DEPTH_TEST);
+    GLStateCache::DepthMask(false);
+    GLStateCache::UseProgram(8);
+    GLStateCache::BindVertexArray(3);
+    GLStateCache::DepthMask(true);
+    GLStateCache::Disable(GL_BLEND);
+
+    // Grass
+    saved = GLStateCache::Capture();
+    GLStateCache::Enable(GL_BLEND);
+    GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLStateCache::Enable(GL_DEPTH_TEST);
+    GLStateCache::DepthMask(false);
+    GLStateCache::Disable(GL_CULL_FACE);
+    GLStateCache::UseProgram(9);
+    GLStateCache::BindVertexArray(4);
+    GLStateCache::Restore(saved, GLStateCache::RESTORE_FIXED_FUNCTION);
+
+    // Particles
+    GLStateCache::Enable(GL_BLEND);
+    GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE);
+    GLStateCache::DepthMask(false);
+    GLStateCache::UseProgram(10);
+    GLStateCache::BindVertexArray(5);
+    GLStateCache::DepthMask(true);
+    GLStateCache::Disable(GL_BLEND);
+
+    // Post process
+    saved = GLStateCache::Capture();
+    GLStateCache::Disable(GL_DEPTH_TEST);
+    GLStateCache::DepthMask(false);
+    GLStateCache::Disable(GL_CULL_FACE);
+    GLStateCache::Disable(GL_BLEND);
+    GLStateCache::UseProgram(11);
+    GLStateCache::BindTexture(0, GL_TEXTURE_2D, 20);
+    GLStateCache::BindVertexArray(6);
+    GLStateCache::Restore(saved);
+}
+
+void RunFrameCounts() {
+    MockGL gpu, reference;
+    ResetModels(gpu, reference);
+    constexpr uint32_t DRAWS = 64;
+    constexpr int FRAMES = 100;
+
+    SimulateFrame(DRAWS);   // Warm-up: shadow state settles
+    GLStateCache::ResetStats();
+    g_Calls = 0;
+    for (int frame = 0; frame < FRAMES; frame++) SimulateFrame(DRAWS);
+
+    const GLStateStats& stats = GLStateCache::GetStats();
+    std::printf("Editor-like frame (%u draws), per frame\n", DRAWS);
+    std::printf("  %-14s %8s %8s\n", "call", "issued", "skipped");
+    const char* names[GLStateStats::CATEGORY_COUNT] = {
+        "Program", "VertexArray", "Buffer", "ActiveTexture", "Texture", "Capability",
+        "BlendFunc", "DepthFunc", "DepthMask", "CullFace", "PolygonMode"
+    };
+    for (uint32_t i = 0; i < GLStateStats::CATEGORY_COUNT; i++) {
+        if (stats.Issued[i] + stats.Skipped[i] == 0) continue;
+        std::printf("  %-14s %8u %8u\n", names[i], stats.Issued[i] / FRAMES, stats.Skipped[i] / FRAMES);
+    }
+    std::printf("  %-14s %8u %8u   (glGet / glIsEnabled: %u)\n", "total",
+                stats.TotalIssued() / FRAMES, stats.TotalSkipped() / FRAMES, g_Queries);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    InstallMockGL();
+
+    TestCounters();
+    TestEquivalence();
+    TestCaptureRestore();
+
+    return Test::Finish(argc, argv, RunFrameCounts);
+}
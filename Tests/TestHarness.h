@@ -0,0 +1,59 @@
+/******************************************************************************
+ * File: TestHarness.h
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Minimal check / report helpers shared by the standalone test executables
+ ******************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace MyEngine {
+namespace Test {
+
+inline int g_Failures = 0;
+
+/**
+ * @brief Record a failed check; execution continues so one run reports every failure
+ */
+inline void Check(bool condition, const char* what) {
+    if (!condition) {
+        std::printf("  FAILED: %s\n", what);
+        g_Failures++;
+    }
+}
+
+/**
+ * @brief Relative comparison, tolerance scaled by the magnitudes of a and b
+ */
+inline bool Near(float a, float b, float tolerance) {
+    return std::fabs(a - b) <= tolerance * (1.0f + std::fabs(a) + std::fabs(b));
+}
+
+/**
+ * @brief Print the summary and run the benchmarks unless a check failed or --no-bench was given
+ * @return The process exit code
+ */
+template<typename BenchmarkFunc>
+int Finish(int argc, char** argv, BenchmarkFunc&& runBenchmarks) {
+    if (g_Failures > 0) {
+        std::printf("%d check(s) FAILED\n", g_Failures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+
+    // --no-bench: correctness only
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--no-bench") == 0) {
+            return 0;
+        }
+    }
+    runBenchmarks();
+    return 0;
+}
+
+} // namespace Test
+} // namespace MyEngine
@@ -0,0 +1,395 @@
+/******************************************************************************
+ * File: TestMathSIMD.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: SIMD math backend correctness tests and micro-benchmarks
+ ******************************************************************************/
+
+#include "Math/MathTypes.h"
+#include "Math/MathSIMD.h"
+#include "TestHarness.h"
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+using namespace MyEngine;
+using namespace MyEngine::Test;
+
+namespace {
+
+bool NearArray(const float* a, const float* b, int count, float tolerance) {
+    for (int i = 0; i < count; i++) {
+        if (!Near(a[i], b[i], tolerance)) return false;
+    }
+    return true;
+}
+
+// =============================================================================
+// Scalar reference implementations (the pre-SIMD code paths)
+// =============================================================================
+
+Mat4 RefMul(const Mat4& a, const Mat4& b) {
+    Mat4 result;
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            float sum = 0;
+            for (int i = 0; i < 4; i++) {
+                sum += a.m[i * 4 + row] * b.m[col * 4 + i];
+            }
+            result.m[col * 4 + row] = sum;
+        }
+    }
+    return result;
+}
+
+Vec4 RefMulVec4(const Mat4& m, const Vec4& v) {
+    return Vec4(m.m[0] * v.x + m.m[4] * v.y + m.m[8] * v.z + m.m[12] * v.w,
+                m.m[1] * v.x + m.m[5] * v.y + m.m[9] * v.z + m.m[13] * v.w,
+                m.m[2] * v.x + m.m[6] * v.y + m.m[10] * v.z + m.m[14] * v.w,
+                m.m[3] * v.x + m.m[7] * v.y + m.m[11] * v.z + m.m[15] * v.w);
+}
+
+// Gauss-Jordan elimination with partial pivoting, in double precision
+bool RefInverse(const Mat4& m, Mat4& out) {
+    double a[4][8];
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            a[row][col] = m.m[col * 4 + row];
+            a[row][col + 4] = (row == col) ? 1.0 : 0.0;
+        }
+    }
+    for (int col = 0; col < 4; col++) {
+        int pivot = col;
+        for (int row = col + 1; row < 4; row++) {
+            if (std::fabs(a[row][col]) > std::fabs(a[pivot][col])) pivot = row;
+        }
+        if (a[pivot][col] == 0.0) return false;
+        for (int k = 0; k < 8; k++) std::swap(a[col][k], a[pivot][k]);
+        const double scale = 1.0 / a[col][col];
+        for (int k = 0; k < 8; k++) a[col][k] *= scale;
+        for (int row = 0; row < 4; row++) {
+            if (row == col) continue;
+            const double factor = a[row][col];
+            for (int k = 0; k < 8; k++) a[row][k] -= factor * a[col][k];
+        }
+    }
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            out.m[col * 4 + row] = static_cast<float>(a[row][col + 4]);
+        }
+    }
+    return true;
+}
+
+Quat RefQuatMul(const Quat& a, const Quat& b) {
+    return Quat(a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+                a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+}
+
+Quat RefNormalize(const Quat& q) {
+    float len = sqrtf(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    if (len < 0.0001f) return Quat(0, 0, 0, 1);
+    return Quat(q.x / len, q.y / len, q.z / len, q.w / len);
+}
+
+Quat RefSlerp(const Quat& a, const Quat& b, float t) {
+    Quat qa = RefNormalize(a);
+    Quat qb = RefNormalize(b);
+    float dot = qa.x * qb.x + qa.y * qb.y + qa.z * qb.z + qa.w * qb.w;
+    if (dot < 0.0f) {
+        qb = Quat(-qb.x, -qb.y, -qb.z, -qb.w);
+        dot = -dot;
+    }
+    if (dot > 0.9995f) {
+        return RefNormalize(Quat(qa.x + t * (qb.x - qa.x), qa.y + t * (qb.y - qa.y),
+                                 qa.z + t * (qb.z - qa.z), qa.w + t * (qb.w - qa.w)));
+    }
+    float theta = acosf(dot);
+    float sinTheta = sinf(theta);
+    float wa = sinf((1.0f - t) * theta) / sinTheta;
+    float wb = sinf(t * theta) / sinTheta;
+    return Quat(wa * qa.x + wb * qb.x, wa * qa.y + wb * qb.y, wa * qa.z + wb * qb.z, wa * qa.w + wb * qb.w);
+}
+
+// =============================================================================
+// Random inputs
+// =============================================================================
+
+std::mt19937 g_Rng(1234);
+
+float Random(float lo, float hi) {
+    return std::uniform_real_distribution<float>(lo, hi)(g_Rng);
+}
+
+Mat4 RandomMatrix() {
+    Mat4 m;
+    for (int i = 0; i < 16; i++) m.m[i] = Random(-2.0f, 2.0f);
+    return m;
+}
+
+// Random TRS, keeps the condition number reasonable for inverse tests
+Mat4 RandomTransform() {
+    Quat rotation = Quat(Random(-1, 1), Random(-1, 1), Random(-1, 1), Random(-1, 1)).Normalized();
+    Mat4 scale = Mat4::Scale(Vec3(Random(0.2f, 3.0f), Random(0.2f, 3.0f), Random(0.2f, 3.0f)));
+    Mat4 translation = Mat4::Translation(Vec3(Random(-50, 50), Random(-50, 50), Random(-50, 50)));
+    return RefMul(translation, RefMul(rotation.ToMatrix(), scale));
+}
+
+Quat RandomQuat() {
+    return Quat(Random(-1, 1), Random(-1, 1), Random(-1, 1), Random(-1, 1));
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestMatrix() {
+    std::printf("Mat4\n");
+    for (int iteration = 0; iteration < 1000; iteration++) {
+        const Mat4 a = RandomMatrix();
+        const Mat4 b = RandomMatrix();
+
+        Check(NearArray((a * b).m, RefMul(a, b).m, 16, 1e-5f), "operator* matches reference");
+
+        Mat4 aliased = a;
+        SIMD::MulMat4(aliased, b, aliased);
+        Check(NearArray(aliased.m, RefMul(a, b).m, 16, 1e-5f), "MulMat4 with out aliasing a");
+
+        const Vec4 v(Random(-5, 5), Random(-5, 5), Random(-5, 5), Random(-5, 5));
+        Vec4 mv;
+        SIMD::Mat4MulVec4(a.m, &v.x, &mv.x);
+        const Vec4 refMv = RefMulVec4(a, v);
+        Check(NearArray(&mv.x, &refMv.x, 4, 1e-5f), "Mat4MulVec4 matches reference");
+
+        // Transpose only moves values: must be bit-exact
+        const Mat4 t = a.Transposed();
+        bool transposeExact = true;
+        for (int row = 0; row < 4; row++) {
+            for (int col = 0; col < 4; col++) {
+                transposeExact &= std::memcmp(&t.m[row * 4 + col], &a.m[col * 4 + row], sizeof(float)) == 0;
+            }
+        }
+        Check(transposeExact, "Transposed is bit-exact");
+    }
+}
+
+void TestInverse() {
+    std::printf("Mat4::Inverted\n");
+    const Mat4 identity;
+    for (int iteration = 0; iteration < 1000; iteration++) {
+        const Mat4 m = RandomTransform();
+        Mat4 reference;
+        RefInverse(m, reference);
+        const Mat4 inverse = m.Inverted();
+        Check(NearArray(inverse.m, reference.m, 16, 1e-4f), "inverse of TRS matches reference");
+        Check(NearArray((m * inverse).m, identity.m, 16, 1e-4f), "M * M^-1 = I");
+
+        // Dense random matrices (skip badly conditioned ones)
+        const Mat4 dense = RandomMatrix();
+        Mat4 denseReference;
+        if (RefInverse(dense, denseReference)) {
+            float maxAbs = 0.0f;
+            for (float value : denseReference.m) maxAbs = std::max(maxAbs, std::fabs(value));
+            if (maxAbs < 50.0f) {
+                Check(NearArray(dense.Inverted().m, denseReference.m, 16, 1e-3f), "inverse of dense matrix");
+            }
+        }
+    }
+
+    // View-projection (the editor's picking path) is not orthonormal
+    const Mat4 projection = Mat4::Perspective(1.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+    const Mat4 view = Mat4::Translation(Vec3(3, -2, 10)).Inverted();
+    const Mat4 viewProjection = projection * view;
+    Check(NearArray((viewProjection * viewProjection.Inverted()).m, identity.m, 16, 1e-4f),
+          "view-projection inverse");
+
+    // The orthonormal fast path must agree on rigid transforms
+    const Mat4 rigid = RefMul(Mat4::Translation(Vec3(1, 2, 3)), Mat4::Rotation(0.7f, Vec3(1, 1, 0)));
+    Check(NearArray(rigid.Inverted().m, rigid.InvertedOrthonormal().m, 16, 1e-5f),
+          "general and orthonormal inverse agree");
+
+    Mat4 singular = RandomMatrix();
+    for (int i = 0; i < 4; i++) singular.m[i * 4 + 2] = 0.0f;  // zero row
+    Mat4 singularInverse;
+    Check(!SIMD::Mat4Inverse(singular.m, singularInverse.m), "singular matrix reported");
+    Check(NearArray(singularInverse.m, identity.m, 16, 0.0f), "singular inverse is identity");
+}
+
+void TestQuat() {
+    std::printf("Quat / Vec4\n");
+    for (int iteration = 0; iteration < 1000; iteration++) {
+        const Quat a = RandomQuat();
+        const Quat b = RandomQuat();
+
+        const Quat product = a * b;
+        const Quat refProduct = RefQuatMul(a, b);
+        Check(NearArray(&product.x, &refProduct.x, 4, 1e-5f), "Quat * Quat matches reference");
+
+        const Quat na = a.Normalized();
+        const Quat nb = b.Normalized();
+        const Quat refNa = RefNormalize(a);
+        Check(NearArray(&na.x, &refNa.x, 4, 1e-5f), "Normalized matches reference");
+
+        // Composition order matches matrices: R(a * b) = R(a) * R(b)
+        Check(NearArray((na * nb).ToMatrix().m, (na.ToMatrix() * nb.ToMatrix()).m, 16, 1e-4f),
+              "ToMatrix(a * b) = ToMatrix(a) * ToMatrix(b)");
+
+        const float t = Random(0.0f, 1.0f);
+        const Quat slerp = Quat::Slerp(a, b, t);
+        const Quat refSlerp = RefSlerp(a, b, t);
+        Check(NearArray(&slerp.x, &refSlerp.x, 4, 1e-5f), "Slerp matches reference");
+
+        const Vec4 va(a.x, a.y, a.z, a.w);
+        const Vec4 vb(b.x, b.y, b.z, b.w);
+        const Vec4 sum = va + vb;
+        const Vec4 difference = va - vb;
+        Check(sum.x == a.x + b.x && sum.y == a.y + b.y && sum.z == a.z + b.z && sum.w == a.w + b.w,
+              "Vec4 + is bit-exact");
+        Check(difference.x == a.x - b.x && difference.w == a.w - b.w, "Vec4 - is bit-exact");
+        Check(Near(va.Dot(vb), a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w, 1e-6f), "Vec4 dot");
+    }
+
+    // Near-identical quaternions take the lerp path
+    const Quat q = RandomQuat().Normalized();
+    const Quat close = Quat(q.x + 1e-4f, q.y, q.z, q.w);
+    const Quat slerp = Quat::Slerp(q, close, 0.5f);
+    const Quat refSlerp = RefSlerp(q, close, 0.5f);
+    Check(NearArray(&slerp.x, &refSlerp.x, 4, 1e-6f), "Slerp lerp path");
+
+    const Quat degenerate = Quat(0, 0, 0, 0).Normalized();
+    Check(degenerate.x == 0 && degenerate.y == 0 && degenerate.z == 0 && degenerate.w == 1,
+          "zero quaternion normalizes to identity");
+}
+
+// =============================================================================
+// Micro-benchmarks
+// =============================================================================
+
+double ElapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+template<typename RefFunc, typename SimdFunc>
+void Compare(const char* name, RefFunc refFunc, SimdFunc simdFunc) {
+    auto start = std::chrono::high_resolution_clock::now();
+    float refSink = refFunc();
+    const double refMs = ElapsedMs(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    float simdSink = simdFunc();
+    const double simdMs = ElapsedMs(start);
+
+    std::printf("  %-20s reference %9.3f ms   %-9s %9.3f ms   x%.2f   (%g %g)\n", name, refMs,
+                SIMD::BackendName(), simdMs, refMs / simdMs, refSink, simdSink);
+}
+
+/**
+ * 基线为上面的参考实现（逆矩阵为双精度 Gauss-Jordan）。
+ * 与标量回退路径对比：用 -DMYENGINE_SIMD_SCALAR=ON 再构建一次运行。
+ */
+void RunBenchmarks() {
+    constexpr int COUNT = 1 << 16;
+    constexpr int REPEAT = 16;
+    std::printf("Micro-benchmarks, %d x %d operations\n", COUNT, REPEAT);
+
+    std::vector<Mat4> matrices(COUNT);
+    std::vector<Mat4> results(COUNT);
+    std::vector<Quat> quats(COUNT);
+    std::vector<Quat> quatResults(COUNT);
+    for (int i = 0; i < COUNT; i++) {
+        matrices[i] = RandomTransform();
+        quats[i] = RandomQuat().Normalized();
+    }
+
+    Compare("Mat4 multiply",
+        [&] {
+            for (int r = 0; r < REPEAT; r++)
+                for (int i = 0; i + 1 < COUNT; i++) results[i] = RefMul(matrices[i], matrices[i + 1]);
+            return results[COUNT / 2].m[5];
+        },
+        [&] {
+            for (int r = 0; r < REPEAT; r++)
+                for (int i = 0; i + 1 < COUNT; i++) results[i] = matrices[i] * matrices[i + 1];
+            return results[COUNT / 2].m[5];
+        });
+
+    Compare("Mat4 inverse",
+        [&] {
+            for (int r = 0; r < REPEAT; r++)
+                for (int i = 0; i < COUNT; i++) RefInverse(matrices[i], results[i]);
+            return results[COUNT / 2].m[5];
+        },
+        [&] {
+            for (int r = 0; r < REPEAT; r++)
+                for (int i = 0; i < COUNT; i++) results[i] = matrices[i].Inverted();
+            return results[COUNT / 2].m[5];
+        });
+
+    Compare("Mat4 transpose",
+        [&] {
+            for (int r = 0; r < REPEAT; r++)
+                for (int i = 0; i < COUNT; i++)
+                    for (int row = 0; row < 4; row++)
+                        for (int col = 0; col < 4; col++)
+                            results[i].m[row * 4 + col] = matrices[i].m[col * 4 + row];
+            return results[COUNT / 2].m[1];
+        },
+        [&] {
+            for (int r = 0; r < REPEAT; r++)
+                for (int i = 0; i < COUNT; i++) results[i] = matrices[i].Transposed();
+            return results[COUNT / 2].m[1];
+        });
+
+    Compare("Quat multiply",
+        [&] {
+            for (int r = 0; r < REPEAT; r++)
+                for (int i = 0; i + 1 < COUNT; i++) quatResults[i] = RefQuatMul(quats[i], quats[i + 1]);
+            return quatResults[COUNT / 2].w;
+        },
+        [&] {
+            for (int r = 0; r < REPEAT; r++)
+                for (int i = 0; i + 1 < COUNT; i++) quatResults[i] = quats[i] * quats[i + 1];
+            return quatResults[COUNT / 2].w;
+        });
+
+    Compare("Quat normalize",
+        [&] {
+            for (int r = 0; r < REPEAT; r++)
+                for (int i = 0; i < COUNT; i++) quatResults[i] = RefNormalize(quats[i]);
+            return quatResults[COUNT / 2].w;
+        },
+        [&] {
+            for (int r = 0; r < REPEAT; r++)
+                for (int i = 0; i < COUNT; i++) quatResults[i] = quats[i].Normalized();
+            return quatResults[COUNT / 2].w;
+        });
+
+    Compare("Quat slerp",
+        [&] {
+            for (int r = 0; r < REPEAT; r++)
+                for (int i = 0; i + 1 < COUNT; i++) quatResults[i] = RefSlerp(quats[i], quats[i + 1], 0.3f);
+            return quatResults[COUNT / 2].w;
+        },
+        [&] {
+            for (int r = 0; r < REPEAT; r++)
+                for (int i = 0; i + 1 < COUNT; i++) quatResults[i] = Quat::Slerp(quats[i], quats[i + 1], 0.3f);
+            return quatResults[COUNT / 2].w;
+        });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::printf("SIMD backend: %s\n", SIMD::BackendName());
+
+    TestMatrix();
+    TestInverse();
+    TestQuat();
+
+    return Test::Finish(argc, argv, RunBenchmarks);
+}
@@ -0,0 +1,338 @@
+/******************************************************************************
+ * File: TestRenderCommands.cpp
+ * Author: AI Assistant
+ * Created: 2026-10-18
+ * Description: Render command buffer sort / merge / replay tests and headless frame benchmark
+ ******************************************************************************/
+
+#include "Rendering/RenderCommandBuffer.h"
+#include "Rendering/NullRenderBackend.h"
+#include "Rendering/RecordingRenderBackend.h"
+#include "Rendering/Shader.h"
+#include "Rendering/VertexArray.h"
+#include "TestHarness.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace MyEngine;
+using namespace MyEngine::Test;
+
+namespace {
+
+std::mt19937 g_Rng(2468);
+
+uint32_t RandomInt(uint32_t lo, uint32_t hi) {
+    return std::uniform_int_distribution<uint32_t>(lo, hi)(g_Rng);
+}
+
+float Random(float lo, float hi) {
+    return std::uniform_real_distribution<float>(lo, hi)(g_Rng);
+}
+
+/**
+ * @brief Shader without a graphics API (uniform setters only touch memory)
+ */
+class FakeShader : public Shader {
+public:
+    explicit FakeShader(const std::string& name) : m_Name(name) {}
+
+    void Bind() const override {}
+    void Unbind() const override {}
+
+    void SetInt(std::string_view name, int value) override { m_Sink += static_cast<float>(value) + name.size(); }
+    void SetBool(std::string_view name, bool value) override { m_Sink += (value ? 1.0f : 0.0f) + name.size(); }
+    void SetFloat(std::string_view name, float value) override { m_Sink += value + name.size(); }
+    void SetFloat3(std::string_view name, const Vec3& value) override { m_Sink += value.x + name.size(); }
+    void SetFloat4(std::string_view name, const Vec4& value) override { m_Sink += value.x + name.size(); }
+    void SetMat4(std::string_view name, const Mat4& value) override { m_Sink += value.m[12] + name.size(); }
+    void SetMat4Array(std::string_view name, const Mat4* values, uint32_t count) override { m_Sink += values[0].m[12] + count + name.size(); }
+
+    const std::string& GetName() const override { return m_Name; }
+
+    float GetSink() const { return m_Sink; }
+
+private:
+    std::string m_Name;
+    float m_Sink = 0.0f;
+};
+
+class FakeVertexArray : public VertexArray {
+public:
+    void Bind() const override {}
+    void Unbind() const override {}
+
+    void AddVertexBuffer(const std::shared_ptr<VertexBuffer>&) override {}
+    void SetIndexBuffer(const std::shared_ptr<IndexBuffer>&) override {}
+
+    const std::vector<std::shared_ptr<VertexBuffer>>& GetVertexBuffers() const override { return m_VertexBuffers; }
+    const std::shared_ptr<IndexBuffer>& GetIndexBuffer() const override { return m_IndexBuffer; }
+
+private:
+    std::vector<std::shared_ptr<VertexBuffer>> m_VertexBuffers;
+    std::shared_ptr<IndexBuffer> m_IndexBuffer;
+};
+
+void TestLayout() {
+    std::printf("Layout\n");
+    Check(sizeof(RenderCommand) == 32, "RenderCommand is 32 bytes");
+
+    const uint64_t setup = RenderSortKey::Setup(RenderLayer::Opaque);
+    const uint64_t draw = RenderSortKey::Draw(RenderLayer::Opaque, 1, 0, 0);
+    const uint64_t transparent = RenderSortKey::Setup(RenderLayer::Transparent);
+    Check(setup < draw && draw < transparent, "setup < draws < next layer");
+    Check(RenderSortKey::Depth(1.0f, 100.0f) < RenderSortKey::Depth(2.0f, 100.0f) &&
+          RenderSortKey::ReverseDepth(1.0f, 100.0f) > RenderSortKey::ReverseDepth(2.0f, 100.0f),
+          "depth front to back / reverse back to front");
+    Check(RenderSortKey::ShaderID(nullptr) != 0 && RenderSortKey::ShaderID(reinterpret_cast<const Shader*>(&g_Failures)) != 0, "shader id never 0");
+}
+
+// Sort must equal a stable comparison sort of the record order
+void TestSort() {
+    std::printf("Sort\n");
+    FakeShader shader("sort");
+    FakeVertexArray vertexArray;
+    for (size_t count : { size_t(0), size_t(1), size_t(10), size_t(63), size_t(64), size_t(1000), size_t(100000) }) {
+        RenderCommandBuffer commands;
+        commands.Reset(3);
+        std::vector<uint64_t> keys;
+        for (size_t i = 0; i < count; i++) {
+            // Few distinct shaders / materials so that equal keys exist
+            const uint64_t key = RenderSortKey::Draw(static_cast<RenderLayer>(RandomInt(0, 2)),
+                                                     static_cast<uint16_t>(RandomInt(1, 4)),
+                                                     static_cast<uint16_t>(RandomInt(0, 3)),
+                                                     RandomInt(0, 50));
+            keys.push_back(key | (3ull << RenderSortKey::PASS_SHIFT));
+            commands.DrawIndexed(key, &shader, &vertexArray, static_cast<uint32_t>(i));
+        }
+        RenderQueue queue;
+        queue.Add(commands);
+        queue.Sort();
+
+        std::vector<uint32_t> expected(count);
+        std::iota(expected.begin(), expected.end(), 0u);
+        std::stable_sort(expected.begin(), expected.end(), [&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+        bool same = queue.GetCommandCount() == count;
+        for (size_t i = 0; same && i < count; i++) {
+            same = queue.GetCommand(i).draw.indexCount == expected[i] && queue.GetKey(i) == keys[expected[i]];
+        }
+        Check(same, "radix sort == stable_sort (keys and record order of equal keys)");
+    }
+}
+
+void TestMerge() {
+    std::printf("Merge\n");
+    FakeShader shader("merge");
+    FakeVertexArray vertexArray;
+
+    RenderCommandBuffer first, second;
+    first.Reset(1);
+    second.Reset(0);
+    first.Clear(RenderSortKey::Setup(RenderLayer::Background), Vec4(0.1f, 0.2f, 0.3f, 1.0f));
+    first.DrawIndexed(RenderSortKey::Draw(RenderLayer::Opaque, 1, 0, 0), &shader, &vertexArray, 6,
+                      Mat4::Translation(Vec3(1, 0, 0)));
+    second.SetUniform(RenderSortKey::Setup(RenderLayer::Opaque), &shader, "u_Value", Vec3(7, 8, 9));
+    second.DrawIndexed(RenderSortKey::Draw(RenderLayer::Opaque, 1, 0, 0), &shader, &vertexArray, 3,
+                       Mat4::Translation(Vec3(2, 0, 0)));
+    second.DrawIndexed(RenderSortKey::Draw(RenderLayer::Opaque, 1, 0, 1), &shader, &vertexArray, 3);
+
+    RenderCommandBuffer empty;
+    RenderQueue queue;
+    queue.Add(first);
+    queue.Add(empty);
+    queue.Add(second);
+    queue.Sort();
+
+    // Pass 0 (second) first, then pass 1; payload read from the owning buffer
+    bool ok = queue.GetCommandCount() == 5;
+    ok = ok && queue.GetCommand(0).type == RenderCommandType::SetUniform &&
+         queue.GetBuffer(0).GetPayload(queue.GetCommand(0).uniform.dataOffset)[2] == 9.0f;
+    ok = ok && queue.GetCommand(1).type == RenderCommandType::DrawIndexed &&
+         queue.GetBuffer(1).GetPayload(queue.GetCommand(1).draw.transformOffset)[12] == 2.0f;
+    ok = ok && queue.GetCommand(2).draw.transformOffset == RenderCommandBuffer::NO_TRANSFORM;
+    ok = ok && queue.GetCommand(3).type == RenderCommandType::Clear &&
+         queue.GetBuffer(3).GetPayload(queue.GetCommand(3).clear.colorOffset)[1] == 0.2f;
+    ok = ok && queue.GetBuffer(4).GetPayload(queue.GetCommand(4).draw.transformOffset)[12] == 1.0f;
+    for (size_t i = 0; ok && i < queue.GetCommandCount(); i++) {
+        ok = RenderSortKey::GetPass(queue.GetKey(i)) == (i < 3 ? 0 : 1);
+    }
+    Check(ok, "queue merges buffers by pass and keeps each command's payload");
+}
+
+void TestReplay() {
+    std::printf("Replay\n");
+    FakeShader shaderA("A"), shaderB("B");
+    std::vector<FakeVertexArray> meshes(4);
+
+    // Two passes recorded on two threads, appended in the wrong order
+    RenderCommandBuffer passBuffers[2];
+    auto recordPass = [&](int pass) {
+        RenderCommandBuffer& commands = passBuffers[pass];
+        commands.Reset(static_cast<uint8_t>(pass));
+        RenderState state;
+        state.wireframe = pass == 1;
+        const uint64_t setup = RenderSortKey::Setup(RenderLayer::Opaque);
+        commands.SetState(setup, state);
+        commands.SetState(setup, state);          // Redundant
+        commands.SetUniform(setup, &shaderA, "u_ViewProjection", Mat4());
+        commands.SetUniform(setup, &shaderB, "u_ViewProjection", Mat4());
+        for (uint32_t i = 0; i < 40; i++) {
+            Shader* shader = (i % 2) ? static_cast<Shader*>(&shaderB) : static_cast<Shader*>(&shaderA);
+            const uint64_t key = RenderSortKey::Draw(RenderLayer::Opaque, RenderSortKey::ShaderID(shader), 0,
+                                                     RenderSortKey::Depth(static_cast<float>(40 - i), 100.0f));
+            commands.DrawIndexed(key, shader, &meshes[i % 4], 100 + i, Mat4());
+        }
+    };
+    std::thread worker(recordPass, 1);
+    recordPass(0);
+    worker.join();
+
+    RenderQueue frame;
+    frame.Add(passBuffers[1]);
+    frame.Add(passBuffers[0]);
+    frame.Sort();
+
+    RecordingRenderBackend backend;
+    backend.BeginFrame();
+    const ReplayStats stats = backend.Submit(frame);
+    const std::vector<RecordedCall>& calls = backend.GetCalls();
+
+    // Per pass: state once, uniforms, then draws grouped by shader and front to back within a shader
+    bool ok = stats.Draws == 80 && stats.StateChanges == 2 && stats.Commands == frame.GetCommandCount();
+    std::vector<uint32_t> drawOrder;
+    std::vector<Shader*> drawShaders;
+    Shader* bound = nullptr;
+    for (const RecordedCall& call : calls) {
+        if (call.kind == RecordedCall::Kind::BindShader) bound = call.shader;
+        if (call.kind == RecordedCall::Kind::DrawIndexed) {
+            drawOrder.push_back(call.value);
+            drawShaders.push_back(bound);
+        }
+    }
+    ok = ok && drawOrder.size() == 80;
+    for (size_t pass = 0; ok && pass < 2; pass++) {
+        const size_t base = pass * 40;
+        for (size_t i = 1; i < 40; i++) {
+            const bool sameShader = drawShaders[base + i] == drawShaders[base + i - 1];
+            // Depth is 40 - i: nearer objects have larger i
+            ok = ok && (!sameShader || drawOrder[base + i] < drawOrder[base + i - 1]);
+        }
+        // Exactly one shader switch between the two groups
+        size_t switches = 0;
+        for (size_t i = 1; i < 40; i++) switches += drawShaders[base + i] != drawShaders[base + i - 1];
+        ok = ok && switches == 1;
+    }
+    Check(ok, "replay order: pass, setup before draws, shader groups, front to back");
+    Check(calls.front().kind == RecordedCall::Kind::SetRenderState && !calls.front().state.wireframe,
+          "first call is pass 0 state");
+    Check(stats.RedundantSkipped > 0 && stats.ShaderBinds < 10, "redundant binds and states filtered");
+}
+
+/**
+ * @brief Headless frame: PASSES passes x DRAWS draws
+ * Immediate = per-draw uniform + draw calls straight into the backend (the old pass code path)
+ */
+void RunBenchmark() {
+    constexpr uint32_t PASSES = 4;
+    constexpr uint32_t DRAWS = 25000;
+    constexpr int REPEAT = 20;
+
+    std::vector<std::unique_ptr<FakeShader>> shaders;
+    for (int i = 0; i < 8; i++) shaders.push_back(std::make_unique<FakeShader>("shader" + std::to_string(i)));
+    std::vector<FakeVertexArray> meshes(256);
+
+    struct Object {
+        Shader* shader;
+        const VertexArray* mesh;
+        Mat4 transform;
+        float depth;
+    };
+    std::vector<Object> objects(DRAWS);
+    for (Object& object : objects) {
+        object.shader = shaders[RandomInt(0, 7)].get();
+        object.mesh = &meshes[RandomInt(0, 255)];
+        object.transform = Mat4::Translation(Vec3(Random(-100, 100), Random(-10, 10), Random(-100, 100)));
+        object.depth = Random(0.1f, 500.0f);
+    }
+
+    NullRenderBackend backend;
+
+    // Immediate: bind + uniform + draw per object, in scene order
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < REPEAT; r++) {
+        backend.BeginFrame();
+        for (uint32_t pass = 0; pass < PASSES; pass++) {
+            for (const Object& object : objects) {
+                object.shader->Bind();
+                object.shader->SetMat4("u_Transform", object.transform);
+                object.mesh->Bind();
+                backend.DrawIndexed(36);
+            }
+        }
+    }
+    const double immediateMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / REPEAT;
+
+    // Recorded: parallel record per pass, merge, radix sort, replay
+    std::vector<RenderCommandBuffer> passBuffers(PASSES);
+    RenderQueue frame;
+    double recordMs = 0.0, sortMs = 0.0, replayMs = 0.0;
+    ReplayStats stats;
+    for (int r = 0; r < REPEAT; r++) {
+        backend.BeginFrame();
+        auto t0 = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> workers;
+        for (uint32_t pass = 0; pass < PASSES; pass++) {
+            workers.emplace_back([&, pass]() {
+                RenderCommandBuffer& commands = passBuffers[pass];
+                commands.Reset(static_cast<uint8_t>(pass));
+                for (const Object& object : objects) {
+                    const uint64_t key = RenderSortKey::Draw(RenderLayer::Opaque, RenderSortKey::ShaderID(object.shader), 0,
+                                                             RenderSortKey::Depth(object.depth, 500.0f));
+                    commands.DrawIndexed(key, object.shader, object.mesh, 36, object.transform);
+                }
+            });
+        }
+        for (std::thread& worker : workers) worker.join();
+        auto t1 = std::chrono::high_resolution_clock::now();
+        frame.Reset();
+        for (const RenderCommandBuffer& commands : passBuffers) frame.Add(commands);
+        frame.Sort();
+        auto t2 = std::chrono::high_resolution_clock::now();
+        stats = backend.Submit(frame);
+        auto t3 = std::chrono::high_resolution_clock::now();
+        recordMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+        sortMs += std::chrono::duration<double, std::milli>(t2 - t1).count();
+        replayMs += std::chrono::duration<double, std::milli>(t3 - t2).count();
+    }
+    recordMs /= REPEAT;
+    sortMs /= REPEAT;
+    replayMs /= REPEAT;
+
+    std::printf("Headless frame: %u passes x %u draws (NullRenderBackend, %u hardware threads)\n",
+                PASSES, DRAWS, std::thread::hardware_concurrency());
+    std::printf("  %-30s %9.3f ms\n", "immediate", immediateMs);
+    std::printf("  %-30s %9.3f ms\n", "record (thread per pass)", recordMs);
+    std::printf("  %-30s %9.3f ms\n", "merge + radix sort", sortMs);
+    std::printf("  %-30s %9.3f ms  (%u shader binds, %u skipped)\n", "replay", replayMs,
+                stats.ShaderBinds, stats.RedundantSkipped);
+    std::printf("  %-30s %9.3f ms  (%llu draws)\n", "recorded total", recordMs + sortMs + replayMs,
+                static_cast<unsigned long long>(backend.GetDrawCount()));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    TestLayout();
+    TestSort();
+    TestMerge();
+    TestReplay();
+
+    return Test::Finish(argc, argv, RunBenchmark);
+}
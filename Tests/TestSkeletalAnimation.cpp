@@ -153,10 +153,7 @@ int main() {
         
         // Upload bone matrices
         auto transforms = animator->GetFinalBoneMatrices();
-        for (size_t i = 0; i < transforms.size(); ++i) {
-            std::string uniformName = "finalBonesMatrices[" + std::to_string(i) + "]";
-            shader->SetMat4(uniformName, transforms[i]);
-        }
+        shader->SetMat4Array("finalBonesMatrices", transforms.data(), static_cast<uint32_t>(transforms.size()));
         
         // Draw mesh
         auto vao = animatedMesh->GetVertexArray();